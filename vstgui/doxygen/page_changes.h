@@ -26,6 +26,30 @@ It's recommended to start new projects with version 4 while old projects should
 
 - add crosshair mouse cursor (kCursorCrosshair)
 - customizable knob range (see CKnob::setKnobRange)
+- invalid rects are merged via a spatial index and the coalescing is configurable (see CInvalidRectList::Policy and CFrame::setInvalidRectListPolicy)
+- view containers can cache their drawing in a bitmap (see CViewContainer::setCacheAsBitmap)
+- the linux frame presents all dirty rects with one fill and reports draw statistics (see X11::IX11Frame::getDrawStatistics)
+- the linux font backend caches shaped text layouts (see Cairo::Font::setLayoutCacheMemoryBudget)
+- bitmaps of an UIDescription can be decoded in the background and their decode time can be traced (see UIDescription::prefetchBitmaps and UIDescription::setBitmapDecodeTraceFunc)
+- UIDescriptions can be saved in a binary format which loads faster (see UIDescription::kWriteAsBinary and the --binary option of the uidesccompressor). Only a MemoryContentProvider is read in place, resources and files are read into a buffer first, and the strings are copied into the nodes in either case
+- the UIViewFactory can create views from pre-resolved creation plans which the UIDescription caches per view node (see UIViewFactory::CreationPlan)
+- animations are frame paced with a configurable frame rate, the invalidations of one animation frame are flushed at once and frame statistics are available (see Animation::Animator::setFrameRate and Animation::Animator::getFrameStatistics)
+- the linux standalone library performs async tasks on a work stealing thread pool and on the glib main loop (see Standalone::Async)
+- view containers with many child views can use a spatial index for hit testing and drawing (see CViewContainer::setSpatialIndexEnabled)
+- scroll views can scroll by translating their container instead of moving every child view, the linux frame moves the already drawn pixels and only redraws the exposed area (see CScrollView::kTransformScrolling)
+- the data browser only visits the rows and columns in the update rect, caches its column layout, looks up the selection in constant time and can reuse one text edit for all cell edits (see CDataBrowser::isRowSelected and CDataBrowser::setTextEditRecycling)
+- view switch containers can keep the views of other indices in a cache and create them one by one on a timer before they are shown (see UIViewSwitchContainer::setViewCachePolicy and UIViewSwitchContainer::setPrewarmViews)
+- shadow view containers can render the shadow at a reduced resolution and only regenerate it if the shape of their sub views changed (see CShadowViewContainer::setShadowDownsampling and CShadowViewContainer::setShadowFollowsContent)
+- parameter displays and text labels can draw short ASCII strings from a shared glyph atlas instead of the text layout engine of the platform (see CParamDisplay::setFastTextRendering and CGlyphAtlas)
+- the base64 codec uses SSE, AVX2 or NEON instructions when the compiler targets them, the PNG data of bitmaps embedded in uidesc files is streamed from the base64 decoder into the bitmap decoder (see Base64Codec::Decoder and IPlatformFactory::createBitmapFromStream)
+- the linux event loop only delivers the newest of the queued motion events of a window unless the frame asks for the complete history, the draw statistics of the linux frame include the input to present latency (see X11::FrameConfig::keepMotionEventHistory and X11::DrawStatistics)
+- vector knobs keep their corona paths in a path cache and only rebuild the value arc if the value changed visibly, the cairo backend caches the pixel aligned copy of a path per transform (see CGraphicsPathCache)
+- bitmaps can be calculated tile by tile on worker threads with progressive refinement, finished tiles are copied into the bitmap on the main thread and only their rects need to be redrawn. The mandelbrot example uses it (see CBitmapTileRenderer)
+- the frame keeps a registry of the views which were set dirty, idle can be told to only visit these views instead of scanning the whole view hierarchy (see CFrame::setIdleVisitsOnlyDirtyViews). This is off by default, as views overriding isDirty and controls changing their value member directly are then only redrawn if they call setDirty or invalid themselves
+- other threads can post control values by tag into a lock free mailbox of the frame, the frame sets the latest value of each tag to its controls before it draws (see CFrame::getControlValueMailbox and CControlValueMailbox)
+- the cairo backend fills tiled bitmaps and nine part tiled bitmaps with repeating patterns, a tiled background is drawn with one fill instead of one bitmap draw per tile (see IPlatformGraphicsDeviceContextBitmapExt)
+- decoded and filtered bitmaps of a UIDescription can be kept in a cache directory keyed by the image data and the filters, on linux the cached pixels are mapped into memory and used by the cairo surface without copying them (see UIDescription::setBitmapCacheDirectory)
+- the list control finds rows by binary search over the row offsets, only visits the rows in the update rect and can fetch the row descriptions in blocks when they are needed (see IListControlBlockConfigurator and UniformListControlConfigurator)
 
 @subsection version4_13 Version 4.13
 
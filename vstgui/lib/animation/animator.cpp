@@ -11,6 +11,9 @@ The source can be found under /lib/animation/
 
 @section the_animator The Animator
 Every @link VSTGUI::CFrame::getAnimator CFrame @endlink object can have one @link VSTGUI::Animation::Animator Animator @endlink object which runs animations at 60 Hz.
+The frame rate can be changed with @link VSTGUI::Animation::Animator::setFrameRate Animator::setFrameRate @endlink.
+All animation targets are updated before the views they invalidated are redrawn together, and the animator keeps
+@link VSTGUI::Animation::Animator::getFrameStatistics statistics @endlink about dropped frames and the time it needs per frame.
 
 The animator is responsible for running animations.
 You can add and remove animations.
@@ -96,6 +99,8 @@ public:
 #include "../cview.h"
 #include "../dispatchlist.h"
 #include "../platform/platformfactory.h"
+#include <algorithm>
+#include <cmath>
 #include <list>
 
 #define DEBUG_LOG	0 // DEBUG
@@ -113,6 +118,7 @@ public:
 	static void addAnimator (Animator* animator)
 	{
 		getInstance ()->animators.emplace_back (animator);
+		gInstance->updateFireTime ();
 #if DEBUG_LOG
 		DebugPrint ("Animator added: %p\n", animator);
 #endif
@@ -136,9 +142,25 @@ public:
 					gInstance->forget ();
 					gInstance = nullptr;
 				}
+				else
+				{
+					gInstance->updateFireTime ();
+				}
 			}
 		}
 	}
+
+	static void frameRateChanged ()
+	{
+		if (gInstance)
+			gInstance->updateFireTime ();
+	}
+
+	/** the interval of the timer in milliseconds or defaultInterval if it is not running */
+	static double getTickInterval (double defaultInterval)
+	{
+		return gInstance ? static_cast<double> (gInstance->fireTime) : defaultInterval;
+	}
 	
 protected:
 	static Timer* getInstance ()
@@ -156,7 +178,7 @@ protected:
 #endif
 		timer = new CVSTGUITimer ([this] (CVSTGUITimer*) {
 			onTimer ();
-		}, 1000/60); // 60 Hz
+		}, fireTime);
 	}
 	
 	~Timer () noexcept override
@@ -183,7 +205,21 @@ protected:
 		toRemove.clear ();
 	}
 
+	void updateFireTime ()
+	{
+		uint32_t frameRate = 1;
+		for (auto& animator : animators)
+			frameRate = std::max (frameRate, animator->getFrameRate ());
+		auto newFireTime = Animator::getTimerInterval (frameRate);
+		if (newFireTime != fireTime)
+		{
+			fireTime = newFireTime;
+			timer->setFireTime (fireTime);
+		}
+	}
+
 	CVSTGUITimer* timer;
+	uint32_t fireTime {1000 / 60};
 	
 	using Animators = std::list<Animator*>;
 	Animators animators;
@@ -245,6 +281,11 @@ Animation::~Animation () noexcept
 struct Animator::Impl
 {
 	DispatchList<SharedPointer<Detail::Animation>> animations;
+	FrameUpdateWrapper frameUpdateWrapper;
+	FrameStatistics frameStatistics;
+	uint32_t frameRate {60};
+	double nextFrameTicks {0.};
+	bool framePacingStarted {false};
 };
 ///@endcond
 
@@ -266,7 +307,11 @@ void Animator::addAnimation (CView* view, IdStringPtr name, IAnimationTarget* ta
 							 bool notifyOnCancel)
 {
 	if (pImpl->animations.empty ())
+	{
+		// the time without animations does not count as dropped frames
+		pImpl->framePacingStarted = false;
 		Detail::Timer::addAnimator (this);
+	}
 	removeAnimation (view, name);
 	pImpl->animations.add (makeOwned<Detail::Animation> (view, name, target, timingFunction,
 														 std::move (notification), notifyOnCancel));
@@ -332,37 +377,121 @@ void Animator::removeAnimations (CView* view)
 	});
 }
 
+//-----------------------------------------------------------------------------
+void Animator::setFrameRate (uint32_t framesPerSecond)
+{
+	pImpl->frameRate = std::max (1u, framesPerSecond);
+	if (!pImpl->animations.empty ())
+		Detail::Timer::frameRateChanged ();
+}
+
+//-----------------------------------------------------------------------------
+uint32_t Animator::getFrameRate () const
+{
+	return pImpl->frameRate;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t Animator::getTimerInterval (uint32_t framesPerSecond)
+{
+	return std::max (1u, 1000u / std::max (1u, framesPerSecond));
+}
+
+//-----------------------------------------------------------------------------
+void Animator::setFrameUpdateWrapper (FrameUpdateWrapper&& wrapper)
+{
+	pImpl->frameUpdateWrapper = std::move (wrapper);
+}
+
+//-----------------------------------------------------------------------------
+auto Animator::getFrameStatistics () const -> const FrameStatistics&
+{
+	return pImpl->frameStatistics;
+}
+
+//-----------------------------------------------------------------------------
+void Animator::resetFrameStatistics ()
+{
+	pImpl->frameStatistics = {};
+}
+
 //-----------------------------------------------------------------------------
 void Animator::onTimer ()
+{
+	onFrame (getPlatformFactory ().getTicks ());
+}
+
+//-----------------------------------------------------------------------------
+void Animator::onFrame (uint64_t currentTicks)
 {
 	auto selfGuard = shared (this);
-	auto currentTicks = getPlatformFactory ().getTicks ();
-	pImpl->animations.forEach ([&] (SharedPointer<Detail::Animation>& animation) {
-		if (animation->startTime == 0)
+	auto frameInterval = 1000. / pImpl->frameRate;
+	auto now = static_cast<double> (currentTicks);
+	if (pImpl->framePacingStarted)
+	{
+		// run the frame on the timer tick nearest to the time it is due
+		auto tickInterval = Detail::Timer::getTickInterval (frameInterval);
+		if (now + tickInterval / 2. < pImpl->nextFrameTicks)
+			return;
+		auto late = now - pImpl->nextFrameTicks;
+		if (late >= frameInterval)
 		{
+			auto missedFrames = std::floor (late / frameInterval);
+			pImpl->frameStatistics.numDroppedFrames += static_cast<uint64_t> (missedFrames);
+			pImpl->nextFrameTicks += missedFrames * frameInterval;
+		}
+		// the next frame is scheduled relative to when this one was due, so that the frames do
+		// not drift if the timer fires a little bit late
+		pImpl->nextFrameTicks += frameInterval;
+	}
+	else
+	{
+		pImpl->framePacingStarted = true;
+		pImpl->nextFrameTicks = now + frameInterval;
+	}
+
+	auto update = [&] () {
+		pImpl->animations.forEach ([&] (SharedPointer<Detail::Animation>& animation) {
+			if (animation->startTime == 0)
+			{
 #if DEBUG_LOG
-			DebugPrint ("animation start: %p - %s\n", animation->view.cast<CView>(), animation->name.data ());
+				DebugPrint ("animation start: %p - %s\n", animation->view.cast<CView>(), animation->name.data ());
 #endif
-			animation->animationTarget->animationStart (animation->view, animation->name.data ());
-			animation->startTime = currentTicks;
-		}
-		uint32_t time = static_cast<uint32_t> (currentTicks - animation->startTime);
-		float pos = animation->timingFunction->getPosition (time);
-		if (pos != animation->lastPos)
-		{
-			animation->animationTarget->animationTick (animation->view, animation->name.data (), pos);
-			animation->lastPos = pos;
-		}
-		if (animation->timingFunction->isDone (time))
-		{
-			animation->done = true;
-			animation->animationTarget->animationFinished (animation->view, animation->name.data (), false);
+				animation->animationTarget->animationStart (animation->view, animation->name.data ());
+				animation->startTime = currentTicks;
+			}
+			uint32_t time = static_cast<uint32_t> (currentTicks - animation->startTime);
+			float pos = animation->timingFunction->getPosition (time);
+			if (pos != animation->lastPos)
+			{
+				animation->animationTarget->animationTick (animation->view, animation->name.data (), pos);
+				animation->lastPos = pos;
+			}
+			if (animation->timingFunction->isDone (time))
+			{
+				animation->done = true;
+				animation->animationTarget->animationFinished (animation->view, animation->name.data (), false);
 #if DEBUG_LOG
-			DebugPrint ("animation finished: %p - %s\n", animation->view.cast<CView>(), animation->name.data ());
+				DebugPrint ("animation finished: %p - %s\n", animation->view.cast<CView>(), animation->name.data ());
 #endif
-			pImpl->animations.remove (animation);
-		}
-	});
+				pImpl->animations.remove (animation);
+			}
+		});
+	};
+
+	auto start = std::chrono::steady_clock::now ();
+	if (pImpl->frameUpdateWrapper)
+		pImpl->frameUpdateWrapper (update);
+	else
+		update ();
+	auto frameTime = std::chrono::duration_cast<std::chrono::nanoseconds> (
+		std::chrono::steady_clock::now () - start);
+	auto& statistics = pImpl->frameStatistics;
+	++statistics.numFrames;
+	statistics.lastFrameTime = frameTime;
+	statistics.maxFrameTime = std::max (statistics.maxFrameTime, frameTime);
+	statistics.totalFrameTime += frameTime;
+
 	if (pImpl->animations.empty ())
 		Detail::Timer::removeAnimator (this);
 }
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../vstguifwd.h"
+#include <chrono>
 #include <string>
 #include <functional>
 #include <memory>
@@ -51,10 +52,48 @@ public:
 	void removeAnimations (CView* view);
 	//@}
 
+	//-----------------------------------------------------------------------------
+	/// @name Frame pacing (new in 4.14)
+	//-----------------------------------------------------------------------------
+	//@{
+	/** set the number of animation frames per second, the default is 60.
+		All animators share one timer which runs at the highest frame rate of all animators,
+		animators with a lower frame rate skip timer ticks.
+	*/
+	void setFrameRate (uint32_t framesPerSecond);
+	uint32_t getFrameRate () const;
+
+	using FrameUpdateFunction = std::function<void ()>;
+	using FrameUpdateWrapper = std::function<void (const FrameUpdateFunction& update)>;
+	/** set a function which is called for every animation frame and must call update.
+		The CFrame uses this to collect the invalidations of all animation targets of one frame and
+		to flush them at once.
+	*/
+	void setFrameUpdateWrapper (FrameUpdateWrapper&& wrapper);
+
+	struct FrameStatistics
+	{
+		/** number of animation frames */
+		uint64_t numFrames {0};
+		/** number of frames which were due but were missed because the timer fired too late */
+		uint64_t numDroppedFrames {0};
+		/** time it took to update all animations of a frame */
+		std::chrono::nanoseconds lastFrameTime {};
+		std::chrono::nanoseconds maxFrameTime {};
+		std::chrono::nanoseconds totalFrameTime {};
+	};
+	const FrameStatistics& getFrameStatistics () const;
+	void resetFrameStatistics ();
+	//@}
+
 	/// @cond ignore
 
 	Animator ();	// do not use this, instead use CFrame::getAnimator()
 	void onTimer ();
+	void onFrame (uint64_t currentTicks);
+	/** the interval of the shared timer in milliseconds for a frame rate. It is rounded down, so
+		that the timer does not fire less often than the frames are due. */
+	static uint32_t getTimerInterval (uint32_t framesPerSecond);
 
 protected:
 	~Animator () noexcept override;
@@ -76,6 +76,14 @@ CBitmap::CBitmap (const PlatformBitmapPtr& platformBitmap)
 	bitmaps.emplace_back (platformBitmap);
 }
 
+//-----------------------------------------------------------------------------
+CBitmap::CBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap)
+: resourceDesc (desc)
+{
+	if (platformBitmap)
+		bitmaps.emplace_back (platformBitmap);
+}
+
 //-----------------------------------------------------------------------------
 void CBitmap::draw (CDrawContext* context, const CRect& rect, const CPoint& offset, float alpha)
 {
@@ -184,6 +192,14 @@ CMultiFrameBitmap::CMultiFrameBitmap (const CResourceDescription& desc,
 {
 }
 
+//-----------------------------------------------------------------------------
+CMultiFrameBitmap::CMultiFrameBitmap (const CResourceDescription& desc,
+									  const PlatformBitmapPtr& platformBitmap,
+									  CMultiFrameBitmapDescription multiFrameDesc)
+: CBitmap (desc, platformBitmap), description (multiFrameDesc)
+{
+}
+
 //-----------------------------------------------------------------------------
 bool CMultiFrameBitmap::setMultiFrameDesc (CMultiFrameBitmapDescription desc)
 {
@@ -288,6 +304,15 @@ CNinePartTiledBitmap::CNinePartTiledBitmap (const PlatformBitmapPtr& platformBit
 {
 }
 
+//-----------------------------------------------------------------------------
+CNinePartTiledBitmap::CNinePartTiledBitmap (const CResourceDescription& desc,
+											const PlatformBitmapPtr& platformBitmap,
+											const CNinePartTiledDescription& offsets)
+: CBitmap (desc, platformBitmap)
+, offsets (offsets)
+{
+}
+
 //-----------------------------------------------------------------------------
 void CNinePartTiledBitmap::draw (CDrawContext* inContext, const CRect& inDestRect, const CPoint& offset, float inAlpha)
 {
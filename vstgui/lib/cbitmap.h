@@ -31,6 +31,8 @@ public:
 	/** Create an image with a given size and scale factor */
 	CBitmap (CPoint size, double scaleFactor = 1.);
 	explicit CBitmap (const PlatformBitmapPtr& platformBitmap);
+	/** Create an image for a resource identifier from an already decoded platform bitmap */
+	CBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap);
 	~CBitmap () noexcept override = default;
 
 	//-----------------------------------------------------------------------------
@@ -104,6 +106,8 @@ public:
 
 	CMultiFrameBitmap (const CResourceDescription& desc,
 					   CMultiFrameBitmapDescription multiFrameDesc);
+	CMultiFrameBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap,
+					   CMultiFrameBitmapDescription multiFrameDesc);
 
 	/** set the multi frame description
 	 *
@@ -310,6 +314,8 @@ class CNinePartTiledBitmap : public CBitmap
 public:
 	CNinePartTiledBitmap (const CResourceDescription& desc, const CNinePartTiledDescription& offsets);
 	CNinePartTiledBitmap (const PlatformBitmapPtr& platformBitmap, const CNinePartTiledDescription& offsets);
+	CNinePartTiledBitmap (const CResourceDescription& desc, const PlatformBitmapPtr& platformBitmap,
+						  const CNinePartTiledDescription& offsets);
 	~CNinePartTiledBitmap () noexcept override = default;
 	
 	//-----------------------------------------------------------------------------
@@ -13,6 +13,18 @@
 #include <algorithm>
 #include <memory>
 #include <climits>
+#include <cstring>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define VSTGUI_BITMAPFILTER_SSE2 1
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#define VSTGUI_BITMAPFILTER_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace VSTGUI {
 
@@ -389,6 +401,189 @@ CBitmap* FilterBase::getInputBitmap () const
 ///@cond ignore
 namespace Standard {
 
+//----------------------------------------------------------------------------------------------------
+namespace Kernels {
+
+//----------------------------------------------------------------------------------------------------
+struct PixelLayout
+{
+	uint32_t redPos;
+	uint32_t greenPos;
+	uint32_t bluePos;
+	uint32_t alphaPos;
+
+	static PixelLayout fromFormat (IPlatformBitmapPixelAccess::PixelFormat format)
+	{
+		switch (format)
+		{
+			case IPlatformBitmapPixelAccess::kARGB: return {1, 2, 3, 0};
+			case IPlatformBitmapPixelAccess::kRGBA: return {0, 1, 2, 3};
+			case IPlatformBitmapPixelAccess::kABGR: return {3, 2, 1, 0};
+			case IPlatformBitmapPixelAccess::kBGRA: return {2, 1, 0, 3};
+		}
+		return {0, 1, 2, 3};
+	}
+
+	/** the native pixel value of a color */
+	uint32_t toPixel (const CColor& color) const
+	{
+		uint8_t bytes[4];
+		bytes[redPos] = color.red;
+		bytes[greenPos] = color.green;
+		bytes[bluePos] = color.blue;
+		bytes[alphaPos] = color.alpha;
+		uint32_t result;
+		memcpy (&result, bytes, sizeof (result));
+		return result;
+	}
+
+	/** mask of the alpha byte of a native pixel value */
+	uint32_t alphaMask () const
+	{
+		uint8_t bytes[4] = {};
+		bytes[alphaPos] = 0xff;
+		uint32_t result;
+		memcpy (&result, bytes, sizeof (result));
+		return result;
+	}
+};
+
+//----------------------------------------------------------------------------------------------------
+/** calls proc (firstRow, lastRow) for bands of rows. Large bitmaps are split into bands which are
+ *	processed in parallel, the bands must not depend on each other.
+ */
+template<typename Proc>
+void forEachRowBand (uint32_t numRows, uint32_t rowLength, Proc proc)
+{
+	constexpr uint64_t kMinPixelsPerBand = 64 * 1024;
+	uint64_t numBands = (static_cast<uint64_t> (numRows) * rowLength) / kMinPixelsPerBand;
+	numBands = std::min<uint64_t> (numBands, std::thread::hardware_concurrency ());
+	numBands = std::min<uint64_t> (numBands, numRows);
+	if (numBands <= 1)
+	{
+		proc (0u, numRows);
+		return;
+	}
+	auto rowsPerBand = static_cast<uint32_t> ((numRows + numBands - 1) / numBands);
+	std::vector<std::thread> threads;
+	threads.reserve (static_cast<size_t> (numBands - 1));
+	for (auto first = rowsPerBand; first < numRows; first += rowsPerBand)
+	{
+		auto last = std::min (first + rowsPerBand, numRows);
+		try
+		{
+			threads.emplace_back (proc, first, last);
+		}
+		catch (const std::system_error&)
+		{
+			proc (first, last);
+		}
+	}
+	proc (0u, rowsPerBand);
+	for (auto& thread : threads)
+		thread.join ();
+}
+
+//----------------------------------------------------------------------------------------------------
+inline void setColorRow (const uint32_t* src, uint32_t* dst, uint32_t width, uint32_t color,
+						 uint32_t keepMask)
+{
+	uint32_t x = 0;
+#if defined(VSTGUI_BITMAPFILTER_SSE2)
+	auto colorVec = _mm_set1_epi32 (static_cast<int> (color & ~keepMask));
+	auto keepVec = _mm_set1_epi32 (static_cast<int> (keepMask));
+	for (; x + 4 <= width; x += 4)
+	{
+		auto p = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + x));
+		p = _mm_or_si128 (_mm_and_si128 (p, keepVec), colorVec);
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + x), p);
+	}
+#elif defined(VSTGUI_BITMAPFILTER_NEON)
+	auto colorVec = vdupq_n_u32 (color & ~keepMask);
+	auto keepVec = vdupq_n_u32 (keepMask);
+	for (; x + 4 <= width; x += 4)
+	{
+		auto p = vld1q_u32 (src + x);
+		vst1q_u32 (dst + x, vorrq_u32 (vandq_u32 (p, keepVec), colorVec));
+	}
+#endif
+	for (; x < width; ++x)
+		dst[x] = (src[x] & keepMask) | (color & ~keepMask);
+}
+
+//----------------------------------------------------------------------------------------------------
+inline void replaceColorRow (const uint32_t* src, uint32_t* dst, uint32_t width, uint32_t from,
+							 uint32_t to)
+{
+	uint32_t x = 0;
+#if defined(VSTGUI_BITMAPFILTER_SSE2)
+	auto fromVec = _mm_set1_epi32 (static_cast<int> (from));
+	auto toVec = _mm_set1_epi32 (static_cast<int> (to));
+	for (; x + 4 <= width; x += 4)
+	{
+		auto p = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + x));
+		auto equal = _mm_cmpeq_epi32 (p, fromVec);
+		p = _mm_or_si128 (_mm_and_si128 (equal, toVec), _mm_andnot_si128 (equal, p));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + x), p);
+	}
+#elif defined(VSTGUI_BITMAPFILTER_NEON)
+	auto fromVec = vdupq_n_u32 (from);
+	auto toVec = vdupq_n_u32 (to);
+	for (; x + 4 <= width; x += 4)
+	{
+		auto p = vld1q_u32 (src + x);
+		vst1q_u32 (dst + x, vbslq_u32 (vceqq_u32 (p, fromVec), toVec, p));
+	}
+#endif
+	for (; x < width; ++x)
+		dst[x] = src[x] == from ? to : src[x];
+}
+
+//----------------------------------------------------------------------------------------------------
+inline void grayscaleRow (const uint32_t* src, uint32_t* dst, uint32_t width,
+						  const PixelLayout& layout)
+{
+	uint32_t x = 0;
+	auto alphaMask = layout.alphaMask ();
+	// the vector version must round exactly like CColor::getLuma, this is only guaranteed if the
+	// compiler does not fuse the multiplications and additions of the scalar version
+#if defined(VSTGUI_BITMAPFILTER_SSE2) && !defined(__FMA__) && !defined(__AVX2__)
+	auto redShift = _mm_cvtsi32_si128 (static_cast<int> (layout.redPos * 8));
+	auto greenShift = _mm_cvtsi32_si128 (static_cast<int> (layout.greenPos * 8));
+	auto blueShift = _mm_cvtsi32_si128 (static_cast<int> (layout.bluePos * 8));
+	auto byteMask = _mm_set1_epi32 (0xff);
+	auto alphaVec = _mm_set1_epi32 (static_cast<int> (alphaMask));
+	auto redFactor = _mm_set1_ps (0.3f);
+	auto greenFactor = _mm_set1_ps (0.59f);
+	auto blueFactor = _mm_set1_ps (0.11f);
+	for (; x + 4 <= width; x += 4)
+	{
+		auto p = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (src + x));
+		auto r = _mm_cvtepi32_ps (_mm_and_si128 (_mm_srl_epi32 (p, redShift), byteMask));
+		auto g = _mm_cvtepi32_ps (_mm_and_si128 (_mm_srl_epi32 (p, greenShift), byteMask));
+		auto b = _mm_cvtepi32_ps (_mm_and_si128 (_mm_srl_epi32 (p, blueShift), byteMask));
+		auto luma = _mm_add_ps (_mm_add_ps (_mm_mul_ps (r, redFactor), _mm_mul_ps (g, greenFactor)),
+								_mm_mul_ps (b, blueFactor));
+		auto l = _mm_and_si128 (_mm_cvttps_epi32 (luma), byteMask);
+		auto result = _mm_and_si128 (p, alphaVec);
+		result = _mm_or_si128 (result, _mm_sll_epi32 (l, redShift));
+		result = _mm_or_si128 (result, _mm_sll_epi32 (l, greenShift));
+		result = _mm_or_si128 (result, _mm_sll_epi32 (l, blueShift));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (dst + x), result);
+	}
+#endif
+	for (; x < width; ++x)
+	{
+		uint8_t bytes[4];
+		memcpy (bytes, src + x, sizeof (bytes));
+		CColor color (bytes[layout.redPos], bytes[layout.greenPos], bytes[layout.bluePos]);
+		bytes[layout.redPos] = bytes[layout.greenPos] = bytes[layout.bluePos] = color.getLuma ();
+		memcpy (dst + x, bytes, sizeof (bytes));
+	}
+}
+
+} // Kernels
+
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
 //----------------------------------------------------------------------------------------------------
@@ -491,6 +686,8 @@ private:
 	Buffer<uint8_t> pc1;
 	Buffer<uint8_t> pc2;
 	Buffer<uint8_t> pc3;
+	Buffer<int32_t> hMin;
+	Buffer<int32_t> hMax;
 	Buffer<int32_t> vMin;
 	Buffer<int32_t> vMax;
 	Buffer<uint8_t> dv;
@@ -519,31 +716,46 @@ private:
 			pc2.allocate (areaSize);
 		if (plane3)
 			pc3.allocate (areaSize);
-		vMin.allocate (std::max (width, height));
-		vMax.allocate (std::max (width, height));
+		hMin.allocate (width);
+		hMax.allocate (width);
+		vMin.allocate (height);
+		vMax.allocate (height);
 		dv.allocate (256 * div);
 
 		for (auto i = 0u; i < dv.size (); ++i)
 			dv[i] = (i / div);
-
-		int32_t sum0, sum1, sum2, sum3;
-		for (auto y = 0, yw = 0, yi = 0; y < height; ++y, yw += width)
+		for (auto x = 0; x < width; ++x)
 		{
-			sum0 = sum1 = sum2 = sum3 = 0;
-			for (auto i = -radius; i <= radius; i++)
-			{
-				auto p = (yi + std::min (wm, std::max (i, 0))) * numComponents;
-				if (plane0)
-					sum0 += inPixel[p + pos0];
-				if (plane1)
-					sum1 += inPixel[p + pos1];
-				if (plane2)
-					sum2 += inPixel[p + pos2];
-				if (plane3)
-					sum3 += inPixel[p + pos3];
-			}
-			if (y == 0)
+			hMin[x] = std::min (x + radius + 1, wm);
+			hMax[x] = std::max (x - radius, 0);
+		}
+		for (auto y = 0; y < height; ++y)
+		{
+			vMin[y] = std::min (y + radius + 1, hm) * width;
+			vMax[y] = std::max (y - radius, 0) * width;
+		}
+
+		// horizontal pass, the rows are independent of each other
+		Kernels::forEachRowBand (static_cast<uint32_t> (height), static_cast<uint32_t> (width),
+								 [&] (uint32_t firstRow, uint32_t lastRow) {
+			int32_t sum0, sum1, sum2, sum3;
+			for (auto y = static_cast<int32_t> (firstRow); y < static_cast<int32_t> (lastRow); ++y)
 			{
+				auto yw = y * width;
+				auto yi = yw;
+				sum0 = sum1 = sum2 = sum3 = 0;
+				for (auto i = -radius; i <= radius; i++)
+				{
+					auto p = (yi + std::min (wm, std::max (i, 0))) * numComponents;
+					if (plane0)
+						sum0 += inPixel[p + pos0];
+					if (plane1)
+						sum1 += inPixel[p + pos1];
+					if (plane2)
+						sum2 += inPixel[p + pos2];
+					if (plane3)
+						sum3 += inPixel[p + pos3];
+				}
 				for (auto x = 0; x < width; ++x, ++yi)
 				{
 					if (plane0)
@@ -554,10 +766,8 @@ private:
 						pc2[yi] = dv[sum2];
 					if (plane3)
 						pc3[yi] = dv[sum3];
-					vMin[x] = std::min (x + radius + 1, wm);
-					vMax[x] = std::max (x - radius, 0);
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
+					auto p1 = (yw + hMin[x]) * numComponents;
+					auto p2 = (yw + hMax[x]) * numComponents;
 					if (plane0)
 						sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
 					if (plane1)
@@ -568,108 +778,64 @@ private:
 						sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
 				}
 			}
-			else
+		});
+
+		// vertical pass, processed row by row with one running sum per column so that the memory
+		// is accessed sequentially, the column bands are independent of each other
+		Kernels::forEachRowBand (static_cast<uint32_t> (width), static_cast<uint32_t> (height),
+								 [&] (uint32_t firstColumn, uint32_t lastColumn) {
+			auto x0 = static_cast<int32_t> (firstColumn);
+			auto numColumns = static_cast<size_t> (lastColumn - firstColumn);
+			std::vector<int32_t> sums0 (plane0 ? numColumns : 0);
+			std::vector<int32_t> sums1 (plane1 ? numColumns : 0);
+			std::vector<int32_t> sums2 (plane2 ? numColumns : 0);
+			std::vector<int32_t> sums3 (plane3 ? numColumns : 0);
+			for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
 			{
-				for (auto x = 0; x < width; ++x, ++yi)
+				// rows outside of the bitmap repeat the edge rows
+				auto yi = std::min (std::max (0, yp), hm * width) + x0;
+				for (auto c = 0u; c < numColumns; ++c, ++yi)
 				{
 					if (plane0)
-						pc0[yi] = dv[sum0];
+						sums0[c] += pc0[yi];
 					if (plane1)
-						pc1[yi] = dv[sum1];
+						sums1[c] += pc1[yi];
 					if (plane2)
-						pc2[yi] = dv[sum2];
+						sums2[c] += pc2[yi];
 					if (plane3)
-						pc3[yi] = dv[sum3];
-					auto p1 = (yw + vMin[x]) * numComponents;
-					auto p2 = (yw + vMax[x]) * numComponents;
+						sums3[c] += pc3[yi];
+				}
+			}
+			for (auto y = 0; y < height; ++y)
+			{
+				auto pos = (y * width + x0) * numComponents;
+				auto p1 = x0 + vMin[y];
+				auto p2 = x0 + vMax[y];
+				for (auto c = 0u; c < numColumns; ++c, pos += numComponents, ++p1, ++p2)
+				{
 					if (plane0)
-						sum0 += inPixel[p1 + pos0] - inPixel[p2 + pos0];
+					{
+						outPixel[pos + pos0] = dv[sums0[c]];
+						sums0[c] += pc0[p1] - pc0[p2];
+					}
 					if (plane1)
-						sum1 += inPixel[p1 + pos1] - inPixel[p2 + pos1];
+					{
+						outPixel[pos + pos1] = dv[sums1[c]];
+						sums1[c] += pc1[p1] - pc1[p2];
+					}
 					if (plane2)
-						sum2 += inPixel[p1 + pos2] - inPixel[p2 + pos2];
+					{
+						outPixel[pos + pos2] = dv[sums2[c]];
+						sums2[c] += pc2[p1] - pc2[p2];
+					}
 					if (plane3)
-						sum3 += inPixel[p1 + pos3] - inPixel[p2 + pos3];
+					{
+						outPixel[pos + pos3] = dv[sums3[c]];
+						sums3[c] += pc3[p1] - pc3[p2];
+					}
 				}
 			}
-		}
-
-		sum0 = sum1 = sum2 = sum3 = 0;
-		for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
-		{
-			auto yi = std::max (0, yp);
-			if (plane0)
-				sum0 += pc0[yi];
-			if (plane1)
-				sum1 += pc1[yi];
-			if (plane2)
-				sum2 += pc2[yi];
-			if (plane3)
-				sum3 += pc3[yi];
-		}
-		for (auto y = 0, yi = 0; y < height; ++y, yi += width)
-		{
-			auto pos = yi * numComponents;
-			if (plane0)
-				outPixel[pos + pos0] = dv[sum0];
-			if (plane1)
-				outPixel[pos + pos1] = dv[sum1];
-			if (plane2)
-				outPixel[pos + pos2] = dv[sum2];
-			if (plane3)
-				outPixel[pos + pos3] = dv[sum3];
-			vMin[y] = std::min (y + radius + 1, hm) * width;
-			vMax[y] = std::max (y - radius, 0) * width;
-			auto p1 = vMin[y];
-			auto p2 = vMax[y];
-			if (plane0)
-				sum0 += pc0[p1] - pc0[p2];
-			if (plane1)
-				sum1 += pc1[p1] - pc1[p2];
-			if (plane2)
-				sum2 += pc2[p1] - pc2[p2];
-			if (plane3)
-				sum3 += pc3[p1] - pc3[p2];
-		}
-
-		for (auto x = 1; x < width; ++x)
-		{
-			sum0 = sum1 = sum2 = sum3 = 0;
-			for (auto i = -radius, yp = -radius * width; i <= radius; ++i, yp += width)
-			{
-				auto yi = std::max (0, yp) + x;
-				if (plane0)
-					sum0 += pc0[yi];
-				if (plane1)
-					sum1 += pc1[yi];
-				if (plane2)
-					sum2 += pc2[yi];
-				if (plane3)
-					sum3 += pc3[yi];
-			}
-			for (auto y = 0, yi = x; y < height; ++y, yi += width)
-			{
-				auto pos = yi * numComponents;
-				if (plane0)
-					outPixel[pos + pos0] = dv[sum0];
-				if (plane1)
-					outPixel[pos + pos1] = dv[sum1];
-				if (plane2)
-					outPixel[pos + pos2] = dv[sum2];
-				if (plane3)
-					outPixel[pos + pos3] = dv[sum3];
-				auto p1 = x + vMin[y];
-				auto p2 = x + vMax[y];
-				if (plane0)
-					sum0 += pc0[p1] - pc0[p2];
-				if (plane1)
-					sum1 += pc1[p1] - pc1[p2];
-				if (plane2)
-					sum2 += pc2[p1] - pc2[p2];
-				if (plane3)
-					sum3 += pc3[p1] - pc3[p2];
-			}
-		}
+		});
 	}
 };
 
@@ -744,29 +910,26 @@ private:
 		uint32_t origBytesPerRow = originalBitmap.getPlatformBitmapPixelAccess ()->getBytesPerRow ();
 		uint32_t copyBytesPerRow = copyBitmap.getPlatformBitmapPixelAccess ()->getBytesPerRow ();
 
-		int32_t ix;
-		int32_t iy = -1;
-		int32_t* origPixel = nullptr;
-		float origY = 0;
+		// the source positions are accumulated like before so that rounding stays the same
+		std::vector<uint32_t> srcColumns (newWidth);
 		float origX = 0;
+		for (uint32_t x = 0; x < newWidth; x++, origX += xRatio)
+			srcColumns[x] = static_cast<uint32_t> (static_cast<int32_t> (origX));
+		std::vector<uint32_t> srcRows (newHeight);
+		float origY = 0;
 		for (uint32_t y = 0; y < newHeight; y++, origY += yRatio)
-		{
-			int32_t* copyPixel = (int32_t*)(copyAddress + y * copyBytesPerRow);
-			if (iy != (int32_t)origY)
-				iy = (int32_t)origY;
-			ix = -1;
-			origX = 0;
-			for (uint32_t x = 0; x < newWidth; x++, origX += xRatio, copyPixel++)
+			srcRows[y] = static_cast<uint32_t> (static_cast<int32_t> (origY));
+
+		Kernels::forEachRowBand (newHeight, newWidth, [&] (uint32_t firstRow, uint32_t lastRow) {
+			for (uint32_t y = firstRow; y < lastRow; y++)
 			{
-				if (ix != (int32_t)origX || origPixel == nullptr)
-				{
-					ix = (int32_t)origX;
-					vstgui_assert (iy >= 0);
-					origPixel = (int32_t*)(origAddress + static_cast<uint32_t> (iy) * origBytesPerRow + ix * 4);
-				}
-				*copyPixel = *origPixel;
+				auto copyPixel = reinterpret_cast<uint32_t*> (copyAddress + y * copyBytesPerRow);
+				auto origRow =
+				    reinterpret_cast<const uint32_t*> (origAddress + srcRows[y] * origBytesPerRow);
+				for (uint32_t x = 0; x < newWidth; x++)
+					copyPixel[x] = origRow[srcColumns[x]];
 			}
-		}
+		});
 	}
 };
 
@@ -783,6 +946,75 @@ private:
 	ScaleBiliniear () : ScaleBase ("A Biliniear Scale Filter") {}
 
 	void process (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap) override
+	{
+		auto origAccess = originalBitmap.getPlatformBitmapPixelAccess ();
+		auto copyAccess = copyBitmap.getPlatformBitmapPixelAccess ();
+		if (origAccess->getPixelFormat () != copyAccess->getPixelFormat ())
+		{
+			processGeneric (originalBitmap, copyBitmap);
+			return;
+		}
+
+		uint32_t origWidth = (uint32_t)originalBitmap.getBitmapWidth ();
+		uint32_t origHeight = (uint32_t)originalBitmap.getBitmapHeight ();
+		uint32_t newWidth = (uint32_t)copyBitmap.getBitmapWidth ();
+		uint32_t newHeight = (uint32_t)copyBitmap.getBitmapHeight ();
+
+		float xRatio = ((float)(origWidth-1)) / (float)newWidth;
+		float yRatio = ((float)(origHeight-1)) / (float)newHeight;
+
+		const uint8_t* origAddress = origAccess->getAddress ();
+		uint8_t* copyAddress = copyAccess->getAddress ();
+		uint32_t origBytesPerRow = origAccess->getBytesPerRow ();
+		uint32_t copyBytesPerRow = copyAccess->getBytesPerRow ();
+		auto layout = Kernels::PixelLayout::fromFormat (origAccess->getPixelFormat ());
+
+		Kernels::forEachRowBand (newHeight, newWidth, [&] (uint32_t firstRow, uint32_t lastRow) {
+			// a position outside of the bitmap keeps the previous position, like
+			// CBitmapPixelAccess::setPosition does
+			const uint8_t* current = origAddress;
+			auto fetch = [&] (uint32_t x, uint32_t y) {
+				if (x < origWidth && y < origHeight)
+					current = origAddress + y * origBytesPerRow + x * 4;
+				return current;
+			};
+			float xDiff, yDiff, r, g, b, a;
+			uint32_t x, y;
+			const uint8_t* color[4];
+			for (uint32_t i = firstRow; i < lastRow; i++)
+			{
+				y = static_cast<uint32_t> (yRatio * i);
+				yDiff = (yRatio * i) - y;
+				uint8_t* copyPixel = copyAddress + i * copyBytesPerRow;
+
+				for (uint32_t j = 0; j < newWidth; j++, copyPixel += 4)
+				{
+					x = static_cast<uint32_t> (xRatio * j);
+					xDiff = (xRatio * j) - x;
+					color[0] = fetch (x, y);
+					color[1] = fetch (x+1, y);
+					color[2] = fetch (x, y+1);
+					color[3] = fetch (x+1, y+1);
+					r = interpolate (color, layout.redPos, xDiff, yDiff);
+					g = interpolate (color, layout.greenPos, xDiff, yDiff);
+					b = interpolate (color, layout.bluePos, xDiff, yDiff);
+					a = interpolate (color, layout.alphaPos, xDiff, yDiff);
+					copyPixel[layout.redPos] = (uint8_t)r;
+					copyPixel[layout.greenPos] = (uint8_t)g;
+					copyPixel[layout.bluePos] = (uint8_t)b;
+					copyPixel[layout.alphaPos] = (uint8_t)a;
+				}
+			}
+		});
+	}
+
+	static float interpolate (const uint8_t* const color[4], uint32_t pos, float xDiff, float yDiff)
+	{
+		return color[0][pos] * (1.f - xDiff) * (1.f - yDiff) + color[1][pos] * xDiff * (1.f - yDiff)
+		+ color[2][pos] * yDiff * (1.f - xDiff) + color[3][pos] * xDiff * yDiff;
+	}
+
+	void processGeneric (CBitmapPixelAccess& originalBitmap, CBitmapPixelAccess& copyBitmap)
 	{
 		originalBitmap.setPosition (0, 0);
 		copyBitmap.setPosition (0, 0);
@@ -877,6 +1109,30 @@ protected:
 
 	void run (CBitmapPixelAccess& inputAccessor, CBitmapPixelAccess& outputAccessor)
 	{
+		auto inputPbpa = inputAccessor.getPlatformBitmapPixelAccess ();
+		auto outputPbpa = outputAccessor.getPlatformBitmapPixelAccess ();
+		auto width = inputAccessor.getBitmapWidth ();
+		auto height = inputAccessor.getBitmapHeight ();
+		if (inputPbpa->getPixelFormat () == outputPbpa->getPixelFormat () &&
+		    width == outputAccessor.getBitmapWidth () && height == outputAccessor.getBitmapHeight ())
+		{
+			auto layout = Kernels::PixelLayout::fromFormat (inputPbpa->getPixelFormat ());
+			auto inputAddress = inputPbpa->getAddress ();
+			auto outputAddress = outputPbpa->getAddress ();
+			auto inputBytesPerRow = inputPbpa->getBytesPerRow ();
+			auto outputBytesPerRow = outputPbpa->getBytesPerRow ();
+			Kernels::forEachRowBand (height, width, [&] (uint32_t firstRow, uint32_t lastRow) {
+				for (auto y = firstRow; y < lastRow; ++y)
+				{
+					processRow (
+					    reinterpret_cast<const uint32_t*> (inputAddress + y * inputBytesPerRow),
+					    reinterpret_cast<uint32_t*> (outputAddress + y * outputBytesPerRow), width,
+					    layout);
+				}
+			});
+			return;
+		}
+
 		inputAccessor.setPosition (0, 0);
 		outputAccessor.setPosition (0, 0);
 		CColor color;
@@ -903,6 +1159,10 @@ protected:
 		}
 	}
 
+	/** process one row of native pixels, must produce the same result as the process function */
+	virtual void processRow (const uint32_t* src, uint32_t* dst, uint32_t width,
+	                         const Kernels::PixelLayout& layout) const = 0;
+
 	SimpleFilterProcessFunction processFunction;
 };
 
@@ -933,6 +1193,13 @@ private:
 		color = filter->inputColor;
 	}
 
+	void processRow (const uint32_t* src, uint32_t* dst, uint32_t width,
+	                 const Kernels::PixelLayout& layout) const override
+	{
+		Kernels::setColorRow (src, dst, width, layout.toPixel (inputColor),
+		                      ignoreAlpha ? layout.alphaMask () : 0u);
+	}
+
 	bool ignoreAlpha;
 	CColor inputColor;
 
@@ -971,6 +1238,12 @@ private:
 		color.red = color.green = color.blue = color.getLuma ();
 	}
 
+	void processRow (const uint32_t* src, uint32_t* dst, uint32_t width,
+	                 const Kernels::PixelLayout& layout) const override
+	{
+		Kernels::grayscaleRow (src, dst, width, layout);
+	}
+
 };
 
 //----------------------------------------------------------------------------------------------------
@@ -999,6 +1272,13 @@ private:
 			color = filter->outputColor;
 	}
 
+	void processRow (const uint32_t* src, uint32_t* dst, uint32_t width,
+	                 const Kernels::PixelLayout& layout) const override
+	{
+		Kernels::replaceColorRow (src, dst, width, layout.toPixel (inputColor),
+		                          layout.toPixel (outputColor));
+	}
+
 	CColor inputColor;
 	CColor outputColor;
 
@@ -0,0 +1,218 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cbitmaptilerenderer.h"
+#include <cstring>
+#include <system_error>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+CBitmapTileRenderer::CBitmapTileRenderer (CBitmap* bitmap, RenderFunction&& renderFunction,
+										  Config&& config)
+: bitmap (bitmap), renderFunction (std::move (renderFunction)), config (std::move (config))
+{
+	if (this->config.tileSize == 0)
+		this->config.tileSize = 64;
+	if (this->config.passes.empty ())
+		this->config.passes.push_back (1);
+	numThreads = this->config.numThreads;
+	if (numThreads == 0)
+		numThreads = std::max (std::thread::hardware_concurrency (), 1u);
+
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		width = accessor->getBitmapWidth ();
+		height = accessor->getBitmapHeight ();
+		pixelFormat = accessor->getPlatformBitmapPixelAccess ()->getPixelFormat ();
+	}
+	auto tileSize = this->config.tileSize;
+	numTilesX = (width + tileSize - 1) / tileSize;
+	numTilesY = (height + tileSize - 1) / tileSize;
+	numThreads = std::min (numThreads, std::max (getNumTiles (), 1u));
+	buffer.resize (static_cast<size_t> (width) * height);
+	numFinishedTiles.resize (this->config.passes.size (), 0);
+}
+
+//-----------------------------------------------------------------------------
+CBitmapTileRenderer::CBitmapTileRenderer (CBitmap* bitmap, RenderFunction&& renderFunction)
+: CBitmapTileRenderer (bitmap, std::move (renderFunction), Config ())
+{
+}
+
+//-----------------------------------------------------------------------------
+CBitmapTileRenderer::~CBitmapTileRenderer () noexcept
+{
+	cancel ();
+	wait ();
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapTileRenderer::start ()
+{
+	if (!threads.empty () || getNumTiles () == 0)
+		return;
+	threads.reserve (numThreads);
+	for (auto i = 0u; i < numThreads; ++i)
+	{
+		try
+		{
+			threads.emplace_back ([this] () { run (); });
+		}
+		catch (const std::system_error&)
+		{
+			break;
+		}
+	}
+	if (threads.empty ())
+		run ();
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapTileRenderer::cancel ()
+{
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		canceled = true;
+	}
+	passCondition.notify_all ();
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapTileRenderer::wait ()
+{
+	for (auto& thread : threads)
+	{
+		if (thread.joinable ())
+			thread.join ();
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool CBitmapTileRenderer::isDone () const
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return numFinishedTiles.back () == getNumTiles ();
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapTileRenderer::run ()
+{
+	const auto numTiles = getNumTiles ();
+	const auto numJobs = numTiles * static_cast<uint32_t> (config.passes.size ());
+	while (!canceled)
+	{
+		// the jobs are handed out pass by pass, so all tiles of a pass are taken before the first
+		// tile of the next pass
+		auto job = nextJob++;
+		if (job >= numJobs)
+			break;
+		auto pass = job / numTiles;
+		if (pass > 0 && !waitForPass (pass - 1))
+			break;
+		renderTile (job % numTiles, pass);
+	}
+}
+
+//-----------------------------------------------------------------------------
+bool CBitmapTileRenderer::waitForPass (uint32_t pass)
+{
+	std::unique_lock<std::mutex> lock (mutex);
+	passCondition.wait (lock, [&] () {
+		return canceled || numFinishedTiles[pass] == getNumTiles ();
+	});
+	return !canceled;
+}
+
+//-----------------------------------------------------------------------------
+CRect CBitmapTileRenderer::getTileRect (uint32_t tileIndex) const
+{
+	auto left = (tileIndex % numTilesX) * config.tileSize;
+	auto top = (tileIndex / numTilesX) * config.tileSize;
+	return CRect (left, top, std::min (left + config.tileSize, width),
+				  std::min (top + config.tileSize, height));
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapTileRenderer::renderTile (uint32_t tileIndex, uint32_t pass)
+{
+	auto r = getTileRect (tileIndex);
+	Tile tile (buffer.data (), width, canceled);
+	tile.left = static_cast<uint32_t> (r.left);
+	tile.top = static_cast<uint32_t> (r.top);
+	tile.right = static_cast<uint32_t> (r.right);
+	tile.bottom = static_cast<uint32_t> (r.bottom);
+	tile.blockSize = std::max (config.passes[pass], 1u);
+	tile.pass = pass;
+	tile.pixelFormat = pixelFormat;
+	renderFunction (tile);
+	if (!canceled)
+		tileDone (tileIndex, pass);
+}
+
+//-----------------------------------------------------------------------------
+void CBitmapTileRenderer::tileDone (uint32_t tileIndex, uint32_t pass)
+{
+	auto r = getTileRect (tileIndex);
+	auto left = static_cast<uint32_t> (r.left);
+	auto tileWidth = static_cast<uint32_t> (r.getWidth ());
+	FinishedTile finishedTile {tileIndex, {}};
+	finishedTile.pixels.reserve (static_cast<size_t> (tileWidth) * r.getHeight ());
+	for (auto y = static_cast<uint32_t> (r.top); y < r.bottom; ++y)
+	{
+		auto row = buffer.data () + static_cast<size_t> (y) * width + left;
+		finishedTile.pixels.insert (finishedTile.pixels.end (), row, row + tileWidth);
+	}
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		// a tile of the next pass replaces the result of the previous pass
+		auto it = std::find_if (finishedTiles.begin (), finishedTiles.end (),
+								[&] (const auto& t) { return t.index == tileIndex; });
+		if (it != finishedTiles.end ())
+			it->pixels = std::move (finishedTile.pixels);
+		else
+			finishedTiles.emplace_back (std::move (finishedTile));
+		++numFinishedTiles[pass];
+	}
+	passCondition.notify_all ();
+	if (config.tileFinished)
+		config.tileFinished ();
+}
+
+//-----------------------------------------------------------------------------
+std::vector<CRect> CBitmapTileRenderer::commit ()
+{
+	std::vector<FinishedTile> tiles;
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		tiles.swap (finishedTiles);
+	}
+	std::vector<CRect> result;
+	if (tiles.empty ())
+		return result;
+	// the pixels are only visible in the bitmap after the accessor was released
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	if (!accessor)
+		return result;
+	auto pixelAccess = accessor->getPlatformBitmapPixelAccess ();
+	auto address = pixelAccess->getAddress ();
+	auto bytesPerRow = pixelAccess->getBytesPerRow ();
+	result.reserve (tiles.size ());
+	for (const auto& tile : tiles)
+	{
+		auto r = getTileRect (tile.index);
+		auto left = static_cast<uint32_t> (r.left);
+		auto tileWidth = static_cast<uint32_t> (r.getWidth ());
+		auto src = tile.pixels.data ();
+		for (auto y = static_cast<uint32_t> (r.top); y < r.bottom; ++y, src += tileWidth)
+		{
+			auto dst = address + static_cast<size_t> (y) * bytesPerRow + left * sizeof (uint32_t);
+			std::memcpy (dst, src, tileWidth * sizeof (uint32_t));
+		}
+		result.emplace_back (r);
+	}
+	return result;
+}
+
+} // VSTGUI
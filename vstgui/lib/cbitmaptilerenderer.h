@@ -0,0 +1,166 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "cbitmap.h"
+#include "crect.h"
+#include "platform/iplatformbitmap.h"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+// CBitmapTileRenderer Declaration
+//! @brief computes the pixels of a bitmap tile by tile on worker threads
+//-----------------------------------------------------------------------------
+/** The bitmap is split into square tiles which are rendered by a render function on a number of
+ *	worker threads. The pixels are written into a buffer owned by the renderer, finished tiles are
+ *	copied into the bitmap with commit () on the thread owning the bitmap. It returns the rects of
+ *	the tiles, so that the view showing the bitmap only needs to invalidate those.
+ *
+ *	For progressive refinement the tiles can be rendered in several passes with decreasing block
+ *	sizes. In a pass with a block size of 8 the render function only needs to compute every 8th
+ *	pixel and fill the block with it via Tile::fillBlock, the last pass should use a block size of 1.
+ *	All tiles of a pass are finished before the next pass starts.
+ *
+ *	The renderer can be canceled at any time, it is canceled and waits for its worker threads when
+ *	it is destroyed.
+ */
+class CBitmapTileRenderer
+{
+public:
+	using PixelFormat = IPlatformBitmapPixelAccess::PixelFormat;
+
+	//-----------------------------------------------------------------------------
+	struct Config
+	{
+		/** width and height of the tiles in pixels */
+		uint32_t tileSize {64};
+		/** number of worker threads, zero for the number of hardware threads */
+		uint32_t numThreads {0};
+		/** block sizes of the refinement passes */
+		std::vector<uint32_t> passes {8, 1};
+		/** called on a worker thread after a tile was finished, use it to schedule a commit on the
+		 *	main thread */
+		std::function<void ()> tileFinished;
+	};
+
+	//-----------------------------------------------------------------------------
+	/** a tile in a pass, the coordinates are in pixels */
+	struct Tile
+	{
+		uint32_t left;
+		uint32_t top;
+		uint32_t right;
+		uint32_t bottom;
+		/** the size of the blocks of this pass */
+		uint32_t blockSize;
+		/** the index of the pass */
+		uint32_t pass;
+		PixelFormat pixelFormat;
+
+		/** the pixels of the row y in the renderer buffer, starting at x = 0 */
+		uint32_t* row (uint32_t y) const { return buffer + y * bufferWidth; }
+		/** fill the block at x, y clipped to the tile */
+		inline void fillBlock (uint32_t x, uint32_t y, uint32_t value) const;
+		/** long running render functions should check this and return early */
+		bool isCanceled () const { return canceled.load (std::memory_order_relaxed); }
+
+	private:
+		Tile (uint32_t* buffer, uint32_t bufferWidth, const std::atomic<bool>& canceled)
+		: buffer (buffer), bufferWidth (bufferWidth), canceled (canceled)
+		{
+		}
+
+		uint32_t* buffer;
+		uint32_t bufferWidth;
+		const std::atomic<bool>& canceled;
+
+		friend class CBitmapTileRenderer;
+	};
+	using RenderFunction = std::function<void (const Tile& tile)>;
+
+	/** the renderer renders into a buffer with the size and the pixel format of the bitmap */
+	CBitmapTileRenderer (CBitmap* bitmap, RenderFunction&& renderFunction, Config&& config);
+	CBitmapTileRenderer (CBitmap* bitmap, RenderFunction&& renderFunction);
+	~CBitmapTileRenderer () noexcept;
+
+	/** start the worker threads */
+	void start ();
+	/** cancel the rendering, the worker threads finish their current tiles */
+	void cancel ();
+	/** wait until all tiles are rendered or the rendering was canceled */
+	void wait ();
+	/** true if the last pass of all tiles was rendered */
+	bool isDone () const;
+
+	/** copy the tiles finished since the last call into the bitmap, must be called on the thread
+	 *	owning the bitmap. Returns the rects of the tiles in pixels.
+	 */
+	std::vector<CRect> commit ();
+
+	CBitmap* getBitmap () const { return bitmap; }
+	uint32_t getWidth () const { return width; }
+	uint32_t getHeight () const { return height; }
+	PixelFormat getPixelFormat () const { return pixelFormat; }
+	uint32_t getNumThreads () const { return numThreads; }
+	uint32_t getNumTiles () const { return numTilesX * numTilesY; }
+
+private:
+	void run ();
+	bool waitForPass (uint32_t pass);
+	void renderTile (uint32_t tileIndex, uint32_t pass);
+	void tileDone (uint32_t tileIndex, uint32_t pass);
+	CRect getTileRect (uint32_t tileIndex) const;
+
+	struct FinishedTile
+	{
+		uint32_t index;
+		/** a copy of the pixels, the buffer may already be used by the next pass */
+		std::vector<uint32_t> pixels;
+	};
+
+	SharedPointer<CBitmap> bitmap;
+	RenderFunction renderFunction;
+	Config config;
+	PixelFormat pixelFormat {IPlatformBitmapPixelAccess::kARGB};
+	uint32_t width {0};
+	uint32_t height {0};
+	uint32_t numTilesX {0};
+	uint32_t numTilesY {0};
+	uint32_t numThreads {0};
+	std::vector<uint32_t> buffer;
+	std::vector<std::thread> threads;
+
+	std::atomic<bool> canceled {false};
+	std::atomic<uint32_t> nextJob {0};
+	mutable std::mutex mutex;
+	std::condition_variable passCondition;
+	/** number of finished tiles per pass, guarded by mutex */
+	std::vector<uint32_t> numFinishedTiles;
+	/** tiles to copy into the bitmap on the next commit, guarded by mutex */
+	std::vector<FinishedTile> finishedTiles;
+};
+
+//-----------------------------------------------------------------------------
+inline void CBitmapTileRenderer::Tile::fillBlock (uint32_t x, uint32_t y, uint32_t value) const
+{
+	auto r = std::min (x + blockSize, right);
+	auto b = std::min (y + blockSize, bottom);
+	for (; y < b; ++y)
+	{
+		auto pixel = row (y);
+		for (auto i = x; i < r; ++i)
+			pixel[i] = value;
+	}
+}
+
+} // VSTGUI
@@ -46,10 +46,34 @@ public:
 
 	bool drawFocusOnTop () override;
 	bool getFocusPath (CGraphicsPath& outPath) override;
+
+	/** row and column metrics of the delegate, queried once per layout */
+	struct Layout
+	{
+		CCoord lineWidth {0.};
+		CColor lineColor;
+		/** height of a row including the row line */
+		CCoord rowHeight {0.};
+		int32_t numRows {0};
+		std::vector<CCoord> columnWidths;
+		/** left edge of every column relative to the view, including the column lines. The last
+		 *	entry is the right edge of the last column */
+		std::vector<CCoord> columnOffsets {0.};
+
+		int32_t numColumns () const { return static_cast<int32_t> (columnWidths.size ()); }
+		/** column containing x (relative to the view), -1 if none */
+		int32_t getColumnAt (CCoord x) const;
+	};
+
+	const Layout& getLayout ();
+	void invalidateLayout () { layoutValid = false; }
 protected:
+	void updateLayout ();
 
 	IDataBrowserDelegate* db;
 	CDataBrowser* browser;
+	Layout layout;
+	bool layoutValid {false};
 };
 
 //-----------------------------------------------------------------------------------------------
@@ -225,6 +249,9 @@ void CDataBrowser::valueChanged (CControl *pControl)
 void CDataBrowser::recalculateSubViews ()
 {
 	CScrollView::recalculateSubViews ();
+	// the column widths of the delegate may depend on the visible scrollbars
+	if (dbView)
+		dbView->invalidateLayout ();
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -233,6 +260,7 @@ void CDataBrowser::recalculateSubViews ()
  */
 void CDataBrowser::recalculateLayout (bool rememberSelection)
 {
+	dbView->invalidateLayout ();
 	CCoord lineWidth = 0;
 	CColor lineColor;
 	db->dbGetLineWidthAndColor (lineWidth, lineColor, this);
@@ -293,6 +321,7 @@ void CDataBrowser::recalculateLayout (bool rememberSelection)
 	newContainerSize.offset (getScrollOffset ().x, -getScrollOffset ().y);
 	dbView->setViewSize (newContainerSize);
 	dbView->setMouseableArea (newContainerSize);
+	dbView->invalidateLayout ();
 
 	CControl* scrollbar = getVerticalScrollbar ();
 	if (scrollbar && newContainerSize.getHeight () > 0.)
@@ -380,11 +409,9 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 		index = numRows-1;
 
 	bool hasChanged = true;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), index);
-	if (alreadySelected != selection.end ())
+	if (isRowSelected (index))
 	{
-		selection.erase (alreadySelected);
-		hasChanged = !selection.empty ();
+		hasChanged = selection.size () > 1;
 	}
 	else
 	{
@@ -393,11 +420,14 @@ void CDataBrowser::setSelectedRow (int32_t index, bool makeVisible)
 	
 	for (auto row : selection)
 	{
-		dbView->invalidateRow (row);
+		if (row != index)
+			dbView->invalidateRow (row);
+		setRowSelected (row, false);
 	}
 	selection.clear ();
 	
 	selection.emplace_back (index);
+	setRowSelected (index, true);
 	if (hasChanged)
 		db->dbSelectionChanged (this);
 	
@@ -418,12 +448,12 @@ void CDataBrowser::selectRow (int32_t row)
 {
 	if (row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected == selection.end ())
+	if (!isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
 			selection.emplace_back (row);
+			setRowSelected (row, true);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -439,12 +469,12 @@ void CDataBrowser::unselectRow (int32_t row)
 {
 	if (row > db->dbGetNumRows (this))
 		return;
-	Selection::iterator alreadySelected = std::find (selection.begin (), selection.end (), row);
-	if (alreadySelected != selection.end ())
+	if (isRowSelected (row))
 	{
 		if (getStyle () & kMultiSelectionStyle)
 		{
-			selection.erase (alreadySelected);
+			selection.erase (std::find (selection.begin (), selection.end (), row));
+			setRowSelected (row, false);
 			dbView->invalidateRow (row);
 			db->dbSelectionChanged (this);
 		}
@@ -465,10 +495,34 @@ void CDataBrowser::unselectAll ()
 			dbView->invalidateRow (row);
 		}
 		selection.clear ();
+		selectedRows.clear ();
 		db->dbSelectionChanged (this);
 	}
 }
 
+//-----------------------------------------------------------------------------------------------
+bool CDataBrowser::isRowSelected (int32_t row) const
+{
+	if (row >= 0)
+		return static_cast<size_t> (row) < selectedRows.size () && selectedRows[row];
+	// invalid rows are not tracked in selectedRows
+	return std::find (selection.begin (), selection.end (), row) != selection.end ();
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::setRowSelected (int32_t row, bool state)
+{
+	if (row < 0)
+		return;
+	if (static_cast<size_t> (row) >= selectedRows.size ())
+	{
+		if (!state)
+			return;
+		selectedRows.resize (static_cast<size_t> (row) + 1, false);
+	}
+	selectedRows[row] = state;
+}
+
 //-----------------------------------------------------------------------------------------------
 void CDataBrowser::validateSelection ()
 {
@@ -478,6 +532,7 @@ void CDataBrowser::validateSelection ()
 	{
 		if (*it >= numRows)
 		{
+			setRowSelected (*it, false);
 			it = selection.erase (it);
 			selectionChanged = true;
 		}
@@ -497,26 +552,12 @@ void CDataBrowser::validateSelection ()
  */
 CRect CDataBrowser::getCellBounds (const Cell& cell)
 {
-	CCoord lineWidth = 0;
-	if (style & kDrawRowLines || style & kDrawColumnLines)
+	const auto& layout = dbView->getLayout ();
+	CRect result (0, layout.rowHeight * cell.row, 0, layout.rowHeight * (cell.row+1));
+	if (cell.column >= 0 && cell.column < layout.numColumns ())
 	{
-		CColor lineColor;
-		db->dbGetLineWidthAndColor (lineWidth, lineColor, this);
-	}
-	CCoord rowHeight = db->dbGetRowHeight (this);
-	if (style & kDrawRowLines)
-		rowHeight += lineWidth;
-	CRect result (0, rowHeight * cell.row, 0, rowHeight * (cell.row+1));
-	for (int32_t i = 0; i <= cell.column; i++)
-	{
-		CCoord colWidth = db->dbGetCurrentColumnWidth (i, this);
-		if (i != cell.column)
-		{
-			result.offset (colWidth, 0);
-			if (style & kDrawColumnLines)
-				result.offset (lineWidth, 0);
-		}
-		result.setWidth (colWidth);
+		result.left = layout.columnOffsets[cell.column];
+		result.setWidth (layout.columnWidths[cell.column]);
 	}
 	CRect viewSize = dbView->getViewSize ();
 	result.offset (viewSize.left, viewSize.top);
@@ -548,7 +589,22 @@ void CDataBrowser::beginTextEdit (const Cell& cell, UTF8StringPtr initialText)
 	CRect r = getCellBounds (cell);
 	makeRectVisible (r);
 	CRect cellRect = getCellBounds (cell);
-	auto* te = new CTextEdit (cellRect, nullptr, -1, initialText);
+	CTextEdit* te = nullptr;
+	if (textEditRecycling && recycledTextEdit && !recycledTextEdit->isAttached ())
+	{
+		te = recycledTextEdit;
+		// addView takes over a reference
+		te->remember ();
+		te->setViewSize (cellRect, false);
+		te->setMouseableArea (cellRect);
+		te->setText (initialText);
+	}
+	else
+	{
+		te = new CTextEdit (cellRect, nullptr, -1, initialText);
+		if (textEditRecycling)
+			recycledTextEdit = te;
+	}
 	db->dbCellSetupTextEdit (cell.row, cell.column, te, this);
 	addView (te);
 	getFrame ()->setFocusView (te);
@@ -557,6 +613,14 @@ void CDataBrowser::beginTextEdit (const Cell& cell, UTF8StringPtr initialText)
 	te->setAttribute ('col ', cell.column);
 }
 
+//-----------------------------------------------------------------------------------------------
+void CDataBrowser::setTextEditRecycling (bool state)
+{
+	textEditRecycling = state;
+	if (!state)
+		recycledTextEdit = nullptr;
+}
+
 //-----------------------------------------------------------------------------------------------
 CMessageResult CDataBrowser::notify (CBaseObject* sender, IdStringPtr message)
 {
@@ -743,20 +807,52 @@ CDataBrowserView::CDataBrowserView (const CRect& size, IDataBrowserDelegate* db,
 }
 
 //-----------------------------------------------------------------------------------------------
-CRect CDataBrowserView::getRowBounds (int32_t row)
+const CDataBrowserView::Layout& CDataBrowserView::getLayout ()
 {
-	CCoord lineWidth = 0;
+	if (!layoutValid)
+		updateLayout ();
+	return layout;
+}
+
+//-----------------------------------------------------------------------------------------------
+void CDataBrowserView::updateLayout ()
+{
+	layout.lineWidth = 0.;
 	if (browser->getStyle () & CDataBrowser::kDrawRowLines || browser->getStyle () & CDataBrowser::kDrawColumnLines)
 	{
-		CColor lineColor;
-		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
+		db->dbGetLineWidthAndColor (layout.lineWidth, layout.lineColor, browser);
 	}
-	CCoord rowHeight = db->dbGetRowHeight (browser);
-
-	CRect where (getViewSize ());
-	where.originize ();
+	layout.rowHeight = db->dbGetRowHeight (browser);
 	if (browser->getStyle () & CDataBrowser::kDrawRowLines)
-		rowHeight+=lineWidth;
+		layout.rowHeight += layout.lineWidth;
+	layout.numRows = db->dbGetNumRows (browser);
+	auto numColumns = std::max<int32_t> (db->dbGetNumColumns (browser), 0);
+	CCoord columnLineWidth = (browser->getStyle () & CDataBrowser::kDrawColumnLines) ? layout.lineWidth : 0.;
+	layout.columnWidths.resize (static_cast<size_t> (numColumns));
+	layout.columnOffsets.resize (static_cast<size_t> (numColumns) + 1);
+	for (int32_t col = 0; col < numColumns; col++)
+	{
+		layout.columnWidths[col] = db->dbGetCurrentColumnWidth (col, browser);
+		layout.columnOffsets[col + 1] = layout.columnOffsets[col] + layout.columnWidths[col] + columnLineWidth;
+	}
+	layoutValid = true;
+}
+
+//-----------------------------------------------------------------------------------------------
+int32_t CDataBrowserView::Layout::getColumnAt (CCoord x) const
+{
+	if (x < 0.)
+		return -1;
+	auto it = std::upper_bound (columnOffsets.begin () + 1, columnOffsets.end (), x);
+	if (it == columnOffsets.end ())
+		return -1;
+	return static_cast<int32_t> (std::distance (columnOffsets.begin () + 1, it));
+}
+
+//-----------------------------------------------------------------------------------------------
+CRect CDataBrowserView::getRowBounds (int32_t row)
+{
+	CCoord rowHeight = getLayout ().rowHeight;
 
 	CRect r (getViewSize ().left, getViewSize ().top + rowHeight * row, getViewSize ().right, getViewSize ().top + rowHeight * (row+1));
 	return r;
@@ -782,36 +878,46 @@ void CDataBrowserView::draw (CDrawContext* context)
 void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 {
 	const bool drawRowLines = (browser->getStyle () & CDataBrowser::kDrawRowLines) ? true : false;
-	CCoord lineWidth = 0;
-	CColor lineColor;
-	if (browser->getStyle () & CDataBrowser::kDrawRowLines || browser->getStyle () & CDataBrowser::kDrawColumnLines)
-	{
-		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
-	}
-
-	CCoord rowHeight = db->dbGetRowHeight (browser);
-	if (drawRowLines)
-		rowHeight += lineWidth;
-	int32_t numRows = db->dbGetNumRows (browser);
-	int32_t numColumns = db->dbGetNumColumns (browser);
-
-	const CDataBrowser::Selection& selection = browser->getSelection ();
+	const bool drawColumnLines = (browser->getStyle () & CDataBrowser::kDrawColumnLines) ? true : false;
+	const auto& layout = getLayout ();
+	const CCoord lineWidth = layout.lineWidth;
+	const CCoord rowHeight = layout.rowHeight;
+	const int32_t numColumns = layout.numColumns ();
 
 	CDrawContext::LineList lines;
 
+	// only the rows and columns intersecting the update rect are visited
+	int32_t firstRow = 0;
+	int32_t lastRow = -1;
+	if (rowHeight > 0.)
+	{
+		auto toRow = [&] (CCoord y) {
+			auto row = std::floor ((y - getViewSize ().top) / rowHeight);
+			return static_cast<int32_t> (std::min<CCoord> (std::max<CCoord> (row, -1.), layout.numRows));
+		};
+		firstRow = std::max<int32_t> (toRow (updateRect.top), 0);
+		lastRow = std::min<int32_t> (toRow (updateRect.bottom), layout.numRows - 1);
+	}
+	int32_t firstColumn = layout.getColumnAt (updateRect.left - getViewSize ().left);
+	if (firstColumn < 0)
+		firstColumn = updateRect.left < getViewSize ().left ? 0 : numColumns;
+
 	CRect r (getViewSize ());
+	r.offset (0, rowHeight * firstRow);
 	r.setHeight (rowHeight - lineWidth);
-	for (int32_t row = 0; row < numRows; row++)
+	for (int32_t row = firstRow; row <= lastRow; row++)
 	{
 		CRect testRect (r);
 		testRect.bound (updateRect);
 		if (testRect.isEmpty () == false)
 		{
-			bool isSelected = std::find (selection.begin (), selection.end (), row) != selection.end ();
-			for (int32_t col = 0; col < numColumns; col++)
+			bool isSelected = browser->isRowSelected (row);
+			for (int32_t col = firstColumn; col < numColumns; col++)
 			{
-				CCoord columnWidth = db->dbGetCurrentColumnWidth (col, browser);
-				r.setWidth (columnWidth);
+				r.left = getViewSize ().left + layout.columnOffsets[col];
+				if (r.left >= updateRect.right)
+					break;
+				r.setWidth (layout.columnWidths[col]);
 				testRect = r;
 				testRect.bound (updateRect);
 				if (testRect.isEmpty () == false)
@@ -822,9 +928,6 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 					cellSize.right++;
 					db->dbDrawCell (context, cellSize, row, col, isSelected ? IDataBrowserDelegate::kRowSelected : 0, browser);
 				}
-				r.offset (columnWidth, 0);
-				if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-					r.offset (lineWidth, 0);
 			}
 		}
 		r.left = getViewSize ().left;
@@ -833,20 +936,18 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 			lines.emplace_back (r.getBottomLeft (), r.getBottomRight ());
 		r.offset (0, rowHeight);
 	}
-	if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
+	if (drawColumnLines)
 	{
-		
-		CPoint p1;
-		CPoint p2;
-		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
+		CPoint p1 (0, getViewSize ().top);
+		CPoint p2 (0, getViewSize ().bottom);
+		for (int32_t col = 0; col < numColumns - 1; col++)
 		{
-			p1 (getViewSize ().left - lineWidth, getViewSize ().top);
-			p2 (getViewSize ().left - lineWidth, getViewSize ().bottom);
-			for (int32_t col = 0; col < numColumns - 1; col++)
-			{
-				p1.x = p2.x = p1.x + db->dbGetCurrentColumnWidth (col, browser) + lineWidth;
-				lines.emplace_back (p1, p2);
-			}
+			p1.x = p2.x = getViewSize ().left + layout.columnOffsets[col + 1] - lineWidth;
+			if (p1.x < updateRect.left - lineWidth)
+				continue;
+			if (p1.x > updateRect.right + lineWidth)
+				break;
+			lines.emplace_back (p1, p2);
 		}
 	}
 	if (!lines.empty ())
@@ -854,7 +955,7 @@ void CDataBrowserView::drawRect (CDrawContext* context, const CRect& updateRect)
 		context->setClipRect (updateRect);
 		context->setDrawMode (kAntiAliasing);
 		context->setLineWidth (lineWidth);
-		context->setFrameColor (lineColor);
+		context->setFrameColor (layout.lineColor);
 		context->setLineStyle (kLineSolid);
 		context->drawLines (lines);
 	}
@@ -869,34 +970,18 @@ bool CDataBrowserView::getCell (const CPoint& where, CDataBrowser::Cell& cell)
 	if (_where.x < 0)
 		return false;
 	
-	CCoord lineWidth = 0;
-	if (browser->getStyle () & CDataBrowser::kDrawRowLines || browser->getStyle () & CDataBrowser::kDrawColumnLines)
-	{
-		CColor lineColor;
-		db->dbGetLineWidthAndColor (lineWidth, lineColor, browser);
-	}
-	CCoord rowHeight = db->dbGetRowHeight (browser);
-	int32_t numColumns = db->dbGetNumColumns (browser);
-
-	if (browser->getStyle () & CDataBrowser::kDrawRowLines)
-		rowHeight += lineWidth;
-	int32_t rowNum = (int32_t)(_where.y / rowHeight);
-	int32_t colNum = 0;
-	CCoord cw = 0;
-	for (int32_t i = 0; i < numColumns; i++)
-	{
-		cw += db->dbGetCurrentColumnWidth (i, browser);
-		if (browser->getStyle () & CDataBrowser::kDrawColumnLines)
-			cw += lineWidth;
-		if (_where.x < cw && rowNum < db->dbGetNumRows (browser) && colNum < db->dbGetNumColumns (browser))
-		{
-			colNum = i;
-			cell.row = rowNum;
-			cell.column = colNum;
-			return true;
-		}
-	}
-	return false;
+	const auto& layout = getLayout ();
+	if (layout.rowHeight <= 0.)
+		return false;
+	auto row = _where.y / layout.rowHeight;
+	if (row >= layout.numRows)
+		return false;
+	auto colNum = layout.getColumnAt (_where.x);
+	if (colNum < 0)
+		return false;
+	cell.row = static_cast<int32_t> (row);
+	cell.column = colNum;
+	return true;
 }
 
 //-----------------------------------------------------------------------------------------------
@@ -907,7 +992,7 @@ CMouseEventResult CDataBrowserView::onMouseDown (CPoint &where, const CButtonSta
 	if (getCell (where, cell))
 	{
 		const CDataBrowser::Selection& selection = browser->getSelection ();
-		bool alreadySelected = std::find (selection.begin (), selection.end (), cell.row) != selection.end ();
+		bool alreadySelected = browser->isRowSelected (cell.row);
 		if (browser->getStyle () & CDataBrowser::kMultiSelectionStyle)
 		{
 			if (buttons.getModifierState () == kControl)
@@ -32,6 +32,9 @@ protected:
 		kDrawHeaderFlag,
 		kMultiSelectionStyleFlag
 	};
+	static_assert (static_cast<int32_t> (kMultiSelectionStyleFlag) <
+					   static_cast<int32_t> (kTransformScrollingFlag),
+				   "the style flags overlap the CScrollView flags");
 	
 public:
 	CDataBrowser (const CRect& size, IDataBrowserDelegate* db, int32_t style = 0, CCoord scrollbarWidth = 16, CBitmap* pBackground = nullptr);
@@ -87,6 +90,8 @@ public:
 
 	/** get all selected rows */
 	const Selection& getSelection () const { return selection; }
+	/** check if a row is selected */
+	bool isRowSelected (int32_t row) const;
 	/** add row to selection */
 	virtual void selectRow (int32_t row);
 	/** remove row from selection */
@@ -96,6 +101,9 @@ public:
 
 	/** starts a text edit for a cell */
 	virtual void beginTextEdit (const Cell& cell, UTF8StringPtr initialText);
+	/** reuse one text edit for all cell edits instead of creating a new one for every edit */
+	void setTextEditRecycling (bool state);
+	bool getTextEditRecycling () const { return textEditRecycling; }
 
 	/** get delegate object */
 	IDataBrowserDelegate* getDelegate () const { return db; }
@@ -117,12 +125,17 @@ protected:
 
 	void recalculateSubViews () override;
 	void validateSelection ();
+	void setRowSelected (int32_t row, bool state);
 
 	IDataBrowserDelegate* db;
 	CDataBrowserView* dbView;
 	CDataBrowserHeader* dbHeader;
 	CViewContainer* dbHeaderContainer;
 	Selection selection;
+	/** selection state per row for constant time lookups, mirrors selection */
+	std::vector<bool> selectedRows;
+	SharedPointer<CTextEdit> recycledTextEdit;
+	bool textEditRecycling {false};
 };
 
 //-----------------------------------------------------------------------------
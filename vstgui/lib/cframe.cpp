@@ -8,17 +8,23 @@
 #include "coffscreencontext.h"
 #include "ctooltipsupport.h"
 #include "cinvalidrectlist.h"
+#include "cvstguitimer.h"
 #include "itouchevent.h"
 #include "iscalefactorchangedlistener.h"
 #include "idatapackage.h"
 #include "animation/animator.h"
+#include "controls/ccontrolvaluemailbox.h"
 #include "controls/ctextedit.h"
 #include "platform/platformfactory.h"
 #include "platform/iplatformframe.h"
+#include <algorithm>
 #include <cassert>
 #include <vector>
 #include <queue>
 #include <stack>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 #include <limits>
 
 namespace VSTGUI {
@@ -73,6 +79,7 @@ struct CFrame::Impl
 	CView* focusView {nullptr};
 	CView* activeFocusView {nullptr};
 	CollectInvalidRects* collectInvalidRects {nullptr};
+	CInvalidRectList::Policy invalidRectListPolicy;
 	
 	ViewList mouseViews;
 	ModalViewSessionStack modalViewSessionStack;
@@ -82,6 +89,17 @@ struct CFrame::Impl
 	DispatchList<IFocusViewObserver*> focusViewObservers;
 	DispatchList<IKeyboardHook*> keyboardHooks;
 	FunctionQueue postEventFunctionQueue;
+	/** views which were set dirty since the last idle call, guarded by dirtyViewsMutex */
+	std::unordered_set<CView*> dirtyViews;
+	std::mutex dirtyViewsMutex;
+	bool idleVisitsOnlyDirtyViews {false};
+
+	SharedPointer<CControlValueMailbox> controlValueMailbox;
+	SharedPointer<CVSTGUITimer> controlValueMailboxTimer;
+	/** the attached controls by tag, rebuilt on the next dispatch after views were added, removed
+	 *	or their tag changed */
+	std::unordered_multimap<int32_t, CControl*> controlsByTag;
+	bool controlsByTagValid {false};
 
 	ModalViewSessionID modalViewSessionIDCounter {0};
 	double userScaleFactor {1.};
@@ -149,7 +167,13 @@ void CFrame::beforeDelete ()
 	removeAll ();
 
 	pImpl->tooltips = nullptr;
-	pImpl->animator = nullptr;
+	if (pImpl->animator)
+	{
+		// the animator may outlive the frame
+		pImpl->animator->setFrameUpdateWrapper (nullptr);
+		pImpl->animator = nullptr;
+	}
+	pImpl->controlValueMailboxTimer = nullptr;
 
 #if DEBUG
 	if (!pImpl->scaleFactorChangedListenerList.empty ())
@@ -192,6 +216,7 @@ void CFrame::close ()
 	setCursor (kCursorDefault);
 	setParentFrame (nullptr);
 	removeAll ();
+	pImpl->controlValueMailboxTimer = nullptr;
 	if (pImpl->platformFrame)
 	{
 		pImpl->platformFrame->onFrameClosed ();
@@ -795,6 +820,7 @@ void CFrame::setClipboard (const SharedPointer<IDataPackage>& data)
 //-----------------------------------------------------------------------------
 void CFrame::idle ()
 {
+	dispatchControlValueMailbox ();
 	if (CView::kDirtyCallAlwaysOnMainThread)
 		return;
 	invalidateDirtyViews ();
@@ -804,7 +830,22 @@ void CFrame::idle ()
 Animation::Animator* CFrame::getAnimator ()
 {
 	if (pImpl->animator == nullptr)
+	{
 		pImpl->animator = makeOwned<Animation::Animator> ();
+		// collect the invalidations of all animations of one animation frame
+		pImpl->animator->setFrameUpdateWrapper (
+			[this] (const Animation::Animator::FrameUpdateFunction& update) {
+				if (pImpl->collectInvalidRects)
+				{
+					update ();
+					return;
+				}
+				// an animation callback may release the last reference to the frame
+				auto self = shared (this);
+				CollectInvalidRects cir (this);
+				update ();
+			});
+	}
 	return pImpl->animator;
 }
 
@@ -1118,6 +1159,11 @@ void CFrame::setCursor (CCursorType type)
 void CFrame::onViewRemoved (CView* pView)
 {
 	removeFromMouseViews (pView);
+	pImpl->controlsByTagValid = false;
+	{
+		std::lock_guard<std::mutex> guard (pImpl->dirtyViewsMutex);
+		pImpl->dirtyViews.erase (pView);
+	}
 
 	if (pImpl->activeFocusView == pView)
 		pImpl->activeFocusView = nullptr;
@@ -1147,6 +1193,9 @@ void CFrame::onViewRemoved (CView* pView)
  */
 void CFrame::onViewAdded (CView* pView)
 {
+	pImpl->controlsByTagValid = false;
+	if (pView->CView::isDirty ())
+		onViewDirty (pView);
 	if (getViewAddedRemovedObserver ())
 		getViewAddedRemovedObserver ()->onViewAdded (this, pView);
 	if (pView->wantsWindowActiveStateChangeNotification ())
@@ -1156,6 +1205,135 @@ void CFrame::onViewAdded (CView* pView)
 	}
 }
 
+//-----------------------------------------------------------------------------
+void CFrame::onViewDirty (CView* pView)
+{
+	std::lock_guard<std::mutex> guard (pImpl->dirtyViewsMutex);
+	pImpl->dirtyViews.emplace (pView);
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::onControlTagChanged (CControl* pControl)
+{
+	pImpl->controlsByTagValid = false;
+}
+
+//-----------------------------------------------------------------------------
+CControlValueMailbox* CFrame::getControlValueMailbox ()
+{
+	if (!pImpl->controlValueMailbox)
+	{
+		pImpl->controlValueMailbox = makeOwned<CControlValueMailbox> ();
+		pImpl->controlValueMailboxTimer = makeOwned<CVSTGUITimer> (
+			[this] (CVSTGUITimer*) { dispatchControlValueMailbox (); }, 1000 / 60);
+	}
+	return pImpl->controlValueMailbox;
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::dispatchControlValueMailbox ()
+{
+	auto mailbox = pImpl->controlValueMailbox.get ();
+	if (!mailbox || !mailbox->hasPendingValues ())
+		return;
+	mailbox->drain ([this] (int32_t tag, float value) {
+		// the controls which got the value, referenced so that their addresses are not reused
+		std::vector<SharedPointer<CControl>> visited;
+		auto indexChanged = true;
+		while (indexChanged)
+		{
+			indexChanged = false;
+			if (!pImpl->controlsByTagValid)
+			{
+				std::vector<CControl*> controls;
+				getChildViewsOfType<CControl> (controls, true);
+				pImpl->controlsByTag.clear ();
+				for (auto control : controls)
+					pImpl->controlsByTag.emplace (control->getTag (), control);
+				pImpl->controlsByTagValid = true;
+			}
+			auto range = pImpl->controlsByTag.equal_range (tag);
+			for (auto it = range.first; it != range.second; ++it)
+			{
+				auto control = it->second;
+				if (std::find (visited.begin (), visited.end (), control) != visited.end ())
+					continue;
+				visited.emplace_back (shared (control));
+				if (control->isEditing ())
+					continue;
+				auto oldValue = control->getValue ();
+				control->setValue (value);
+				if (control->getValue () != oldValue)
+					control->invalid ();
+				// a control changed the view hierarchy, continue with the remaining controls of
+				// the rebuilt index
+				if (!pImpl->controlsByTagValid)
+				{
+					indexChanged = true;
+					break;
+				}
+			}
+		}
+	});
+}
+
+//-----------------------------------------------------------------------------
+void CFrame::setIdleVisitsOnlyDirtyViews (bool state)
+{
+	pImpl->idleVisitsOnlyDirtyViews = state;
+}
+
+//-----------------------------------------------------------------------------
+bool CFrame::getIdleVisitsOnlyDirtyViews () const
+{
+	return pImpl->idleVisitsOnlyDirtyViews;
+}
+
+//-----------------------------------------------------------------------------
+/** if enabled via setIdleVisitsOnlyDirtyViews, only visits the views which were set dirty since
+ *	the last call instead of the whole view hierarchy, see onViewDirty. Dirty views with an
+ *	invisible ancestor stay in the set until they are visible again.
+ */
+bool CFrame::invalidateDirtyViews ()
+{
+	decltype (pImpl->dirtyViews) views;
+	{
+		std::lock_guard<std::mutex> guard (pImpl->dirtyViewsMutex);
+		views.swap (pImpl->dirtyViews);
+	}
+	if (!pImpl->idleVisitsOnlyDirtyViews)
+		return CViewContainer::invalidateDirtyViews ();
+	std::vector<CView*> hiddenViews;
+	for (auto view : views)
+	{
+		// containers report dirty children via isDirty, those are in the set on their own
+		auto dirty = view->asViewContainer () ? view->CView::isDirty () : view->isDirty ();
+		if (!dirty)
+			continue;
+		auto visible = true;
+		for (auto v = view; v && visible; v = v->getParentView ())
+			visible = v->isVisible ();
+		if (!visible)
+		{
+			hiddenViews.emplace_back (view);
+			continue;
+		}
+		if (view->asViewContainer ())
+		{
+			if (auto parent = view->getParentView ())
+				parent->invalidRect (view->getViewSize ());
+		}
+		else
+			view->invalid ();
+	}
+	if (!hiddenViews.empty ())
+	{
+		std::lock_guard<std::mutex> guard (pImpl->dirtyViewsMutex);
+		pImpl->dirtyViews.insert (hiddenViews.begin (), hiddenViews.end ());
+	}
+	return true;
+}
+
 //-----------------------------------------------------------------------------
 /**
  * @param pView new focus view
@@ -1487,17 +1665,37 @@ void CFrame::setFocusWidth (CCoord width)
  */
 void CFrame::scrollRect (const CRect& src, const CPoint& distance)
 {
-	CRect rect (src);
-	rect.offset (getViewSize ().left, getViewSize ().top);
-
-	if (pImpl->platformFrame)
-	{
-		if (pImpl->platformFrame->scrollRect (src, distance))
+	if (pImpl->platformFrame && isVisible ())
+	{
+		// the pending invalid rects must be known to the platform frame, so that it can move
+		// them together with the content
+		if (pImpl->collectInvalidRects)
+			pImpl->collectInvalidRects->flush ();
+		CRect rect (src);
+		CPoint d (distance);
+		getTransform ().transform (rect);
+		getTransform ().transform (d);
+		CPoint origin;
+		getTransform ().transform (origin);
+		d -= origin;
+		if (pImpl->platformFrame->scrollRect (rect, d))
 			return;
 	}
 	invalidRect (src);
 }
 
+//-----------------------------------------------------------------------------
+void CFrame::setInvalidRectListPolicy (const CInvalidRectList::Policy& policy)
+{
+	pImpl->invalidRectListPolicy = policy;
+}
+
+//-----------------------------------------------------------------------------
+const CInvalidRectList::Policy& CFrame::getInvalidRectListPolicy () const
+{
+	return pImpl->invalidRectListPolicy;
+}
+
 //-----------------------------------------------------------------------------
 void CFrame::invalidate (const CRect &rect)
 {
@@ -1664,6 +1862,7 @@ IPlatformFrame* CFrame::getPlatformFrame () const
 void CFrame::platformDrawRects (const PlatformGraphicsDeviceContextPtr& context, double scaleFactor,
 								const std::vector<CRect>& rects)
 {
+	dispatchControlValueMailbox ();
 	CDrawContext drawContext (context, getViewSize (), scaleFactor);
 	for (auto rect : rects)
 		drawRect (&drawContext, rect);
@@ -1894,6 +2093,7 @@ void CFrame::setCollectInvalidRects (CollectInvalidRects* cir)
 //-----------------------------------------------------------------------------
 CFrame::CollectInvalidRects::CollectInvalidRects (CFrame* frame)
 : frame (frame)
+, invalidRects (frame->pImpl->invalidRectListPolicy)
 , lastTicks (frame->getTicks ())
 {
 #if VSTGUI_LOG_COLLECT_INVALID_RECTS
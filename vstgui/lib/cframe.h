@@ -6,6 +6,7 @@
 
 #include "vstguifwd.h"
 #include "cviewcontainer.h"
+#include "cinvalidrectlist.h"
 #include "optional.h"
 #include "platform/iplatformframecallback.h"
 
@@ -110,6 +111,30 @@ public:
 
 	void onViewAdded (CView* pView);
 	void onViewRemoved (CView* pView);
+	/** called by CView::setDirty and CControl::setValue, the dirty views are invalidated in the
+	 *	next idle call.
+	 *	Thread Safe ! But the call must not race with the removal of the view from the frame, as
+	 *	the frame does not own the views in its dirty set.
+	 */
+	void onViewDirty (CView* pView);
+	/** let idle only visit the views posted via onViewDirty instead of scanning the whole view
+	 *	hierarchy for dirty views.
+	 *	When enabled, views which override isDirty and controls which change their value member
+	 *	directly are only redrawn if they call setDirty or invalid themselves. Default is false.
+	 */
+	void setIdleVisitsOnlyDirtyViews (bool state);
+	bool getIdleVisitsOnlyDirtyViews () const;
+	/** called by CControl::setTag */
+	void onControlTagChanged (CControl* pControl);
+
+	/** get the mailbox for the values of the controls of this frame, which other threads can post
+	 *	to. The frame drains it before it draws and with a timer, and sets the latest posted value
+	 *	of a tag to all controls with this tag, except the ones the user currently edits.
+	 *	The mailbox is created on the first call, which must be on the UI thread.
+	 */
+	CControlValueMailbox* getControlValueMailbox ();
+	/** set the values posted to the control value mailbox to the controls now */
+	void dispatchControlValueMailbox ();
 
 	/** called when the platform view/window is activated/deactivated */
 	void onActivate (bool state);
@@ -119,6 +144,11 @@ public:
 	/** scroll src rect by distance */
 	void scrollRect (const CRect& src, const CPoint& distance);
 
+	/** set the policy how invalid rects are coalesced before they are passed to the platform */
+	void setInvalidRectListPolicy (const CInvalidRectList::Policy& policy);
+	/** get the policy how invalid rects are coalesced */
+	const CInvalidRectList::Policy& getInvalidRectListPolicy () const;
+
 	/** enable or disable tooltips */
 	void enableTooltips (bool state, uint32_t delayTimeInMs = 1000);
 
@@ -210,6 +240,7 @@ public:
 
 	bool removeView (CView* pView, bool withForget = true) override;
 	bool removeAll (bool withForget = true) override;
+	bool invalidateDirtyViews () override;
 	CView* getViewAt (const CPoint& where, const GetViewOptions& options = GetViewOptions ()) const override;
 	CViewContainer* getContainerAt (const CPoint& where, const GetViewOptions& options = GetViewOptions ().deep ()) const override;
 	bool getViewsAt (const CPoint& where, ViewList& views, const GetViewOptions& options = GetViewOptions ().deep ()) const override;
@@ -0,0 +1,208 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cglyphatlas.h"
+#include "cbitmap.h"
+#include "coffscreencontext.h"
+#include "platform/iplatformfont.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+static std::vector<SharedPointer<CGlyphAtlas>>& getGlyphAtlasCache ()
+{
+	static std::vector<SharedPointer<CGlyphAtlas>> cache;
+	return cache;
+}
+
+//-----------------------------------------------------------------------------
+SharedPointer<CGlyphAtlas> CGlyphAtlas::get (CFontRef font, const CColor& color,
+											 double scaleFactor, bool antialias)
+{
+	if (!font || scaleFactor <= 0.)
+		return nullptr;
+	auto& cache = getGlyphAtlasCache ();
+	auto it = std::find_if (cache.begin (), cache.end (), [&] (const auto& atlas) {
+		return atlas->matches (*font, color, scaleFactor, antialias);
+	});
+	if (it != cache.end ())
+	{
+		// keep the most recently used atlas at the end
+		auto atlas = *it;
+		cache.erase (it);
+		cache.emplace_back (atlas);
+		return atlas;
+	}
+	auto atlas = owned (new CGlyphAtlas (font, color, scaleFactor, antialias));
+	if (!atlas->render ())
+		return nullptr;
+	if (cache.size () >= kMaxCachedAtlases)
+		cache.erase (cache.begin ());
+	cache.emplace_back (atlas);
+	return atlas;
+}
+
+//-----------------------------------------------------------------------------
+void CGlyphAtlas::clearCache ()
+{
+	getGlyphAtlasCache ().clear ();
+}
+
+//-----------------------------------------------------------------------------
+size_t CGlyphAtlas::getNumCachedAtlases ()
+{
+	return getGlyphAtlasCache ().size ();
+}
+
+//-----------------------------------------------------------------------------
+bool CGlyphAtlas::isSupported (UTF8StringPtr string)
+{
+	if (!string)
+		return false;
+	size_t length = 0;
+	for (auto c = reinterpret_cast<const uint8_t*> (string); *c; ++c)
+	{
+		if (*c < kFirstCharacter || *c > kLastCharacter || ++length > kMaxStringLength)
+			return false;
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+CGlyphAtlas::CGlyphAtlas (CFontRef inFont, const CColor& inColor, double inScaleFactor,
+						  bool inAntialias)
+: font (makeOwned<CFontDesc> (*inFont))
+, color (inColor)
+, scaleFactor (inScaleFactor)
+, antialias (inAntialias)
+{
+}
+
+//-----------------------------------------------------------------------------
+CGlyphAtlas::~CGlyphAtlas () noexcept = default;
+
+//-----------------------------------------------------------------------------
+bool CGlyphAtlas::matches (const CFontDesc& inFont, const CColor& inColor, double inScaleFactor,
+						   bool inAntialias) const
+{
+	return color == inColor && scaleFactor == inScaleFactor && antialias == inAntialias &&
+		   *font == inFont;
+}
+
+//-----------------------------------------------------------------------------
+bool CGlyphAtlas::render ()
+{
+	auto platformFont = font->getPlatformFont ();
+	if (!platformFont)
+		return false;
+	ascent = platformFont->getAscent ();
+	auto descent = platformFont->getDescent ();
+	if (ascent <= 0. || descent < 0.)
+	{
+		ascent = font->getSize ();
+		descent = font->getSize () / 4.;
+	}
+	capHeight = platformFont->getCapHeight ();
+	padding = std::ceil (font->getSize () / 4.);
+
+	char glyphString[2] {};
+	// measure the glyphs first to know the size of the atlas
+	auto measureContext = COffscreenContext::create ({1., 1.}, scaleFactor);
+	if (!measureContext)
+		return false;
+	measureContext->setFont (font);
+	CCoord maxAdvance = 0.;
+	for (size_t i = 0; i < kNumGlyphs; ++i)
+	{
+		glyphString[0] = static_cast<char> (kFirstCharacter + i);
+		glyphs[i].advance = measureContext->getStringWidth (glyphString);
+		maxAdvance = std::max (maxAdvance, glyphs[i].advance);
+	}
+	cellSize.x = std::ceil (maxAdvance + padding * 2.);
+	cellSize.y = std::ceil (ascent + descent + padding * 2.);
+
+	constexpr auto numRows = (kNumGlyphs + kNumColumns - 1) / kNumColumns;
+	auto context =
+		COffscreenContext::create ({cellSize.x * kNumColumns, cellSize.y * numRows}, scaleFactor);
+	if (!context)
+		return false;
+	context->beginDraw ();
+	context->clearRect (CRect (0., 0., cellSize.x * kNumColumns, cellSize.y * numRows));
+	context->setFont (font);
+	context->setFontColor (color);
+	context->setDrawMode (antialias ? kAntiAliasing : kAliasing);
+	for (size_t i = 0; i < kNumGlyphs; ++i)
+	{
+		glyphString[0] = static_cast<char> (kFirstCharacter + i);
+		auto& glyph = glyphs[i];
+		glyph.offset.x = static_cast<CCoord> (i % kNumColumns) * cellSize.x;
+		glyph.offset.y = static_cast<CCoord> (i / kNumColumns) * cellSize.y;
+		context->drawString (glyphString,
+							 CPoint (glyph.offset.x + padding, glyph.offset.y + padding + ascent),
+							 antialias);
+	}
+	context->endDraw ();
+	bitmap = shared (context->getBitmap ());
+	return bitmap != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+CCoord CGlyphAtlas::snapToPixel (CCoord value) const
+{
+	return std::round (value * scaleFactor) / scaleFactor;
+}
+
+//-----------------------------------------------------------------------------
+CCoord CGlyphAtlas::getStringWidth (UTF8StringPtr string) const
+{
+	CCoord width = 0.;
+	for (auto c = reinterpret_cast<const uint8_t*> (string); c && *c; ++c)
+	{
+		if (*c >= kFirstCharacter && *c <= kLastCharacter)
+			width += glyphs[*c - kFirstCharacter].advance;
+	}
+	return width;
+}
+
+//-----------------------------------------------------------------------------
+bool CGlyphAtlas::drawString (CDrawContext* context, UTF8StringPtr string, const CRect& rect,
+							  CHoriTxtAlign hAlign) const
+{
+	if (!isSupported (string))
+		return false;
+
+	// same vertical and horizontal placement as CDrawContext::drawString
+	CCoord baseline = rect.bottom;
+	if (capHeight > 0.)
+		baseline -= rect.getHeight () / 2. - capHeight / 2.;
+	else
+		baseline -= (rect.getHeight () / 2. - font->getSize () / 2.) + 1.;
+	CCoord x = rect.left;
+	if (hAlign != kLeftText)
+	{
+		auto stringWidth = getStringWidth (string);
+		if (hAlign == kRightText)
+			x = rect.right - stringWidth;
+		else
+			x = rect.left + (rect.getWidth () / 2.) - (stringWidth / 2.);
+	}
+
+	auto top = snapToPixel (baseline - ascent - padding);
+	for (auto c = reinterpret_cast<const uint8_t*> (string); *c; ++c)
+	{
+		const auto& glyph = glyphs[*c - kFirstCharacter];
+		if (*c != ' ')
+		{
+			CRect dest (CPoint (snapToPixel (x - padding), top), cellSize);
+			context->drawBitmap (bitmap, dest, glyph.offset);
+		}
+		x += glyph.advance;
+	}
+	return true;
+}
+
+} // VSTGUI
@@ -0,0 +1,89 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "ccolor.h"
+#include "cdrawdefs.h"
+#include "cfont.h"
+#include "crect.h"
+#include <array>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+// CGlyphAtlas Declaration
+//! @brief a bitmap with the pre-rendered glyphs of a font
+//-----------------------------------------------------------------------------
+/** The printable ASCII characters of a font are rendered once in one color into a bitmap.
+ *	Strings are drawn by copying the glyphs out of this bitmap, without going through the text
+ *	layout engine of the platform.
+ *
+ *	Kerning and ligatures are not applied, so this is meant for short strings which are drawn
+ *	very often, like the values of parameter displays. Strings with other characters can not be
+ *	drawn with an atlas and must use CDrawContext::drawString.
+ *
+ *	The atlases are shared per font, color, scale factor and antialiasing via a small cache.
+ */
+class CGlyphAtlas : public NonAtomicReferenceCounted
+{
+public:
+	static constexpr uint8_t kFirstCharacter = 0x20;
+	static constexpr uint8_t kLastCharacter = 0x7e;
+	static constexpr size_t kMaxStringLength = 64;
+	static constexpr size_t kMaxCachedAtlases = 32;
+
+	/** get the atlas for the font from the cache or create it, returns nullptr on failure */
+	static SharedPointer<CGlyphAtlas> get (CFontRef font, const CColor& color, double scaleFactor,
+										   bool antialias = true);
+	static void clearCache ();
+	static size_t getNumCachedAtlases ();
+
+	/** check if the string only has characters of the atlas and is not too long */
+	static bool isSupported (UTF8StringPtr string);
+
+	/** the width of the string, without kerning */
+	CCoord getStringWidth (UTF8StringPtr string) const;
+	/** draw the string vertically centered into the rect, like CDrawContext::drawString
+	 *
+	 *	returns false if the string is not supported
+	 */
+	bool drawString (CDrawContext* context, UTF8StringPtr string, const CRect& rect,
+					 CHoriTxtAlign hAlign = kCenterText) const;
+
+	CBitmap* getBitmap () const { return bitmap; }
+	const CColor& getColor () const { return color; }
+	double getScaleFactor () const { return scaleFactor; }
+
+	~CGlyphAtlas () noexcept override;
+
+private:
+	static constexpr size_t kNumGlyphs = kLastCharacter - kFirstCharacter + 1;
+	static constexpr size_t kNumColumns = 16;
+
+	struct Glyph
+	{
+		CPoint offset;
+		CCoord advance {0.};
+	};
+
+	CGlyphAtlas (CFontRef font, const CColor& color, double scaleFactor, bool antialias);
+	bool render ();
+	bool matches (const CFontDesc& font, const CColor& color, double scaleFactor,
+				  bool antialias) const;
+	CCoord snapToPixel (CCoord value) const;
+
+	SharedPointer<CFontDesc> font;
+	SharedPointer<CBitmap> bitmap;
+	std::array<Glyph, kNumGlyphs> glyphs;
+	CColor color;
+	double scaleFactor;
+	bool antialias;
+	CCoord padding {0.};
+	CCoord ascent {0.};
+	CCoord capHeight {0.};
+	CPoint cellSize;
+};
+
+} // VSTGUI
@@ -0,0 +1,94 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "cgraphicspathcache.h"
+#include "cdrawcontext.h"
+#include "platform/iplatformgraphicsdevice.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+auto CGraphicsPathCache::KeyBuilder::add (uint64_t value) -> KeyBuilder&
+{
+	// FNV-1a over the bytes of the value
+	for (auto i = 0u; i < sizeof (value); ++i)
+	{
+		key ^= (value >> (i * 8)) & 0xFF;
+		key *= 1099511628211ull;
+	}
+	return *this;
+}
+
+//-----------------------------------------------------------------------------
+auto CGraphicsPathCache::KeyBuilder::add (double value) -> KeyBuilder&
+{
+	if (value == 0.)
+		value = 0.; // -0 and 0 are the same shape
+	uint64_t bits;
+	std::memcpy (&bits, &value, sizeof (bits));
+	return add (bits);
+}
+
+//-----------------------------------------------------------------------------
+double CGraphicsPathCache::quantize (double value, uint32_t numSteps)
+{
+	if (numSteps == 0)
+		return value;
+	return std::round (value * numSteps) / numSteps;
+}
+
+//-----------------------------------------------------------------------------
+CGraphicsPathCache::CGraphicsPathCache (size_t maxEntries)
+: maxEntries (std::max<size_t> (maxEntries, 1))
+{
+}
+
+//-----------------------------------------------------------------------------
+void CGraphicsPathCache::clear ()
+{
+	entries.clear ();
+}
+
+//-----------------------------------------------------------------------------
+auto CGraphicsPathCache::getDeviceID (CDrawContext* context) -> DeviceID
+{
+	if (auto& deviceContext = context->getPlatformDeviceContext ())
+		return &deviceContext->getDevice ();
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+CGraphicsPath* CGraphicsPathCache::find (DeviceID device, Key key)
+{
+	auto it = std::find_if (entries.begin (), entries.end (), [&] (const auto& entry) {
+		return entry.key == key && entry.device == device;
+	});
+	if (it == entries.end ())
+		return nullptr;
+	if (it != entries.end () - 1)
+	{
+		auto entry = std::move (*it);
+		entries.erase (it);
+		entries.emplace_back (std::move (entry));
+	}
+	return entries.back ().path;
+}
+
+//-----------------------------------------------------------------------------
+CGraphicsPath* CGraphicsPathCache::add (CDrawContext* context, DeviceID device, Key key)
+{
+	auto path = owned (context->createGraphicsPath ());
+	if (!path)
+		return nullptr;
+	if (entries.size () >= maxEntries)
+		entries.erase (entries.begin ());
+	entries.push_back ({key, device, path});
+	++numBuiltPaths;
+	return path;
+}
+
+} // VSTGUI
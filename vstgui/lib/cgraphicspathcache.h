@@ -0,0 +1,102 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "cgraphicspath.h"
+#include "crect.h"
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+// CGraphicsPathCache Declaration
+//! @brief retains the graphics paths of a view between draw calls
+//-----------------------------------------------------------------------------
+/** Vector drawn views can keep the paths of their shapes in this cache instead of creating and
+ *	building a new path on every draw call. The paths are looked up by a key built from all
+ *	parameters which define the shape, see KeyBuilder.
+ *
+ *	Values which change often, like the value of a control, should be quantized with quantize ()
+ *	before they are added to a key, so that small changes which are not visible reuse the path.
+ *
+ *	The cache holds a limited number of paths, the least recently used path is removed first.
+ *	Paths are only shared between draw contexts of the same graphics device.
+ */
+class CGraphicsPathCache
+{
+public:
+	using Key = uint64_t;
+
+	//-----------------------------------------------------------------------------
+	/** builds a cache key from the shape parameters */
+	struct KeyBuilder
+	{
+		KeyBuilder& add (uint64_t value);
+		KeyBuilder& add (int32_t value) { return add (static_cast<uint64_t> (value)); }
+		KeyBuilder& add (double value);
+		KeyBuilder& add (const CPoint& p) { return add (p.x).add (p.y); }
+		KeyBuilder& add (const CRect& r) { return add (r.left).add (r.top).add (r.right).add (r.bottom); }
+
+		Key get () const { return key; }
+
+	private:
+		Key key {14695981039346656037ull};
+	};
+
+	/** quantize a normalized value into numSteps steps */
+	static double quantize (double value, uint32_t numSteps);
+
+	explicit CGraphicsPathCache (size_t maxEntries = 4);
+
+	/** get the path for the key or create it and build it with the build function
+	 *
+	 *	@param context the context the path is drawn into
+	 *	@param key the key of the shape
+	 *	@param build function with the signature void (CGraphicsPath& path)
+	 *	@return the path or nullptr if the context can not create paths
+	 */
+	template <typename BuildProc>
+	CGraphicsPath* get (CDrawContext* context, Key key, BuildProc&& build);
+
+	void clear ();
+	size_t getNumEntries () const { return entries.size (); }
+	size_t getMaxEntries () const { return maxEntries; }
+	/** number of paths built since the cache was created */
+	uint64_t getNumBuiltPaths () const { return numBuiltPaths; }
+
+private:
+	using DeviceID = const void*;
+
+	struct Entry
+	{
+		Key key;
+		DeviceID device;
+		SharedPointer<CGraphicsPath> path;
+	};
+
+	static DeviceID getDeviceID (CDrawContext* context);
+	CGraphicsPath* find (DeviceID device, Key key);
+	CGraphicsPath* add (CDrawContext* context, DeviceID device, Key key);
+
+	/** the most recently used entry is at the end */
+	std::vector<Entry> entries;
+	size_t maxEntries;
+	uint64_t numBuiltPaths {0};
+};
+
+//-----------------------------------------------------------------------------
+template <typename BuildProc>
+inline CGraphicsPath* CGraphicsPathCache::get (CDrawContext* context, Key key, BuildProc&& build)
+{
+	auto device = getDeviceID (context);
+	if (auto path = find (device, key))
+		return path;
+	auto path = add (context, device, key);
+	if (path)
+		build (*path);
+	return path;
+}
+
+} // VSTGUI
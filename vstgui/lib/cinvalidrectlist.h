@@ -5,106 +5,369 @@
 #pragma once
 
 #include "crect.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
 #include <vector>
 
 namespace VSTGUI {
 
 //-----------------------------------------------------------------------------
+/** List of invalid rectangles
+ *
+ *	Rectangles are merged on insertion. To find the merge candidates the rectangles are bucketed
+ *	into a uniform grid, so that adding a rectangle only needs to look at the rectangles in its
+ *	neighbourhood instead of the whole list.
+ */
 struct CInvalidRectList
 {
 	using RectList = std::vector<CRect>;
 
+	/** Policy how far rectangles are coalesced */
+	struct Policy
+	{
+		/** size of one grid cell of the spatial index */
+		CCoord cellSize {128.};
+		/** two rectangles are joined if the area of the joined rectangle is not bigger than the
+		 *	area of both rectangles multiplied by this factor */
+		double joinAreaFactor {1.};
+		/** only rectangles which are not further away than this distance are joined */
+		CCoord joinDistance {0.};
+		/** if the list has more rectangles than this, all rectangles are joined into one
+		 *	(zero means no limit) */
+		size_t maxRects {0};
+	};
+
+	CInvalidRectList () = default;
+	explicit CInvalidRectList (const Policy& policy) : policy (policy) {}
+
+	void setPolicy (const Policy& newPolicy);
+	const Policy& getPolicy () const { return policy; }
+
 	bool add (const CRect& r);
+	void joinNearby (CCoord maxDistance);
 
 	RectList::iterator begin () { return list.begin (); }
 	RectList::iterator end () { return list.end (); }
 	RectList::const_iterator begin () const { return list.begin (); }
 	RectList::const_iterator end () const { return list.end (); }
 
-	void erase (RectList::iterator it) { list.erase (it); }
+	/** erase a rectangle. The order of the remaining rectangles may change. */
+	void erase (RectList::iterator it) { removeAt (static_cast<Index> (it - list.begin ())); }
 
-	void clear () { list.clear (); }
+	void clear ();
 	const RectList& data () const { return list; }
 	bool empty () const { return list.empty (); }
 
 private:
+	using Index = uint32_t;
+	using Bucket = std::vector<Index>;
+	using CellMap = std::unordered_map<uint64_t, Bucket>;
+
+	struct CellRange
+	{
+		int64_t left;
+		int64_t top;
+		int64_t right;
+		int64_t bottom;
+	};
+
+	static constexpr int64_t kMaxCellsPerRect = 256;
+
+	bool getCellRange (const CRect& r, CellRange& range) const;
+	static uint64_t cellKey (int64_t x, int64_t y);
+	template<typename Proc>
+	void forEachBucket (const CRect& r, Proc proc);
+	void collectCandidates (const CRect& r);
+	bool shouldJoin (const CRect& r1, const CRect& r2) const;
+	void insert (const CRect& r);
+	void indexInsert (Index index);
+	void indexRemove (Index index);
+	void indexRename (Index from, Index to);
+	void removeAt (Index index);
+	void replaceAt (Index index, const CRect& r);
+	void rebuildIndex ();
+
 	RectList list;
+	CellMap cells;
+	Bucket oversized;
+	Bucket candidates;
+	Policy policy;
 };
 
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::setPolicy (const Policy& newPolicy)
+{
+	policy = newPolicy;
+	rebuildIndex ();
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::clear ()
+{
+	list.clear ();
+	// keep the bucket storage alive, the same cells are usually used again in the next frame
+	for (auto& cell : cells)
+		cell.second.clear ();
+	oversized.clear ();
+}
+
 //-----------------------------------------------------------------------------
 inline bool CInvalidRectList::add (const CRect& r)
 {
-	for (auto it = list.begin (), end = list.end (); it != end; ++it)
+	CRect rect (r);
+	bool changed = false;
+	bool restart = true;
+	while (restart)
 	{
-		// the same rectangle is already in the list
-		if (*it == r)
-			return false;
-		// the new rectangle is part of one already in the list
-		if (it->rectInside (r))
-			return false;
-		// if the new rectangle contains one of the previous rectangles
-		if (r.rectInside (*it))
+		restart = false;
+		collectCandidates (rect);
+		for (auto index : candidates)
 		{
-			list.erase (it);
-			return add (r);
-		}
-		// now check if the combined rect has the same or less area as both rects together
-		auto area1 = r.getWidth () * r.getHeight ();
-		auto area2 = it->getWidth () * it->getHeight ();
-		CRect jr (*it);
-		jr.unite (r);
-		auto joinedArea = jr.getWidth () * jr.getHeight ();
-		if (joinedArea <= (area1 + area2))
-		{
-			list.erase (it);
-			return add (jr);
+			const auto& other = list[index];
+			// the new rectangle is the same or part of one already in the list
+			if (other.rectInside (rect))
+				return changed;
+			// if the new rectangle contains one of the previous rectangles
+			if (rect.rectInside (other))
+			{
+				removeAt (index);
+				changed = restart = true;
+				break;
+			}
+			if (shouldJoin (rect, other))
+			{
+				rect.unite (other);
+				removeAt (index);
+				changed = restart = true;
+				break;
+			}
 		}
 	}
-	list.emplace_back (r);
+	insert (rect);
 	return true;
 }
 
 //-----------------------------------------------------------------------------
-inline void joinNearbyInvalidRects (CInvalidRectList& list, CCoord maxDistance)
+inline void CInvalidRectList::joinNearby (CCoord maxDistance)
 {
-	for (auto it = list.begin (); it != list.end (); ++it)
+	auto isNear = [&] (const CRect& r1, const CRect& r2) {
+		if (r1.left == r2.left && r1.right == r2.right)
+		{
+			auto distance = (r1.bottom < r2.top) ? r2.top - r1.bottom : r1.top - r2.bottom;
+			if (distance <= maxDistance)
+				return true;
+		}
+		if (r1.top == r2.top && r1.bottom == r2.bottom)
+		{
+			auto distance = (r1.right < r2.left) ? r2.left - r1.right : r1.left - r2.right;
+			if (distance <= maxDistance)
+				return true;
+		}
+		return false;
+	};
+
+	bool changed = true;
+	while (changed)
 	{
-		for (auto it2 = list.begin (); it2 != list.end (); ++it2)
+		changed = false;
+		for (Index i = 0; i < list.size (); ++i)
 		{
-			if (it2 == it)
-				continue;
-			if (it->left == it2->left && it->right == it2->right)
+			bool restart = true;
+			while (restart)
 			{
-				CCoord distance;
-				if (it->bottom < it2->top)
-					distance = it2->top - it->bottom;
-				else
-					distance = it->top - it2->bottom;
-				if (distance <= maxDistance)
+				restart = false;
+				auto r = list[i];
+				collectCandidates (CRect (r).extend (maxDistance, maxDistance));
+				for (auto j : candidates)
 				{
-					it->unite (*it2);
-					list.erase (it2);
-					joinNearbyInvalidRects (list, maxDistance);
-					return;
+					if (j == i || !isNear (r, list[j]))
+						continue;
+					r.unite (list[j]);
+					removeAt (j);
+					if (i == list.size ())
+						i = j;
+					replaceAt (i, r);
+					changed = restart = true;
+					break;
 				}
 			}
-			if (it->top == it2->top && it->bottom == it2->bottom)
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+inline bool CInvalidRectList::shouldJoin (const CRect& r1, const CRect& r2) const
+{
+	if (!CRect (r1).extend (policy.joinDistance, policy.joinDistance).rectOverlap (r2))
+		return false;
+	// check if the combined rect has the same or less area as both rects together
+	auto area1 = r1.getWidth () * r1.getHeight ();
+	auto area2 = r2.getWidth () * r2.getHeight ();
+	CRect jr (r1);
+	jr.unite (r2);
+	auto joinedArea = jr.getWidth () * jr.getHeight ();
+	return joinedArea <= (area1 + area2) * policy.joinAreaFactor;
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::insert (const CRect& r)
+{
+	if (policy.maxRects > 0 && list.size () >= policy.maxRects)
+	{
+		CRect joined (r);
+		for (const auto& other : list)
+			joined.unite (other);
+		clear ();
+		list.emplace_back (joined);
+		indexInsert (0);
+		return;
+	}
+	list.emplace_back (r);
+	indexInsert (static_cast<Index> (list.size () - 1));
+}
+
+//-----------------------------------------------------------------------------
+inline bool CInvalidRectList::getCellRange (const CRect& r, CellRange& range) const
+{
+	if (policy.cellSize <= 0.)
+		return false;
+	auto toCell = [this] (CCoord c) -> double { return std::floor (c / policy.cellSize); };
+	auto left = toCell (std::min (r.left, r.right));
+	auto right = toCell (std::max (r.left, r.right));
+	auto top = toCell (std::min (r.top, r.bottom));
+	auto bottom = toCell (std::max (r.top, r.bottom));
+	if (!std::isfinite (left) || !std::isfinite (right) || !std::isfinite (top) ||
+		!std::isfinite (bottom))
+		return false;
+	if ((right - left + 1.) * (bottom - top + 1.) > static_cast<double> (kMaxCellsPerRect))
+		return false;
+	range.left = static_cast<int64_t> (left);
+	range.right = static_cast<int64_t> (right);
+	range.top = static_cast<int64_t> (top);
+	range.bottom = static_cast<int64_t> (bottom);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+inline uint64_t CInvalidRectList::cellKey (int64_t x, int64_t y)
+{
+	return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) |
+		   static_cast<uint64_t> (static_cast<uint32_t> (y));
+}
+
+//-----------------------------------------------------------------------------
+template<typename Proc>
+inline void CInvalidRectList::forEachBucket (const CRect& r, Proc proc)
+{
+	CellRange range;
+	if (!getCellRange (r, range))
+	{
+		proc (oversized);
+		return;
+	}
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		for (auto x = range.left; x <= range.right; ++x)
+			proc (cells[cellKey (x, y)]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::collectCandidates (const CRect& r)
+{
+	candidates.clear ();
+	auto addBucket = [this] (const Bucket& bucket) {
+		candidates.insert (candidates.end (), bucket.begin (), bucket.end ());
+	};
+	CellRange range;
+	if (getCellRange (CRect (r).extend (policy.joinDistance, policy.joinDistance), range))
+	{
+		for (auto y = range.top; y <= range.bottom; ++y)
+		{
+			for (auto x = range.left; x <= range.right; ++x)
 			{
-				CCoord distance;
-				if (it->right < it2->left)
-					distance = it2->left - it->right;
-				else
-					distance = it->left - it2->right;
-				if (distance <= maxDistance)
-				{
-					it->unite (*it2);
-					list.erase (it2);
-					joinNearbyInvalidRects (list, maxDistance);
-					return;
-				}
+				auto it = cells.find (cellKey (x, y));
+				if (it != cells.end ())
+					addBucket (it->second);
 			}
 		}
 	}
+	else
+	{
+		// the rect covers too many cells, so everything is a candidate
+		candidates.resize (list.size ());
+		for (Index i = 0; i < list.size (); ++i)
+			candidates[i] = i;
+		return;
+	}
+	addBucket (oversized);
+	// keep the list order and remove the duplicates of rects spanning multiple cells
+	std::sort (candidates.begin (), candidates.end ());
+	candidates.erase (std::unique (candidates.begin (), candidates.end ()), candidates.end ());
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::indexInsert (Index index)
+{
+	forEachBucket (list[index], [index] (Bucket& bucket) { bucket.emplace_back (index); });
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::indexRemove (Index index)
+{
+	forEachBucket (list[index], [index] (Bucket& bucket) {
+		auto it = std::find (bucket.begin (), bucket.end (), index);
+		if (it == bucket.end ())
+			return;
+		*it = bucket.back ();
+		bucket.pop_back ();
+	});
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::indexRename (Index from, Index to)
+{
+	forEachBucket (list[from], [from, to] (Bucket& bucket) {
+		std::replace (bucket.begin (), bucket.end (), from, to);
+	});
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::removeAt (Index index)
+{
+	indexRemove (index);
+	auto last = static_cast<Index> (list.size () - 1);
+	if (index != last)
+	{
+		indexRename (last, index);
+		list[index] = list[last];
+	}
+	list.pop_back ();
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::replaceAt (Index index, const CRect& r)
+{
+	indexRemove (index);
+	list[index] = r;
+	indexInsert (index);
+}
+
+//-----------------------------------------------------------------------------
+inline void CInvalidRectList::rebuildIndex ()
+{
+	cells.clear ();
+	oversized.clear ();
+	for (Index i = 0; i < list.size (); ++i)
+		indexInsert (i);
+}
+
+//-----------------------------------------------------------------------------
+inline void joinNearbyInvalidRects (CInvalidRectList& list, CCoord maxDistance)
+{
+	list.joinNearby (maxDistance);
 }
 
 //-----------------------------------------------------------------------------
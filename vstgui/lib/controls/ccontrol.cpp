@@ -174,6 +174,11 @@ void CControl::setTag (int32_t val)
 	tag = val;
 	if (listener)
 		listener->controlTagDidChange (this);
+	if (isAttached ())
+	{
+		if (auto frame = getFrame ())
+			frame->onControlTagChanged (this);
+	}
 }
 
 //------------------------------------------------------------------------
@@ -220,7 +225,11 @@ void CControl::endEdit ()
 }
 
 //------------------------------------------------------------------------
-void CControl::setValue (float val) { value = clamp (val, getMin (), getMax ()); }
+void CControl::setValue (float val)
+{
+	value = clamp (val, getMin (), getMax ());
+	postDirtyValue ();
+}
 
 //------------------------------------------------------------------------
 void CControl::setValueNormalized (float val)
@@ -228,6 +237,7 @@ void CControl::setValueNormalized (float val)
 	if (getRange () == 0.f)
 	{
 		value = getMin ();
+		postDirtyValue ();
 		return;
 	}
 	val = clampNorm (val);
@@ -274,6 +284,18 @@ void CControl::setDirty (bool val)
 		setOldValue (value);
 }
 
+//------------------------------------------------------------------------
+void CControl::postDirtyValue ()
+{
+	// the frame may only visit the registered dirty views in idle, see
+	// CFrame::setIdleVisitsOnlyDirtyViews
+	if (getOldValue () != value)
+	{
+		if (auto frame = getFrame ())
+			frame->onViewDirty (this);
+	}
+}
+
 //------------------------------------------------------------------------
 void CControl::bounceValue () { value = clamp (value, getMin (), getMax ()); }
 
@@ -125,6 +125,8 @@ protected:
 	float value;
 
 private:
+	void postDirtyValue ();
+
 	struct Impl;
 	std::unique_ptr<Impl> impl;
 };
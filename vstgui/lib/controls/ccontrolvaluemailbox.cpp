@@ -0,0 +1,67 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "ccontrolvaluemailbox.h"
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+CControlValueMailbox::CControlValueMailbox (uint32_t cap)
+{
+	capacity = 64;
+	while (capacity < cap && capacity < (1u << 20))
+		capacity *= 2;
+	slots = std::unique_ptr<Slot[]> (new Slot[capacity]);
+	pending = std::unique_ptr<PendingWord[]> (new PendingWord[capacity / 64]);
+	for (auto i = 0u; i < capacity / 64; ++i)
+		pending[i].store (0, std::memory_order_relaxed);
+}
+
+//-----------------------------------------------------------------------------
+CControlValueMailbox::~CControlValueMailbox () noexcept = default;
+
+//-----------------------------------------------------------------------------
+bool CControlValueMailbox::post (int32_t tag, float value)
+{
+	if (tag == kInvalidTag)
+		return false;
+	uint32_t bitPattern;
+	std::memcpy (&bitPattern, &value, sizeof (bitPattern));
+
+	// open addressing, a slot keeps its tag once it was claimed
+	auto index = (static_cast<uint32_t> (tag) * 2654435761u) & (capacity - 1);
+	for (auto probe = 0u; probe < capacity; ++probe, index = (index + 1) & (capacity - 1))
+	{
+		auto& slot = slots[index];
+		auto slotTag = slot.tag.load (std::memory_order_acquire);
+		if (slotTag == kInvalidTag)
+		{
+			if (!slot.tag.compare_exchange_strong (slotTag, tag, std::memory_order_acq_rel))
+			{
+				// another thread claimed the slot, slotTag now holds its tag
+				if (slotTag != tag)
+					continue;
+			}
+		}
+		else if (slotTag != tag)
+			continue;
+		slot.value.store (bitPattern, std::memory_order_release);
+		pending[index / 64].fetch_or (uint64_t (1) << (index % 64), std::memory_order_release);
+		return true;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+bool CControlValueMailbox::hasPendingValues () const
+{
+	for (auto i = 0u; i < capacity / 64; ++i)
+	{
+		if (pending[i].load (std::memory_order_relaxed))
+			return true;
+	}
+	return false;
+}
+
+} // VSTGUI
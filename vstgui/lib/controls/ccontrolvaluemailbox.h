@@ -0,0 +1,97 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../vstguibase.h"
+#include <atomic>
+#include <cstring>
+#include <limits>
+#include <memory>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+// CControlValueMailbox Declaration
+//! @brief passes control values from other threads to the UI thread
+//-----------------------------------------------------------------------------
+/** Any number of threads can post values for control tags without locking or allocating memory.
+ *	The UI thread drains the mailbox and only gets the latest value for every tag which was posted
+ *	since the last drain.
+ *
+ *	The mailbox has a fixed number of slots, every tag posted for the first time takes a slot which
+ *	is not released again. If all slots are taken, posting a new tag fails.
+ *
+ *	The mailbox of a frame is drained by the frame, see CFrame::getControlValueMailbox.
+ */
+class CControlValueMailbox : public AtomicReferenceCounted
+{
+public:
+	/** the capacity is rounded up to a power of two and at least 64 */
+	explicit CControlValueMailbox (uint32_t capacity = 1024);
+	~CControlValueMailbox () noexcept override;
+
+	/** post a value for a tag, can be called on any thread
+	 *
+	 *	@return false if the mailbox is full or the tag is invalid
+	 */
+	bool post (int32_t tag, float value);
+
+	/** call proc (tag, value) for every tag posted since the last drain, must only be called on
+	 *	one thread at a time
+	 *
+	 *	@return the number of drained tags
+	 */
+	template <typename Proc>
+	uint32_t drain (Proc&& proc);
+
+	/** true if values were posted since the last drain */
+	bool hasPendingValues () const;
+	uint32_t getCapacity () const { return capacity; }
+
+	static constexpr int32_t kInvalidTag = std::numeric_limits<int32_t>::min ();
+
+private:
+	struct Slot
+	{
+		std::atomic<int32_t> tag {kInvalidTag};
+		std::atomic<uint32_t> value {0};
+	};
+	using PendingWord = std::atomic<uint64_t>;
+
+	uint32_t capacity;
+	std::unique_ptr<Slot[]> slots;
+	/** one bit per slot, set when a value was posted to the slot */
+	std::unique_ptr<PendingWord[]> pending;
+};
+
+//-----------------------------------------------------------------------------
+template <typename Proc>
+inline uint32_t CControlValueMailbox::drain (Proc&& proc)
+{
+	uint32_t numDrained = 0;
+	for (auto wordIndex = 0u; wordIndex < capacity / 64; ++wordIndex)
+	{
+		auto& word = pending[wordIndex];
+		if (word.load (std::memory_order_relaxed) == 0)
+			continue;
+		auto bits = word.exchange (0, std::memory_order_acquire);
+		while (bits)
+		{
+			uint32_t bit = 0;
+			while ((bits & (uint64_t (1) << bit)) == 0)
+				++bit;
+			bits &= ~(uint64_t (1) << bit);
+			auto& slot = slots[wordIndex * 64 + bit];
+			auto bitPattern = slot.value.load (std::memory_order_acquire);
+			float value;
+			std::memcpy (&value, &bitPattern, sizeof (value));
+			proc (slot.tag.load (std::memory_order_relaxed), value);
+			++numDrained;
+		}
+	}
+	return numDrained;
+}
+
+} // VSTGUI
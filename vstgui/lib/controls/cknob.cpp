@@ -7,8 +7,10 @@
 #include "../cdrawcontext.h"
 #include "../cframe.h"
 #include "../cgraphicspath.h"
+#include "../cgraphicspathcache.h"
 #include "../cvstguitimer.h"
 #include "../events.h"
+#include <algorithm>
 #include <cmath>
 
 namespace VSTGUI {
@@ -516,12 +518,19 @@ void CKnob::addArc (CGraphicsPath* path, const CRect& r, double startAngle, doub
 	path->addArc (r, startAngle / Constants::pi * 180, endAngle / Constants::pi * 180, sweepAngle >= 0);
 }
 
+//------------------------------------------------------------------------
+CGraphicsPath* CKnob::getArcPath (CDrawContext* pContext, const CRect& r, double startAngle,
+								  double sweepAngle) const
+{
+	auto key = CGraphicsPathCache::KeyBuilder ().add (r).add (startAngle).add (sweepAngle).get ();
+	return pathCache.get (pContext, key, [&] (CGraphicsPath& path) {
+		addArc (&path, r, startAngle, sweepAngle);
+	});
+}
+
 //------------------------------------------------------------------------
 void CKnob::drawCoronaOutline (CDrawContext* pContext) const
 {
-	auto path = owned (pContext->createGraphicsPath ());
-	if (path == nullptr)
-		return;
 	CRect corona (getViewSize ());
 	corona.inset (coronaInset, coronaInset);
 	auto start = startAngle;
@@ -532,7 +541,9 @@ void CKnob::drawCoronaOutline (CDrawContext* pContext) const
 		start -= a;
 		range += a * 2.f;
 	}
-	addArc (path, corona, start, range);
+	auto path = getArcPath (pContext, corona, start, range);
+	if (path == nullptr)
+		return;
 	pContext->setFrameColor (colorShadowHandle);
 	CLineStyle lineStyle (kLineSolid);
 	if (!(drawStyle & kCoronaLineCapButt))
@@ -546,23 +557,29 @@ void CKnob::drawCoronaOutline (CDrawContext* pContext) const
 //------------------------------------------------------------------------
 void CKnob::drawCorona (CDrawContext* pContext) const
 {
-	auto path = owned (pContext->createGraphicsPath ());
-	if (path == nullptr)
-		return;
-	float coronaValue = getValueNormalized ();
+	double coronaValue = getValueNormalized ();
 	if (drawStyle & kCoronaInverted)
-		coronaValue = 1.f - coronaValue;
+		coronaValue = 1. - coronaValue;
 	CRect corona (getViewSize ());
 	corona.inset (coronaInset, coronaInset);
+	// quantize the value to a quarter of a pixel on the arc, so that value changes which are not
+	// visible reuse the cached path
+	auto radius = std::max (corona.getWidth (), corona.getHeight ()) / 2.;
+	auto numSteps = std::ceil (radius * std::abs (rangeAngle) * pContext->getScaleFactor () * 4.);
+	coronaValue = CGraphicsPathCache::quantize (
+		coronaValue, static_cast<uint32_t> (std::min (std::max (numSteps, 1.), 65536.)));
+	CGraphicsPath* path = nullptr;
 	if (drawStyle & kCoronaFromCenter)
-		addArc (path, corona, 1.5 * Constants::pi, rangeAngle * (coronaValue - 0.5));
+		path = getArcPath (pContext, corona, 1.5 * Constants::pi, rangeAngle * (coronaValue - 0.5));
 	else
 	{
 		if (drawStyle & kCoronaInverted)
-			addArc (path, corona, startAngle + rangeAngle, -rangeAngle * coronaValue);
+			path = getArcPath (pContext, corona, startAngle + rangeAngle, -rangeAngle * coronaValue);
 		else
-			addArc (path, corona, startAngle, rangeAngle * coronaValue);
+			path = getArcPath (pContext, corona, startAngle, rangeAngle * coronaValue);
 	}
+	if (path == nullptr)
+		return;
 	pContext->setFrameColor (coronaColor);
 	if (!(drawStyle & kCoronaLineCapButt))
 	{
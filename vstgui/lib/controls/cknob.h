@@ -7,6 +7,7 @@
 #include "ccontrol.h"
 #include "../cbitmap.h"
 #include "../ccolor.h"
+#include "../cgraphicspathcache.h"
 #include "../clinestyle.h"
 
 namespace VSTGUI {
@@ -140,6 +141,9 @@ protected:
 	virtual void drawHandleAsLine (CDrawContext* pContext) const;
 
 	static void addArc (CGraphicsPath* path, const CRect& r, double startAngle, double sweepAngle);
+	/** the arc path from the path cache */
+	CGraphicsPath* getArcPath (CDrawContext* pContext, const CRect& r, double startAngle,
+							   double sweepAngle) const;
 
 	CPoint offset;
 	
@@ -151,6 +155,7 @@ protected:
 
 	CLineStyle coronaLineStyle;
 	CBitmap* pHandle;
+	mutable CGraphicsPathCache pathCache {8};
 };
 
 //-----------------------------------------------------------------------------
@@ -9,6 +9,8 @@
 #include "../cscrollview.h"
 #include "../events.h"
 #include "clistcontrol.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 
 //------------------------------------------------------------------------
@@ -17,13 +19,103 @@ namespace VSTGUI {
 //------------------------------------------------------------------------
 struct CListControl::Impl
 {
+	/** number of rows fetched at once from a block configurator */
+	static constexpr size_t kBlockSize = 256;
+
 	SharedPointer<IListControlDrawer> drawer;
 	SharedPointer<IListControlConfigurator> configurator;
+	IListControlBlockConfigurator* blockConfigurator {nullptr};
 
 	std::vector<CListControlRowDesc> rowDescriptions;
+	/** the top of every row relative to the control followed by the height of all rows, empty if
+	 *	all rows have the same height */
+	std::vector<CCoord> rowOffsets;
+	/** the blocks of the row descriptions already fetched, only used if all rows have the same
+	 *	height */
+	std::vector<bool> fetchedBlocks;
+	CCoord uniformRowHeight {0.};
+	bool uniformRows {false};
+	size_t numRows {0};
 	Optional<int32_t> hoveredRow {};
 	bool doHoverCheck {false};
 	CCoord minHeight {0.};
+
+	void fetchRows (size_t first, size_t count)
+	{
+		if (count == 0)
+			return;
+		if (blockConfigurator)
+		{
+			blockConfigurator->getRowDescs (static_cast<int32_t> (first),
+											static_cast<int32_t> (count),
+											rowDescriptions.data () + first);
+			return;
+		}
+		if (!configurator)
+			return;
+		for (auto row = first; row < first + count; ++row)
+			rowDescriptions[row] = configurator->getRowDesc (static_cast<int32_t> (row));
+	}
+
+	const CListControlRowDesc& getRowDesc (size_t index)
+	{
+		if (uniformRows)
+		{
+			auto block = index / kBlockSize;
+			if (!fetchedBlocks[block])
+			{
+				auto first = block * kBlockSize;
+				fetchRows (first, std::min (kBlockSize, numRows - first));
+				fetchedBlocks[block] = true;
+			}
+		}
+		return rowDescriptions[index];
+	}
+
+	CCoord getRowTop (size_t index) const
+	{
+		return uniformRows ? index * uniformRowHeight : rowOffsets[index];
+	}
+
+	CCoord getRowHeight (size_t index) const
+	{
+		return uniformRows ? uniformRowHeight : rowOffsets[index + 1] - rowOffsets[index];
+	}
+
+	CCoord getTotalHeight () const { return getRowTop (numRows); }
+
+	/** the index of the first row with its bottom below y, numRows if there is none */
+	size_t findRow (CCoord y) const
+	{
+		if (!uniformRows)
+		{
+			return static_cast<size_t> (
+				std::upper_bound (rowOffsets.begin () + 1, rowOffsets.end (), y) -
+				(rowOffsets.begin () + 1));
+		}
+		if (y < 0.)
+			return 0;
+		if (uniformRowHeight <= 0.)
+			return numRows;
+		return std::min (static_cast<size_t> (std::floor (y / uniformRowHeight)), numRows);
+	}
+
+	/** the index of the first row with its bottom not above y, numRows if there is none */
+	size_t findFirstRowReaching (CCoord y) const
+	{
+		if (!uniformRows)
+		{
+			return static_cast<size_t> (
+				std::lower_bound (rowOffsets.begin () + 1, rowOffsets.end (), y) -
+				(rowOffsets.begin () + 1));
+		}
+		if (y <= 0.)
+			return 0;
+		if (uniformRowHeight <= 0.)
+			return numRows;
+		auto index = std::ceil (y / uniformRowHeight) - 1.;
+		return std::min (static_cast<size_t> (std::max (index, 0.)), numRows);
+	}
 };
 
 //------------------------------------------------------------------------
@@ -85,20 +177,44 @@ int32_t CListControl::getIntValue () const
 //------------------------------------------------------------------------
 void CListControl::recalculateLayout ()
 {
+	impl->blockConfigurator =
+		dynamic_cast<IListControlBlockConfigurator*> (impl->configurator.get ());
 	if (!impl->configurator)
 		return;
 
-	CCoord height = 0.;
-	auto numRows = getNumRows ();
-	impl->rowDescriptions.resize (static_cast<size_t> (numRows));
-	impl->doHoverCheck = false;
-
-	for (auto row = 0; row < numRows; ++row)
+	auto uniformRowHeight =
+		impl->blockConfigurator ? impl->blockConfigurator->getUniformRowHeight () : Optional<CCoord> ();
+	auto numRows = static_cast<size_t> (getNumRows ());
+	impl->numRows = numRows;
+	impl->rowDescriptions.clear ();
+	impl->rowDescriptions.resize (numRows);
+	impl->rowOffsets.clear ();
+	impl->fetchedBlocks.clear ();
+	impl->uniformRows = uniformRowHeight ? true : false;
+
+	if (impl->uniformRows)
+	{
+		// the rows are fetched when they are needed, so their flags are not known yet
+		impl->uniformRowHeight = *uniformRowHeight;
+		impl->fetchedBlocks.resize ((numRows + Impl::kBlockSize - 1) / Impl::kBlockSize, false);
+		impl->doHoverCheck = true;
+	}
+	else
 	{
-		impl->rowDescriptions[row] = impl->configurator->getRowDesc (row);
-		height += impl->rowDescriptions[row].height;
-		impl->doHoverCheck |= (impl->rowDescriptions[row].flags & CListControlRowDesc::Hoverable) != 0;
+		impl->fetchRows (0, numRows);
+		impl->rowOffsets.resize (numRows + 1);
+		impl->doHoverCheck = false;
+		CCoord offset = 0.;
+		for (auto row = 0u; row < numRows; ++row)
+		{
+			impl->rowOffsets[row] = offset;
+			offset += impl->rowDescriptions[row].height;
+			impl->doHoverCheck |=
+				(impl->rowDescriptions[row].flags & CListControlRowDesc::Hoverable) != 0;
+		}
+		impl->rowOffsets[numRows] = offset;
 	}
+	auto height = impl->getTotalHeight ();
 
 	if (impl->minHeight > 0 && height < impl->minHeight)
 		height = impl->minHeight;
@@ -117,16 +233,13 @@ Optional<CRect> CListControl::getRowRect (int32_t row) const
 {
 	if (row < getMinRowIndex () || row > getMaxRowIndex ())
 		return {};
-	row -= getMinRowIndex ();
+	auto index = getNormalizedRowIndex (row);
+	if (index >= impl->numRows)
+		return {};
 	CRect rowSize;
 	rowSize.setWidth (getWidth ());
-	for (auto i = 0u; i < impl->rowDescriptions.size (); ++i)
-	{
-		rowSize.setHeight (impl->rowDescriptions[i].height);
-		if (i == row)
-			break;
-		rowSize.offset (0, impl->rowDescriptions[i].height);
-	}
+	rowSize.setHeight (impl->getRowHeight (index));
+	rowSize.offset (0, impl->getRowTop (index));
 	rowSize.offset (getViewSize ().getTopLeft ());
 	return makeOptional (rowSize);
 }
@@ -143,13 +256,9 @@ Optional<int32_t> CListControl::getRowAtPoint (CPoint where) const
 {
 	where.offsetInverse (getViewSize ().getTopLeft ());
 
-	auto numRows = getNumRows ();
-	for (auto row = 0; row < numRows; ++row)
-	{
-		if (where.y < impl->rowDescriptions[row].height)
-			return {row + getMinRowIndex ()};
-		where.y -= impl->rowDescriptions[row].height;
-	}
+	auto index = impl->findRow (where.y);
+	if (index < impl->numRows)
+		return {static_cast<int32_t> (index) + getMinRowIndex ()};
 	return {};
 }
 
@@ -176,19 +285,25 @@ void CListControl::drawRect (CDrawContext* context, const CRect& updateRect)
 	if (!getTransparency ())
 		impl->drawer->drawBackground (context, getViewSize ());
 
-	CRect rowSize;
-	rowSize.setTopLeft (getViewSize ().getTopLeft ());
-	rowSize.setWidth (getWidth ());
-	rowSize.setHeight (0);
-	auto numRows = getNumRows ();
+	// only the rows from the first one reaching the top of the update rect are visited
+	auto top = getViewSize ().top;
+	auto numRows = static_cast<int32_t> (impl->numRows);
 	auto selectedRow = static_cast<int32_t> (getNormalizedRowIndex (getIntValue ()));
-	for (auto row = 0; row < numRows; ++row)
+	auto firstRow = static_cast<int32_t> (impl->findFirstRowReaching (updateRect.top - top));
+	for (auto row = firstRow; row < numRows; ++row)
 	{
-		rowSize.setHeight (impl->rowDescriptions[row].height);
+		CRect rowSize;
+		rowSize.setTopLeft (getViewSize ().getTopLeft ());
+		rowSize.setWidth (getWidth ());
+		rowSize.setHeight (impl->getRowHeight (row));
+		rowSize.offset (0, impl->getRowTop (row));
+		if (rowSize.top > updateRect.bottom)
+			break;
 		if (updateRect.rectOverlap (rowSize))
 		{
+			const auto& rowDesc = impl->getRowDesc (row);
 			int32_t flags = selectedRow == row ? IListControlDrawer::Row::Selected : 0;
-			if (impl->rowDescriptions[row].flags & CListControlRowDesc::Selectable)
+			if (rowDesc.flags & CListControlRowDesc::Selectable)
 				flags |= IListControlDrawer::Row::Selectable;
 			if (impl->hoveredRow && *impl->hoveredRow == row + getMinRowIndex ())
 				flags |= IListControlDrawer::Row::Hovered;
@@ -196,7 +311,6 @@ void CListControl::drawRect (CDrawContext* context, const CRect& updateRect)
 				flags |= IListControlDrawer::Row::LastRow;
 			impl->drawer->drawRow (context, rowSize, {row + getMinRowIndex (), flags});
 		}
-		rowSize.offset (0, impl->rowDescriptions[row].height);
 	}
 }
 
@@ -305,8 +419,7 @@ CMouseEventResult CListControl::onMouseMoved (CPoint& where, const CButtonState&
 		auto row = getRowAtPoint (where);
 		if (row)
 		{
-			if (impl->rowDescriptions[getNormalizedRowIndex (*row)].flags &
-			    CListControlRowDesc::Hoverable)
+			if (getRowDesc (*row).flags & CListControlRowDesc::Hoverable)
 			{
 				if (!impl->hoveredRow || *impl->hoveredRow != *row)
 				{
@@ -327,7 +440,7 @@ CMouseEventResult CListControl::onMouseMoved (CPoint& where, const CButtonState&
 //------------------------------------------------------------------------
 CMouseEventResult CListControl::onMouseUp (CPoint& where, const CButtonState& buttons)
 {
-	if (impl->rowDescriptions.empty () || !buttons.isLeftButton ())
+	if (impl->numRows == 0 || !buttons.isLeftButton ())
 		return kMouseEventHandled;
 
 	auto row = getRowAtPoint (where);
@@ -388,8 +501,13 @@ int32_t CListControl::getNextSelectableRow (int32_t r, int32_t direction) const
 //------------------------------------------------------------------------
 bool CListControl::rowSelectable (int32_t row) const
 {
-	return (impl->rowDescriptions[getNormalizedRowIndex (row)].flags &
-	        CListControlRowDesc::Selectable) != 0;
+	return (getRowDesc (row).flags & CListControlRowDesc::Selectable) != 0;
+}
+
+//------------------------------------------------------------------------
+const CListControlRowDesc& CListControl::getRowDesc (int32_t row) const
+{
+	return impl->getRowDesc (getNormalizedRowIndex (row));
 }
 
 //------------------------------------------------------------------------
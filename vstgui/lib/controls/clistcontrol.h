@@ -6,6 +6,7 @@
 
 #include "../optional.h"
 #include "ccontrol.h"
+#include <algorithm>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -20,6 +21,11 @@ namespace VSTGUI {
  *	handled via the IListControlConfigurator instance. Every row can have different heights and
  *	flags.
  *
+ *	The control keeps the offsets of the rows, so that finding the row at a point or the rect of a
+ *	row does not depend on the number of rows, and only draws the rows inside the update rect. For
+ *	lists with many rows the configurator can implement IListControlBlockConfigurator to deliver
+ *	the row descriptions block by block when they are needed.
+ *
  *	@ingroup new_in_4_9
  */
 //------------------------------------------------------------------------
@@ -67,6 +73,7 @@ private:
 	int32_t getMinRowIndex () const;
 	int32_t getMaxRowIndex () const;
 	size_t getNormalizedRowIndex (int32_t row) const;
+	const CListControlRowDesc& getRowDesc (int32_t row) const;
 	bool rowSelectable (int32_t row) const;
 	void clearHoveredRow ();
 
@@ -156,6 +163,30 @@ public:
 	virtual CListControlRowDesc getRowDesc (int32_t row) const = 0;
 };
 
+//------------------------------------------------------------------------
+/** An optional extension of the list control configurator for lists with many rows
+ *
+ *	If the configurator of a list control also implements this interface, the list control fetches
+ *	the row descriptions in blocks instead of row by row. If all rows have the same height, the
+ *	descriptions are only fetched for the blocks of the rows the control actually needs, for
+ *	example when it draws them.
+ *
+ *	@ingroup new_in_4_14
+ */
+//------------------------------------------------------------------------
+class IListControlBlockConfigurator : virtual public IReference
+{
+public:
+	virtual ~IListControlBlockConfigurator () noexcept {}
+
+	/** fill descs with the descriptions of the numRows rows starting at firstRow */
+	virtual void getRowDescs (int32_t firstRow, int32_t numRows,
+							  CListControlRowDesc* descs) const = 0;
+	/** the height of all rows, if the rows have different heights return an empty optional. The
+	 *	height in the row descriptions is ignored when this returns a height. */
+	virtual Optional<CCoord> getUniformRowHeight () const = 0;
+};
+
 //------------------------------------------------------------------------
 /** A list control configurator implementation.
  *
@@ -187,5 +218,31 @@ private:
 	int32_t flags;
 };
 
+//------------------------------------------------------------------------
+/** A list control configurator implementation for lists with many rows.
+ *
+ *	Returns the same row description for all row indices and lets the list control fetch the
+ *	descriptions only for the rows it needs
+ *
+ *	@ingroup new_in_4_14
+ */
+//------------------------------------------------------------------------
+class UniformListControlConfigurator final : public StaticListControlConfigurator,
+                                             public IListControlBlockConfigurator
+{
+public:
+	using StaticListControlConfigurator::StaticListControlConfigurator;
+
+	void getRowDescs (int32_t firstRow, int32_t numRows,
+					  CListControlRowDesc* descs) const override
+	{
+		std::fill_n (descs, numRows, CListControlRowDesc {getRowHeight (), getFlags ()});
+	}
+	Optional<CCoord> getUniformRowHeight () const override
+	{
+		return makeOptional (getRowHeight ());
+	}
+};
+
 //------------------------------------------------------------------------
 } // VSTGUI
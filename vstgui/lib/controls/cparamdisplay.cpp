@@ -8,6 +8,7 @@
 #include "../cstring.h"
 #include "../cgraphicspath.h"
 #include "../cdrawcontext.h"
+#include "../cglyphatlas.h"
 #include <string>
 
 namespace VSTGUI {
@@ -58,6 +59,7 @@ CParamDisplay::CParamDisplay (const CParamDisplay& v)
 , roundRectRadius (v.roundRectRadius)
 , frameWidth (v.frameWidth)
 , textRotation (v.textRotation)
+, fastTextRendering (v.fastTextRendering)
 {
 	fontID->remember ();
 }
@@ -338,6 +340,9 @@ void CParamDisplay::drawPlatformText (CDrawContext* pContext, const UTF8String&
 		textRect.inset (textInset.x, textInset.y);
 
 		drawClipped (pContext, textRect, [&] () {
+			if (fastTextRendering && drawGlyphAtlasText (pContext, string, textRect))
+				return;
+
 			CPoint center (textRect.getCenter ());
 			CGraphicsTransform transform;
 			transform.rotate (textRotation, center);
@@ -363,6 +368,43 @@ void CParamDisplay::drawPlatformText (CDrawContext* pContext, const UTF8String&
 	}
 }
 
+//------------------------------------------------------------------------
+bool CParamDisplay::drawGlyphAtlasText (CDrawContext* pContext, const UTF8String& string,
+										const CRect& textRect)
+{
+	if (textRotation != 0. || !CGlyphAtlas::isSupported (string))
+		return false;
+	// the glyphs are only copied pixel exact when the context is not rotated or skewed
+	auto matrix = pContext->getCurrentTransform ();
+	if (matrix.m12 != 0. || matrix.m21 != 0. || matrix.m11 != matrix.m22 || matrix.m11 <= 0.)
+		return false;
+	auto scaleFactor = pContext->getScaleFactor () * matrix.m11;
+	auto antialias = hasBit (style, kAntialias);
+	auto atlas = CGlyphAtlas::get (fontID, fontColor, scaleFactor, antialias);
+	if (!atlas)
+		return false;
+	if (hasBit (style, kShadowText))
+	{
+		auto shadowAtlas = CGlyphAtlas::get (fontID, shadowColor, scaleFactor, antialias);
+		if (!shadowAtlas)
+			return false;
+		CRect shadowRect (textRect);
+		shadowRect.offset (shadowTextOffset);
+		shadowAtlas->drawString (pContext, string, shadowRect, horiTxtAlign);
+	}
+	return atlas->drawString (pContext, string, textRect, horiTxtAlign);
+}
+
+//------------------------------------------------------------------------
+void CParamDisplay::setFastTextRendering (bool state)
+{
+	if (fastTextRendering != state)
+	{
+		fastTextRendering = state;
+		drawStyleChanged ();
+	}
+}
+
 //------------------------------------------------------------------------
 void CParamDisplay::setFont (CFontRef inFontID)
 {
@@ -80,6 +80,11 @@ public:
 	virtual void setFrameWidth (const CCoord& width);
 	CCoord getFrameWidth () const { return frameWidth; }
 
+	/** draw short ASCII strings with a shared glyph atlas instead of the text layout engine of the
+	 *	platform, other strings and rotated text are drawn as before. See CGlyphAtlas */
+	void setFastTextRendering (bool state);
+	bool getFastTextRendering () const { return fastTextRendering; }
+
 	using ValueToStringUserData = CParamDisplay;
 	using ValueToStringFunction = std::function<bool (float value, char utf8String[256], CParamDisplay* display)>;
 	
@@ -128,6 +133,9 @@ protected:
 
 	virtual void drawStyleChanged ();
 
+	bool drawGlyphAtlasText (CDrawContext* pContext, const UTF8String& string,
+							 const CRect& textRect);
+
 	ValueToStringFunction2 valueToStringFunction;
 
 	enum StylePrivate {
@@ -149,6 +157,7 @@ protected:
 	CCoord		roundRectRadius;
 	CCoord		frameWidth;
 	double		textRotation;
+	bool		fastTextRendering {false};
 };
 
 } // VSTGUI
@@ -35,8 +35,16 @@ public:
 
 	void setAutoDragScroll (bool state) { autoDragScroll = state; }
 
+	/** apply the scroll offset as transform, the cost of a scroll step does not depend on the
+	 *	number of child views this way */
+	void setTransformScrolling (bool state);
+	bool getTransformScrolling () const { return transformScrolling; }
+
 	bool attached (CView* parent) override;
 	CMessageResult notify (CBaseObject* sender, IdStringPtr message) override;
+	CRect getVisibleSize (const CRect& rect) const override;
+	CPoint& frameToLocal (CPoint& point) const override;
+	CPoint& localToFrame (CPoint& point) const override;
 
 	SharedPointer<IDropTarget> getDropTarget () override;
 	void onDragMove (CPoint where);
@@ -74,11 +82,14 @@ protected:
 	};
 
 	bool getScrollValue (const CPoint& where, float& x, float& y);
+	void moveContent (CPoint distance);
+	bool hasBitmapCachingAncestor () const;
 
 	CRect containerSize;
 	CPoint offset;
 	bool autoDragScroll;
 	bool inScrolling;
+	bool transformScrolling {false};
 };
 
 //-----------------------------------------------------------------------------
@@ -101,6 +112,7 @@ CScrollContainer::CScrollContainer (const CScrollContainer& v)
 , offset (v.offset)
 , autoDragScroll (v.autoDragScroll)
 , inScrolling (false)
+, transformScrolling (v.transformScrolling)
 {
 }
 
@@ -136,21 +148,11 @@ void CScrollContainer::setScrollOffset (CPoint newOffset, bool redraw)
 	if (diff.x == 0 && diff.y == 0)
 		return;
 	offset = newOffset;
-	inScrolling = true;
-	for (const auto& pV : getChildren ())
-	{
-		CRect r = pV->getViewSize ();
-		CRect mr = pV->getMouseableArea ();
-		r.offset (diff.x , diff.y);
-		pV->setViewSize (r, false);
-		mr.offset (diff.x , diff.y);
-		pV->setMouseableArea (mr);
-	}
-	inScrolling = false;
+	moveContent (diff);
 	if (!isAttached ())
 		return;
 
-	if (getTransparency ())
+	if (getTransparency () || hasBitmapCachingAncestor ())
 	{
 		invalid ();
 	}
@@ -177,6 +179,96 @@ void CScrollContainer::setScrollOffset (CPoint newOffset, bool redraw)
 	}
 }
 
+//-----------------------------------------------------------------------------
+/** the platform blit of CFrame::scrollRect does not reach the bitmap of a caching container, so
+ *	inside of one the content is invalidated instead of scrolled */
+bool CScrollContainer::hasBitmapCachingAncestor () const
+{
+	for (auto parent = getParentView (); parent; parent = parent->getParentView ())
+	{
+		if (auto container = parent->asViewContainer ())
+		{
+			if (container->getCacheAsBitmap ())
+				return true;
+		}
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+void CScrollContainer::moveContent (CPoint distance)
+{
+	if (transformScrolling)
+	{
+		// the content is translated by the scroll offset relative to the unscrolled content
+		setTransform (CGraphicsTransform ().translate (offset.x, -offset.y));
+		return;
+	}
+	inScrolling = true;
+	for (const auto& pV : getChildren ())
+	{
+		CRect r = pV->getViewSize ();
+		CRect mr = pV->getMouseableArea ();
+		r.offset (distance.x , distance.y);
+		pV->setViewSize (r, false);
+		mr.offset (distance.x , distance.y);
+		pV->setMouseableArea (mr);
+	}
+	inScrolling = false;
+	// the size change notifications of the children are not forwarded while scrolling
+	invalidateSpatialIndex ();
+	invalidateBitmapCache ();
+}
+
+//-----------------------------------------------------------------------------
+void CScrollContainer::setTransformScrolling (bool state)
+{
+	if (state == transformScrolling)
+		return;
+	// move the content back to the unscrolled position and apply the offset the other way
+	CPoint unscrolled (-offset.x, offset.y);
+	if (transformScrolling)
+		setTransform (CGraphicsTransform ());
+	else
+		moveContent (unscrolled);
+	transformScrolling = state;
+	moveContent (CPoint (-unscrolled.x, -unscrolled.y));
+	invalid ();
+}
+
+//-----------------------------------------------------------------------------
+CRect CScrollContainer::getVisibleSize (const CRect& rect) const
+{
+	if (!transformScrolling)
+		return CViewContainer::getVisibleSize (rect);
+	CRect result (rect);
+	getTransform ().transform (result);
+	result.offset (getViewSize ().left, getViewSize ().top);
+	result.bound (getViewSize ());
+	if (auto parent = getParentView ())
+		result = static_cast<CViewContainer*> (parent)->getVisibleSize (result);
+	result.offset (-getViewSize ().left, -getViewSize ().top);
+	getTransform ().inverse ().transform (result);
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+CPoint& CScrollContainer::frameToLocal (CPoint& point) const
+{
+	CViewContainer::frameToLocal (point);
+	if (transformScrolling)
+		getTransform ().inverse ().transform (point);
+	return point;
+}
+
+//-----------------------------------------------------------------------------
+CPoint& CScrollContainer::localToFrame (CPoint& point) const
+{
+	if (transformScrolling)
+		getTransform ().transform (point);
+	return CViewContainer::localToFrame (point);
+}
+
 //-----------------------------------------------------------------------------
 bool CScrollContainer::isDirty () const
 {
@@ -275,6 +367,12 @@ bool CScrollContainer::attached (CView* parent)
 //-----------------------------------------------------------------------------
 CMessageResult CScrollContainer::notify (CBaseObject* sender, IdStringPtr message)
 {
+	if ((message == kMsgViewSizeChanged || message == kMsgViewMouseableAreaChanged) &&
+		!inScrolling)
+	{
+		// keeps the spatial index and the bitmap cache of this container up to date
+		CViewContainer::notify (sender, message);
+	}
 	if (message == kMsgViewSizeChanged && !inScrolling)
 	{
 		uint32_t numSubViews = getNbViews ();
@@ -478,6 +576,7 @@ void CScrollView::recalculateSubViews ()
 		sc->setMouseableArea (scsize);
 	}
 	sc->setAutoDragScroll ((style & kAutoDragScrolling) ? true : false);
+	sc->setTransformScrolling ((style & kTransformScrolling) ? true : false);
 	recalculateSubViewsRecursionGard = false;
 }
 
@@ -30,7 +30,11 @@ protected:
 		kFollowFocusViewFlag,
 		kAutoHideScrollbarsFlag,
 
-		kLastScrollViewStyleFlag
+		kLastScrollViewStyleFlag,
+
+		// subclasses like CDataBrowser define their flags from kLastScrollViewStyleFlag on, newer
+		// flags use bits above them to keep the style values of the subclasses
+		kTransformScrollingFlag = 16
 	};
 
 public:
@@ -53,7 +57,10 @@ public:
 		/** scroll to focus view when focus view changes */
 		kFollowFocusView = 1 << kFollowFocusViewFlag,
 		/** automatically hides the scrollbar if the container size is smaller than the size of the scrollview */
-		kAutoHideScrollbars = 1 << kAutoHideScrollbarsFlag
+		kAutoHideScrollbars = 1 << kAutoHideScrollbarsFlag,
+		/** scroll by translating the container instead of moving every child view. Views with
+		 *	a platform counterpart (text edits, external views) do not follow the translation */
+		kTransformScrolling = 1 << kTransformScrollingFlag
 	};
 
 	//-----------------------------------------------------------------------------
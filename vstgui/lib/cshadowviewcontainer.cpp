@@ -7,7 +7,10 @@
 #include "cbitmapfilter.h"
 #include "cframe.h"
 #include "cbitmap.h"
+#include "platform/iplatformbitmap.h"
 #include <cassert>
+#include <cstring>
+#include <algorithm>
 #include <array>
 
 namespace VSTGUI {
@@ -19,6 +22,11 @@ CShadowViewContainer::CShadowViewContainer (const CRect& size)
 , shadowIntensity (0.3f)
 , shadowBlurSize (4)
 , scaleFactorUsed (0.)
+, shapeHash (0)
+, layoutHash (0)
+, shadowDownsampling (1)
+, shadowState (ShadowState::kInvalid)
+, shadowFollowsContent (false)
 {
 	registerViewContainerListener (this);
 }
@@ -30,6 +38,11 @@ CShadowViewContainer::CShadowViewContainer (const CShadowViewContainer& copy)
 , shadowIntensity (copy.shadowIntensity)
 , shadowBlurSize (copy.shadowBlurSize)
 , scaleFactorUsed (0.)
+, shapeHash (0)
+, layoutHash (0)
+, shadowDownsampling (copy.shadowDownsampling)
+, shadowState (ShadowState::kInvalid)
+, shadowFollowsContent (copy.shadowFollowsContent)
 {
 	registerViewContainerListener (this);
 }
@@ -100,18 +113,60 @@ void CShadowViewContainer::setShadowBlurSize (double size)
 	}
 }
 
+//-----------------------------------------------------------------------------
+void CShadowViewContainer::setShadowDownsampling (uint32_t factor)
+{
+	factor = std::max (1u, std::min (factor, 8u));
+	if (shadowDownsampling != factor)
+	{
+		shadowDownsampling = factor;
+		invalidateShadow ();
+	}
+}
+
+//-----------------------------------------------------------------------------
+void CShadowViewContainer::setShadowFollowsContent (bool state)
+{
+	if (shadowFollowsContent != state)
+	{
+		shadowFollowsContent = state;
+		if (state)
+			invalidateShadowShape ();
+	}
+}
+
 //-----------------------------------------------------------------------------
 void CShadowViewContainer::invalidateShadow ()
 {
-	scaleFactorUsed = 0.;
+	shadowState = ShadowState::kInvalid;
+	invalid ();
+}
+
+//-----------------------------------------------------------------------------
+void CShadowViewContainer::invalidateShadowShape ()
+{
+	if (shadowState == ShadowState::kValid)
+		shadowState = ShadowState::kCheckShape;
 	invalid ();
 }
 
+//-----------------------------------------------------------------------------
+void CShadowViewContainer::invalidRect (const CRect& rect)
+{
+	// the sub views invalidate their area via this method, while invalid () of the container
+	// invalidates the parent directly. Rendering the sub views to check their shape is too
+	// expensive to do for every content change, so only a changed layout is followed.
+	if (shadowFollowsContent && shadowState == ShadowState::kValid &&
+		calcSubViewLayoutHash () != layoutHash)
+		invalidateShadowShape ();
+	CViewContainer::invalidRect (rect);
+}
+
 //-----------------------------------------------------------------------------
 CMessageResult CShadowViewContainer::notify (CBaseObject* sender, IdStringPtr message)
 {
 	if (message == kMsgViewSizeChanged)
-		invalidateShadow ();
+		invalidateShadowShape ();
 	return CViewContainer::notify(sender, message);
 }
 
@@ -138,6 +193,80 @@ static bool isUniformScaled (const CGraphicsTransform& matrix)
 	return matrix.m11 == matrix.m22;
 }
 
+//-----------------------------------------------------------------------------
+static void hashValue (uint64_t& hash, double value)
+{
+	uint64_t bits;
+	memcpy (&bits, &value, sizeof (bits));
+	hash ^= bits;
+	hash *= 1099511628211u;
+}
+
+//-----------------------------------------------------------------------------
+static void hashSubViewLayout (const CViewContainer* container, uint64_t& hash)
+{
+	container->forEachChild ([&] (CView* view) {
+		if (!view->isVisible ())
+			return;
+		const auto& size = view->getViewSize ();
+		hashValue (hash, size.left);
+		hashValue (hash, size.top);
+		hashValue (hash, size.right);
+		hashValue (hash, size.bottom);
+		hashValue (hash, view->getAlphaValue ());
+		if (auto subContainer = view->asViewContainer ())
+		{
+			const auto& transform = subContainer->getTransform ();
+			hashValue (hash, transform.m11);
+			hashValue (hash, transform.m12);
+			hashValue (hash, transform.m21);
+			hashValue (hash, transform.m22);
+			hashValue (hash, transform.dx);
+			hashValue (hash, transform.dy);
+			hashSubViewLayout (subContainer, hash);
+		}
+	});
+}
+
+//-----------------------------------------------------------------------------
+uint64_t CShadowViewContainer::calcSubViewLayoutHash () const
+{
+	uint64_t hash = 14695981039346656037u;
+	hashSubViewLayout (this, hash);
+	return hash;
+}
+
+//-----------------------------------------------------------------------------
+/** FNV-1a hash of the alpha channel, the shape of the shadow does not depend on the colors */
+static uint64_t hashShadowShape (CBitmap* bitmap)
+{
+	uint64_t hash = 14695981039346656037u;
+	auto platformBitmap = bitmap->getPlatformBitmap ();
+	if (!platformBitmap)
+		return hash;
+	// premultiplied, converting the pixels is not needed to read the alpha channel
+	auto pixelAccess = platformBitmap->lockPixels (true);
+	if (!pixelAccess)
+		return hash;
+	auto format = pixelAccess->getPixelFormat ();
+	uint32_t alphaOffset = (format == IPlatformBitmapPixelAccess::kARGB ||
+							format == IPlatformBitmapPixelAccess::kABGR) ?
+							   0 :
+							   3;
+	auto width = static_cast<uint32_t> (platformBitmap->getSize ().x);
+	auto height = static_cast<uint32_t> (platformBitmap->getSize ().y);
+	for (uint32_t y = 0; y < height; ++y)
+	{
+		auto pixel = pixelAccess->getAddress () + y * pixelAccess->getBytesPerRow () + alphaOffset;
+		for (uint32_t x = 0; x < width; ++x, pixel += 4)
+		{
+			hash ^= *pixel;
+			hash *= 1099511628211u;
+		}
+	}
+	return hash;
+}
+
 //-----------------------------------------------------------------------------
 void CShadowViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 {
@@ -149,58 +278,75 @@ void CShadowViewContainer::drawRect (CDrawContext* pContext, const CRect& update
 		if (matrixScale != 0.)
 			scaleFactor *= matrixScale;
 	}
-	if (scaleFactor != scaleFactorUsed && getWidth () > 0. && getHeight () > 0.)
+	if (scaleFactor != scaleFactorUsed || shadowState != ShadowState::kValid)
+		updateShadow (scaleFactor);
+	CViewContainer::drawRect (pContext, updateRect);
+}
+
+//-----------------------------------------------------------------------------
+void CShadowViewContainer::updateShadow (double scaleFactor)
+{
+	bool shapeCheckOnly = shadowState == ShadowState::kCheckShape && scaleFactor == scaleFactorUsed;
+	shadowState = ShadowState::kValid;
+	scaleFactorUsed = scaleFactor;
+	layoutHash = calcSubViewLayoutHash ();
+	if (getWidth () <= 0. || getHeight () <= 0.)
+		return;
+
+	// the shadow is blurred anyway, so it does not need the full resolution
+	auto offscreenContext = COffscreenContext::create (
+		{getWidth (), getHeight ()}, scaleFactor / static_cast<double> (shadowDownsampling));
+	if (!offscreenContext)
+		return;
+	offscreenContext->beginDraw ();
 	{
-		scaleFactorUsed = scaleFactor;
-		CCoord width = getWidth ();
-		CCoord height = getHeight ();
-		
-		if (auto offscreenContext = COffscreenContext::create ({width, height}, scaleFactor))
-		{
-			offscreenContext->beginDraw ();
-			CDrawContext::Transform transform (*offscreenContext, CGraphicsTransform ().translate (-getViewSize ().left - shadowOffset.x, -getViewSize ().top - shadowOffset.y));
-			dontDrawBackground = true;
-			CViewContainer::draw (offscreenContext);
-			dontDrawBackground = false;
-			offscreenContext->endDraw ();
-			CBitmap* bitmap = offscreenContext->getBitmap ();
-			if (bitmap)
-			{
-				setBackground (bitmap);
-				SharedPointer<BitmapFilter::IFilter> setColorFilter = owned (BitmapFilter::Factory::getInstance ().createFilter (BitmapFilter::Standard::kSetColor));
-				if (setColorFilter)
-				{
-					setColorFilter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
-					setColorFilter->setProperty (BitmapFilter::Standard::Property::kInputColor, kBlackCColor);
-					setColorFilter->setProperty (BitmapFilter::Standard::Property::kIgnoreAlphaColorValue, (int32_t)1);
-					if (setColorFilter->run (true))
-					{
-						SharedPointer<BitmapFilter::IFilter> boxBlurFilter = owned (BitmapFilter::Factory::getInstance ().createFilter (BitmapFilter::Standard::kBoxBlur));
-						if (boxBlurFilter)
-						{
-							auto boxSizes = boxesForGauss<3> (shadowBlurSize);
-							boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
-							boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kRadius, boxSizes[0]);
-							boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kAlphaChannelOnly, 1);
-							if (boxBlurFilter->run (true))
-							{
-								boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kRadius, boxSizes[1]);
-								boxBlurFilter->run (true);
-								boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kRadius, boxSizes[2]);
-								boxBlurFilter->run (true);
-							}
-						}
-					}
-				}
-
-				CViewContainer::drawRect (pContext, updateRect);
-			}
-		}
+		CDrawContext::Transform transform (
+			*offscreenContext, CGraphicsTransform ().translate (-getViewSize ().left - shadowOffset.x,
+															   -getViewSize ().top - shadowOffset.y));
+		dontDrawBackground = true;
+		CViewContainer::draw (offscreenContext);
+		dontDrawBackground = false;
 	}
-	else
+	offscreenContext->endDraw ();
+	CBitmap* bitmap = offscreenContext->getBitmap ();
+	if (!bitmap)
+		return;
+
+	auto hash = hashShadowShape (bitmap);
+	if (shapeCheckOnly && hash == shapeHash && getBackground ())
+		return;
+	shapeHash = hash;
+	applyShadowFilters (bitmap);
+	// the whole container was invalidated together with the request for the shape check, so the
+	// new shadow is completely drawn without invalidating it again
+	setBackground (bitmap);
+}
+
+//-----------------------------------------------------------------------------
+bool CShadowViewContainer::applyShadowFilters (CBitmap* bitmap) const
+{
+	auto setColorFilter = owned (BitmapFilter::Factory::getInstance ().createFilter (BitmapFilter::Standard::kSetColor));
+	if (!setColorFilter)
+		return false;
+	setColorFilter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
+	setColorFilter->setProperty (BitmapFilter::Standard::Property::kInputColor, kBlackCColor);
+	setColorFilter->setProperty (BitmapFilter::Standard::Property::kIgnoreAlphaColorValue, (int32_t)1);
+	if (!setColorFilter->run (true))
+		return false;
+	auto boxBlurFilter = owned (BitmapFilter::Factory::getInstance ().createFilter (BitmapFilter::Standard::kBoxBlur));
+	if (!boxBlurFilter)
+		return false;
+	// the blur size is in pixels of the downsampled bitmap
+	auto boxSizes = boxesForGauss<3> (shadowBlurSize / static_cast<double> (shadowDownsampling));
+	boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
+	boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kAlphaChannelOnly, 1);
+	for (auto boxSize : boxSizes)
 	{
-		CViewContainer::drawRect (pContext, updateRect);
+		boxBlurFilter->setProperty (BitmapFilter::Standard::Property::kRadius, boxSize);
+		if (!boxBlurFilter->run (true))
+			return false;
 	}
+	return true;
 }
 
 //-----------------------------------------------------------------------------
@@ -231,21 +377,21 @@ void CShadowViewContainer::setViewSize (const CRect& rect, bool invalid)
 void CShadowViewContainer::viewContainerViewAdded (CViewContainer* container, CView* view)
 {
 	vstgui_assert (container == this);
-	invalidateShadow ();
+	invalidateShadowShape ();
 }
 
 //-----------------------------------------------------------------------------
 void CShadowViewContainer::viewContainerViewRemoved (CViewContainer* container, CView* view)
 {
 	vstgui_assert (container == this);
-	invalidateShadow ();
+	invalidateShadowShape ();
 }
 
 //-----------------------------------------------------------------------------
 void CShadowViewContainer::viewContainerViewZOrderChanged (CViewContainer* container, CView* view)
 {
 	vstgui_assert (container == this);
-	invalidateShadow ();
+	invalidateShadowShape ();
 }
 
 } // VSTGUI
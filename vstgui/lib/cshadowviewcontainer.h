@@ -38,7 +38,21 @@ public:
 	virtual void setShadowBlurSize (double size);
 	double getShadowBlurSize () const { return shadowBlurSize; }
 
+	/** render the shadow at 1/factor of the resolution of the draw context, the shadow is
+	 *	scaled up when drawn */
+	void setShadowDownsampling (uint32_t factor);
+	uint32_t getShadowDownsampling () const { return shadowDownsampling; }
+
+	/** if enabled, an invalidation of a sub view checks the shape of the sub views when their
+	 *	layout (size, position, visibility or alpha value) changed. A changed content alone does
+	 *	not check the shape, use invalidateShadowShape () for that */
+	void setShadowFollowsContent (bool state);
+	bool getShadowFollowsContent () const { return shadowFollowsContent; }
+
+	/** regenerate the shadow on the next draw */
 	void invalidateShadow ();
+	/** regenerate the shadow on the next draw only if the shape of the sub views changed */
+	void invalidateShadowShape ();
 	//@}
 
 	// override
@@ -47,6 +61,7 @@ public:
 	void drawRect (CDrawContext* pContext, const CRect& updateRect) override;
 	void drawBackgroundRect (CDrawContext* pContext, const CRect& _updateRect) override;
 	void setViewSize (const CRect& rect, bool invalid = true) override;
+	void invalidRect (const CRect& rect) override;
 	CMessageResult notify (CBaseObject* sender, IdStringPtr message) override;
 
 	void onScaleFactorChanged (CFrame* frame, double newScaleFactor) override;
@@ -59,11 +74,27 @@ protected:
 
 	void beforeDelete () override;
 
+	void updateShadow (double scaleFactor);
+	bool applyShadowFilters (CBitmap* bitmap) const;
+	uint64_t calcSubViewLayoutHash () const;
+
+	enum class ShadowState : uint8_t
+	{
+		kValid,
+		kCheckShape,
+		kInvalid
+	};
+
 	bool dontDrawBackground;
 	CPoint shadowOffset;
 	float shadowIntensity;
 	double shadowBlurSize;
 	double scaleFactorUsed;
+	uint64_t shapeHash;
+	uint64_t layoutHash;
+	uint32_t shadowDownsampling;
+	ShadowState shadowState;
+	bool shadowFollowsContent;
 };
 
 } // VSTGUI
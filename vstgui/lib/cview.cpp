@@ -159,6 +159,7 @@ UTF8StringPtr kPerthousandSymbol= "\xE2\x80\xB0";
 
 //-----------------------------------------------------------------------------
 IdStringPtr kMsgViewSizeChanged = "kMsgViewSizeChanged";
+IdStringPtr kMsgViewMouseableAreaChanged = "kMsgViewMouseableAreaChanged";
 
 bool CView::kDirtyCallAlwaysOnMainThread = false;
 
@@ -285,6 +286,8 @@ void CView::setMouseableArea (const CRect& rect)
 		setViewFlag (kHasMouseableArea, true);
 		setAttribute (kCViewMouseableAreaAttrID, rect);
 	}
+	if (getParentView ())
+		getParentView ()->notify (this, kMsgViewMouseableAreaChanged);
 }
 
 #if VSTGUI_ENABLE_DEPRECATED_METHODS
@@ -416,6 +419,8 @@ void CView::setDirty (bool state)
 	else
 	{
 		setViewFlag (kDirty, state);
+		if (state && pImpl->parentFrame)
+			pImpl->parentFrame->onViewDirty (this);
 	}
 }
 
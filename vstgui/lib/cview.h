@@ -34,6 +34,8 @@ extern UTF8StringPtr kPerthousandSymbol;
 //-----------------------------------------------------------------------------
 /** Message send to parent that the size of the view has changed */
 extern IdStringPtr kMsgViewSizeChanged;
+/** Message send to parent that the mouseable area of the view has changed */
+extern IdStringPtr kMsgViewMouseableAreaChanged;
 
 //-----------------------------------------------------------------------------
 // Attributes
@@ -65,7 +67,9 @@ public:
 
 	/** check if view is dirty */
 	virtual bool isDirty () const { return hasViewFlag (kDirty); }
-	/** set the view to dirty so that it is redrawn in the next idle. Thread Safe ! */
+	/** set the view to dirty so that it is redrawn in the next idle. Thread Safe ! But when called
+	 *	from another thread than the main thread, the caller must make sure that the view is not
+	 *	removed from its frame at the same time. */
 	virtual void setDirty (bool val = true);
 	/** if this is true, setting a view dirty will call invalid() instead of checking it in idle. Default value is false. */
 	static bool kDirtyCallAlwaysOnMainThread;
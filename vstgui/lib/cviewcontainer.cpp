@@ -17,6 +17,8 @@
 #include "dispatchlist.h"
 #include "events.h"
 #include "finally.h"
+#include "cinvalidrectlist.h"
+#include "cviewspatialindex.h"
 
 #include <algorithm>
 #include <cassert>
@@ -44,6 +46,66 @@ struct CViewContainer::Impl
 	
 	CDrawStyle backgroundColorDrawStyle {kDrawFilledAndStroked};
 	CColor backgroundColor {kBlackCColor};
+
+	struct BitmapCache
+	{
+		SharedPointer<COffscreenContext> context;
+		CInvalidRectList dirtyRects;
+		CPoint size;
+		double scaleFactor {0.};
+	};
+	std::unique_ptr<BitmapCache> bitmapCache;
+
+	std::unique_ptr<CViewSpatialIndex> spatialIndex;
+
+	/** below this number of child views a linear search is faster than the index */
+	static constexpr size_t kMinViewsForSpatialIndex = 16;
+
+	/** the index is only used while attached, as only then the child views report size changes */
+	CViewSpatialIndex* getSpatialIndex (bool attached)
+	{
+		if (!spatialIndex || !attached || children.size () < kMinViewsForSpatialIndex)
+			return nullptr;
+		if (!spatialIndex->isValid ())
+			spatialIndex->rebuild (children);
+		return spatialIndex.get ();
+	}
+
+	void invalidateSpatialIndex ()
+	{
+		if (spatialIndex)
+			spatialIndex->invalidate ();
+	}
+
+	/** call proc for the child views which may contain the point, top->down, until proc returns
+	 *	false */
+	template<typename Proc>
+	void forEachChildAt (const CPoint& where, bool attached, Proc proc)
+	{
+		if (auto index = getSpatialIndex (attached))
+		{
+			index->forEachViewAt (where, proc);
+			return;
+		}
+		for (auto it = children.rbegin (), end = children.rend (); it != end; ++it)
+		{
+			if (!proc (*it))
+				return;
+		}
+	}
+
+	static double getBitmapCacheScaleFactor (CDrawContext* context)
+	{
+		auto scaleFactor = context->getScaleFactor ();
+		const auto& matrix = context->getCurrentTransform ();
+		if (matrix.m11 == matrix.m22)
+		{
+			auto matrixScale = std::floor (matrix.m11 + 0.5);
+			if (matrixScale != 0.)
+				scaleFactor *= matrixScale;
+		}
+		return scaleFactor;
+	}
 };
 
 //------------------------------------------------------------------------
@@ -151,6 +213,8 @@ CViewContainer::CViewContainer (const CViewContainer& v)
 	pImpl->backgroundColorDrawStyle = v.pImpl->backgroundColorDrawStyle;
 	pImpl->backgroundColor = v.pImpl->backgroundColor;
 	setBackgroundOffset (v.getBackgroundOffset ());
+	setCacheAsBitmap (v.getCacheAsBitmap ());
+	setSpatialIndexEnabled (v.getSpatialIndexEnabled ());
 	for (auto& view : v.pImpl->children)
 		addView (static_cast<CView*> (view->newCopy ()));
 }
@@ -500,6 +564,18 @@ CMessageResult CViewContainer::notify (CBaseObject* sender, IdStringPtr message)
 			setLastDrawnFocus (CRect (0, 0, 0, 0));
 		}
 	}
+	else if (message == kMsgViewSizeChanged)
+	{
+		// the old size of the subview is unknown here
+		invalidateBitmapCache ();
+		if (pImpl->spatialIndex)
+			pImpl->spatialIndex->update (dynamic_cast<CView*> (sender));
+	}
+	else if (message == kMsgViewMouseableAreaChanged)
+	{
+		if (pImpl->spatialIndex)
+			pImpl->spatialIndex->update (dynamic_cast<CView*> (sender));
+	}
 	return kMessageUnknown;
 }
 
@@ -526,6 +602,7 @@ bool CViewContainer::addView (CView *pView, CView* pBefore)
 	{
 		pImpl->children.emplace_back (pView);
 	}
+	pImpl->invalidateSpatialIndex ();
 
 	pView->setSubviewState (true);
 
@@ -583,6 +660,7 @@ bool CViewContainer::removeAll (bool withForget)
 			view->forget ();
 		it = pImpl->children.begin ();
 	}
+	pImpl->invalidateSpatialIndex ();
 	return true;
 }
 
@@ -609,6 +687,7 @@ bool CViewContainer::removeView (CView *pView, bool withForget)
 		if (withForget)
 			pView->forget ();
 		pImpl->children.erase (it);
+		pImpl->invalidateSpatialIndex ();
 		return true;
 	}
 	return false;
@@ -629,7 +708,16 @@ bool CViewContainer::isChild (CView *pView, bool deep) const
 {
 	bool found = false;
 
-	if (deep)
+	if (deep && pView && isAttached () && pView->isAttached ())
+	{
+		// the parent chain of attached views is complete, no need to walk all sub views
+		for (auto parent = pView->getParentView (); parent; parent = parent->getParentView ())
+		{
+			if (parent == this)
+				return true;
+		}
+	}
+	else if (deep)
 	{
 		auto it = pImpl->children.begin ();
 		while (!found && it != pImpl->children.end ())
@@ -706,6 +794,7 @@ bool CViewContainer::changeViewZOrder (CView* view, uint32_t newIndex)
 
 			pImpl->children.insert (dest, view);
 			pImpl->children.erase (src);
+			pImpl->invalidateSpatialIndex ();
 
 			pImpl->viewContainerListeners.forEach ([&] (IViewContainerListener* listener) {
 				listener->viewContainerViewZOrderChanged (this, view);
@@ -740,11 +829,23 @@ bool CViewContainer::invalidateDirtyViews ()
 	return true;
 }
 
+//-----------------------------------------------------------------------------
+void CViewContainer::setDirty (bool state)
+{
+	// setDirty may be called from another thread, so the bitmap cache is invalidated when the dirty
+	// container is drawn. With kDirtyCallAlwaysOnMainThread the flag is cleared right away and
+	// this is the main thread.
+	if (state && kDirtyCallAlwaysOnMainThread && isAttached ())
+		invalidateBitmapCache ();
+	CView::setDirty (state);
+}
+
 //-----------------------------------------------------------------------------
 void CViewContainer::invalid ()
 {
 	if (!isVisible ())
 		return;
+	invalidateBitmapCache ();
 	CRect _rect (getViewSize ());
 	if (auto parent = getParentView ())
 		parent->invalidRect (_rect);
@@ -757,6 +858,13 @@ void CViewContainer::invalidRect (const CRect& rect)
 		return;
 	CRect _rect (rect);
 	getTransform ().transform (_rect);
+	if (pImpl->bitmapCache)
+	{
+		CRect cacheRect (_rect);
+		cacheRect.bound (CRect (0., 0., getWidth (), getHeight ()));
+		if (!cacheRect.isEmpty ())
+			pImpl->bitmapCache->dirtyRects.add (cacheRect);
+	}
 	_rect.offset (getViewSize ().left, getViewSize ().top);
 	_rect.bound (getViewSize ());
 	if (_rect.isEmpty ())
@@ -816,6 +924,14 @@ void CViewContainer::drawBackgroundRect (CDrawContext* pContext, const CRect& _u
  * @param updateRect the area which to draw
  */
 void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
+{
+	if (pImpl->bitmapCache && drawRectFromBitmapCache (pContext, updateRect))
+		return;
+	drawRectInternal (pContext, updateRect);
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::drawRectInternal (CDrawContext* pContext, const CRect& updateRect)
 {
 	CPoint offset (getViewSize ().left, getViewSize ().top);
 	CDrawContext::Transform offsetTransform (*pContext, CGraphicsTransform ().translate (offset.x, offset.y));
@@ -852,47 +968,59 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 		getTransform ().inverse ().transform (clientRect);
 		getTransform ().transform (oldClip2);
 		
-		// draw each view
-		for (const auto& pV : pImpl->children)
-		{
-			if (pV->isVisible ())
+		auto drawView = [&] (CView* pV) {
+			if (!pV->isVisible ())
+				return;
+			if (frame && _focusDrawing && _focusView == pV && !_focusDrawing->drawFocusOnTop ())
 			{
-				if (frame && _focusDrawing && _focusView == pV && !_focusDrawing->drawFocusOnTop ())
+				SharedPointer<CGraphicsPath> focusPath = owned (pContext->createGraphicsPath ());
+				if (focusPath)
 				{
-					SharedPointer<CGraphicsPath> focusPath = owned (pContext->createGraphicsPath ());
-					if (focusPath)
+					if (_focusDrawing->getFocusPath (*focusPath))
 					{
-						if (_focusDrawing->getFocusPath (*focusPath))
+						auto lastDrawnFocus = focusPath->getBoundingBox ();
+						if (!lastDrawnFocus.isEmpty ())
 						{
-							auto lastDrawnFocus = focusPath->getBoundingBox ();
-							if (!lastDrawnFocus.isEmpty ())
-							{
-								pContext->setClipRect (oldClip2);
-								pContext->setDrawMode (kAntiAliasing|kNonIntegralMode);
-								pContext->setFillColor (frame->getFocusColor ());
-								pContext->drawGraphicsPath (focusPath, CDrawContext::kPathFilledEvenOdd);
-								lastDrawnFocus.extend (1, 1);
-								setLastDrawnFocus (lastDrawnFocus);
-							}
-							_focusDrawing = nullptr;
-							_focusView = nullptr;
+							pContext->setClipRect (oldClip2);
+							pContext->setDrawMode (kAntiAliasing|kNonIntegralMode);
+							pContext->setFillColor (frame->getFocusColor ());
+							pContext->drawGraphicsPath (focusPath, CDrawContext::kPathFilledEvenOdd);
+							lastDrawnFocus.extend (1, 1);
+							setLastDrawnFocus (lastDrawnFocus);
 						}
+						_focusDrawing = nullptr;
+						_focusView = nullptr;
 					}
 				}
+			}
 
-				if (checkUpdateRect (pV, clientRect))
-				{
-					CRect viewSize = pV->getViewSize ();
-					viewSize.bound (newClip);
-					if (viewSize.getWidth () == 0 || viewSize.getHeight () == 0)
-						continue;
-					pContext->setClipRect (viewSize);
-					float globalContextAlpha = pContext->getGlobalAlpha ();
-					pContext->setGlobalAlpha (globalContextAlpha * pV->getAlphaValue ());
-					pV->drawRect (pContext, viewSize);
-					pContext->setGlobalAlpha (globalContextAlpha);
-				}
+			if (checkUpdateRect (pV, clientRect))
+			{
+				CRect viewSize = pV->getViewSize ();
+				viewSize.bound (newClip);
+				if (viewSize.getWidth () == 0 || viewSize.getHeight () == 0)
+					return;
+				pContext->setClipRect (viewSize);
+				float globalContextAlpha = pContext->getGlobalAlpha ();
+				pContext->setGlobalAlpha (globalContextAlpha * pV->getAlphaValue ());
+				pV->drawRect (pContext, viewSize);
+				pContext->setGlobalAlpha (globalContextAlpha);
 			}
+		};
+
+		// draw each view
+		std::vector<CView*> viewsToDraw;
+		auto index = pImpl->getSpatialIndex (isAttached ());
+		if (index && index->collectViews (clientRect, viewsToDraw))
+		{
+			// if the focus view is not part of the update rect, its focus is drawn on top below
+			for (auto pV : viewsToDraw)
+				drawView (pV);
+		}
+		else
+		{
+			for (const auto& pV : pImpl->children)
+				drawView (pV);
 		}
 	}
 	
@@ -931,6 +1059,98 @@ void CViewContainer::drawRect (CDrawContext* pContext, const CRect& updateRect)
 	setDirty (false);
 }
 
+//-----------------------------------------------------------------------------
+bool CViewContainer::drawRectFromBitmapCache (CDrawContext* pContext, const CRect& updateRect)
+{
+	auto& cache = *pImpl->bitmapCache;
+	if (CView::isDirty ())
+		invalidateBitmapCache ();
+	CPoint size (getWidth (), getHeight ());
+	auto scaleFactor = Impl::getBitmapCacheScaleFactor (pContext);
+	if (!cache.context || cache.size != size || cache.scaleFactor != scaleFactor)
+	{
+		cache.context = COffscreenContext::create (size, scaleFactor);
+		if (!cache.context)
+			return false;
+		cache.size = size;
+		cache.scaleFactor = scaleFactor;
+		invalidateBitmapCache ();
+	}
+	if (!cache.dirtyRects.empty ())
+	{
+		auto offscreen = cache.context;
+		offscreen->beginDraw ();
+		CDrawContext::Transform transform (
+			*offscreen,
+			CGraphicsTransform ().translate (-getViewSize ().left, -getViewSize ().top));
+		for (auto dirtyRect : cache.dirtyRects)
+		{
+			dirtyRect.offset (getViewSize ().left, getViewSize ().top);
+			offscreen->setClipRect (dirtyRect);
+			offscreen->clearRect (dirtyRect);
+			drawRectInternal (offscreen, dirtyRect);
+		}
+		offscreen->endDraw ();
+		cache.dirtyRects.clear ();
+	}
+	CRect r (updateRect);
+	r.bound (getViewSize ());
+	if (!r.isEmpty ())
+		cache.context->copyFrom (pContext, r, r.getTopLeft () - getViewSize ().getTopLeft ());
+	setDirty (false);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::setCacheAsBitmap (bool state)
+{
+	if (state == getCacheAsBitmap ())
+		return;
+	if (state)
+		pImpl->bitmapCache = std::unique_ptr<Impl::BitmapCache> (new Impl::BitmapCache ());
+	else
+		pImpl->bitmapCache = nullptr;
+	invalid ();
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::getCacheAsBitmap () const
+{
+	return pImpl->bitmapCache != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::setSpatialIndexEnabled (bool state)
+{
+	if (state == getSpatialIndexEnabled ())
+		return;
+	if (state)
+		pImpl->spatialIndex = std::unique_ptr<CViewSpatialIndex> (new CViewSpatialIndex ());
+	else
+		pImpl->spatialIndex = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+bool CViewContainer::getSpatialIndexEnabled () const
+{
+	return pImpl->spatialIndex != nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::invalidateSpatialIndex ()
+{
+	pImpl->invalidateSpatialIndex ();
+}
+
+//-----------------------------------------------------------------------------
+void CViewContainer::invalidateBitmapCache ()
+{
+	if (!pImpl->bitmapCache)
+		return;
+	pImpl->bitmapCache->dirtyRects.clear ();
+	pImpl->bitmapCache->dirtyRects.add (CRect (0., 0., getWidth (), getHeight ()));
+}
+
 //-----------------------------------------------------------------------------
 /**
  * check if view needs to be updated for rect
@@ -1357,33 +1577,32 @@ CView* CViewContainer::getViewAt (const CPoint& p, const GetViewOptions& options
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+	CView* result = nullptr;
+	pImpl->forEachChildAt (where, isAttached (), [&] (CView* pV) {
+		if (!pV->getMouseableArea ().pointInside (where))
+			return true;
+		if (!options.getIncludeInvisible () && pV->isVisible () == false)
+			return true;
+		if (options.getMouseEnabled ())
 		{
-			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
-			if (options.getMouseEnabled ())
+			if (pV->getMouseEnabled () == false)
+				return true;
+		}
+		if (options.getDeep ())
+		{
+			if (auto container = pV->asViewContainer ())
 			{
-				if (pV->getMouseEnabled () == false)
-					continue;
+				CView* view = container->getViewAt (where, options);
+				result = options.getIncludeViewContainer () ? (view ? view : container) : view;
+				return false;
 			}
-			if (options.getDeep ())
-			{
-				if (auto container = pV->asViewContainer ())
-				{
-					CView* view = container->getViewAt (where, options);
-					return options.getIncludeViewContainer () ? (view ? view : container) : view;
-				}
-			}
-			if (!options.getIncludeViewContainer () && pV->asViewContainer ())
-				continue;
-			return pV;
 		}
-	}
-
-	return nullptr;
+		if (!options.getIncludeViewContainer () && pV->asViewContainer ())
+			return true;
+		result = pV;
+		return false;
+	});
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1401,32 +1620,30 @@ bool CViewContainer::getViewsAt (const CPoint& p, ViewList& views, const GetView
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+	pImpl->forEachChildAt (where, isAttached (), [&] (CView* pV) {
+		if (!pV->getMouseableArea ().pointInside (where))
+			return true;
+		if (!options.getIncludeInvisible () && pV->isVisible () == false)
+			return true;
+		if (options.getMouseEnabled ())
 		{
-			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
-			if (options.getMouseEnabled ())
-			{
-				if (pV->getMouseEnabled () == false)
-					continue;
-			}
-			if (options.getDeep ())
-			{
-				if (CViewContainer* container = pV->asViewContainer ())
-					result |= container->getViewsAt (where, views, options);
-			}
-			if (options.getIncludeViewContainer () == false)
-			{
-				if (pV->asViewContainer ())
-					continue;
-			}
-			views.emplace_back (pV);
-			result = true;
+			if (pV->getMouseEnabled () == false)
+				return true;
 		}
-	}
+		if (options.getDeep ())
+		{
+			if (CViewContainer* container = pV->asViewContainer ())
+				result |= container->getViewsAt (where, views, options);
+		}
+		if (options.getIncludeViewContainer () == false)
+		{
+			if (pV->asViewContainer ())
+				return true;
+		}
+		views.emplace_back (pV);
+		result = true;
+		return true;
+	});
 
 	return result;
 }
@@ -1443,28 +1660,25 @@ CViewContainer* CViewContainer::getContainerAt (const CPoint& p, const GetViewOp
 	where.offset (-getViewSize ().left, -getViewSize ().top);
 	getTransform ().inverse ().transform (where);
 
-	for (auto it = pImpl->children.rbegin (), end = pImpl->children.rend (); it != end; ++it)
-	{
-		const auto& pV = *it;
-		if (pV && pV->getMouseableArea ().pointInside (where))
+	auto result = const_cast<CViewContainer*> (this);
+	pImpl->forEachChildAt (where, isAttached (), [&] (CView* pV) {
+		if (!pV->getMouseableArea ().pointInside (where))
+			return true;
+		if (!options.getIncludeInvisible () && pV->isVisible () == false)
+			return true;
+		if (options.getMouseEnabled ())
 		{
-			if (!options.getIncludeInvisible () && pV->isVisible () == false)
-				continue;
-			if (options.getMouseEnabled ())
-			{
-				if (pV->getMouseEnabled() == false)
-					continue;
-			}
-			if (options.getDeep ())
-			{
-				if (CViewContainer* container = pV->asViewContainer ())
-					return container->getContainerAt (where, options);
-			}
-			break;
+			if (pV->getMouseEnabled() == false)
+				return true;
 		}
-	}
-
-	return const_cast<CViewContainer*>(this);
+		if (options.getDeep ())
+		{
+			if (CViewContainer* container = pV->asViewContainer ())
+				result = container->getContainerAt (where, options);
+		}
+		return false;
+	});
+	return result;
 }
 
 //-----------------------------------------------------------------------------
@@ -1493,7 +1707,10 @@ bool CViewContainer::removed (CView* parent)
 
 	for (const auto& pV : pImpl->children)
 		pV->removed (this);
-	
+
+	if (pImpl->bitmapCache)
+		pImpl->bitmapCache->context = nullptr;
+
 	return CView::removed (parent);
 }
 
@@ -1508,6 +1725,8 @@ bool CViewContainer::attached (CView* parent)
 	bool result = CView::attached (parent);
 	if (result)
 	{
+		// the child views may have changed while not being attached
+		pImpl->invalidateSpatialIndex ();
 		for (const auto& pV : pImpl->children)
 			pV->attached (this);
 	}
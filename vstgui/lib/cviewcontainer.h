@@ -123,6 +123,43 @@ public:
 	CDrawStyle getBackgroundColorDrawStyle () const;
 	//@}
 
+	//-----------------------------------------------------------------------------
+	/// @name Bitmap Cache Methods
+	//-----------------------------------------------------------------------------
+	//@{
+	/** draw this container and its subviews into a bitmap and use the bitmap for drawing.
+	 *
+	 *	Only the regions of the bitmap invalidated by subviews are drawn again, all other regions
+	 *	are just copied from the bitmap. The bitmap is released when the size of the container or
+	 *	the scale factor changes. Setting the container dirty redraws the whole bitmap the next
+	 *	time the container is drawn. Use this for mostly static subtrees.
+	 */
+	void setCacheAsBitmap (bool state);
+	/** returns true if this container draws via a bitmap cache */
+	bool getCacheAsBitmap () const;
+	/** mark the whole bitmap cache as dirty */
+	void invalidateBitmapCache ();
+	//@}
+
+	//-----------------------------------------------------------------------------
+	/// @name Spatial Index Methods
+	//-----------------------------------------------------------------------------
+	//@{
+	/** use a spatial index of the child views for hit testing and drawing.
+	 *
+	 *	For containers with many child views. getViewAt, getViewsAt and getContainerAt only look at
+	 *	the child views near the point and drawRect only at the child views overlapping the update
+	 *	rect. The index is only used while the container is attached and expects the child views
+	 *	to draw inside their view size.
+	 */
+	void setSpatialIndexEnabled (bool state);
+	/** returns true if this container uses a spatial index */
+	bool getSpatialIndexEnabled () const;
+	/** rebuild the spatial index on its next use, for subclasses which move the child views
+	 *	without notifying this container */
+	void invalidateSpatialIndex ();
+	//@}
+
 	virtual bool advanceNextFocusView (CView* oldFocus, bool reverse = false);
 	virtual bool invalidateDirtyViews ();
 	virtual CRect getVisibleSize (const CRect& rect) const;
@@ -160,6 +197,7 @@ public:
 	void takeFocus () override;
 
 	bool isDirty () const override;
+	void setDirty (bool state = true) override;
 
 	void invalid () override;
 	void invalidRect (const CRect& rect) override;
@@ -262,6 +300,8 @@ protected:
 	const ViewList& getChildren () const;
 private:
 	void dispatchEventToSubViews (Event& event);
+	void drawRectInternal (CDrawContext* pContext, const CRect& updateRect);
+	bool drawRectFromBitmapCache (CDrawContext* pContext, const CRect& updateRect);
 	
 	void clearMouseDownView ();
 	CRect getLastDrawnFocus () const;
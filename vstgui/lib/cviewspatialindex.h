@@ -0,0 +1,267 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "cview.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace VSTGUI {
+
+//-----------------------------------------------------------------------------
+/** Spatial index of the child views of a view container
+ *
+ *	The bounds of the views (the union of the view size and the mouseable area) are bucketed into
+ *	a uniform grid, so that finding the views at a point or in a rectangle only needs to look at
+ *	the views in the neighbourhood instead of all views. The index of a view in the index is its
+ *	z-order position, the buckets are sorted by it.
+ */
+struct CViewSpatialIndex
+{
+	/** rebuild the index from a list of views in z-order */
+	template<typename ViewList>
+	void rebuild (const ViewList& views);
+	/** update the bounds of a view after its size or mouseable area changed */
+	void update (CView* view);
+
+	void invalidate () { valid = false; }
+	bool isValid () const { return valid; }
+
+	/** call proc for all views whose bounds contain the point, top->down, until proc returns
+	 *	false */
+	template<typename Proc>
+	void forEachViewAt (const CPoint& where, Proc proc) const;
+	/** collect all views whose bounds overlap the rect, down->top
+	 *
+	 *	returns false if the rect covers that many cells that using the index does not pay off
+	 */
+	bool collectViews (const CRect& r, std::vector<CView*>& result) const;
+
+	CCoord getCellSize () const { return cellSize; }
+
+private:
+	using Index = uint32_t;
+	using Bucket = std::vector<Index>;
+	using CellMap = std::unordered_map<uint64_t, Bucket>;
+
+	struct Entry
+	{
+		CView* view;
+		CRect bounds;
+	};
+
+	struct CellRange
+	{
+		int64_t left;
+		int64_t top;
+		int64_t right;
+		int64_t bottom;
+
+		int64_t numCells () const { return (right - left + 1) * (bottom - top + 1); }
+	};
+
+	static constexpr int64_t kMaxCellsPerRect = 64;
+	static constexpr CCoord kMinCellSize = 8.;
+	static constexpr CCoord kMaxCellSize = 1024.;
+
+	static CRect getBounds (CView* view);
+	static uint64_t cellKey (int64_t x, int64_t y);
+	bool getCellRange (const CRect& r, CellRange& range, int64_t maxCells) const;
+	template<typename Proc>
+	void forEachBucket (const CRect& r, Proc proc);
+	void indexInsert (Index index);
+	void indexRemove (Index index);
+
+	std::vector<Entry> entries;
+	std::unordered_map<const CView*, Index> entryIndex;
+	CellMap cells;
+	Bucket oversized;
+	mutable Bucket candidates;
+	CCoord cellSize {64.};
+	bool valid {false};
+};
+
+//-----------------------------------------------------------------------------
+template<typename ViewList>
+inline void CViewSpatialIndex::rebuild (const ViewList& views)
+{
+	entries.clear ();
+	entryIndex.clear ();
+	cells.clear ();
+	oversized.clear ();
+	CCoord extentSum = 0.;
+	for (const auto& view : views)
+	{
+		auto bounds = getBounds (view);
+		entryIndex.emplace (view, static_cast<Index> (entries.size ()));
+		entries.push_back ({view, bounds});
+		extentSum += std::max (bounds.getWidth (), bounds.getHeight ());
+	}
+	// a cell should hold only a few views of the typical size
+	if (!entries.empty ())
+	{
+		auto extent = extentSum / static_cast<CCoord> (entries.size ());
+		if (std::isfinite (extent))
+			cellSize = std::min (std::max (extent * 2., kMinCellSize), kMaxCellSize);
+	}
+	for (Index i = 0; i < entries.size (); ++i)
+		indexInsert (i);
+	valid = true;
+}
+
+//-----------------------------------------------------------------------------
+inline void CViewSpatialIndex::update (CView* view)
+{
+	if (!valid)
+		return;
+	auto it = entryIndex.find (view);
+	if (it == entryIndex.end ())
+		return;
+	auto bounds = getBounds (view);
+	if (bounds == entries[it->second].bounds)
+		return;
+	indexRemove (it->second);
+	entries[it->second].bounds = bounds;
+	indexInsert (it->second);
+}
+
+//-----------------------------------------------------------------------------
+template<typename Proc>
+inline void CViewSpatialIndex::forEachViewAt (const CPoint& where, Proc proc) const
+{
+	if (!std::isfinite (where.x) || !std::isfinite (where.y))
+		return;
+	static const Bucket emptyBucket;
+	const Bucket* cell = &emptyBucket;
+	auto it = cells.find (cellKey (static_cast<int64_t> (std::floor (where.x / cellSize)),
+								   static_cast<int64_t> (std::floor (where.y / cellSize))));
+	if (it != cells.end ())
+		cell = &it->second;
+	// both buckets are sorted, merge them from the top most view down
+	auto c = cell->rbegin ();
+	auto o = oversized.rbegin ();
+	while (c != cell->rend () || o != oversized.rend ())
+	{
+		Index index;
+		if (o == oversized.rend () || (c != cell->rend () && *c > *o))
+			index = *c++;
+		else
+			index = *o++;
+		const auto& entry = entries[index];
+		if (entry.bounds.pointInside (where) && !proc (entry.view))
+			return;
+	}
+}
+
+//-----------------------------------------------------------------------------
+inline bool CViewSpatialIndex::collectViews (const CRect& r, std::vector<CView*>& result) const
+{
+	CellRange range;
+	if (!getCellRange (r, range, std::min<int64_t> (kMaxCellsPerRect,
+													static_cast<int64_t> (entries.size ()))))
+		return false;
+	candidates.clear ();
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		for (auto x = range.left; x <= range.right; ++x)
+		{
+			auto it = cells.find (cellKey (x, y));
+			if (it != cells.end ())
+				candidates.insert (candidates.end (), it->second.begin (), it->second.end ());
+		}
+	}
+	candidates.insert (candidates.end (), oversized.begin (), oversized.end ());
+	// restore the z-order and remove the duplicates of views spanning multiple cells
+	std::sort (candidates.begin (), candidates.end ());
+	candidates.erase (std::unique (candidates.begin (), candidates.end ()), candidates.end ());
+	result.clear ();
+	for (auto index : candidates)
+	{
+		if (entries[index].bounds.rectOverlap (r))
+			result.emplace_back (entries[index].view);
+	}
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+inline CRect CViewSpatialIndex::getBounds (CView* view)
+{
+	auto bounds = view->getViewSize ();
+	bounds.normalize ();
+	auto mouseableArea = view->getMouseableArea ();
+	mouseableArea.normalize ();
+	if (mouseableArea != bounds)
+		bounds.unite (mouseableArea);
+	return bounds;
+}
+
+//-----------------------------------------------------------------------------
+inline uint64_t CViewSpatialIndex::cellKey (int64_t x, int64_t y)
+{
+	return (static_cast<uint64_t> (static_cast<uint32_t> (x)) << 32) |
+		   static_cast<uint64_t> (static_cast<uint32_t> (y));
+}
+
+//-----------------------------------------------------------------------------
+inline bool CViewSpatialIndex::getCellRange (const CRect& r, CellRange& range,
+											 int64_t maxCells) const
+{
+	auto toCell = [this] (CCoord c) -> double { return std::floor (c / cellSize); };
+	auto left = toCell (std::min (r.left, r.right));
+	auto right = toCell (std::max (r.left, r.right));
+	auto top = toCell (std::min (r.top, r.bottom));
+	auto bottom = toCell (std::max (r.top, r.bottom));
+	if (!std::isfinite (left) || !std::isfinite (right) || !std::isfinite (top) ||
+		!std::isfinite (bottom))
+		return false;
+	if ((right - left + 1.) * (bottom - top + 1.) > static_cast<double> (maxCells))
+		return false;
+	range.left = static_cast<int64_t> (left);
+	range.right = static_cast<int64_t> (right);
+	range.top = static_cast<int64_t> (top);
+	range.bottom = static_cast<int64_t> (bottom);
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+template<typename Proc>
+inline void CViewSpatialIndex::forEachBucket (const CRect& r, Proc proc)
+{
+	CellRange range;
+	if (!getCellRange (r, range, kMaxCellsPerRect))
+	{
+		proc (oversized);
+		return;
+	}
+	for (auto y = range.top; y <= range.bottom; ++y)
+	{
+		for (auto x = range.left; x <= range.right; ++x)
+			proc (cells[cellKey (x, y)]);
+	}
+}
+
+//-----------------------------------------------------------------------------
+inline void CViewSpatialIndex::indexInsert (Index index)
+{
+	forEachBucket (entries[index].bounds, [index] (Bucket& bucket) {
+		bucket.insert (std::lower_bound (bucket.begin (), bucket.end (), index), index);
+	});
+}
+
+//-----------------------------------------------------------------------------
+inline void CViewSpatialIndex::indexRemove (Index index)
+{
+	forEachBucket (entries[index].bounds, [index] (Bucket& bucket) {
+		auto it = std::lower_bound (bucket.begin (), bucket.end (), index);
+		if (it != bucket.end () && *it == index)
+			bucket.erase (it);
+	});
+}
+
+//-----------------------------------------------------------------------------
+} // VSTGUI
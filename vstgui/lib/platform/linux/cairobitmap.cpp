@@ -4,6 +4,7 @@
 
 #include "../../cpoint.h"
 #include "../../cresourcedescription.h"
+#include "../iplatformresourceinputstream.h"
 #include "linuxfactory.h"
 #include "cairobitmap.h"
 #include <memory>
@@ -40,6 +41,31 @@ private:
 	size_t size;
 };
 
+//-----------------------------------------------------------------------------
+struct PNGStreamReader
+{
+	PNGStreamReader (IPlatformResourceInputStream& stream) : stream (stream) {}
+
+	cairo_surface_t* create () { return cairo_image_surface_create_from_png_stream (read, this); }
+
+private:
+	static cairo_status_t read (void* closure, unsigned char* data, unsigned int length)
+	{
+		auto self = reinterpret_cast<PNGStreamReader*> (closure);
+		while (length > 0)
+		{
+			auto numBytes = self->stream.readRaw (data, length);
+			if (numBytes == 0 || numBytes == kStreamIOError)
+				return CAIRO_STATUS_READ_ERROR;
+			data += numBytes;
+			length -= numBytes;
+		}
+		return CAIRO_STATUS_SUCCESS;
+	}
+
+	IPlatformResourceInputStream& stream;
+};
+
 //-----------------------------------------------------------------------------
 struct PNGMemoryWriter
 {
@@ -65,36 +91,56 @@ private:
 };
 
 //-----------------------------------------------------------------------------
-static SurfaceHandle createImageFromPath (const char* path)
+/** validates a decoded image and converts it to 32 bit if necessary.
+ *	Only touches the passed surface, so it is safe to call from any thread. */
+static SurfaceHandle finishDecodedImage (cairo_surface_t* surface)
 {
-	if (auto surface = cairo_image_surface_create_from_png (path))
+	if (!surface)
+		return {};
+	if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
 	{
-		if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
-		{
-			cairo_surface_destroy (surface);
-			return {};
-		}
-		if (cairo_image_surface_get_format (surface) == CAIRO_FORMAT_ARGB32)
-			return SurfaceHandle {surface};
-
-		// vstgui always works with 32 bit images
-		auto x = cairo_image_surface_get_width (surface);
-		auto y = cairo_image_surface_get_height (surface);
-		auto surface32 = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, x, y);
-		vstgui_assert (cairo_surface_status (surface32) == CAIRO_STATUS_SUCCESS);
-		auto context = cairo_create (surface32);
-		vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
-		cairo_set_source_surface (context, surface, 0, 0);
-		vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
-		cairo_paint (context);
-		vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
-		cairo_surface_flush (surface32);
-		vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
-		cairo_destroy (context);
 		cairo_surface_destroy (surface);
-		return SurfaceHandle {surface32};
+		return {};
 	}
-	return {};
+	if (cairo_image_surface_get_format (surface) == CAIRO_FORMAT_ARGB32)
+		return SurfaceHandle {surface};
+
+	// vstgui always works with 32 bit images
+	auto x = cairo_image_surface_get_width (surface);
+	auto y = cairo_image_surface_get_height (surface);
+	auto surface32 = cairo_image_surface_create (CAIRO_FORMAT_ARGB32, x, y);
+	vstgui_assert (cairo_surface_status (surface32) == CAIRO_STATUS_SUCCESS);
+	auto context = cairo_create (surface32);
+	vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
+	cairo_set_source_surface (context, surface, 0, 0);
+	vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
+	cairo_paint (context);
+	vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
+	cairo_surface_flush (surface32);
+	vstgui_assert (cairo_status (context) == CAIRO_STATUS_SUCCESS);
+	cairo_destroy (context);
+	cairo_surface_destroy (surface);
+	return SurfaceHandle {surface32};
+}
+
+//-----------------------------------------------------------------------------
+static SurfaceHandle createImageFromPath (const char* path)
+{
+	return finishDecodedImage (cairo_image_surface_create_from_png (path));
+}
+
+//-----------------------------------------------------------------------------
+static SurfaceHandle createImageFromMemory (const void* ptr, uint32_t memSize)
+{
+	PNGMemoryReader reader (reinterpret_cast<const uint8_t*> (ptr), memSize);
+	return finishDecodedImage (reader.create ());
+}
+
+//-----------------------------------------------------------------------------
+static SurfaceHandle createImageFromStream (IPlatformResourceInputStream& stream)
+{
+	PNGStreamReader reader (stream);
+	return finishDecodedImage (reader.create ());
 }
 
 //-----------------------------------------------------------------------------
@@ -111,14 +157,7 @@ private:
 
 	uint8_t* getAddress () const override { return address; }
 	uint32_t getBytesPerRow () const override { return bytesPerRow; }
-	PixelFormat getPixelFormat () const override
-	{
-#if __LITTLE_ENDIAN
-		return kBGRA;
-#else
-		return kARGB;
-#endif
-	}
+	PixelFormat getPixelFormat () const override { return Bitmap::getNativePixelFormat (); }
 
 	SharedPointer<Bitmap> bitmap;
 	SurfaceHandle surface;
@@ -131,27 +170,71 @@ private:
 SharedPointer<Bitmap> Bitmap::create (UTF8StringPtr absolutePath)
 {
 	if (auto surface = Cairo::CairoBitmapPrivate::createImageFromPath (absolutePath))
-	{
-		if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
-		{
-			cairo_surface_destroy (surface);
-			return nullptr;
-		}
 		return makeOwned<Bitmap> (surface);
-	}
 	return nullptr;
 }
 
 //-----------------------------------------------------------------------------
 SharedPointer<Bitmap> Bitmap::create (const void* ptr, uint32_t memSize)
 {
-	Cairo::CairoBitmapPrivate::PNGMemoryReader reader (reinterpret_cast<const uint8_t*> (ptr),
-													   memSize);
-	if (auto surface = reader.create ())
+	if (auto surface = Cairo::CairoBitmapPrivate::createImageFromMemory (ptr, memSize))
+		return makeOwned<Bitmap> (surface);
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+SharedPointer<Bitmap> Bitmap::create (IPlatformResourceInputStream& stream)
+{
+	if (auto surface = Cairo::CairoBitmapPrivate::createImageFromStream (stream))
+		return makeOwned<Bitmap> (surface);
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+SharedPointer<Bitmap> Bitmap::create (uint8_t* address, const CPoint& size, uint32_t bytesPerRow,
+									  std::function<void ()>&& release)
+{
+	auto width = static_cast<int> (size.x);
+	auto height = static_cast<int> (size.y);
+	if (static_cast<int> (bytesPerRow) != cairo_format_stride_for_width (CAIRO_FORMAT_ARGB32, width))
 	{
-		return makeOwned<Bitmap> (Cairo::SurfaceHandle {surface});
+		release ();
+		return nullptr;
 	}
-	return nullptr;
+	auto surface = cairo_image_surface_create_for_data (address, CAIRO_FORMAT_ARGB32, width, height,
+														static_cast<int> (bytesPerRow));
+	if (cairo_surface_status (surface) != CAIRO_STATUS_SUCCESS)
+	{
+		cairo_surface_destroy (surface);
+		release ();
+		return nullptr;
+	}
+	// the surface owns the release function from now on
+	static cairo_user_data_key_t releaseKey;
+	auto releaseFunc = new std::function<void ()> (std::move (release));
+	auto status = cairo_surface_set_user_data (surface, &releaseKey, releaseFunc, [] (void* data) {
+		auto func = reinterpret_cast<std::function<void ()>*> (data);
+		(*func) ();
+		delete func;
+	});
+	if (status != CAIRO_STATUS_SUCCESS)
+	{
+		cairo_surface_destroy (surface);
+		(*releaseFunc) ();
+		delete releaseFunc;
+		return nullptr;
+	}
+	return makeOwned<Bitmap> (SurfaceHandle {surface});
+}
+
+//-----------------------------------------------------------------------------
+auto Bitmap::getNativePixelFormat () -> IPlatformBitmapPixelAccess::PixelFormat
+{
+#if __LITTLE_ENDIAN
+	return IPlatformBitmapPixelAccess::kBGRA;
+#else
+	return IPlatformBitmapPixelAccess::kARGB;
+#endif
 }
 
 //-----------------------------------------------------------------------------
@@ -195,11 +278,6 @@ bool Bitmap::load (const CResourceDescription& desc)
 		}
 		if (auto s = CairoBitmapPrivate::createImageFromPath (path.data ()))
 		{
-			if (cairo_surface_status (s) != CAIRO_STATUS_SUCCESS)
-			{
-				cairo_surface_destroy (s);
-				return false;
-			}
 			surface = s;
 			size.x = cairo_image_surface_get_width (surface);
 			size.y = cairo_image_surface_get_height (surface);
@@ -23,6 +23,14 @@ class Bitmap : public IPlatformBitmap
 public:
 	static SharedPointer<Bitmap> create (UTF8StringPtr absolutePath);
 	static SharedPointer<Bitmap> create (const void* ptr, uint32_t memSize);
+	/** decodes the PNG data while reading it from the stream */
+	static SharedPointer<Bitmap> create (IPlatformResourceInputStream& stream);
+	/** uses the premultiplied pixels at address without copying them. release is called when the
+	 *	pixels are not used anymore, also if the bitmap could not be created */
+	static SharedPointer<Bitmap> create (uint8_t* address, const CPoint& size, uint32_t bytesPerRow,
+										 std::function<void ()>&& release);
+	/** the pixel format of the surfaces */
+	static IPlatformBitmapPixelAccess::PixelFormat getNativePixelFormat ();
 
 	Bitmap ();
 	explicit Bitmap (const CPoint& size);
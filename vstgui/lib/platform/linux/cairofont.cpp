@@ -14,6 +14,11 @@
 #include <pango/pango-features.h>
 #include <pango/pangofc-fontmap.h>
 #include <fontconfig/fontconfig.h>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -123,6 +128,200 @@ private:
 	}
 };
 
+//------------------------------------------------------------------------
+struct ShapedText
+{
+	PangoLayout* layout {nullptr};
+	PangoRectangle logicalExtents {};
+	CCoord baseline {0.};
+
+	ShapedText () = default;
+	ShapedText (const ShapedText&) = delete;
+	ShapedText& operator= (const ShapedText&) = delete;
+	~ShapedText ()
+	{
+		if (layout)
+			g_object_unref (layout);
+	}
+};
+using ShapedTextPtr = std::shared_ptr<const ShapedText>;
+
+//------------------------------------------------------------------------
+class LayoutCache
+{
+public:
+	static LayoutCache& instance ()
+	{
+		static LayoutCache gInstance;
+		return gInstance;
+	}
+
+	ShapedTextPtr get (PangoFont* font, int32_t style, const std::string& text)
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		Key key {font, style, text};
+		auto it = map.find (key);
+		if (it != map.end ())
+		{
+			++statistics.hits;
+			entries.splice (entries.begin (), entries, it->second);
+			return it->second->shapedText;
+		}
+		++statistics.misses;
+		auto shapedText = shape (font, style, text);
+		if (!shapedText || memoryBudget == 0)
+			return shapedText;
+		auto cost = estimateCost (text);
+		entries.push_front ({std::move (key), shapedText, PangoFontHandle (), cost});
+		if (font)
+			entries.front ().font.assign (static_cast<PangoFont*> (g_object_ref (font)));
+		map.emplace (entries.front ().key, entries.begin ());
+		memoryUsage += cost;
+		trim ();
+		return shapedText;
+	}
+
+	void setMemoryBudget (size_t bytes)
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		memoryBudget = bytes;
+		trim ();
+	}
+
+	size_t getMemoryBudget () const
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		return memoryBudget;
+	}
+
+	Font::LayoutCacheStatistics getStatistics () const
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		auto result = statistics;
+		result.numEntries = entries.size ();
+		result.memoryUsage = memoryUsage;
+		return result;
+	}
+
+	void clear ()
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		map.clear ();
+		entries.clear ();
+		memoryUsage = 0;
+	}
+
+private:
+	// a rough estimate of the memory of a layout with its glyph strings
+	static constexpr size_t kEntryBaseCost = 1024;
+	static constexpr size_t kCostPerByte = 48;
+	static constexpr size_t kDefaultMemoryBudget = 4 * 1024 * 1024;
+
+	struct Key
+	{
+		PangoFont* font;
+		int32_t style;
+		std::string text;
+
+		bool operator== (const Key& other) const
+		{
+			return font == other.font && style == other.style && text == other.text;
+		}
+	};
+
+	struct KeyHash
+	{
+		size_t operator() (const Key& key) const
+		{
+			auto h = std::hash<std::string> () (key.text);
+			h ^= std::hash<const void*> () (key.font) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			h ^= std::hash<int32_t> () (key.style) + 0x9e3779b9 + (h << 6) + (h >> 2);
+			return h;
+		}
+	};
+
+	struct Entry
+	{
+		Key key;
+		ShapedTextPtr shapedText;
+		// keeps the font alive so that the font pointer of the key stays unique
+		PangoFontHandle font;
+		size_t cost;
+	};
+	using EntryList = std::list<Entry>;
+
+	static size_t estimateCost (const std::string& text)
+	{
+		return kEntryBaseCost + text.size () * kCostPerByte;
+	}
+
+	static ShapedTextPtr shape (PangoFont* font, int32_t style, const std::string& text)
+	{
+		PangoContext* context = FontList::instance ().getFontContext ();
+		if (!context)
+			return nullptr;
+		auto result = std::make_shared<ShapedText> ();
+		result->layout = pango_layout_new (context);
+		if (!result->layout)
+			return nullptr;
+
+		if (font)
+		{
+			PangoFontDescription* desc = pango_font_describe (font);
+			if (desc)
+			{
+				pango_layout_set_font_description (result->layout, desc);
+				pango_font_description_free (desc);
+			}
+		}
+
+		if (style & (kUnderlineFace | kStrikethroughFace))
+		{
+			PangoAttrList* attrs = pango_attr_list_new ();
+			if (attrs)
+			{
+				if (style & kUnderlineFace)
+					pango_attr_list_insert (attrs,
+											pango_attr_underline_new (PANGO_UNDERLINE_SINGLE));
+				if (style & kStrikethroughFace)
+					pango_attr_list_insert (attrs, pango_attr_strikethrough_new (true));
+				pango_layout_set_attributes (result->layout, attrs);
+				pango_attr_list_unref (attrs);
+			}
+		}
+
+		pango_layout_set_text (result->layout, text.c_str (), -1);
+
+		pango_layout_get_pixel_extents (result->layout, nullptr, &result->logicalExtents);
+
+		PangoLayoutIter* iter = pango_layout_get_iter (result->layout);
+		if (iter)
+		{
+			result->baseline = pango_units_to_double (pango_layout_iter_get_baseline (iter));
+			pango_layout_iter_free (iter);
+		}
+		return result;
+	}
+
+	void trim ()
+	{
+		while (memoryUsage > memoryBudget && !entries.empty ())
+		{
+			auto& last = entries.back ();
+			memoryUsage -= last.cost;
+			map.erase (last.key);
+			entries.pop_back ();
+		}
+	}
+
+	mutable std::mutex mutex;
+	EntryList entries;
+	std::unordered_map<Key, EntryList::iterator, KeyHash> map;
+	size_t memoryBudget {kDefaultMemoryBudget};
+	size_t memoryUsage {0};
+	Font::LayoutCacheStatistics statistics;
+};
+
 //------------------------------------------------------------------------
 } // anonymous
 
@@ -218,50 +417,14 @@ void Font::drawString (const PlatformGraphicsDeviceContextPtr& context, IPlatfor
 	auto linuxString = dynamic_cast<LinuxString*> (string);
 	if (!linuxString)
 		return;
-	PangoContext* pangoContext = FontList::instance ().getFontContext ();
-	if (!pangoContext)
-		return;
-	PangoLayout* layout = pango_layout_new (pangoContext);
-	if (!layout)
+	auto shapedText =
+		LayoutCache::instance ().get (impl->font, impl->style, linuxString->get ());
+	if (!shapedText)
 		return;
 
-	if (impl->font)
-	{
-		PangoFontDescription* desc = pango_font_describe (impl->font);
-		if (desc)
-		{
-			pango_layout_set_font_description (layout, desc);
-			pango_font_description_free (desc);
-		}
-	}
-
-	PangoAttrList* attrs = pango_attr_list_new ();
-	if (attrs)
-	{
-		if (impl->style & kUnderlineFace)
-			pango_attr_list_insert (attrs, pango_attr_underline_new (PANGO_UNDERLINE_SINGLE));
-		if (impl->style & kStrikethroughFace)
-			pango_attr_list_insert (attrs, pango_attr_strikethrough_new (true));
-		pango_layout_set_attributes (layout, attrs);
-		pango_attr_list_unref (attrs);
-	}
-
-	pango_layout_set_text (layout, linuxString->get ().c_str (), -1);
-
-	PangoRectangle extents {};
-	pango_layout_get_pixel_extents (layout, nullptr, &extents);
-
-	PangoLayoutIter* iter = pango_layout_get_iter (layout);
-	CCoord baseline = 0.0;
-	if (iter)
-	{
-		baseline = pango_units_to_double (pango_layout_iter_get_baseline (iter));
-		pango_layout_iter_free (iter);
-	}
-
-	cairoContext->drawPangoLayout (layout, {p.x + extents.x, p.y + extents.y - baseline}, color);
-
-	g_object_unref (layout);
+	const auto& extents = shapedText->logicalExtents;
+	cairoContext->drawPangoLayout (
+		shapedText->layout, {p.x + extents.x, p.y + extents.y - shapedText->baseline}, color);
 }
 
 //------------------------------------------------------------------------
@@ -270,29 +433,9 @@ CCoord Font::getStringWidth (const PlatformGraphicsDeviceContextPtr&, IPlatformS
 {
 	if (auto linuxString = dynamic_cast<LinuxString*> (string))
 	{
-		int pangoWidth = 0;
-		PangoContext* context = FontList::instance ().getFontContext ();
-		if (context)
-		{
-			PangoLayout* layout = pango_layout_new (context);
-			if (layout)
-			{
-				if (impl->font)
-				{
-					PangoFontDescription* desc = pango_font_describe (impl->font);
-					if (desc)
-					{
-						pango_layout_set_font_description (layout, desc);
-						pango_font_description_free (desc);
-					}
-				}
-				pango_layout_set_text (layout, linuxString->get ().c_str (), -1);
-				pango_layout_get_pixel_size (layout, &pangoWidth, nullptr);
-				g_object_unref (layout);
-			}
-		}
-
-		return pangoWidth;
+		if (auto shapedText =
+				LayoutCache::instance ().get (impl->font, impl->style, linuxString->get ()))
+			return shapedText->logicalExtents.width;
 	}
 	return 0;
 }
@@ -303,6 +446,27 @@ bool Font::getAllFamilies (const FontFamilyCallback& callback)
 	return Cairo::FontList::instance ().getAllFontFamilies (callback);
 }
 
+//------------------------------------------------------------------------
+void Font::setLayoutCacheMemoryBudget (size_t bytes)
+{
+	LayoutCache::instance ().setMemoryBudget (bytes);
+}
+
+//------------------------------------------------------------------------
+size_t Font::getLayoutCacheMemoryBudget ()
+{
+	return LayoutCache::instance ().getMemoryBudget ();
+}
+
+//------------------------------------------------------------------------
+Font::LayoutCacheStatistics Font::getLayoutCacheStatistics ()
+{
+	return LayoutCache::instance ().getStatistics ();
+}
+
+//------------------------------------------------------------------------
+void Font::clearLayoutCache () { LayoutCache::instance ().clear (); }
+
 //------------------------------------------------------------------------
 } // Cairo
 } // VSTGUI
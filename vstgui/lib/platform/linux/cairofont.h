@@ -6,6 +6,7 @@
 
 #include "../iplatformfont.h"
 #include "../platformfactory.h"
+#include <cstdint>
 #include <memory>
 
 //------------------------------------------------------------------------
@@ -36,6 +37,22 @@ public:
 
 	static bool getAllFamilies (const FontFamilyCallback& callback);
 
+	struct LayoutCacheStatistics
+	{
+		uint64_t hits {0};
+		uint64_t misses {0};
+		size_t numEntries {0};
+		size_t memoryUsage {0};
+	};
+
+	/** the shaped text layouts are cached and shared between drawing and measuring. The cache is
+	 *	bounded by an estimated memory budget in bytes (zero disables the cache).
+	 */
+	static void setLayoutCacheMemoryBudget (size_t bytes);
+	static size_t getLayoutCacheMemoryBudget ();
+	static LayoutCacheStatistics getLayoutCacheStatistics ();
+	static void clearLayoutCache ();
+
 private:
 	struct Impl;
 	std::unique_ptr<Impl> impl;
@@ -6,6 +6,7 @@
 #include "cairobitmap.h"
 #include "cairopath.h"
 #include "cairogradient.h"
+#include "../../cbitmap.h"
 #include "../../crect.h"
 #include "../../cgraphicstransform.h"
 #include "../../ccolor.h"
@@ -13,6 +14,7 @@
 #include "../../clinestyle.h"
 
 #include <pango/pangocairo.h>
+#include <cmath>
 #include <stack>
 
 //------------------------------------------------------------------------
@@ -172,6 +174,72 @@ struct CairoGraphicsDeviceContext::Impl
 		cairo_restore (context);
 	}
 
+	/** the src part in pixels of the surface. Returns false if the part does not start and end on
+	 *	pixel boundaries, as a sub surface cannot sample between pixels like drawBitmap does.
+	 */
+	static bool calcSurfacePart (CRect src, double scaleFactor, CPoint surfaceSize, CRect& part)
+	{
+		auto toPixel = [scaleFactor] (CCoord value, CCoord& pixel) {
+			value *= scaleFactor;
+			pixel = std::round (value);
+			return std::abs (pixel - value) < 0.0001;
+		};
+		if (!toPixel (src.left, part.left) || !toPixel (src.top, part.top) ||
+			!toPixel (src.right, part.right) || !toPixel (src.bottom, part.bottom))
+			return false;
+		part.bound (CRect (CPoint (), surfaceSize));
+		return true;
+	}
+
+	/** fill dst with the part of the surface, repeated from the top left of dst */
+	void fillWithBitmapPart (cairo_surface_t* surface, CPoint surfaceSize, double scaleFactor,
+							 CRect part, CRect dst, double alpha, cairo_filter_t filter)
+	{
+		if (part.isEmpty () || dst.isEmpty ())
+			return;
+		auto isWholeSurface = part == CRect (CPoint (), surfaceSize);
+		auto partSurface = isWholeSurface
+							   ? cairo_surface_reference (surface)
+							   : cairo_surface_create_for_rectangle (surface, part.left, part.top,
+																	 part.getWidth (),
+																	 part.getHeight ());
+		auto pattern = cairo_pattern_create_for_surface (partSurface);
+		cairo_matrix_t matrix;
+		cairo_matrix_init_scale (&matrix, scaleFactor, scaleFactor);
+		cairo_matrix_translate (&matrix, -dst.left, -dst.top);
+		cairo_pattern_set_matrix (pattern, &matrix);
+		cairo_pattern_set_extend (pattern, CAIRO_EXTEND_REPEAT);
+		cairo_pattern_set_filter (pattern, filter);
+		cairo_set_source (context, pattern);
+		cairo_rectangle (context, dst.left, dst.top, dst.getWidth (), dst.getHeight ());
+		if (alpha != 1.)
+		{
+			cairo_save (context);
+			cairo_clip (context);
+			cairo_paint_with_alpha (context, alpha);
+			cairo_restore (context);
+		}
+		else
+		{
+			cairo_fill (context);
+		}
+		cairo_pattern_destroy (pattern);
+		cairo_surface_destroy (partSurface);
+	}
+
+	static cairo_filter_t toCairoFilter (BitmapInterpolationQuality quality)
+	{
+		switch (quality)
+		{
+			case BitmapInterpolationQuality::kLow:
+				return CAIRO_FILTER_FAST;
+			case BitmapInterpolationQuality::kHigh:
+				return CAIRO_FILTER_BEST;
+			default:
+				return CAIRO_FILTER_GOOD;
+		}
+	}
+
 	void applyLineWidthCTM ()
 	{
 		auto p = calcLineTranslate ();
@@ -536,15 +604,11 @@ bool CairoGraphicsDeviceContext::drawGraphicsPath (IPlatformGraphicsPath& path,
 	if (!cairoPath)
 		return false;
 	impl->doInContext ([&] () {
-		std::unique_ptr<Cairo::GraphicsPath> alignedPath;
-		if (impl->state.drawMode.integralMode ())
-		{
-			alignedPath = cairoPath->copyPixelAlign ([&] (CPoint p) {
-				p = pixelAlign (impl->state.tm, p);
-				return p;
-			});
-		}
-		auto p = alignedPath ? alignedPath->getCairoPath () : cairoPath->getCairoPath ();
+		auto p = impl->state.drawMode.integralMode ()
+					 ? cairoPath->getPixelAlignedCairoPath (
+						   impl->state.tm,
+						   [&] (CPoint point) { return pixelAlign (impl->state.tm, point); })
+					 : cairoPath->getCairoPath ();
 		if (transformation)
 		{
 			cairo_matrix_t currentMatrix;
@@ -596,15 +660,11 @@ bool CairoGraphicsDeviceContext::fillLinearGradient (IPlatformGraphicsPath& path
 	if (!cairoGradient)
 		return false;
 	impl->doInContext ([&] () {
-		std::unique_ptr<Cairo::GraphicsPath> alignedPath;
-		if (impl->state.drawMode.integralMode ())
-		{
-			alignedPath = cairoPath->copyPixelAlign ([&] (CPoint p) {
-				p = pixelAlign (impl->state.tm, p);
-				return p;
-			});
-		}
-		auto p = alignedPath ? alignedPath->getCairoPath () : cairoPath->getCairoPath ();
+		auto p = impl->state.drawMode.integralMode ()
+					 ? cairoPath->getPixelAlignedCairoPath (
+						   impl->state.tm,
+						   [&] (CPoint point) { return pixelAlign (impl->state.tm, point); })
+					 : cairoPath->getCairoPath ();
 		cairo_append_path (impl->context, p);
 		cairo_set_source (impl->context, cairoGradient->getLinearGradient (startPoint, endPoint));
 		if (evenOdd)
@@ -629,15 +689,11 @@ bool CairoGraphicsDeviceContext::fillRadialGradient (IPlatformGraphicsPath& path
 	if (!cairoGradient)
 		return false;
 	impl->doInContext ([&] () {
-		std::unique_ptr<Cairo::GraphicsPath> alignedPath;
-		if (impl->state.drawMode.integralMode ())
-		{
-			alignedPath = cairoPath->copyPixelAlign ([&] (CPoint p) {
-				p = pixelAlign (impl->state.tm, p);
-				return p;
-			});
-		}
-		auto p = alignedPath ? alignedPath->getCairoPath () : cairoPath->getCairoPath ();
+		auto p = impl->state.drawMode.integralMode ()
+					 ? cairoPath->getPixelAlignedCairoPath (
+						   impl->state.tm,
+						   [&] (CPoint point) { return pixelAlign (impl->state.tm, point); })
+					 : cairoPath->getCairoPath ();
 		cairo_append_path (impl->context, p);
 
 		const auto& radialGradient =
@@ -720,7 +776,67 @@ void CairoGraphicsDeviceContext::setTransformMatrix (const TransformMatrix& tm)
 //------------------------------------------------------------------------
 const IPlatformGraphicsDeviceContextBitmapExt* CairoGraphicsDeviceContext::asBitmapExt () const
 {
-	return nullptr;
+	return this;
+}
+
+//------------------------------------------------------------------------
+bool CairoGraphicsDeviceContext::drawBitmapNinePartTiled (IPlatformBitmap& bitmap, CRect dest,
+														  const CNinePartTiledDescription& desc,
+														  double alpha,
+														  BitmapInterpolationQuality quality) const
+{
+	auto cairoBitmap = dynamic_cast<Cairo::Bitmap*> (&bitmap);
+	if (!cairoBitmap)
+		return false;
+	alpha *= impl->state.globalAlpha;
+	if (alpha == 0.)
+		return true;
+
+	auto scaleFactor = cairoBitmap->getScaleFactor ();
+	const auto& size = cairoBitmap->getSize ();
+	CRect bitmapBounds (0, 0, size.x / scaleFactor, size.y / scaleFactor);
+	CRect sourceRects[CNinePartTiledDescription::kPartCount];
+	CRect destRects[CNinePartTiledDescription::kPartCount];
+	desc.calcRects (bitmapBounds, sourceRects);
+	desc.calcRects (dest, destRects);
+	CRect surfaceParts[CNinePartTiledDescription::kPartCount];
+	for (auto i = 0u; i < CNinePartTiledDescription::kPartCount; ++i)
+	{
+		if (!Impl::calcSurfacePart (sourceRects[i], scaleFactor, size, surfaceParts[i]))
+			return false;
+	}
+
+	auto filter = Impl::toCairoFilter (quality);
+	impl->doInContext ([&] () {
+		// one fill per part, the corners have the size of their source and are not repeated
+		for (auto i = 0u; i < CNinePartTiledDescription::kPartCount; ++i)
+			impl->fillWithBitmapPart (cairoBitmap->getSurface (), size, scaleFactor,
+									  surfaceParts[i], destRects[i], alpha, filter);
+	});
+	return true;
+}
+
+//------------------------------------------------------------------------
+bool CairoGraphicsDeviceContext::fillRectWithBitmap (IPlatformBitmap& bitmap, CRect srcRect,
+													 CRect dstRect, double alpha,
+													 BitmapInterpolationQuality quality) const
+{
+	auto cairoBitmap = dynamic_cast<Cairo::Bitmap*> (&bitmap);
+	if (!cairoBitmap)
+		return false;
+	CRect surfacePart;
+	if (!Impl::calcSurfacePart (srcRect, cairoBitmap->getScaleFactor (), cairoBitmap->getSize (),
+								surfacePart))
+		return false;
+	alpha *= impl->state.globalAlpha;
+	if (alpha == 0.)
+		return true;
+	impl->doInContext ([&] () {
+		impl->fillWithBitmapPart (cairoBitmap->getSurface (), cairoBitmap->getSize (),
+								  cairoBitmap->getScaleFactor (), surfacePart, dstRect, alpha,
+								  Impl::toCairoFilter (quality));
+	});
+	return true;
 }
 
 //------------------------------------------------------------------------
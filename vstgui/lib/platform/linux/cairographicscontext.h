@@ -14,7 +14,8 @@ namespace VSTGUI {
 class CairoGraphicsDevice;
 
 //------------------------------------------------------------------------
-class CairoGraphicsDeviceContext : public IPlatformGraphicsDeviceContext
+class CairoGraphicsDeviceContext : public IPlatformGraphicsDeviceContext,
+								   public IPlatformGraphicsDeviceContextBitmapExt
 {
 public:
 	CairoGraphicsDeviceContext (const CairoGraphicsDevice& device,
@@ -62,6 +63,13 @@ public:
 	// extension
 	const IPlatformGraphicsDeviceContextBitmapExt* asBitmapExt () const override;
 
+	// IPlatformGraphicsDeviceContextBitmapExt
+	bool drawBitmapNinePartTiled (IPlatformBitmap& bitmap, CRect dest,
+								  const CNinePartTiledDescription& desc, double alpha,
+								  BitmapInterpolationQuality quality) const override;
+	bool fillRectWithBitmap (IPlatformBitmap& bitmap, CRect srcRect, CRect dstRect, double alpha,
+							 BitmapInterpolationQuality quality) const override;
+
 	// private
 	void drawPangoLayout (void* layout, CPoint pos, CColor color) const;
 
@@ -157,6 +157,18 @@ std::unique_ptr<GraphicsPath> GraphicsPath::copyPixelAlign (const std::function<
 	return result;
 }
 
+//------------------------------------------------------------------------
+cairo_path_t* GraphicsPath::getPixelAlignedCairoPath (
+	const CGraphicsTransform& transform, const std::function<CPoint (CPoint)>& pixelAlignFunc)
+{
+	if (!pixelAlignedPath || pixelAlignedPathTransform != transform)
+	{
+		pixelAlignedPath = copyPixelAlign (pixelAlignFunc);
+		pixelAlignedPathTransform = transform;
+	}
+	return pixelAlignedPath->getCairoPath ();
+}
+
 //------------------------------------------------------------------------
 bool GraphicsPath::hitTest (const CPoint& p, bool evenOddFilled,
                             CGraphicsTransform* transform) const
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "../../cgraphicspath.h"
+#include "../../cgraphicstransform.h"
 #include "../iplatformgraphicspath.h"
 #include "cairoutils.h"
 
@@ -36,6 +37,9 @@ public:
 	cairo_path_t* getCairoPath () const { return path; }
 	std::unique_ptr<GraphicsPath>
 		copyPixelAlign (const std::function<CPoint (CPoint)>& pixelAlignFunc);
+	/** the pixel aligned copy of the path, which is cached for the last used transform */
+	cairo_path_t* getPixelAlignedCairoPath (const CGraphicsTransform& transform,
+											const std::function<CPoint (CPoint)>& pixelAlignFunc);
 
 	// IPlatformGraphicsPath
 	void addArc (const CRect& rect, double startAngle, double endAngle, bool clockwise) override;
@@ -58,6 +62,8 @@ public:
 private:
 	ContextHandle context;
 	cairo_path_t* path {nullptr};
+	std::unique_ptr<GraphicsPath> pixelAlignedPath;
+	CGraphicsTransform pixelAlignedPathTransform;
 };
 
 //------------------------------------------------------------------------
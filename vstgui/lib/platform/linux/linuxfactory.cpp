@@ -141,6 +141,26 @@ PlatformBitmapPtr LinuxFactory::createBitmapFromMemory (const void* ptr,
 	return Cairo::Bitmap::create (ptr, memSize);
 }
 
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr
+	LinuxFactory::createBitmapFromStream (IPlatformResourceInputStream& stream) const noexcept
+{
+	return Cairo::Bitmap::create (stream);
+}
+
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr LinuxFactory::createBitmapFromPixels (
+	uint8_t* address, const CPoint& size, uint32_t bytesPerRow,
+	IPlatformBitmapPixelAccess::PixelFormat format, std::function<void ()>&& release) const noexcept
+{
+	if (format != Cairo::Bitmap::getNativePixelFormat ())
+	{
+		release ();
+		return nullptr;
+	}
+	return Cairo::Bitmap::create (address, size, bytesPerRow, std::move (release));
+}
+
 //-----------------------------------------------------------------------------
 PNGBitmapBuffer LinuxFactory::createBitmapMemoryPNGRepresentation (
 	const PlatformBitmapPtr& bitmap) const noexcept
@@ -5,6 +5,8 @@
 #pragma once
 
 #include "../platformfactory.h"
+#include "../iplatformbitmap.h"
+#include <functional>
 
 //-----------------------------------------------------------------------------
 namespace VSTGUI {
@@ -72,6 +74,24 @@ public:
 	 */
 	PlatformBitmapPtr createBitmapFromMemory (const void* ptr,
 											  uint32_t memSize) const noexcept final;
+	/** Create a platform bitmap object from a stream
+	 *	@param stream the stream to read the encoded bitmap data from
+	 *	@return platform bitmap or nullptr on failure
+	 */
+	PlatformBitmapPtr
+		createBitmapFromStream (IPlatformResourceInputStream& stream) const noexcept final;
+	/** Create a platform bitmap object using premultiplied 32 bit pixels without copying them
+	 *	@param address address of the first row
+	 *	@param size size of the bitmap in pixels
+	 *	@param bytesPerRow bytes per row, must be the row size cairo uses for the width
+	 *	@param format pixel format of the pixels
+	 *	@param release called when the pixels are not used anymore, also on failure
+	 *	@return platform bitmap or nullptr if the pixels can not be used directly
+	 */
+	PlatformBitmapPtr createBitmapFromPixels (uint8_t* address, const CPoint& size,
+											  uint32_t bytesPerRow,
+											  IPlatformBitmapPixelAccess::PixelFormat format,
+											  std::function<void ()>&& release) const noexcept;
 	/** Create a memory representation of the platform bitmap in PNG format.
 	 *	@param bitmap the platform bitmap object
 	 *	@return memory buffer containing the PNG representation of the bitmap
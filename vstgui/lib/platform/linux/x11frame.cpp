@@ -23,7 +23,10 @@
 #include "cairographicscontext.h"
 #include "x11platform.h"
 #include "x11utils.h"
+#include <algorithm>
 #include <cassert>
+#include <chrono>
+#include <cmath>
 #include <iostream>
 #include <unordered_map>
 #include <X11/Xlib.h>
@@ -181,11 +184,19 @@ struct DrawHandler
 	void onSizeChanged (const CPoint& size)
 	{
 		cairo_xcb_surface_set_size (windowSurface, size.x, size.y);
-		backBuffer = Cairo::SurfaceHandle (cairo_surface_create_similar (
-			windowSurface, CAIRO_CONTENT_COLOR_ALPHA, size.x, size.y));
-		backBufferSize.setSize (size);
-		auto cairoDevice = std::static_pointer_cast<CairoGraphicsDevice> (device);
-		drawContext = std::make_shared<CairoGraphicsDeviceContext> (*cairoDevice, backBuffer);
+		auto width = static_cast<int> (std::ceil (size.x));
+		auto height = static_cast<int> (std::ceil (size.y));
+		if (width > backBufferWidth || height > backBufferHeight ||
+			shouldShrinkBackBuffer (width, height))
+		{
+			// grow in steps to prevent reallocating the back buffer on every step of a live resize
+			backBufferWidth = roundUpToBackBufferGranularity (width);
+			backBufferHeight = roundUpToBackBufferGranularity (height);
+			backBuffer = Cairo::SurfaceHandle (cairo_surface_create_similar (
+				windowSurface, CAIRO_CONTENT_COLOR_ALPHA, backBufferWidth, backBufferHeight));
+			auto cairoDevice = std::static_pointer_cast<CairoGraphicsDevice> (device);
+			drawContext = std::make_shared<CairoGraphicsDeviceContext> (*cairoDevice, backBuffer);
+		}
 	}
 
 	void draw (const CInvalidRectList& dirtyRects, IPlatformFrameCallback* frame)
@@ -198,26 +209,105 @@ struct DrawHandler
 		xcb_flush (RunLoop::instance ().getXcbConnection ());
 	}
 
+	/** move the pixels of src by distance inside the back buffer. The moved pixels are presented
+	 *	with the next draw call. */
+	void scroll (const CRect& src, const CPoint& distance)
+	{
+		auto dst = toIntegralRect (CRect (src).offset (distance.x, distance.y));
+		Cairo::ContextHandle context (cairo_create (backBuffer));
+		cairo_rectangle (context, dst.x, dst.y, dst.width, dst.height);
+		cairo_clip (context);
+		// source and destination overlap, so copy via an intermediate group
+		cairo_push_group (context);
+		cairo_set_source_surface (context, backBuffer, distance.x, distance.y);
+		cairo_paint (context);
+		cairo_pop_group_to_source (context);
+		cairo_set_operator (context, CAIRO_OPERATOR_SOURCE);
+		cairo_paint (context);
+		cairo_surface_flush (backBuffer);
+		movedRects.emplace_back (dst);
+	}
+
+	const DrawStatistics& getStatistics () const { return statistics; }
+
 private:
+	static constexpr int kBackBufferGranularity = 128;
+
 	Cairo::SurfaceHandle windowSurface;
 	Cairo::SurfaceHandle backBuffer;
-	CRect backBufferSize;
+	int backBufferWidth {0};
+	int backBufferHeight {0};
 	std::shared_ptr<CairoGraphicsDeviceContext> drawContext;
 	PlatformGraphicsDevicePtr device;
+	DrawStatistics statistics;
+	std::vector<cairo_rectangle_int_t> movedRects;
+
+	static int roundUpToBackBufferGranularity (int value)
+	{
+		return std::max (1, (value + kBackBufferGranularity - 1) / kBackBufferGranularity) *
+			   kBackBufferGranularity;
+	}
+
+	bool shouldShrinkBackBuffer (int width, int height) const
+	{
+		// release memory if the window uses less than a quarter of the back buffer
+		auto neededArea = static_cast<int64_t> (roundUpToBackBufferGranularity (width)) *
+						  roundUpToBackBufferGranularity (height);
+		auto backBufferArea = static_cast<int64_t> (backBufferWidth) * backBufferHeight;
+		return neededArea * 4 < backBufferArea;
+	}
+
+	static cairo_rectangle_int_t toIntegralRect (const CRect& r)
+	{
+		cairo_rectangle_int_t result;
+		result.x = static_cast<int> (std::floor (r.left));
+		result.y = static_cast<int> (std::floor (r.top));
+		result.width = static_cast<int> (std::ceil (r.right)) - result.x;
+		result.height = static_cast<int> (std::ceil (r.bottom)) - result.y;
+		return result;
+	}
 
 	void blitBackbufferToWindow (const CInvalidRectList& rects)
 	{
-		Cairo::ContextHandle windowContext (cairo_create (windowSurface));
-		cairo_set_source_surface (windowContext, backBuffer, 0, 0);
-		for (auto rect : rects)
+		// combine all dirty rects into one region of non overlapping rectangles and present it
+		// with one fill
+		uint64_t pixelsDrawn = 0;
+		auto region = cairo_region_create ();
+		for (const auto& rect : rects)
+		{
+			auto r = toIntegralRect (rect);
+			if (r.width <= 0 || r.height <= 0)
+				continue;
+			pixelsDrawn += static_cast<uint64_t> (r.width) * r.height;
+			cairo_region_union_rectangle (region, &r);
+		}
+		// the scrolled pixels are already in the back buffer and only need to be presented
+		for (auto& r : movedRects)
+			cairo_region_union_rectangle (region, &r);
+		movedRects.clear ();
+		uint64_t pixelsPresented = 0;
+		auto numRects = cairo_region_num_rectangles (region);
+		if (numRects > 0)
 		{
-			cairo_rectangle (windowContext, rect.left, rect.top, rect.getWidth (),
-							 rect.getHeight ());
-			cairo_clip_preserve (windowContext);
+			Cairo::ContextHandle windowContext (cairo_create (windowSurface));
+			cairo_set_source_surface (windowContext, backBuffer, 0, 0);
+			for (auto i = 0; i < numRects; ++i)
+			{
+				cairo_rectangle_int_t r;
+				cairo_region_get_rectangle (region, i, &r);
+				cairo_rectangle (windowContext, r.x, r.y, r.width, r.height);
+				pixelsPresented += static_cast<uint64_t> (r.width) * r.height;
+			}
 			cairo_fill (windowContext);
-			cairo_reset_clip (windowContext);
+			cairo_surface_flush (windowSurface);
 		}
-		cairo_surface_flush (windowSurface);
+		cairo_region_destroy (region);
+
+		++statistics.numFrames;
+		statistics.lastFramePixelsDrawn = pixelsDrawn;
+		statistics.lastFramePixelsPresented = pixelsPresented;
+		statistics.totalPixelsDrawn += pixelsDrawn;
+		statistics.totalPixelsPresented += pixelsPresented;
 	}
 };
 
@@ -321,10 +411,28 @@ struct Frame::Impl : IFrameEventHandler
 	CCursorType currentCursor {kCursorDefault};
 	uint32_t pointerGrabed {0};
 	XdndHandler dndHandler;
+	bool keepMotionEventHistory;
+
+	using Clock = std::chrono::steady_clock;
+	// input latency measurement
+	Clock::time_point inputEventTime;
+	Clock::time_point oldestUnpresentedInputTime;
+	bool inInputEvent {false};
+	bool hasUnpresentedInput {false};
+	uint64_t numInputEvents {0};
+	uint64_t numCoalescedMotionEvents {0};
+	uint64_t lastInputLatency {0};
+	uint64_t maxInputLatency {0};
 
 	//------------------------------------------------------------------------
-	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame)
-	: window (parent, size), drawHandler (window), frame (frame), dndHandler (&window, frame)
+	Impl (::Window parent, CPoint size, IPlatformFrameCallback* frame,
+		  const CInvalidRectList::Policy& invalidRectListPolicy, bool keepMotionEventHistory)
+	: window (parent, size)
+	, drawHandler (window)
+	, frame (frame)
+	, dirtyRects (invalidRectListPolicy)
+	, dndHandler (&window, frame)
+	, keepMotionEventHistory (keepMotionEventHistory)
 	{
 		RunLoop::instance ().registerWindowEventHandler (window.getID (), this);
 	}
@@ -366,11 +474,43 @@ struct Frame::Impl : IFrameEventHandler
 	{
 		drawHandler.draw (dirtyRects, frame);
 		dirtyRects.clear ();
+		if (hasUnpresentedInput)
+		{
+			hasUnpresentedInput = false;
+			lastInputLatency = static_cast<uint64_t> (
+				std::chrono::duration_cast<std::chrono::microseconds> (
+					Clock::now () - oldestUnpresentedInputTime)
+					.count ());
+			maxInputLatency = std::max (maxInputLatency, lastInputLatency);
+		}
 	}
 
+	//------------------------------------------------------------------------
+	/** marks the scope of handling an input event to measure the time until its changes are
+	 *	presented */
+	struct InputEventScope
+	{
+		InputEventScope (Impl& impl) : impl (impl)
+		{
+			auto& runLoop = RunLoop::instance ();
+			impl.inputEventTime = runLoop.getCurrentEventTime ();
+			impl.inInputEvent = true;
+			++impl.numInputEvents;
+			impl.numCoalescedMotionEvents += runLoop.getCurrentEventNumCoalesced ();
+		}
+		~InputEventScope () noexcept { impl.inInputEvent = false; }
+
+		Impl& impl;
+	};
+
 	//------------------------------------------------------------------------
 	void invalidRect (CRect r)
 	{
+		if (inInputEvent && !hasUnpresentedInput)
+		{
+			oldestUnpresentedInputTime = inputEventTime;
+			hasUnpresentedInput = true;
+		}
 		dirtyRects.add (r);
 		if (redrawTimer)
 			return;
@@ -381,6 +521,56 @@ struct Frame::Impl : IFrameEventHandler
 		});
 	}
 
+	//------------------------------------------------------------------------
+	bool scrollRect (const CRect& src, const CPoint& distance)
+	{
+		if (distance.x == 0. && distance.y == 0.)
+			return true;
+		// only whole pixels can be moved
+		if (distance.x != std::round (distance.x) || distance.y != std::round (distance.y))
+			return false;
+		CRect windowRect (CPoint (), window.getSize ());
+		CRect source (src);
+		source.makeIntegral ();
+		source.bound (windowRect);
+		CRect dest (source);
+		dest.offset (distance.x, distance.y);
+		dest.bound (windowRect);
+		if (dest.isEmpty ())
+			return false;
+		source = dest;
+		source.offset (-distance.x, -distance.y);
+
+		// pending dirty rects move with the content
+		std::vector<CRect> movedDirtyRects;
+		for (const auto& r : dirtyRects)
+		{
+			CRect moved (r);
+			moved.bound (source);
+			if (moved.isEmpty ())
+				continue;
+			moved.offset (distance.x, distance.y);
+			movedDirtyRects.emplace_back (moved);
+		}
+		drawHandler.scroll (source, distance);
+		for (const auto& r : movedDirtyRects)
+			invalidRect (r);
+
+		// the exposed strips
+		CRect area (src);
+		area.bound (windowRect);
+		area.unite (dest);
+		if (dest.top > area.top)
+			invalidRect (CRect (area.left, area.top, area.right, dest.top));
+		if (dest.bottom < area.bottom)
+			invalidRect (CRect (area.left, dest.bottom, area.right, area.bottom));
+		if (dest.left > area.left)
+			invalidRect (CRect (area.left, area.top, dest.left, area.bottom));
+		if (dest.right < area.right)
+			invalidRect (CRect (dest.right, area.top, area.right, area.bottom));
+		return true;
+	}
+
 	//------------------------------------------------------------------------
 	void grabPointer ()
 	{
@@ -421,6 +611,7 @@ struct Frame::Impl : IFrameEventHandler
 	//------------------------------------------------------------------------
 	void onEvent (xcb_key_press_event_t& event) override
 	{
+		InputEventScope inputEventScope (*this);
 		auto type = (event.response_type & ~0x80);
 		auto keyEvent = RunLoop::instance ().getCurrentKeyEvent ();
 		frame->platformOnEvent (keyEvent);
@@ -429,6 +620,7 @@ struct Frame::Impl : IFrameEventHandler
 	//------------------------------------------------------------------------
 	void onEvent (xcb_button_press_event_t& event) override
 	{
+		InputEventScope inputEventScope (*this);
 		CPoint where (event.event_x, event.event_y);
 		if ((event.response_type & ~0x80) == XCB_BUTTON_PRESS) // mouse down or wheel
 		{
@@ -500,6 +692,7 @@ struct Frame::Impl : IFrameEventHandler
 	//------------------------------------------------------------------------
 	void onEvent (xcb_motion_notify_event_t& event) override
 	{
+		InputEventScope inputEventScope (*this);
 		MouseMoveEvent moveEvent;
 		moveEvent.mousePosition (event.event_x, event.event_y);
 		setupMouseEventButtons (moveEvent, event.state);
@@ -511,6 +704,9 @@ struct Frame::Impl : IFrameEventHandler
 		xcb_get_motion_events (xcb, window.getID (), event.time, event.time + 10000000);
 	}
 
+	//------------------------------------------------------------------------
+	bool wantsMotionEventHistory () const override { return keepMotionEventHistory; }
+
 	//------------------------------------------------------------------------
 	void onEvent (xcb_enter_notify_event_t& event) override
 	{
@@ -640,7 +836,10 @@ Frame::Frame (IPlatformFrameCallback* frame, const CRect& size, uint32_t parent,
 		RunLoop::init (cfg->runLoop);
 	}
 
-	impl = std::unique_ptr<Impl> (new Impl (parent, {size.getWidth (), size.getHeight ()}, frame));
+	impl = std::unique_ptr<Impl> (
+		new Impl (parent, {size.getWidth (), size.getHeight ()}, frame,
+				  cfg ? cfg->invalidRectListPolicy : CInvalidRectList::Policy (),
+				  cfg ? cfg->keepMotionEventHistory : false));
 
 	frame->platformOnActivate (true);
 }
@@ -729,9 +928,7 @@ bool Frame::invalidRect (const CRect& rect)
 //------------------------------------------------------------------------
 bool Frame::scrollRect (const CRect& src, const CPoint& distance)
 {
-	(void)src;
-	(void)distance;
-	return false;
+	return impl->scrollRect (src, distance);
 }
 
 //------------------------------------------------------------------------
@@ -760,6 +957,29 @@ uint32_t Frame::getX11WindowID () const
 	return impl->window.getID ();
 }
 
+//------------------------------------------------------------------------
+DrawStatistics Frame::getDrawStatistics () const
+{
+	auto statistics = impl->drawHandler.getStatistics ();
+	statistics.numInputEvents = impl->numInputEvents;
+	statistics.numCoalescedMotionEvents = impl->numCoalescedMotionEvents;
+	statistics.lastInputLatency = impl->lastInputLatency;
+	statistics.maxInputLatency = impl->maxInputLatency;
+	return statistics;
+}
+
+//------------------------------------------------------------------------
+void Frame::setKeepMotionEventHistory (bool state)
+{
+	impl->keepMotionEventHistory = state;
+}
+
+//------------------------------------------------------------------------
+bool Frame::getKeepMotionEventHistory () const
+{
+	return impl->keepMotionEventHistory;
+}
+
 //------------------------------------------------------------------------
 SharedPointer<IPlatformTextEdit> Frame::createPlatformTextEdit (IPlatformTextEditCallback* textEdit)
 {
@@ -60,6 +60,9 @@ private:
 	bool setupGenericOptionMenu (bool use, GenericOptionMenuTheme* theme = nullptr) override;
 
 	uint32_t getX11WindowID () const override;
+	DrawStatistics getDrawStatistics () const override;
+	void setKeepMotionEventHistory (bool state) override;
+	bool getKeepMotionEventHistory () const override;
 
 	void optionMenuPopupStarted () override;
 	void optionMenuPopupStopped () override;
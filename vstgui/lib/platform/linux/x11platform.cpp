@@ -10,6 +10,7 @@
 #include "x11frame.h"
 #include "x11dragging.h"
 #include "cairobitmap.h"
+#include <algorithm>
 #include <cassert>
 #include <chrono>
 #include <array>
@@ -18,6 +19,7 @@
 #include <locale>
 #include <link.h>
 #include <unordered_map>
+#include <vector>
 #include <codecvt>
 #include <xcb/xcb.h>
 #include <xcb/xcb_cursor.h>
@@ -109,6 +111,14 @@ const VirtMap shiftKeyMap = {{XKB_KEY_KP_Page_Up, VirtualKey::PageUp},
 struct RunLoop::Impl : IEventHandler
 {
 	using WindowEventHandlerMap = std::unordered_map<uint32_t, IFrameEventHandler*>;
+	using Clock = std::chrono::steady_clock;
+
+	struct PendingMotionEvent
+	{
+		xcb_motion_notify_event_t* event;
+		Clock::time_point receiveTime;
+		uint32_t numCoalesced;
+	};
 
 	SharedPointer<IRunLoop> runLoop;
 	std::atomic<uint32_t> useCount {0};
@@ -122,6 +132,9 @@ struct RunLoop::Impl : IEventHandler
 	std::array<xcb_cursor_t, CCursorType::kCursorIBeam + 1> cursors {{XCB_CURSOR_NONE}};
 	KeyboardEvent lastUnprocessedKeyEvent;
 	uint32_t lastUtf32KeyEventChar {0};
+	std::vector<PendingMotionEvent> pendingMotionEvents;
+	Clock::time_point currentEventTime;
+	uint32_t currentEventNumCoalesced {0};
 	cairo_device_t* device {nullptr};
 
 	void init (const SharedPointer<IRunLoop>& inRunLoop)
@@ -277,110 +290,165 @@ struct RunLoop::Impl : IEventHandler
 		lastUnprocessedKeyEvent = std::move (keyEvent);
 	}
 
+	//------------------------------------------------------------------------
+	/** keep only the newest motion event per window until another event is read, returns false
+	 *	if the event must be dispatched immediately */
+	bool queueMotionEvent (xcb_motion_notify_event_t* event, Clock::time_point receiveTime)
+	{
+		auto handler = windowEventHandlerMap.find (event->event);
+		if (handler == windowEventHandlerMap.end () || handler->second->wantsMotionEventHistory ())
+			return false;
+		auto it = std::find_if (
+			pendingMotionEvents.begin (), pendingMotionEvents.end (),
+			[&] (const auto& pending) { return pending.event->event == event->event; });
+		if (it == pendingMotionEvents.end ())
+		{
+			pendingMotionEvents.push_back ({event, receiveTime, 0});
+			return true;
+		}
+		// keep the receive time of the oldest event for the latency measurement
+		std::free (it->event);
+		it->event = event;
+		++it->numCoalesced;
+		return true;
+	}
+
+	//------------------------------------------------------------------------
+	void flushMotionEvents ()
+	{
+		if (pendingMotionEvents.empty ())
+			return;
+		auto events = std::move (pendingMotionEvents);
+		pendingMotionEvents.clear ();
+		for (auto& pending : events)
+			handleEvent (reinterpret_cast<xcb_generic_event_t*> (pending.event),
+						 pending.receiveTime, pending.numCoalesced);
+	}
+
+	//------------------------------------------------------------------------
 	void onEvent () override
 	{
 		while (auto event = xcb_poll_for_event (xcbConnection))
 		{
-			auto type = event->response_type & ~0x80;
-			switch (type)
+			auto receiveTime = Clock::now ();
+			if ((event->response_type & ~0x80) == XCB_MOTION_NOTIFY)
 			{
-				case XCB_KEY_PRESS:
-				{
-					auto ev = reinterpret_cast<xcb_key_press_event_t*> (event);
-					onKeyEvent (*ev, true);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_KEY_RELEASE:
-				{
-					auto ev = reinterpret_cast<xcb_key_release_event_t*> (event);
-					onKeyEvent (*ev, false);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_BUTTON_PRESS:
-				{
-					auto ev = reinterpret_cast<xcb_button_press_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_BUTTON_RELEASE:
-				{
-					auto ev = reinterpret_cast<xcb_button_release_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_MOTION_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_motion_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_ENTER_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_enter_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_LEAVE_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_leave_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
-				case XCB_EXPOSE:
-				{
-					auto ev = reinterpret_cast<xcb_expose_event_t*> (event);
-					dispatchEvent (*ev, ev->window);
-					break;
-				}
-				case XCB_UNMAP_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_unmap_notify_event_t*> (event);
-					break;
-				}
-				case XCB_MAP_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_map_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->window);
-					break;
-				}
-				case XCB_CONFIGURE_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_configure_notify_event_t*> (event);
-					break;
-				}
-				case XCB_PROPERTY_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_property_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->window);
-					break;
-				}
-				case XCB_SELECTION_NOTIFY:
-				{
-					auto ev = reinterpret_cast<xcb_selection_notify_event_t*> (event);
-					dispatchEvent (*ev, ev->requestor);
-					break;
-				}
-				case XCB_CLIENT_MESSAGE:
-				{
-					auto ev = reinterpret_cast<xcb_client_message_event_t*> (event);
-					dispatchEvent (*ev, ev->window);
-					break;
-				}
-				case XCB_FOCUS_IN:
-				case XCB_FOCUS_OUT:
-				{
-					auto ev = reinterpret_cast<xcb_focus_in_event_t*> (event);
-					dispatchEvent (*ev, ev->event);
-					break;
-				}
+				if (queueMotionEvent (reinterpret_cast<xcb_motion_notify_event_t*> (event),
+									  receiveTime))
+					continue;
 			}
-			std::free (event);
+			// keep the order of the motion events relative to all other events
+			flushMotionEvents ();
+			handleEvent (event, receiveTime, 0);
 		}
+		flushMotionEvents ();
 		xcb_aux_sync (xcbConnection);
 		xcb_flush (xcbConnection);
 	}
+
+	//------------------------------------------------------------------------
+	void handleEvent (xcb_generic_event_t* event, Clock::time_point receiveTime,
+					  uint32_t numCoalesced)
+	{
+		currentEventTime = receiveTime;
+		currentEventNumCoalesced = numCoalesced;
+		auto type = event->response_type & ~0x80;
+		switch (type)
+		{
+			case XCB_KEY_PRESS:
+			{
+				auto ev = reinterpret_cast<xcb_key_press_event_t*> (event);
+				onKeyEvent (*ev, true);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_KEY_RELEASE:
+			{
+				auto ev = reinterpret_cast<xcb_key_release_event_t*> (event);
+				onKeyEvent (*ev, false);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_BUTTON_PRESS:
+			{
+				auto ev = reinterpret_cast<xcb_button_press_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_BUTTON_RELEASE:
+			{
+				auto ev = reinterpret_cast<xcb_button_release_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_MOTION_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_motion_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_ENTER_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_enter_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_LEAVE_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_leave_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+			case XCB_EXPOSE:
+			{
+				auto ev = reinterpret_cast<xcb_expose_event_t*> (event);
+				dispatchEvent (*ev, ev->window);
+				break;
+			}
+			case XCB_UNMAP_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_unmap_notify_event_t*> (event);
+				break;
+			}
+			case XCB_MAP_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_map_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->window);
+				break;
+			}
+			case XCB_CONFIGURE_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_configure_notify_event_t*> (event);
+				break;
+			}
+			case XCB_PROPERTY_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_property_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->window);
+				break;
+			}
+			case XCB_SELECTION_NOTIFY:
+			{
+				auto ev = reinterpret_cast<xcb_selection_notify_event_t*> (event);
+				dispatchEvent (*ev, ev->requestor);
+				break;
+			}
+			case XCB_CLIENT_MESSAGE:
+			{
+				auto ev = reinterpret_cast<xcb_client_message_event_t*> (event);
+				dispatchEvent (*ev, ev->window);
+				break;
+			}
+			case XCB_FOCUS_IN:
+			case XCB_FOCUS_OUT:
+			{
+				auto ev = reinterpret_cast<xcb_focus_in_event_t*> (event);
+				dispatchEvent (*ev, ev->event);
+				break;
+			}
+		}
+		std::free (event);
+	}
 };
 
 //------------------------------------------------------------------------
@@ -539,6 +607,18 @@ KeyboardEvent&& RunLoop::getCurrentKeyEvent () const
 	return std::move (impl->lastUnprocessedKeyEvent);
 }
 
+//------------------------------------------------------------------------
+std::chrono::steady_clock::time_point RunLoop::getCurrentEventTime () const
+{
+	return impl->currentEventTime;
+}
+
+//------------------------------------------------------------------------
+uint32_t RunLoop::getCurrentEventNumCoalesced () const
+{
+	return impl->currentEventNumCoalesced;
+}
+
 //------------------------------------------------------------------------
 Optional<UTF8String> RunLoop::convertCurrentKeyEventToText () const
 {
@@ -7,6 +7,7 @@
 #include "../../vstguifwd.h"
 #include "x11frame.h"
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <cairo/cairo.h>
 
@@ -45,6 +46,9 @@ struct IFrameEventHandler
 	virtual void onEvent (xcb_property_notify_event_t& event) = 0;
 	virtual void onEvent (xcb_selection_notify_event_t& event) = 0;
 	virtual void onEvent (xcb_client_message_event_t& event, xcb_window_t proxyId = 0) = 0;
+
+	/** if false only the newest of the queued motion events is delivered */
+	virtual bool wantsMotionEventHistory () const = 0;
 };
 
 //------------------------------------------------------------------------
@@ -61,6 +65,11 @@ struct RunLoop
 
 	uint32_t getCursorID (CCursorType cursor);
 	KeyboardEvent&& getCurrentKeyEvent () const;
+	/** the time the currently dispatched event was read from the connection, for coalesced
+	 *	motion events the time of the oldest one */
+	std::chrono::steady_clock::time_point getCurrentEventTime () const;
+	/** the number of older motion events dropped in favor of the currently dispatched one */
+	uint32_t getCurrentEventNumCoalesced () const;
 	Optional<UTF8String> convertCurrentKeyEventToText () const;
 
 	void setDevice (cairo_device_t* device);
@@ -79,6 +79,12 @@ public:
 	 */
 	PlatformBitmapPtr createBitmapFromMemory (const void* ptr,
 											  uint32_t memSize) const noexcept final;
+	/** Create a platform bitmap object from a stream
+	 *	@param stream the stream to read the encoded bitmap data from
+	 *	@return platform bitmap or nullptr on failure
+	 */
+	PlatformBitmapPtr
+		createBitmapFromStream (IPlatformResourceInputStream& stream) const noexcept final;
 	/** Create a memory representation of the platform bitmap in PNG format.
 	 *	@param bitmap the platform bitmap object
 	 *	@return memory buffer containing the PNG representation of the bitmap
@@ -24,6 +24,7 @@
 #include <list>
 #include <mach/mach_time.h>
 #include <memory>
+#include <vector>
 
 //-----------------------------------------------------------------------------
 namespace VSTGUI {
@@ -144,6 +145,27 @@ PlatformBitmapPtr MacFactory::createBitmapFromMemory (const void* ptr,
 	return CGBitmap::createFromMemory (ptr, memSize);
 }
 
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr
+	MacFactory::createBitmapFromStream (IPlatformResourceInputStream& stream) const noexcept
+{
+	// the platform decoders need the complete data
+	std::vector<uint8_t> buffer;
+	uint8_t chunk[8192];
+	while (true)
+	{
+		auto numBytes = stream.readRaw (chunk, sizeof (chunk));
+		if (numBytes == kStreamIOError)
+			return nullptr;
+		if (numBytes == 0)
+			break;
+		buffer.insert (buffer.end (), chunk, chunk + numBytes);
+	}
+	if (buffer.empty ())
+		return nullptr;
+	return createBitmapFromMemory (buffer.data (), static_cast<uint32_t> (buffer.size ()));
+}
+
 //-----------------------------------------------------------------------------
 PNGBitmapBuffer
 	MacFactory::createBitmapMemoryPNGRepresentation (const PlatformBitmapPtr& bitmap) const noexcept
@@ -5,6 +5,7 @@
 #pragma once
 
 #include "iplatformframe.h"
+#include "../cinvalidrectlist.h"
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -40,6 +41,35 @@ class FrameConfig : public IPlatformFrameConfig
 {
 public:
 	SharedPointer<IRunLoop> runLoop;
+	/** policy how the dirty rects of the window are coalesced before they are redrawn */
+	CInvalidRectList::Policy invalidRectListPolicy;
+	/** deliver every queued motion event instead of only the newest one per event loop
+	 *	iteration, for views which need the complete mouse path like drawing tools */
+	bool keepMotionEventHistory {false};
+};
+
+//------------------------------------------------------------------------
+struct DrawStatistics
+{
+	/** number of presented frames */
+	uint64_t numFrames {0};
+	/** number of pixels drawn into the back buffer in the last frame */
+	uint64_t lastFramePixelsDrawn {0};
+	/** number of pixels copied from the back buffer to the window in the last frame */
+	uint64_t lastFramePixelsPresented {0};
+	/** number of pixels drawn into the back buffer since the frame was opened */
+	uint64_t totalPixelsDrawn {0};
+	/** number of pixels copied to the window since the frame was opened */
+	uint64_t totalPixelsPresented {0};
+	/** number of mouse and keyboard events handled since the frame was opened */
+	uint64_t numInputEvents {0};
+	/** number of motion events dropped because a newer one for the window was queued */
+	uint64_t numCoalescedMotionEvents {0};
+	/** microseconds from reading the oldest input event which changed the last frame from the
+	 *	connection until the frame was presented */
+	uint64_t lastInputLatency {0};
+	/** the maximum of lastInputLatency since the frame was opened */
+	uint64_t maxInputLatency {0};
 };
 
 //------------------------------------------------------------------------
@@ -47,6 +77,9 @@ class IX11Frame
 {
 public:
 	virtual uint32_t getX11WindowID () const = 0;
+	virtual DrawStatistics getDrawStatistics () const = 0;
+	virtual void setKeepMotionEventHistory (bool state) = 0;
+	virtual bool getKeepMotionEventHistory () const = 0;
 };
 
 //------------------------------------------------------------------------
@@ -28,6 +28,7 @@
 #include <cassert>
 #include <list>
 #include <memory>
+#include <vector>
 #include <shlwapi.h>
 #include <d2d1.h>
 #include <d2d1_1.h>
@@ -338,6 +339,27 @@ PlatformBitmapPtr Win32Factory::createBitmapFromMemory (const void* ptr,
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr
+	Win32Factory::createBitmapFromStream (IPlatformResourceInputStream& stream) const noexcept
+{
+	// the platform decoders need the complete data
+	std::vector<uint8_t> buffer;
+	uint8_t chunk[8192];
+	while (true)
+	{
+		auto numBytes = stream.readRaw (chunk, sizeof (chunk));
+		if (numBytes == kStreamIOError)
+			return nullptr;
+		if (numBytes == 0)
+			break;
+		buffer.insert (buffer.end (), chunk, chunk + numBytes);
+	}
+	if (buffer.empty ())
+		return nullptr;
+	return createBitmapFromMemory (buffer.data (), static_cast<uint32_t> (buffer.size ()));
+}
+
 //-----------------------------------------------------------------------------
 PNGBitmapBuffer Win32Factory::createBitmapMemoryPNGRepresentation (
 	const PlatformBitmapPtr& bitmap) const noexcept
@@ -187,6 +187,7 @@ class ITextEditListener;
 class ITextLabelListener;
 class IListControlDrawer;
 class IListControlConfigurator;
+class IListControlBlockConfigurator;
 
 #if VSTGUI_TOUCH_EVENT_HANDLING
 class ITouchEvent;
@@ -215,6 +216,7 @@ class CMenuItem;
 class CCommandMenuItem;
 class GenericStringListDataBrowserSource;
 class StaticListControlConfigurator;
+class UniformListControlConfigurator;
 class StringListControlDrawer;
 
 using CFontRef = CFontDesc*;
@@ -244,6 +246,7 @@ class CKickButton;
 class CTextButton;
 class CColorChooser;
 class CControl;
+class CControlValueMailbox;
 class CFontChooser;
 class CKnob;
 class CAnimKnob;
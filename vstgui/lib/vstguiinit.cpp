@@ -3,6 +3,7 @@
 
 #include "platform/platformfactory.h"
 #include "cfont.h"
+#include "cglyphatlas.h"
 
 //-----------------------------------------------------------------------------
 namespace VSTGUI {
@@ -17,6 +18,7 @@ void init (PlatformInstanceHandle instance)
 //-----------------------------------------------------------------------------
 void exit ()
 {
+	CGlyphAtlas::clearCache ();
 	CFontDesc::cleanup ();
 	exitPlatform ();
 }
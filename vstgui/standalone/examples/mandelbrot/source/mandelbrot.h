@@ -4,7 +4,6 @@
 
 #include "vstgui/lib/cpoint.h"
 #include "vstgui/lib/dispatchlist.h"
-#include <complex>
 #include <iostream>
 #include <memory>
 
@@ -12,7 +11,6 @@
 namespace Mandelbrot {
 
 using Point = VSTGUI::CPoint;
-using Complex = std::complex<double>;
 struct Model;
 
 //------------------------------------------------------------------------
@@ -73,56 +71,80 @@ inline Point pixelToPoint (Point max, Point min, Point size, Point pixel)
 }
 
 //------------------------------------------------------------------------
-inline double hypot (double x, double y)
+/** number of points calculated at once */
+static constexpr uint32_t kNumLanes = 4;
+
+//------------------------------------------------------------------------
+/** calculates the escape iterations of kNumLanes points at once. The lanes do not depend on each
+ *	other, so that the compiler can use vector instructions for the inner loop. The iteration stops
+ *	when all points escaped.
+ *	|z|^2 is compared against 4 instead of |z| against 2, so a point whose |z|^2 is within rounding
+ *	distance of 4 may escape one iteration later than with the square root.
+ */
+inline void calculateIterations (const double (&cReal)[kNumLanes],
+                                 const double (&cImag)[kNumLanes], uint32_t maxIterations,
+                                 uint32_t (&result)[kNumLanes])
 {
-	return std::sqrt (x * x + y * y);
+	double zReal[kNumLanes] = {};
+	double zImag[kNumLanes] = {};
+	uint32_t iterations[kNumLanes] = {};
+	for (auto i = 0u; i < maxIterations; ++i)
+	{
+		uint32_t numActive = 0;
+		for (auto lane = 0u; lane < kNumLanes; ++lane)
+		{
+			auto a = zReal[lane];
+			auto b = zImag[lane];
+			// |z| < 2 without the square root
+			uint32_t active = (a * a + b * b) < 4.;
+			auto x = (a * a - b * b) + cReal[lane];
+			auto y = (a * b + b * a) + cImag[lane];
+			zReal[lane] = active ? x : a;
+			zImag[lane] = active ? y : b;
+			iterations[lane] += active;
+			numActive += active;
+		}
+		if (numActive == 0)
+			break;
+	}
+	for (auto lane = 0u; lane < kNumLanes; ++lane)
+		result[lane] = iterations[lane];
 }
 
 //------------------------------------------------------------------------
-inline Complex mulAdd (Complex z, Complex w, Complex v)
+/** calculates every step-th pixel of the row y in the range [left, right) and calls
+ *	setPixel (x, iterations) for them
+ */
+template <typename SetPixelProc>
+inline void calculateRow (uint32_t y, uint32_t left, uint32_t right, uint32_t step, Point size,
+                          const Model& model, SetPixelProc setPixel)
 {
-	auto a = z.real ();
-	auto b = z.imag ();
-	auto c = w.real ();
-	auto d = w.imag ();
-	auto ac = a * c;
-	auto bd = b * d;
-	auto ad = a * d;
-	auto bc = b * c;
-	auto x = ac - bd;
-	auto y = ad + bc;
-	return Complex (x + v.real (), y + v.imag ());
+	// the same rounding as the scalar implementation had, so that the points do not move
+	const auto sizeInvX = 1. / (size.x - 1.);
+	const auto sizeInvY = 1. / (size.y - 1.);
+	const auto diffX = model.getMax ().x - model.getMin ().x;
+	const auto diffY = model.getMax ().y - model.getMin ().y;
+	const auto posY = model.getMin ().y + y * sizeInvY * diffY;
+	double cReal[kNumLanes];
+	double cImag[kNumLanes];
+	uint32_t iterations[kNumLanes];
+	for (auto lane = 0u; lane < kNumLanes; ++lane)
+		cImag[lane] = posY;
+	for (auto x = left; x < right; x += step * kNumLanes)
+	{
+		for (auto lane = 0u; lane < kNumLanes; ++lane)
+			cReal[lane] = model.getMin ().x + (x + lane * step) * sizeInvX * diffX;
+		calculateIterations (cReal, cImag, model.getIterations (), iterations);
+		for (auto lane = 0u; lane < kNumLanes && x + lane * step < right; ++lane)
+			setPixel (x + lane * step, iterations[lane]);
+	}
 }
 
 //------------------------------------------------------------------------
 template <typename SetPixelProc>
 inline void calculateLine (uint32_t line, Point size, const Model& model, SetPixelProc setPixel)
 {
-	Point sizeInv (size);
-	sizeInv -= {1, 1};
-	sizeInv.x = 1. / sizeInv.x;
-	sizeInv.y = 1. / sizeInv.y;
-	Point diff;
-	diff.x = model.getMax ().x - model.getMin ().x;
-	diff.y = model.getMax ().y - model.getMin ().y;
-	Point pos;
-	pos.y = model.getMin ().y + line * sizeInv.y * diff.y;
-	auto numIterations = static_cast<uint32_t> (size.x);
-	std::vector<uint32_t> iterationResult (numIterations);
-	for (auto x = 0u; x < numIterations; ++x)
-	{
-		pos.x = model.getMin ().x + x * sizeInv.x * diff.x;
-		Complex c {pos.x, pos.y};
-		Complex z {0};
-		uint32_t iterations {};
-
-		for (; iterations < model.getIterations () && hypot (z.real (), z.imag ()) < 2.0;
-		     ++iterations)
-			z = mulAdd (z, z, c);
-		iterationResult[x] = iterations;
-	}
-	for (auto x = 0u; x < size.x; ++x)
-		setPixel (x, iterationResult[x]);
+	calculateRow (line, 0, static_cast<uint32_t> (size.x), 1, size, model, setPixel);
 }
 
 //------------------------------------------------------------------------
@@ -11,6 +11,7 @@
 #include "vstgui/lib/animation/ianimationtarget.h"
 #include "vstgui/lib/animation/timingfunctions.h"
 #include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cbitmaptilerenderer.h"
 #include "vstgui/lib/ccolor.h"
 #include "vstgui/lib/cfileselector.h"
 #include "vstgui/lib/cframe.h"
@@ -31,7 +32,7 @@
 #include "vstgui/uidescription/uiattributes.h"
 #include <atomic>
 #include <cassert>
-#include <thread>
+#include <memory>
 
 //------------------------------------------------------------------------
 namespace Mandelbrot {
@@ -89,46 +90,36 @@ inline std::function<uint32_t (CColor)> getColorToInt32 (IPlatformBitmapPixelAcc
 }
 
 //------------------------------------------------------------------------
-template <typename ReadyCallback>
-inline void calculateMandelbrotBitmap (Model model, SharedPointer<CBitmap> bitmap, CPoint size,
-                                       uint32_t id, const std::atomic<uint32_t>& taskID,
-                                       ReadyCallback readyCallback)
+/** creates the renderer which calculates the bitmap tile by tile in the background, first in
+ *	blocks of 8x8 pixels and then in full resolution
+ */
+inline std::unique_ptr<CBitmapTileRenderer> makeMandelbrotRenderer (
+    Model model, SharedPointer<CBitmap> bitmap, CPoint size, std::function<void ()>&& tileFinished)
 {
-	if (auto pa = owned (CBitmapPixelAccess::create (bitmap)))
-	{
-		const auto numLinesPerTask =
-		    static_cast<uint32_t> (size.y / (std::thread::hardware_concurrency () * 8));
-
-		const auto maxIterationInv = 1. / model.getIterations ();
-
-		auto asyncGroup = Async::Group::make (Async::backgroundQueue ());
-
-		auto pixelAccess = shared (pa->getPlatformBitmapPixelAccess ());
-		auto colorToInt32 = getColorToInt32 (pixelAccess->getPixelFormat ());
-		for (auto y = 0u; y < static_cast<uint32_t> (size.y); y += numLinesPerTask)
+	auto pa = owned (CBitmapPixelAccess::create (bitmap));
+	if (!pa)
+		return nullptr;
+	auto colorToInt32 = getColorToInt32 (pa->getPlatformBitmapPixelAccess ()->getPixelFormat ());
+	pa = nullptr;
+
+	const auto maxIterationInv = 1. / model.getIterations ();
+	std::vector<uint32_t> palette (model.getIterations () + 1);
+	for (auto i = 0u; i < palette.size (); ++i)
+		palette[i] = colorToInt32 (calculateColor (i, maxIterationInv));
+
+	auto render = [model, size, palette = std::move (palette)] (
+	                  const CBitmapTileRenderer::Tile& tile) {
+		for (auto y = tile.top; y < tile.bottom && !tile.isCanceled (); y += tile.blockSize)
 		{
-			auto task = [=, &taskID] () {
-				for (auto i = 0u; i < numLinesPerTask; ++i)
-				{
-					if (y + i >= size.y || taskID != id)
-						break;
-					auto pixelPtr = reinterpret_cast<uint32_t*> (
-					    pixelAccess->getAddress () + (y + i) * pixelAccess->getBytesPerRow ());
-					calculateLine (y + i, size, model, [&] (auto x, auto iteration) {
-						auto color = calculateColor (iteration, maxIterationInv);
-						*pixelPtr = colorToInt32 (color);
-						pixelPtr++;
-					});
-				}
-			};
-			asyncGroup->add (std::move (task));
+			calculateRow (y, tile.left, tile.right, tile.blockSize, size, model,
+			              [&] (uint32_t x, uint32_t iteration) {
+				              tile.fillBlock (x, y, palette[iteration]);
+			              });
 		}
-
-		asyncGroup->start ([callback = std::move (readyCallback), bitmap, id] () {
-			Async::schedule (Async::mainQueue (),
-			                [call = std::move (callback), bitmap, id] () { call (id, bitmap); });
-		});
-	}
+	};
+	CBitmapTileRenderer::Config config;
+	config.tileFinished = std::move (tileFinished);
+	return std::make_unique<CBitmapTileRenderer> (bitmap, std::move (render), std::move (config));
 }
 
 //------------------------------------------------------------------------
@@ -196,7 +187,11 @@ struct ViewController : DelegationController,
 	{
 		model->registerListener (this);
 	}
-	~ViewController () noexcept override { model->unregisterListener (this); }
+	~ViewController () noexcept override
+	{
+		renderer = nullptr;
+		model->unregisterListener (this);
+	}
 
 	CView* createView (const UIAttributes& attributes, const IUIDescription* description) override
 	{
@@ -247,7 +242,9 @@ struct ViewController : DelegationController,
 	void viewWillDelete (CView* view) override
 	{
 		assert (mandelbrotView == view);
-		++taskID; // cancel background calculation
+		// the renderer may hold the last reference to this controller
+		auto self = shared (this);
+		renderer = nullptr; // cancel background calculation
 		mandelbrotView->unregisterViewListener (this);
 		mandelbrotView = nullptr;
 	}
@@ -265,6 +262,7 @@ struct ViewController : DelegationController,
 
 	void updateMandelbrot ()
 	{
+		renderer = nullptr;
 		CPoint size = mandelbrotView->getViewSize ().getSize ();
 		size.x *= scaleFactor;
 		size.y *= scaleFactor;
@@ -274,16 +272,46 @@ struct ViewController : DelegationController,
 		Value::performSingleEdit (*progressValue, 1.);
 		auto bitmap = makeOwned<CBitmap> (size.x, size.y);
 		bitmap->getPlatformBitmap ()->setScaleFactor (scaleFactor);
-		auto id = ++taskID;
-		auto This = shared (this);
-		calculateMandelbrotBitmap (*model.get (), bitmap, size, id, taskID,
-		                           [This] (uint32_t id, SharedPointer<CBitmap> bitmap) {
-			                           if (id == This->taskID && This->mandelbrotView)
-			                           {
-				                           This->mandelbrotView->setBackground (bitmap);
-				                           Value::performSingleEdit (*This->progressValue, 0.);
-			                           }
-		                           });
+		// the renderer holds a reference to this controller while it is running, the renderer is
+		// released when it is done or when the view is deleted
+		renderer = makeMandelbrotRenderer (*model.get (), bitmap, size, [This = shared (this)] () {
+			if (!This->commitPending.exchange (true))
+				Async::schedule (Async::mainQueue (), [This] () { This->commitTiles (); });
+		});
+		if (renderer)
+			renderer->start ();
+	}
+
+	void commitTiles ()
+	{
+		commitPending = false;
+		if (!renderer || !mandelbrotView)
+			return;
+		auto done = renderer->isDone ();
+		auto rects = renderer->commit ();
+		if (mandelbrotView->getBackground () != renderer->getBitmap ())
+		{
+			// the old bitmap is shown until the first tiles are ready
+			mandelbrotView->setBackground (renderer->getBitmap ());
+		}
+		else
+		{
+			auto viewSize = mandelbrotView->getViewSize ();
+			for (auto r : rects)
+			{
+				r.left /= scaleFactor;
+				r.top /= scaleFactor;
+				r.right /= scaleFactor;
+				r.bottom /= scaleFactor;
+				r.offset (viewSize.getTopLeft ());
+				mandelbrotView->invalidRect (r.extend (1., 1.));
+			}
+		}
+		if (done)
+		{
+			renderer = nullptr;
+			Value::performSingleEdit (*progressValue, 0.);
+		}
 	}
 
 	void saveBitmap (OutputStream& stream)
@@ -307,7 +335,8 @@ struct ViewController : DelegationController,
 	CControl* progressControl {nullptr};
 	CView* mandelbrotView {nullptr};
 	double scaleFactor {1.};
-	std::atomic<uint32_t> taskID {0};
+	std::unique_ptr<CBitmapTileRenderer> renderer;
+	std::atomic<bool> commitPending {false};
 };
 
 static const Command saveCommand {"File", "Save Bitmap"};
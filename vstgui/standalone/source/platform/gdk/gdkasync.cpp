@@ -2,7 +2,19 @@
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
-#include "../../../include/iasync.h"
+#include "gdkasync.h"
+#include <glib.h>
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -10,6 +22,182 @@ namespace Standalone {
 namespace Platform {
 namespace GDK {
 
+using Clock = std::chrono::steady_clock;
+
+static std::atomic<uint32_t> gBackgroundTaskCount {};
+
+//------------------------------------------------------------------------
+class QueueStatistics
+{
+public:
+	void taskScheduled ()
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		++data.queueDepth;
+	}
+
+	void taskStarted (Clock::time_point scheduleTime)
+	{
+		auto latency =
+			std::chrono::duration_cast<std::chrono::nanoseconds> (Clock::now () - scheduleTime);
+		std::lock_guard<std::mutex> guard (mutex);
+		--data.queueDepth;
+		++data.numTasks;
+		data.totalLatency += latency;
+		data.maxLatency = std::max (data.maxLatency, latency);
+	}
+
+	AsyncQueueStatistics get () const
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		return data;
+	}
+
+private:
+	mutable std::mutex mutex;
+	AsyncQueueStatistics data;
+};
+
+//------------------------------------------------------------------------
+struct ScheduledTask
+{
+	Async::Task task;
+	Clock::time_point scheduleTime;
+};
+
+//------------------------------------------------------------------------
+/** Work stealing thread pool
+ *
+ *	Every worker thread has its own job queue. Jobs scheduled from a worker thread are added to
+ *	the queue of this worker, other jobs are distributed round robin. A worker without jobs steals
+ *	from the end of the queues of the other workers.
+ */
+class WorkerPool
+{
+public:
+	using Job = std::function<void ()>;
+
+	static WorkerPool& instance ()
+	{
+		static WorkerPool pool;
+		return pool;
+	}
+
+	~WorkerPool () noexcept { stop (); }
+
+	void push (Job&& job)
+	{
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			if (workers.empty ())
+				start ();
+			auto index = currentWorkerIndex ();
+			if (index >= workers.size ())
+				index = nextWorker++ % workers.size ();
+			auto& worker = *workers[index];
+			{
+				std::lock_guard<std::mutex> workerGuard (worker.mutex);
+				worker.jobs.emplace_back (std::move (job));
+			}
+			++numPendingJobs;
+		}
+		wakeUp.notify_one ();
+	}
+
+	void stop ()
+	{
+		std::vector<std::unique_ptr<Worker>> stoppedWorkers;
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			quit = true;
+			stoppedWorkers.swap (workers);
+		}
+		wakeUp.notify_all ();
+		for (auto& worker : stoppedWorkers)
+			worker->thread.join ();
+		std::lock_guard<std::mutex> guard (mutex);
+		quit = false;
+		numPendingJobs = 0;
+	}
+
+private:
+	struct Worker
+	{
+		std::mutex mutex;
+		std::deque<Job> jobs;
+		std::thread thread;
+	};
+
+	/** the index of the worker running on the current thread, invalid for other threads */
+	static size_t& currentWorkerIndex ()
+	{
+		thread_local size_t index {std::numeric_limits<size_t>::max ()};
+		return index;
+	}
+
+	void start ()
+	{
+		auto numThreads = std::max (1u, std::thread::hardware_concurrency ());
+		for (auto i = 0u; i < numThreads; ++i)
+			workers.emplace_back (std::make_unique<Worker> ());
+		for (size_t i = 0; i < workers.size (); ++i)
+			workers[i]->thread = std::thread ([this, i] () { workerLoop (i); });
+	}
+
+	bool popJob (size_t index, Job& job)
+	{
+		auto& own = *workers[index];
+		{
+			std::lock_guard<std::mutex> guard (own.mutex);
+			if (!own.jobs.empty ())
+			{
+				job = std::move (own.jobs.front ());
+				own.jobs.pop_front ();
+				return true;
+			}
+		}
+		for (size_t i = 1; i < workers.size (); ++i)
+		{
+			auto& other = *workers[(index + i) % workers.size ()];
+			std::lock_guard<std::mutex> guard (other.mutex);
+			if (!other.jobs.empty ())
+			{
+				job = std::move (other.jobs.back ());
+				other.jobs.pop_back ();
+				return true;
+			}
+		}
+		return false;
+	}
+
+	void workerLoop (size_t index)
+	{
+		currentWorkerIndex () = index;
+		while (true)
+		{
+			{
+				std::unique_lock<std::mutex> lock (mutex);
+				wakeUp.wait (lock, [this] () { return quit || numPendingJobs > 0; });
+				if (quit)
+					return;
+				// reserves one of the pending jobs for this worker
+				--numPendingJobs;
+			}
+			Job job;
+			while (!popJob (index, job))
+				std::this_thread::yield ();
+			job ();
+		}
+	}
+
+	std::mutex mutex;
+	std::condition_variable wakeUp;
+	std::vector<std::unique_ptr<Worker>> workers;
+	size_t numPendingJobs {0};
+	size_t nextWorker {0};
+	bool quit {false};
+};
+
 //------------------------------------------------------------------------
 } // GDK
 } // Platform
@@ -20,31 +208,164 @@ namespace Async {
 //------------------------------------------------------------------------
 struct Queue
 {
-	void schedule (Task&& task)
+	virtual ~Queue () noexcept = default;
+	virtual void schedule (Task&& task) = 0;
+
+	Platform::GDK::QueueStatistics statistics;
+};
+
+//------------------------------------------------------------------------
+namespace {
+
+using Platform::GDK::Clock;
+using Platform::GDK::ScheduledTask;
+using Platform::GDK::WorkerPool;
+using Platform::GDK::gBackgroundTaskCount;
+
+//------------------------------------------------------------------------
+/** performs the tasks on the main thread via an idle source of the glib main context */
+struct MainQueue final : Queue
+{
+	void schedule (Task&& task) override
 	{
-		// TODO: scheduling not implemented yet
-		task ();
+		statistics.taskScheduled ();
+		bool attachSource = false;
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			tasks.emplace_back (ScheduledTask {std::move (task), Clock::now ()});
+			attachSource = !sourceAttached;
+			sourceAttached = true;
+		}
+		if (attachSource)
+		{
+			auto source = g_idle_source_new ();
+			g_source_set_priority (source, G_PRIORITY_DEFAULT);
+			g_source_set_callback (source,
+								   [] (gpointer userData) -> gboolean {
+									   static_cast<MainQueue*> (userData)->perform ();
+									   return G_SOURCE_REMOVE;
+								   },
+								   this, nullptr);
+			g_source_attach (source, g_main_context_default ());
+			g_source_unref (source);
+		}
 	}
+
+	void perform ()
+	{
+		std::deque<ScheduledTask> current;
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			current.swap (tasks);
+			sourceAttached = false;
+		}
+		for (auto& t : current)
+		{
+			statistics.taskStarted (t.scheduleTime);
+			t.task ();
+		}
+	}
+
+private:
+	std::mutex mutex;
+	std::deque<ScheduledTask> tasks;
+	bool sourceAttached {false};
 };
 
+//------------------------------------------------------------------------
+struct BackgroundQueue final : Queue
+{
+	void schedule (Task&& task) override
+	{
+		++gBackgroundTaskCount;
+		statistics.taskScheduled ();
+		WorkerPool::instance ().push (
+			[this, t = std::move (task), scheduleTime = Clock::now ()] () {
+				statistics.taskStarted (scheduleTime);
+				t ();
+				--gBackgroundTaskCount;
+			});
+	}
+};
+
+//------------------------------------------------------------------------
+/** performs one task at a time on the worker pool */
+struct SerialQueue final : Queue, std::enable_shared_from_this<SerialQueue>
+{
+	SerialQueue (const char* n)
+	{
+		if (n)
+			name = n;
+	}
+
+	void schedule (Task&& task) override
+	{
+		++gBackgroundTaskCount;
+		statistics.taskScheduled ();
+		bool start = false;
+		{
+			std::lock_guard<std::mutex> guard (mutex);
+			tasks.emplace_back (ScheduledTask {std::move (task), Clock::now ()});
+			start = !running;
+			running = true;
+		}
+		if (start)
+			performNext ();
+	}
+
+private:
+	void performNext ()
+	{
+		// only one task is performed per job, so that other queues get their share of the workers
+		WorkerPool::instance ().push ([queue = shared_from_this ()] () {
+			ScheduledTask t;
+			{
+				std::lock_guard<std::mutex> guard (queue->mutex);
+				t = std::move (queue->tasks.front ());
+				queue->tasks.pop_front ();
+			}
+			queue->statistics.taskStarted (t.scheduleTime);
+			t.task ();
+			--gBackgroundTaskCount;
+			{
+				std::lock_guard<std::mutex> guard (queue->mutex);
+				if (queue->tasks.empty ())
+				{
+					queue->running = false;
+					return;
+				}
+			}
+			queue->performNext ();
+		});
+	}
+
+	std::string name;
+	std::mutex mutex;
+	std::deque<ScheduledTask> tasks;
+	bool running {false};
+};
+
+//------------------------------------------------------------------------
+} // anonymous
+
 //------------------------------------------------------------------------
 const QueuePtr& mainQueue ()
 {
-	static QueuePtr q = std::make_shared<Queue> ();
+	static QueuePtr q = std::make_shared<MainQueue> ();
 	return q;
 }
 
 //------------------------------------------------------------------------
 const QueuePtr& backgroundQueue ()
 {
-	static QueuePtr q = std::make_shared<Queue> ();
+	static QueuePtr q = std::make_shared<BackgroundQueue> ();
 	return q;
 }
 
 //------------------------------------------------------------------------
 QueuePtr makeSerialQueue (const char* name)
 {
-	return std::make_shared<Queue> ();
+	return std::make_shared<SerialQueue> (name);
 }
 
 //------------------------------------------------------------------------
@@ -55,5 +376,32 @@ void schedule (QueuePtr queue, Task&& task)
 
 //------------------------------------------------------------------------
 } // Async
+
+//------------------------------------------------------------------------
+namespace Platform {
+namespace GDK {
+
+//------------------------------------------------------------------------
+AsyncQueueStatistics getAsyncQueueStatistics (const Async::QueuePtr& queue)
+{
+	return queue ? queue->statistics.get () : AsyncQueueStatistics {};
+}
+
+//------------------------------------------------------------------------
+void terminateAsyncHandling ()
+{
+	// background tasks may schedule tasks on the main queue, so keep the main context running
+	while (gBackgroundTaskCount != 0)
+	{
+		if (!g_main_context_iteration (nullptr, false))
+			std::this_thread::sleep_for (std::chrono::milliseconds (1));
+	}
+	static_cast<Async::MainQueue*> (Async::mainQueue ().get ())->perform ();
+	WorkerPool::instance ().stop ();
+}
+
+//------------------------------------------------------------------------
+} // GDK
+} // Platform
 } // Standalone
 } // VSTGUI
@@ -0,0 +1,39 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../../include/iasync.h"
+#include <chrono>
+#include <cstdint>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Standalone {
+namespace Platform {
+namespace GDK {
+
+//------------------------------------------------------------------------
+struct AsyncQueueStatistics
+{
+	/** number of tasks scheduled but not yet started */
+	uint64_t queueDepth {0};
+	/** number of tasks executed */
+	uint64_t numTasks {0};
+	/** time between scheduling and starting a task */
+	std::chrono::nanoseconds totalLatency {};
+	std::chrono::nanoseconds maxLatency {};
+};
+
+//------------------------------------------------------------------------
+AsyncQueueStatistics getAsyncQueueStatistics (const Async::QueuePtr& queue);
+
+/** waits until all background tasks are done and stops the worker threads */
+void terminateAsyncHandling ();
+
+//------------------------------------------------------------------------
+} // GDK
+} // Platform
+} // Standalone
+} // VSTGUI
@@ -1,14 +1,42 @@
-// This file is part of VSTGUI. It is subject to the license terms 
+// This file is part of VSTGUI. It is subject to the license terms
 // in the LICENSE file found in the top-level directory of this
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "vstgui/uidescription/base64codec.h"
 #include "vstgui/lib/malloc.h"
 
+#include <chrono>
+#include <cstdio>
 #include <random>
 
 using namespace VSTGUI;
 
+using Backend = Base64Codec::Backend;
+
+//------------------------------------------------------------------------
+static const char* getBackendName (Backend backend)
+{
+	switch (backend)
+	{
+		case Backend::kScalar: return "scalar";
+		case Backend::kSSE: return "sse";
+		case Backend::kAVX2: return "avx2";
+		case Backend::kNEON: return "neon";
+	}
+	return "";
+}
+
+//------------------------------------------------------------------------
+template<typename Proc>
+static double measureGBPerSecond (size_t numBytes, Proc proc)
+{
+	auto start = std::chrono::high_resolution_clock::now ();
+	proc ();
+	std::chrono::duration<double> duration = std::chrono::high_resolution_clock::now () - start;
+	return static_cast<double> (numBytes) / duration.count () / (1024. * 1024. * 1024.);
+}
+
+//------------------------------------------------------------------------
 int main ()
 {
 	Buffer<uint8_t> origData;
@@ -17,13 +45,27 @@ int main ()
 	std::independent_bits_engine<std::default_random_engine, sizeof (uint16_t) * 8, uint16_t> rbe;
 	std::generate (origData.get (), origData.get () + origData.size (), std::ref (rbe));
 
-	auto encoderResult = Base64Codec::encode (origData.get (), origData.size ());
-	auto decoderResult = Base64Codec::decode (encoderResult.data.get (), encoderResult.dataSize);
+	for (auto backend : {Backend::kScalar, Backend::kSSE, Backend::kAVX2, Backend::kNEON})
+	{
+		if (!Base64Codec::isAvailable (backend))
+			continue;
+		Base64Codec::Result encoderResult;
+		auto encodeSpeed = measureGBPerSecond (origData.size (), [&] () {
+			encoderResult = Base64Codec::encode (origData.get (), origData.size (), backend);
+		});
+		Base64Codec::Result decoderResult;
+		auto decodeSpeed = measureGBPerSecond (encoderResult.dataSize, [&] () {
+			decoderResult =
+				Base64Codec::decode (encoderResult.data.get (), encoderResult.dataSize, backend);
+		});
+		printf ("%-8s encode: %6.2f GB/s decode: %6.2f GB/s\n", getBackendName (backend),
+				encodeSpeed, decodeSpeed);
 
-	if (origData.size () != decoderResult.dataSize)
-		return -1;
+		if (origData.size () != decoderResult.dataSize)
+			return -1;
 
-	if (memcmp (origData.get (), decoderResult.data.get (), origData.size ()) != 0)
-		return -1;
+		if (memcmp (origData.get (), decoderResult.data.get (), origData.size ()) != 0)
+			return -1;
+	}
 	return 0;
 }
@@ -0,0 +1,127 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cbitmaptilerenderer.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/platform/iplatformbitmap.h"
+#include "vstgui/lib/vstguiinit.h"
+#include "vstgui/standalone/examples/mandelbrot/source/mandelbrot.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+//------------------------------------------------------------------------
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+static std::vector<uint8_t> copyPixels (CBitmap* bitmap)
+{
+	std::vector<uint8_t> result;
+	auto platformBitmap = bitmap->getPlatformBitmap ();
+	if (!platformBitmap)
+		return result;
+	auto accessor = platformBitmap->lockPixels (true);
+	if (!accessor)
+		return result;
+	auto rowSize = static_cast<size_t> (platformBitmap->getSize ().x) * 4;
+	auto height = static_cast<uint32_t> (platformBitmap->getSize ().y);
+	result.resize (rowSize * height);
+	for (auto y = 0u; y < height; ++y)
+		memcpy (result.data () + y * rowSize, accessor->getAddress () + y * accessor->getBytesPerRow (),
+				rowSize);
+	return result;
+}
+
+//------------------------------------------------------------------------
+/** renders the mandelbrot set with the kernel of the standalone example */
+static bool measureMandelbrot (uint32_t size, uint32_t maxIterations)
+{
+	using namespace std::chrono;
+
+	Mandelbrot::Model model;
+	model.setIterations (maxIterations);
+	auto bitmap = makeOwned<CBitmap> (size, size);
+	std::vector<uint8_t> singleThreadPixels;
+	auto numThreads = std::max (std::thread::hardware_concurrency (), 1u);
+	for (auto threads = 1u;; threads = std::min (threads * 2, numThreads))
+	{
+		CBitmapTileRenderer::Config config;
+		config.numThreads = threads;
+		config.passes = {1};
+		auto render = [&model, size] (const CBitmapTileRenderer::Tile& tile) {
+			for (auto y = tile.top; y < tile.bottom && !tile.isCanceled (); y += tile.blockSize)
+			{
+				Mandelbrot::calculateRow (
+					y, tile.left, tile.right, tile.blockSize, Mandelbrot::Point (size, size), model,
+					[&] (uint32_t x, uint32_t iterations) {
+						tile.fillBlock (x, y, iterations * 0x010101u);
+					});
+			}
+		};
+		CBitmapTileRenderer renderer (bitmap, render, std::move (config));
+		auto start = steady_clock::now ();
+		renderer.start ();
+		renderer.wait ();
+		renderer.commit ();
+		auto seconds =
+			static_cast<double> (duration_cast<microseconds> (steady_clock::now () - start).count ()) /
+			1000000.;
+		if (!renderer.isDone ())
+		{
+			printf ("The renderer did not finish\n");
+			return false;
+		}
+		printf ("%4ux%-4u %2u threads %8.1f megapixels per second\n", size, size, threads,
+				(static_cast<double> (size) * size) / (seconds * 1000000.));
+		auto pixels = copyPixels (bitmap);
+		if (threads == 1)
+			singleThreadPixels = std::move (pixels);
+		else if (pixels != singleThreadPixels)
+		{
+			printf ("The result differs from the single threaded one\n");
+			return false;
+		}
+		if (threads == numThreads)
+			break;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#else
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	// usage: bitmaptilerendererspeed [max iterations]
+	uint32_t maxIterations = argc > 1 ? static_cast<uint32_t> (std::stoul (argv[1])) : 200;
+	if (maxIterations == 0)
+		maxIterations = 1;
+
+	for (auto size : {512u, 1024u})
+	{
+		if (!measureMandelbrot (size, maxIterations))
+			return -1;
+	}
+	return 0;
+}
@@ -0,0 +1,88 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cbitmap.h"
+#include "vstgui/lib/cdrawcontext.h"
+#include "vstgui/lib/coffscreencontext.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+//------------------------------------------------------------------------
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+/** a panel background tiled from a small bitmap and a nine part frame around it */
+static bool measureTiledPanel (CCoord width, CCoord height, uint32_t iterations)
+{
+	using namespace std::chrono;
+
+	auto tile = makeOwned<CBitmap> (CPoint (16., 16.));
+	auto frameBitmap = makeOwned<CBitmap> (CPoint (48., 48.));
+	CNinePartTiledDescription desc (16., 16., 16., 16.);
+	auto drawContext = COffscreenContext::create ({width, height});
+	if (!drawContext)
+	{
+		printf ("Could not create the offscreen context\n");
+		return false;
+	}
+	CRect panel (0., 0., width, height);
+
+	auto measure = [&] (auto proc) {
+		auto start = steady_clock::now ();
+		for (auto i = 0u; i < iterations; ++i)
+		{
+			drawContext->beginDraw ();
+			proc ();
+			drawContext->endDraw ();
+		}
+		return static_cast<double> (
+				   duration_cast<microseconds> (steady_clock::now () - start).count ()) /
+			   (iterations * 1000.);
+	};
+	auto tiled = measure ([&] () {
+		drawContext->fillRectWithBitmap (tile, CRect (0., 0., 16., 16.), panel, 1.f);
+	});
+	auto ninePart = measure ([&] () {
+		drawContext->drawBitmapNinePartTiled (frameBitmap, panel, desc, 1.f);
+	});
+	printf ("%4.0fx%-4.0f panel  tiled background %8.2f ms  nine part frame %8.2f ms\n", width,
+			height, tiled, ninePart);
+	return true;
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#else
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	// usage: drawcontextspeed [iterations]
+	uint32_t iterations = argc > 1 ? static_cast<uint32_t> (std::stoul (argv[1])) : 20;
+	if (iterations == 0)
+		iterations = 1;
+
+	for (auto size : {CPoint (1000., 800.), CPoint (2560., 1440.)})
+	{
+		if (!measureTiledPanel (size.x, size.y, iterations))
+			return -1;
+	}
+	return 0;
+}
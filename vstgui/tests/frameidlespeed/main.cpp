@@ -0,0 +1,107 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+/** compares the full tree scan of the idle handler with the dirty view registry */
+static bool measureIdle (uint32_t numViews, uint32_t numDirtyViews, uint32_t numTicks)
+{
+	using namespace std::chrono;
+	constexpr auto viewsPerContainer = 100u;
+
+	auto frame = new CFrame (CRect (0, 0, 2000, 1000), nullptr);
+	auto closeFrame = finally ([frame] () { frame->close (); });
+	std::vector<CView*> views;
+	for (auto i = 0u; i < numViews / viewsPerContainer; ++i)
+	{
+		auto container = new CViewContainer (CRect (0, i * 10., 2000, i * 10. + 10.));
+		for (auto x = 0u; x < viewsPerContainer; ++x)
+		{
+			auto view = new CView (CRect (x * 20., 0, x * 20. + 20., 10.));
+			container->addView (view);
+			views.push_back (view);
+		}
+		frame->addView (container);
+	}
+	frame->setIdleVisitsOnlyDirtyViews (true);
+	frame->attached (frame);
+
+	std::mt19937 rng (numViews);
+	std::uniform_int_distribution<size_t> dist (0, views.size () - 1);
+	auto measure = [&] (bool fullScan) {
+		auto start = steady_clock::now ();
+		for (auto tick = 0u; tick < numTicks; ++tick)
+		{
+			for (auto i = 0u; i < numDirtyViews; ++i)
+				views[dist (rng)]->setDirty ();
+			if (fullScan)
+				frame->CViewContainer::invalidateDirtyViews ();
+			else
+				frame->idle ();
+		}
+		return static_cast<double> (
+				   duration_cast<nanoseconds> (steady_clock::now () - start).count ()) /
+			   (numTicks * 1000.);
+	};
+	auto scanTime = measure (true);
+	// the full scan does not drain the dirty view registry
+	frame->idle ();
+	auto registryTime = measure (false);
+	printf ("%6u views %3u dirty per tick  full tree scan %8.2f us  dirty view registry %8.2f us\n",
+			numViews, numDirtyViews, scanTime, registryTime);
+
+	uint32_t numDirty = 0;
+	for (auto view : views)
+		numDirty += view->isDirty () ? 1 : 0;
+	if (numDirty != 0)
+	{
+		printf ("%u views are still dirty after idle\n", numDirty);
+		return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#else
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	// usage: frameidlespeed [ticks]
+	uint32_t numTicks = argc > 1 ? static_cast<uint32_t> (std::stoul (argv[1])) : 2000;
+	if (numTicks == 0)
+		numTicks = 1;
+
+	for (auto numViews : {1000u, 5000u, 20000u})
+	{
+		if (!measureIdle (numViews, 20, numTicks))
+			return -1;
+	}
+	return 0;
+}
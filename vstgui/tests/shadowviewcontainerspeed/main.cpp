@@ -0,0 +1,104 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/coffscreencontext.h"
+#include "vstgui/lib/cshadowviewcontainer.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+//------------------------------------------------------------------------
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+static bool measureShadow (CCoord size, uint32_t iterations)
+{
+	using namespace std::chrono;
+
+	auto frame = new CFrame (CRect (0, 0, size, size), nullptr);
+	auto closeFrame = finally ([frame] () { frame->close (); });
+	auto container = new CShadowViewContainer (CRect (0, 0, size, size));
+	for (auto y = 10.; y + 20. < size; y += 30.)
+	{
+		for (auto x = 10.; x + 20. < size; x += 30.)
+			container->addView (new CView (CRect (x, y, x + 20., y + 20.)));
+	}
+	frame->addView (container);
+	frame->attached (frame);
+	auto drawContext = COffscreenContext::create ({size, size});
+	if (!drawContext)
+	{
+		printf ("Could not create an offscreen context\n");
+		return false;
+	}
+
+	auto draw = [&] () {
+		drawContext->beginDraw ();
+		container->drawRect (drawContext, container->getViewSize ());
+		drawContext->endDraw ();
+	};
+	auto measure = [&] (auto invalidate) {
+		auto start = steady_clock::now ();
+		for (auto i = 0u; i < iterations; ++i)
+		{
+			invalidate ();
+			draw ();
+		}
+		return static_cast<double> (
+				   duration_cast<microseconds> (steady_clock::now () - start).count ()) /
+			   (iterations * 1000.);
+	};
+	double regenerate[3];
+	uint32_t index = 0;
+	for (auto downsampling : {1u, 2u, 4u})
+	{
+		container->setShadowDownsampling (downsampling);
+		regenerate[index++] = measure ([&] () { container->invalidateShadow (); });
+	}
+	auto shapeCheck = measure ([&] () { container->invalidateShadowShape (); });
+	container->setShadowFollowsContent (true);
+	auto child = container->getView (0);
+	auto contentChange = measure ([&] () { child->invalid (); });
+
+	printf ("%4.0fx%-4.0f  shadow %7.2f ms  1/2 resolution %7.2f ms  1/4 resolution %7.2f ms  "
+			"unchanged shape %7.2f ms  content change %7.2f ms\n",
+			size, size, regenerate[0], regenerate[1], regenerate[2], shapeCheck, contentChange);
+	return true;
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#else
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	// usage: shadowviewcontainerspeed [iterations]
+	uint32_t iterations = argc > 1 ? static_cast<uint32_t> (std::stoul (argv[1])) : 5;
+	if (iterations == 0)
+		iterations = 1;
+
+	for (auto size : {100., 400., 1000.})
+	{
+		if (!measureShadow (size, iterations))
+			return -1;
+	}
+	return 0;
+}
@@ -0,0 +1,274 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cresourcedescription.h"
+#include "vstgui/lib/cviewcontainer.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+#include "vstgui/uidescription/cstream.h"
+#include "vstgui/uidescription/uicontentprovider.h"
+#include "vstgui/uidescription/uidescription.h"
+#include "vstgui/uidescription/uiviewfactory.h"
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <list>
+#include <sstream>
+#include <string>
+
+//------------------------------------------------------------------------
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+struct BenchmarkUIDescription : UIDescription
+{
+	using UIDescription::UIDescription;
+	using UIDescription::saveToStream;
+};
+
+//------------------------------------------------------------------------
+/** forwards to the UIViewFactory, this way the UIDescription does not use creation plans */
+struct ForwardingViewFactory : IViewFactory
+{
+	CView* createView (const UIAttributes& attributes, const IUIDescription* desc) const override
+	{
+		return factory.createView (attributes, desc);
+	}
+	bool applyAttributeValues (CView* view, const UIAttributes& attributes,
+							   const IUIDescription* desc) const override
+	{
+		return factory.applyAttributeValues (view, attributes, desc);
+	}
+	bool applyCustomViewAttributeValues (CView* customView, IdStringPtr baseViewName,
+										 const UIAttributes& attributes,
+										 const IUIDescription* desc) const override
+	{
+		return factory.applyCustomViewAttributeValues (customView, baseViewName, attributes, desc);
+	}
+
+	UIViewFactory factory;
+};
+
+//------------------------------------------------------------------------
+static std::string createTestDescription (uint32_t numTemplates, uint32_t numRows)
+{
+	std::ostringstream str;
+	str << R"({"vstgui-ui-description": {"version": "1", "colors": {"c1": "#000000ff", "c2": "#ff0000ff"}, )";
+	str << R"("control-tags": {)";
+	for (auto i = 0u; i < numRows; ++i)
+		str << (i ? ", " : "") << "\"tag" << i << "\": \"" << i << "\"";
+	str << R"(}, "templates": {)";
+	for (auto t = 0u; t < numTemplates; ++t)
+	{
+		str << (t ? ", " : "") << "\"template" << t << "\": {";
+		str << R"("attributes": {"class": "CViewContainer", "origin": "0, 0", "size": "400, )"
+			<< numRows * 20 << R"(", "background-color": "c1"}, "children": {)";
+		for (auto r = 0u; r < numRows; ++r)
+		{
+			str << (r ? ", " : "") << R"("CViewContainer": {"attributes": {"class": "CViewContainer", "origin": "0, )"
+				<< r * 20 << R"(", "size": "400, 20", "background-color": "c2", "transparent": "true"}, )";
+			str << R"("children": {"CTextLabel": {"attributes": {"class": "CTextLabel", "origin": "0, 0", )";
+			str << R"("size": "200, 20", "title": "Label )" << r << R"(", "font-color": "c1", )";
+			str << R"("text-alignment": "left", "transparent": "true"}}, )";
+			str << R"("CTextEdit": {"attributes": {"class": "CTextEdit", "origin": "200, 0", "size": "200, 20", )";
+			str << R"("control-tag": "tag)" << r << R"(", "default-value": "0.5", )";
+			str << R"("value-precision": "2", "font-color": "c2"}}}})";
+		}
+		str << "}}";
+	}
+	str << "}}}";
+	return str.str ();
+}
+
+//------------------------------------------------------------------------
+static uint32_t countViews (CView* view)
+{
+	uint32_t count = 1;
+	if (auto container = view->asViewContainer ())
+	{
+		container->forEachChild ([&] (CView* child) { count += countViews (child); });
+	}
+	return count;
+}
+
+//------------------------------------------------------------------------
+struct Result
+{
+	double parseTime {0.};
+	double createViewTime {0.};
+	uint32_t numViews {0};
+	bool ok {true};
+};
+
+//------------------------------------------------------------------------
+static Result measure (const void* data, size_t dataSize, uint32_t iterations)
+{
+	using Clock = std::chrono::high_resolution_clock;
+	Result result;
+	for (auto i = 0u; i < iterations; ++i)
+	{
+		MemoryContentProvider provider (data, static_cast<uint32_t> (dataSize));
+		UIDescription desc (&provider);
+		auto start = Clock::now ();
+		if (!desc.parse ())
+		{
+			result.ok = false;
+			return result;
+		}
+		auto parsed = Clock::now ();
+		std::list<const std::string*> templateNames;
+		desc.collectTemplateViewNames (templateNames);
+		result.numViews = 0;
+		for (auto name : templateNames)
+		{
+			if (auto view = desc.createView (name->data (), nullptr))
+			{
+				result.numViews += countViews (view);
+				view->forget ();
+			}
+		}
+		auto created = Clock::now ();
+		result.parseTime += std::chrono::duration<double, std::milli> (parsed - start).count ();
+		result.createViewTime +=
+			std::chrono::duration<double, std::milli> (created - parsed).count ();
+	}
+	result.parseTime /= iterations;
+	result.createViewTime /= iterations;
+	return result;
+}
+
+//------------------------------------------------------------------------
+static double measureInstantiation (const std::string& text, IViewFactory* factory,
+									uint32_t iterations, uint32_t& numViews)
+{
+	using Clock = std::chrono::high_resolution_clock;
+	MemoryContentProvider provider (text.data (), static_cast<uint32_t> (text.size ()));
+	UIDescription desc (&provider, factory);
+	if (!desc.parse ())
+		return 0.;
+	std::list<const std::string*> templateNames;
+	desc.collectTemplateViewNames (templateNames);
+	if (templateNames.empty ())
+		return 0.;
+	// use the largest template
+	const std::string* templateName = nullptr;
+	numViews = 0;
+	for (auto name : templateNames)
+	{
+		if (auto view = desc.createView (name->data (), nullptr))
+		{
+			auto count = countViews (view);
+			if (count > numViews)
+			{
+				numViews = count;
+				templateName = name;
+			}
+			view->forget ();
+		}
+	}
+	if (!templateName)
+		return 0.;
+	auto start = Clock::now ();
+	for (auto i = 0u; i < iterations; ++i)
+	{
+		if (auto view = desc.createView (templateName->data (), nullptr))
+			view->forget ();
+	}
+	return std::chrono::duration<double, std::milli> (Clock::now () - start).count () / iterations;
+}
+
+//------------------------------------------------------------------------
+static void printResult (const char* name, size_t dataSize, const Result& result)
+{
+	printf ("%-8s %10zu bytes  parse %8.3f ms  createView %8.3f ms  (%u views)\n", name, dataSize,
+			result.parseTime, result.createViewTime, result.numViews);
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#else
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	// usage: uidescloadspeed [path to uidesc file] [iterations]
+	std::string text;
+	if (argc > 1)
+	{
+		std::ifstream file (argv[1], std::ios::binary);
+		if (!file)
+		{
+			printf ("Could not open %s\n", argv[1]);
+			return -1;
+		}
+		text.assign (std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ());
+	}
+	else
+	{
+		text = createTestDescription (50, 100);
+	}
+	uint32_t iterations = argc > 2 ? static_cast<uint32_t> (std::stoul (argv[2])) : 10;
+	if (iterations == 0)
+		iterations = 1;
+
+	CMemoryStream binary;
+	{
+		MemoryContentProvider provider (text.data (), static_cast<uint32_t> (text.size ()));
+		BenchmarkUIDescription desc (&provider);
+		if (!desc.parse () ||
+			!desc.saveToStream (binary,
+								UIDescription::kWriteImagesIntoUIDescFile |
+									UIDescription::kDoNotVerifyImageData |
+									UIDescription::kWriteAsBinary,
+								nullptr))
+		{
+			printf ("Compiling the description failed\n");
+			return -1;
+		}
+	}
+	auto binarySize = static_cast<size_t> (binary.tell ());
+
+	auto textResult = measure (text.data (), text.size (), iterations);
+	auto binaryResult = measure (binary.getBuffer (), binarySize, iterations);
+	if (!textResult.ok || !binaryResult.ok)
+	{
+		printf ("Parsing failed\n");
+		return -1;
+	}
+	printResult ("text", text.size (), textResult);
+	printResult ("binary", binarySize, binaryResult);
+	printf ("parse speedup %.2fx\n", textResult.parseTime / binaryResult.parseTime);
+	if (textResult.numViews != binaryResult.numViews)
+	{
+		printf ("View trees differ\n");
+		return -1;
+	}
+
+	uint32_t numViews = 0;
+	uint32_t numViewsWithPlans = 0;
+	ForwardingViewFactory forwardingFactory;
+	auto withoutPlans = measureInstantiation (text, &forwardingFactory, iterations * 10, numViews);
+	auto withPlans = measureInstantiation (text, nullptr, iterations * 10, numViewsWithPlans);
+	printf ("largest template (%u views): createView %8.3f ms, with creation plans %8.3f ms\n",
+			numViews, withoutPlans, withPlans);
+	if (numViews != numViewsWithPlans)
+	{
+		printf ("View trees differ\n");
+		return -1;
+	}
+	return 0;
+}
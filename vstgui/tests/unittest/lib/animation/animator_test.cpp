@@ -118,3 +118,67 @@ TEST_CASE (AnimatorTest, AnimationMessage)
 } // VSTGUI
 
 #endif // MAC
+
+namespace VSTGUI {
+using namespace Animation;
+
+//-----------------------------------------------------------------------------
+TEST_CASE (AnimatorTest, FramePacing)
+{
+	auto a = owned (new Animator ());
+	a->setFrameRate (30);
+	EXPECT_EQ (a->getFrameRate (), 30u);
+	a->onFrame (1000);
+	EXPECT_EQ (a->getFrameStatistics ().numFrames, 1u);
+	// not yet due
+	a->onFrame (1016);
+	EXPECT_EQ (a->getFrameStatistics ().numFrames, 1u);
+	a->onFrame (1033);
+	EXPECT_EQ (a->getFrameStatistics ().numFrames, 2u);
+	EXPECT_EQ (a->getFrameStatistics ().numDroppedFrames, 0u);
+	// three frames at 1066, 1100 and 1133 were missed
+	a->onFrame (1190);
+	EXPECT_EQ (a->getFrameStatistics ().numFrames, 3u);
+	EXPECT_EQ (a->getFrameStatistics ().numDroppedFrames, 3u);
+	a->resetFrameStatistics ();
+	EXPECT_EQ (a->getFrameStatistics ().numFrames, 0u);
+	EXPECT_EQ (a->getFrameStatistics ().numDroppedFrames, 0u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE (AnimatorTest, NoDroppedFramesAtTimerInterval)
+{
+	for (auto frameRate : {24u, 30u, 60u, 90u, 120u, 144u})
+	{
+		auto a = owned (new Animator ());
+		a->setFrameRate (frameRate);
+		auto tickInterval = Animator::getTimerInterval (frameRate);
+		EXPECT (tickInterval <= 1000. / frameRate);
+		// ten seconds of timer ticks
+		for (uint64_t ticks = 1000; ticks <= 11000; ticks += tickInterval)
+			a->onFrame (ticks);
+		EXPECT_EQ (a->getFrameStatistics ().numDroppedFrames, 0u);
+		EXPECT (a->getFrameStatistics ().numFrames >= frameRate * 10 - 1);
+		EXPECT (a->getFrameStatistics ().numFrames <= frameRate * 10 + 1);
+	}
+	EXPECT_EQ (Animator::getTimerInterval (60), 16u);
+	EXPECT_EQ (Animator::getTimerInterval (5000), 1u);
+}
+
+//-----------------------------------------------------------------------------
+TEST_CASE (AnimatorTest, FrameUpdateWrapper)
+{
+	auto a = owned (new Animator ());
+	uint32_t numWrapperCalls = 0;
+	a->setFrameUpdateWrapper ([&] (const Animator::FrameUpdateFunction& update) {
+		++numWrapperCalls;
+		update ();
+	});
+	a->onFrame (1000);
+	a->onFrame (1017);
+	a->onFrame (1020);
+	EXPECT_EQ (numWrapperCalls, 2u);
+	EXPECT (a->getFrameStatistics ().totalFrameTime >= a->getFrameStatistics ().maxFrameTime);
+}
+
+} // VSTGUI
@@ -0,0 +1,316 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/cbitmapfilter.h"
+#include "../../../lib/ccolor.h"
+#include "../unittests.h"
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+using namespace BitmapFilter;
+
+//------------------------------------------------------------------------
+// an odd width to test the remaining pixels of the vectorized row kernels
+constexpr CCoord kBitmapWidth = 13.;
+constexpr CCoord kBitmapHeight = 5.;
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> createTestBitmap ()
+{
+	auto bitmap = makeOwned<CBitmap> (kBitmapWidth, kBitmapHeight);
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		uint8_t value = 0;
+		do
+		{
+			// every third pixel is opaque white to have something to replace
+			if (((accessor->getX () + accessor->getY ()) % 3) == 0)
+				accessor->setColor (kWhiteCColor);
+			else
+				accessor->setColor (CColor (value, value * 3, value * 7, 255));
+			value += 11;
+		} while (++(*accessor));
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+// large enough that the filters split the rows into bands which run in parallel, if the system
+// has more than one core
+constexpr CCoord kLargeBitmapWidth = 512.;
+constexpr CCoord kLargeBitmapHeight = 520.;
+
+//------------------------------------------------------------------------
+SharedPointer<CBitmap> createLargeTestBitmap ()
+{
+	auto bitmap = makeOwned<CBitmap> (kLargeBitmapWidth, kLargeBitmapHeight);
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		do
+		{
+			auto x = accessor->getX ();
+			auto y = accessor->getY ();
+			// every seventh pixel is opaque white to have something to replace
+			if (((x * 3 + y) % 7) == 0)
+				accessor->setColor (kWhiteCColor);
+			else
+				accessor->setColor (CColor (static_cast<uint8_t> (x * 7 + y),
+											static_cast<uint8_t> (y * 5 + (x >> 3)),
+											static_cast<uint8_t> ((x ^ y) * 3), 255));
+		} while (++(*accessor));
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+std::vector<CColor> getColors (CBitmap* bitmap)
+{
+	std::vector<CColor> result;
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		do
+		{
+			CColor color;
+			accessor->getColor (color);
+			result.emplace_back (color);
+		} while (++(*accessor));
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+CBitmap* runFilter (IFilter* filter, CBitmap* input)
+{
+	filter->setProperty (Standard::Property::kInputBitmap, input);
+	if (!filter->run ())
+		return nullptr;
+	auto object = filter->getProperty (Standard::Property::kOutputBitmap).getObject ();
+	return dynamic_cast<CBitmap*> (object);
+}
+
+//------------------------------------------------------------------------
+void expectPerPixelResult (CBitmap* input, CBitmap* output,
+						   const std::function<CColor (CColor)>& expected)
+{
+	auto inputColors = getColors (input);
+	auto outputColors = getColors (output);
+	EXPECT_EQ (inputColors.size (), outputColors.size ());
+	for (auto i = 0u; i < inputColors.size (); ++i)
+	{
+		EXPECT_EQ (outputColors[i], expected (inputColors[i]));
+	}
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapFilterTest, Grayscale)
+{
+	auto input = createTestBitmap ();
+	auto filter = owned (Factory::getInstance ().createFilter (Standard::kGrayscale));
+	EXPECT (filter);
+	auto output = runFilter (filter, input);
+	EXPECT (output);
+	expectPerPixelResult (input, output, [] (CColor color) {
+		color.red = color.green = color.blue = color.getLuma ();
+		return color;
+	});
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapFilterTest, SetColorIgnoreAlpha)
+{
+	auto input = createTestBitmap ();
+	auto filter = owned (Factory::getInstance ().createFilter (Standard::kSetColor));
+	EXPECT (filter);
+	CColor color (10, 20, 30, 40);
+	filter->setProperty (Standard::Property::kInputColor, color);
+	filter->setProperty (Standard::Property::kIgnoreAlphaColorValue, static_cast<int32_t> (1));
+	auto output = runFilter (filter, input);
+	EXPECT (output);
+	expectPerPixelResult (input, output, [&] (CColor c) {
+		return CColor (color.red, color.green, color.blue, c.alpha);
+	});
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapFilterTest, SetColor)
+{
+	auto input = createTestBitmap ();
+	auto filter = owned (Factory::getInstance ().createFilter (Standard::kSetColor));
+	EXPECT (filter);
+	CColor color (10, 20, 30, 40);
+	filter->setProperty (Standard::Property::kInputColor, color);
+	filter->setProperty (Standard::Property::kIgnoreAlphaColorValue, static_cast<int32_t> (0));
+	auto output = runFilter (filter, input);
+	EXPECT (output);
+	expectPerPixelResult (input, output, [&] (CColor) { return color; });
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapFilterTest, ReplaceColor)
+{
+	auto input = createTestBitmap ();
+	auto filter = owned (Factory::getInstance ().createFilter (Standard::kReplaceColor));
+	EXPECT (filter);
+	filter->setProperty (Standard::Property::kInputColor, kWhiteCColor);
+	filter->setProperty (Standard::Property::kOutputColor, kRedCColor);
+	auto output = runFilter (filter, input);
+	EXPECT (output);
+	expectPerPixelResult (input, output,
+						  [] (CColor c) { return c == kWhiteCColor ? kRedCColor : c; });
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapFilterTest, ScaleLinear)
+{
+	auto input = createTestBitmap ();
+	auto filter = owned (Factory::getInstance ().createFilter (Standard::kScaleLinear));
+	EXPECT (filter);
+	filter->setProperty (Standard::Property::kOutputRect,
+						 CRect (0, 0, kBitmapWidth * 2., kBitmapHeight * 2.));
+	auto output = runFilter (filter, input);
+	EXPECT (output);
+	EXPECT_EQ (output->getWidth (), kBitmapWidth * 2.);
+	EXPECT_EQ (output->getHeight (), kBitmapHeight * 2.);
+	auto inputColors = getColors (input);
+	auto outputColors = getColors (output);
+	auto inputWidth = static_cast<size_t> (kBitmapWidth);
+	auto outputWidth = inputWidth * 2;
+	for (auto i = 0u; i < outputColors.size (); ++i)
+	{
+		auto x = (i % outputWidth) / 2;
+		auto y = (i / outputWidth) / 2;
+		EXPECT_EQ (outputColors[i], inputColors[y * inputWidth + x]);
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapFilterTest, BoxBlurUniformColor)
+{
+	auto input = makeOwned<CBitmap> (kBitmapWidth, kBitmapHeight);
+	if (auto accessor = owned (CBitmapPixelAccess::create (input)))
+	{
+		do
+		{
+			accessor->setColor (CColor (100, 150, 200, 255));
+		} while (++(*accessor));
+	}
+	auto filter = owned (Factory::getInstance ().createFilter (Standard::kBoxBlur));
+	EXPECT (filter);
+	filter->setProperty (Standard::Property::kRadius, static_cast<int32_t> (4));
+	auto output = runFilter (filter, input);
+	EXPECT (output);
+	expectPerPixelResult (input, output, [] (CColor c) { return c; });
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapFilterTest, GrayscaleInBands)
+{
+	auto input = createLargeTestBitmap ();
+	auto filter = owned (Factory::getInstance ().createFilter (Standard::kGrayscale));
+	EXPECT (filter);
+	auto output = runFilter (filter, input);
+	EXPECT (output);
+	expectPerPixelResult (input, output, [] (CColor color) {
+		color.red = color.green = color.blue = color.getLuma ();
+		return color;
+	});
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapFilterTest, ReplaceColorInBands)
+{
+	auto input = createLargeTestBitmap ();
+	auto filter = owned (Factory::getInstance ().createFilter (Standard::kReplaceColor));
+	EXPECT (filter);
+	filter->setProperty (Standard::Property::kInputColor, kWhiteCColor);
+	filter->setProperty (Standard::Property::kOutputColor, kRedCColor);
+	auto output = runFilter (filter, input);
+	EXPECT (output);
+	expectPerPixelResult (input, output,
+						  [] (CColor c) { return c == kWhiteCColor ? kRedCColor : c; });
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapFilterTest, ScaleLinearInBands)
+{
+	auto input = createLargeTestBitmap ();
+	auto filter = owned (Factory::getInstance ().createFilter (Standard::kScaleLinear));
+	EXPECT (filter);
+	filter->setProperty (Standard::Property::kOutputRect,
+						 CRect (0, 0, kLargeBitmapWidth * 2., kLargeBitmapHeight * 2.));
+	auto output = runFilter (filter, input);
+	EXPECT (output);
+	auto inputColors = getColors (input);
+	auto outputColors = getColors (output);
+	auto inputWidth = static_cast<size_t> (kLargeBitmapWidth);
+	auto outputWidth = inputWidth * 2;
+	EXPECT_EQ (outputColors.size (), inputColors.size () * 4);
+	for (auto i = 0u; i < outputColors.size (); ++i)
+	{
+		auto x = (i % outputWidth) / 2;
+		auto y = (i / outputWidth) / 2;
+		EXPECT_EQ (outputColors[i], inputColors[y * inputWidth + x]);
+	}
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapFilterTest, BoxBlurInBands)
+{
+	constexpr int32_t radius = 6;
+	auto input = createLargeTestBitmap ();
+	auto filter = owned (Factory::getInstance ().createFilter (Standard::kBoxBlur));
+	EXPECT (filter);
+	filter->setProperty (Standard::Property::kRadius, radius);
+	auto output = runFilter (filter, input);
+	EXPECT (output);
+
+	// the serial box blur: a horizontal and a vertical pass over radius / 2 pixels on each side,
+	// pixels outside of the bitmap repeat the edge pixels
+	auto width = static_cast<int32_t> (kLargeBitmapWidth);
+	auto height = static_cast<int32_t> (kLargeBitmapHeight);
+	auto r = radius / 2;
+	auto div = r + r + 1;
+	auto clamp = [] (int32_t v, int32_t max) { return std::min (std::max (v, 0), max - 1); };
+	auto inputColors = getColors (input);
+	auto blur = [&] (const std::vector<CColor>& src, bool horizontal) {
+		std::vector<CColor> dst (src.size ());
+		for (auto y = 0; y < height; ++y)
+		{
+			for (auto x = 0; x < width; ++x)
+			{
+				int32_t sum[4] = {};
+				for (auto i = -r; i <= r; ++i)
+				{
+					const auto& c = horizontal ? src[y * width + clamp (x + i, width)]
+											   : src[clamp (y + i, height) * width + x];
+					sum[0] += c.red;
+					sum[1] += c.green;
+					sum[2] += c.blue;
+					sum[3] += c.alpha;
+				}
+				dst[y * width + x] =
+					CColor (static_cast<uint8_t> (sum[0] / div), static_cast<uint8_t> (sum[1] / div),
+							static_cast<uint8_t> (sum[2] / div), static_cast<uint8_t> (sum[3] / div));
+			}
+		}
+		return dst;
+	};
+	auto expected = blur (blur (inputColors, true), false);
+	auto outputColors = getColors (output);
+	EXPECT_EQ (outputColors.size (), expected.size ());
+	for (auto i = 0u; i < outputColors.size (); ++i)
+		EXPECT_EQ (outputColors[i], expected[i]);
+}
+
+//------------------------------------------------------------------------
+} // VSTGUI
@@ -0,0 +1,138 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cbitmaptilerenderer.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+uint32_t pixelValue (uint32_t x, uint32_t y)
+{
+	return (x << 16) | y;
+}
+
+//------------------------------------------------------------------------
+CBitmapTileRenderer::Config makeConfig (uint32_t tileSize, uint32_t numThreads)
+{
+	CBitmapTileRenderer::Config config;
+	config.tileSize = tileSize;
+	config.numThreads = numThreads;
+	return config;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapTileRendererTest, RendersAllPixels)
+{
+	auto bitmap = makeOwned<CBitmap> (100., 70.);
+	std::atomic<uint32_t> numFinishedCalls {0};
+	auto config = makeConfig (32, 3);
+	config.tileFinished = [&] () { ++numFinishedCalls; };
+	CBitmapTileRenderer renderer (bitmap,
+								  [] (const CBitmapTileRenderer::Tile& tile) {
+									  for (auto y = tile.top; y < tile.bottom; y += tile.blockSize)
+									  {
+										  for (auto x = tile.left; x < tile.right;
+											   x += tile.blockSize)
+											  tile.fillBlock (x, y, pixelValue (x, y));
+									  }
+								  },
+								  std::move (config));
+	EXPECT_EQ (renderer.getWidth (), 100u);
+	EXPECT_EQ (renderer.getHeight (), 70u);
+	EXPECT_EQ (renderer.getNumTiles (), 12u);
+	EXPECT_EQ (renderer.getNumThreads (), 3u);
+	renderer.start ();
+	renderer.wait ();
+	EXPECT (renderer.isDone ());
+	// two passes
+	EXPECT_EQ (numFinishedCalls, 24u);
+
+	// the result of the last pass replaces the one of the first pass
+	auto rects = renderer.commit ();
+	EXPECT_EQ (rects.size (), 12u);
+	EXPECT (renderer.commit ().empty ());
+	CCoord area = 0.;
+	for (const auto& r : rects)
+		area += r.getWidth () * r.getHeight ();
+	EXPECT_EQ (area, 7000.);
+
+	auto accessor = owned (CBitmapPixelAccess::create (bitmap));
+	EXPECT (accessor);
+	uint32_t numWrongPixels = 0;
+	do
+	{
+		uint32_t value;
+		accessor->getValue (value);
+		if (value != pixelValue (accessor->getX (), accessor->getY ()))
+			++numWrongPixels;
+	} while (++*accessor);
+	EXPECT_EQ (numWrongPixels, 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapTileRendererTest, PassesAreRenderedInOrder)
+{
+	auto bitmap = makeOwned<CBitmap> (64., 64.);
+	std::atomic<uint32_t> numCoarseTiles {0};
+	std::atomic<uint32_t> numEarlyTiles {0};
+	std::atomic<uint32_t> numWrongBlockSizes {0};
+	auto config = makeConfig (16, 4);
+	config.passes = {4, 2, 1};
+	CBitmapTileRenderer renderer (bitmap,
+								  [&] (const CBitmapTileRenderer::Tile& tile) {
+									  if (tile.pass == 0)
+										  ++numCoarseTiles;
+									  else if (numCoarseTiles != 16)
+										  ++numEarlyTiles;
+									  if (tile.blockSize != (4u >> tile.pass))
+										  ++numWrongBlockSizes;
+								  },
+								  std::move (config));
+	renderer.start ();
+	renderer.wait ();
+	EXPECT (renderer.isDone ());
+	EXPECT_EQ (numCoarseTiles, 16u);
+	EXPECT_EQ (numEarlyTiles, 0u);
+	EXPECT_EQ (numWrongBlockSizes, 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapTileRendererTest, Cancel)
+{
+	auto bitmap = makeOwned<CBitmap> (64., 64.);
+	std::atomic<uint32_t> numRenderedTiles {0};
+	CBitmapTileRenderer renderer (bitmap,
+								  [&] (const CBitmapTileRenderer::Tile& tile) {
+									  ++numRenderedTiles;
+									  while (!tile.isCanceled ())
+										  std::this_thread::yield ();
+								  },
+								  makeConfig (16, 2));
+	renderer.start ();
+	while (numRenderedTiles == 0)
+		std::this_thread::yield ();
+	renderer.cancel ();
+	renderer.wait ();
+	EXPECT_FALSE (renderer.isDone ());
+	EXPECT (renderer.commit ().empty ());
+	EXPECT (numRenderedTiles <= 2u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CBitmapTileRendererTest, EmptyBitmap)
+{
+	auto bitmap = makeOwned<CBitmap> (0., 0.);
+	CBitmapTileRenderer renderer (bitmap, [] (const CBitmapTileRenderer::Tile&) {});
+	EXPECT_EQ (renderer.getNumTiles (), 0u);
+	renderer.start ();
+	renderer.wait ();
+	EXPECT (renderer.commit ().empty ());
+}
+
+} // VSTGUI
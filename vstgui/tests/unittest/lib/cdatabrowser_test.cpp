@@ -0,0 +1,184 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cdatabrowser.h"
+#include "../../../lib/cframe.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../../../lib/controls/ctextedit.h"
+#include "../../../lib/idatabrowserdelegate.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+struct TestDelegate : DataBrowserDelegateAdapter
+{
+	int32_t numRows {200000};
+	uint32_t numDrawnCells {0};
+	uint32_t numColumnWidthCalls {0};
+	int32_t minDrawnRow {-1};
+	int32_t maxDrawnRow {-1};
+	uint32_t numSelectedCells {0};
+	CTextEdit* lastTextEdit {nullptr};
+
+	int32_t dbGetNumRows (CDataBrowser* browser) override { return numRows; }
+	int32_t dbGetNumColumns (CDataBrowser* browser) override { return 3; }
+	CCoord dbGetRowHeight (CDataBrowser* browser) override { return 20.; }
+	CCoord dbGetCurrentColumnWidth (int32_t index, CDataBrowser* browser) override
+	{
+		++numColumnWidthCalls;
+		return 50. + index * 10.;
+	}
+	bool dbGetLineWidthAndColor (CCoord& width, CColor& color, CDataBrowser* browser) override
+	{
+		width = 1.;
+		color = kBlackCColor;
+		return true;
+	}
+	void dbDrawCell (CDrawContext* context, const CRect& size, int32_t row, int32_t column,
+					 int32_t flags, CDataBrowser* browser) override
+	{
+		++numDrawnCells;
+		if (minDrawnRow == -1 || row < minDrawnRow)
+			minDrawnRow = row;
+		maxDrawnRow = std::max (maxDrawnRow, row);
+		if (flags & kRowSelected)
+			++numSelectedCells;
+	}
+	void dbCellSetupTextEdit (int32_t row, int32_t column, CTextEdit* textEditControl,
+							  CDataBrowser* browser) override
+	{
+		lastTextEdit = textEditControl;
+	}
+};
+
+constexpr auto kBrowserStyle = CDataBrowser::kDrawRowLines | CDataBrowser::kDrawColumnLines |
+							   CDataBrowser::kMultiSelectionStyle | CScrollView::kDontDrawFrame |
+							   CScrollView::kVerticalScrollbar;
+
+//------------------------------------------------------------------------
+/** sends the loose focus message like CTextEdit does when its platform text edit lost focus */
+void endTextEdit (CTextEdit* textEdit)
+{
+	CView* receiver = textEdit->getParentView ();
+	while (receiver)
+	{
+		if (receiver->notify (textEdit, kMsgLooseFocus) == kMessageNotified)
+			break;
+		receiver = receiver->getParentView ();
+	}
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CDataBrowserTest, CellBounds)
+{
+	TestDelegate delegate;
+	auto browser = owned (new CDataBrowser (CRect (0, 0, 300, 300), &delegate, kBrowserStyle));
+	browser->recalculateLayout ();
+	// row height and column widths include the line width
+	auto bounds = browser->getCellBounds (CDataBrowser::Cell (2, 1));
+	EXPECT_EQ (bounds, CRect (51, 42, 111, 63));
+	auto cell = browser->getCellAt (CPoint (60, 50));
+	EXPECT_EQ (cell.row, 2);
+	EXPECT_EQ (cell.column, 1);
+	cell = browser->getCellAt (CPoint (175, 50));
+	EXPECT_EQ (cell.column, 2);
+	cell = browser->getCellAt (CPoint (190, 50));
+	EXPECT_FALSE (cell.isValid ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CDataBrowserTest, Selection)
+{
+	TestDelegate delegate;
+	auto browser = owned (new CDataBrowser (CRect (0, 0, 300, 300), &delegate, kBrowserStyle));
+	browser->recalculateLayout ();
+	browser->selectRow (10);
+	browser->selectRow (150000);
+	EXPECT_TRUE (browser->isRowSelected (10));
+	EXPECT_TRUE (browser->isRowSelected (150000));
+	EXPECT_FALSE (browser->isRowSelected (11));
+	EXPECT_EQ (browser->getSelection ().size (), 2u);
+	browser->unselectRow (10);
+	EXPECT_FALSE (browser->isRowSelected (10));
+	EXPECT_EQ (browser->getSelectedRow (), 150000);
+	browser->setSelectedRow (5);
+	EXPECT_TRUE (browser->isRowSelected (5));
+	EXPECT_FALSE (browser->isRowSelected (150000));
+	EXPECT_EQ (browser->getSelection ().size (), 1u);
+	browser->selectRow (199999);
+	delegate.numRows = 100;
+	browser->recalculateLayout (true);
+	EXPECT_TRUE (browser->isRowSelected (5));
+	EXPECT_FALSE (browser->isRowSelected (199999));
+	EXPECT_EQ (browser->getSelection ().size (), 1u);
+	browser->unselectAll ();
+	EXPECT_FALSE (browser->isRowSelected (5));
+	EXPECT_EQ (browser->getSelectedRow (), CDataBrowser::kNoSelection);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CDataBrowserTest, DrawOnlyVisibleRows)
+{
+	TestDelegate delegate;
+	auto frame = new CFrame (CRect (0, 0, 300, 300), nullptr);
+	auto browser = new CDataBrowser (CRect (0, 0, 300, 300), &delegate, kBrowserStyle);
+	frame->addView (browser);
+	frame->attached (frame);
+	browser->setSelectedRow (100010);
+	browser->makeRowVisible (100010);
+
+	auto drawContext = COffscreenContext::create ({300., 300.});
+	EXPECT (drawContext);
+	drawContext->beginDraw ();
+	delegate.numColumnWidthCalls = 0;
+	browser->drawRect (drawContext, browser->getViewSize ());
+	drawContext->endDraw ();
+
+	// 300 / 21 visible rows, partially visible rows on both ends
+	EXPECT (delegate.numDrawnCells <= 16u * 3u);
+	EXPECT (delegate.numDrawnCells >= 14u * 3u);
+	EXPECT (delegate.minDrawnRow > 99990);
+	EXPECT (delegate.maxDrawnRow <= 100010);
+	EXPECT_EQ (delegate.numSelectedCells, 3u);
+	// the column widths are cached per layout
+	EXPECT (delegate.numColumnWidthCalls < 10u);
+	frame->close ();
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CDataBrowserTest, TextEditRecycling)
+{
+	TestDelegate delegate;
+	auto frame = new CFrame (CRect (0, 0, 300, 300), nullptr);
+	auto browser = new CDataBrowser (CRect (0, 0, 300, 300), &delegate, kBrowserStyle);
+	frame->addView (browser);
+	frame->attached (frame);
+	browser->setTextEditRecycling (true);
+	EXPECT_TRUE (browser->getTextEditRecycling ());
+
+	browser->beginTextEdit (CDataBrowser::Cell (1, 1), "first");
+	SharedPointer<CTextEdit> firstTextEdit = delegate.lastTextEdit;
+	EXPECT (firstTextEdit);
+	endTextEdit (firstTextEdit);
+	EXPECT_FALSE (firstTextEdit->isAttached ());
+
+	browser->beginTextEdit (CDataBrowser::Cell (2, 0), "second");
+	EXPECT_EQ (delegate.lastTextEdit, firstTextEdit.get ());
+	EXPECT_EQ (firstTextEdit->getViewSize (), browser->getCellBounds (CDataBrowser::Cell (2, 0)));
+	EXPECT_EQ (firstTextEdit->getText (), "second");
+	endTextEdit (firstTextEdit);
+
+	browser->setTextEditRecycling (false);
+	browser->beginTextEdit (CDataBrowser::Cell (1, 1), "third");
+	EXPECT_NE (delegate.lastTextEdit, firstTextEdit.get ());
+	endTextEdit (delegate.lastTextEdit);
+	frame->close ();
+}
+
+} // VSTGUI
@@ -4,6 +4,7 @@
 
 #include "../../../lib/ccolor.h"
 #include "../../../lib/cframe.h"
+#include "../../../lib/controls/ccontrol.h"
 #include "../../../lib/events.h"
 #include "../unittests.h"
 #include "eventhelpers.h"
@@ -665,6 +666,155 @@ TEST_CASE (CFrameTest, KeyboardHook)
 	frame->unregisterKeyboardHook (&hook);
 }
 
+TEST_CASE (CFrameTest, IdleInvalidatesDirtyViews)
+{
+	struct InvalidCountView : CView
+	{
+		InvalidCountView () : CView (CRect (0, 0, 10, 10)) {}
+		void invalid () override
+		{
+			++numInvalidCalls;
+			CView::invalid ();
+		}
+		uint32_t numInvalidCalls {0};
+	};
+
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto container = new CViewContainer (CRect (0, 0, 50, 50));
+	auto view1 = new InvalidCountView ();
+	auto view2 = new InvalidCountView ();
+	auto view3 = new InvalidCountView ();
+	container->addView (view1);
+	container->addView (view2);
+	frame->addView (container);
+	frame->addView (view3);
+	frame->setIdleVisitsOnlyDirtyViews (true);
+	// set dirty before the view is attached
+	view3->setDirty ();
+	frame->attached (frame);
+
+	view1->setDirty ();
+	view1->setDirty ();
+	frame->idle ();
+	EXPECT_EQ (view1->numInvalidCalls, 1u);
+	EXPECT_EQ (view2->numInvalidCalls, 0u);
+	EXPECT_EQ (view3->numInvalidCalls, 1u);
+	EXPECT_FALSE (view1->isDirty ());
+	EXPECT_FALSE (view3->isDirty ());
+	frame->idle ();
+	EXPECT_EQ (view1->numInvalidCalls, 1u);
+
+	// views in invisible containers are not invalidated
+	container->setVisible (false);
+	view2->setDirty ();
+	frame->idle ();
+	EXPECT_EQ (view2->numInvalidCalls, 0u);
+	EXPECT (view2->isDirty ());
+	// but they are when the container is visible again
+	container->setVisible (true);
+	frame->idle ();
+	EXPECT_EQ (view2->numInvalidCalls, 1u);
+	EXPECT_FALSE (view2->isDirty ());
+
+	// removed views are not visited
+	view3->setDirty ();
+	frame->removeView (view3);
+	frame->idle ();
+	frame->removeAll ();
+}
+
+TEST_CASE (CFrameTest, IdleInvalidatesControlsWithChangedValue)
+{
+	struct InvalidCountControl : CControl
+	{
+		InvalidCountControl () : CControl (CRect (0, 0, 10, 10)) {}
+		void draw (CDrawContext*) override {}
+		void invalid () override
+		{
+			++numInvalidCalls;
+			CControl::invalid ();
+		}
+		uint32_t numInvalidCalls {0};
+
+		CLASS_METHODS_NOCOPY (InvalidCountControl, CControl)
+	};
+
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto control = new InvalidCountControl ();
+	frame->addView (control);
+	frame->setIdleVisitsOnlyDirtyViews (true);
+	frame->attached (frame);
+	frame->idle ();
+	control->numInvalidCalls = 0;
+
+	control->setValue (0.5f);
+	frame->idle ();
+	EXPECT_EQ (control->numInvalidCalls, 1u);
+	control->setValue (0.5f);
+	frame->idle ();
+	EXPECT_EQ (control->numInvalidCalls, 1u);
+	control->setValueNormalized (1.f);
+	frame->idle ();
+	EXPECT_EQ (control->numInvalidCalls, 2u);
+	frame->removeAll ();
+}
+
+TEST_CASE (CFrameTest, IdleScansForDirtyViewsByDefault)
+{
+	struct CustomDirtyView : CView
+	{
+		CustomDirtyView () : CView (CRect (0, 0, 10, 10)) {}
+		bool isDirty () const override { return customDirty; }
+		void invalid () override
+		{
+			++numInvalidCalls;
+			customDirty = false;
+			CView::invalid ();
+		}
+		bool customDirty {false};
+		uint32_t numInvalidCalls {0};
+	};
+	struct DirectValueControl : CControl
+	{
+		DirectValueControl () : CControl (CRect (0, 0, 10, 10)) {}
+		void draw (CDrawContext*) override {}
+		void invalid () override
+		{
+			++numInvalidCalls;
+			CControl::invalid ();
+		}
+		void setValueDirectly (float newValue) { value = newValue; }
+		uint32_t numInvalidCalls {0};
+
+		CLASS_METHODS_NOCOPY (DirectValueControl, CControl)
+	};
+
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto view = new CustomDirtyView ();
+	auto control = new DirectValueControl ();
+	frame->addView (view);
+	frame->addView (control);
+	frame->attached (frame);
+	EXPECT_FALSE (frame->getIdleVisitsOnlyDirtyViews ());
+	frame->idle ();
+	control->numInvalidCalls = 0;
+
+	view->customDirty = true;
+	control->setValueDirectly (0.5f);
+	frame->idle ();
+	EXPECT_EQ (view->numInvalidCalls, 1u);
+	EXPECT_EQ (control->numInvalidCalls, 1u);
+
+	// these views are not posted to the registry, so they are not visited anymore
+	frame->setIdleVisitsOnlyDirtyViews (true);
+	view->customDirty = true;
+	control->setValueDirectly (1.f);
+	frame->idle ();
+	EXPECT_EQ (view->numInvalidCalls, 1u);
+	EXPECT_EQ (control->numInvalidCalls, 1u);
+	frame->removeAll ();
+}
+
 TEST_CASE (CFrameTest, Open)
 {
 	auto platformHandle = UnitTest::PlatformParentHandle::create ();
@@ -0,0 +1,118 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/cglyphatlas.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../../../lib/controls/cparamdisplay.h"
+#include "../../../lib/platform/iplatformbitmap.h"
+#include "../unittests.h"
+#include <string>
+
+namespace VSTGUI {
+
+//------------------------------------------------------------------------
+TEST_CASE (CGlyphAtlasTest, IsSupported)
+{
+	EXPECT_TRUE (CGlyphAtlas::isSupported ("-12.50 dB"));
+	EXPECT_TRUE (CGlyphAtlas::isSupported (""));
+	EXPECT_FALSE (CGlyphAtlas::isSupported (nullptr));
+	EXPECT_FALSE (CGlyphAtlas::isSupported ("100 \xC2\xB5s"));
+	EXPECT_FALSE (CGlyphAtlas::isSupported ("a\tb"));
+	std::string longString (CGlyphAtlas::kMaxStringLength, '0');
+	EXPECT_TRUE (CGlyphAtlas::isSupported (longString.data ()));
+	longString += '0';
+	EXPECT_FALSE (CGlyphAtlas::isSupported (longString.data ()));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CGlyphAtlasTest, SharedPerFontColorAndScaleFactor)
+{
+	CGlyphAtlas::clearCache ();
+	auto atlas = CGlyphAtlas::get (kNormalFont, kWhiteCColor, 1.);
+	EXPECT (atlas);
+	if (!atlas)
+		return;
+	EXPECT_EQ (CGlyphAtlas::get (kNormalFont, kWhiteCColor, 1.), atlas);
+	auto copy = makeOwned<CFontDesc> (*kNormalFont);
+	EXPECT_EQ (CGlyphAtlas::get (copy, kWhiteCColor, 1.), atlas);
+	EXPECT_NE (CGlyphAtlas::get (kNormalFont, kRedCColor, 1.), atlas);
+	EXPECT_NE (CGlyphAtlas::get (kNormalFontBig, kWhiteCColor, 1.), atlas);
+
+	auto atlas2x = CGlyphAtlas::get (kNormalFont, kWhiteCColor, 2.);
+	EXPECT (atlas2x && atlas2x != atlas);
+	EXPECT_EQ (atlas2x->getBitmap ()->getPlatformBitmap ()->getSize (),
+			   atlas->getBitmap ()->getPlatformBitmap ()->getSize () * 2.);
+	EXPECT_EQ (CGlyphAtlas::getNumCachedAtlases (), 4u);
+	CGlyphAtlas::clearCache ();
+	EXPECT_EQ (CGlyphAtlas::getNumCachedAtlases (), 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CGlyphAtlasTest, CacheIsBounded)
+{
+	CGlyphAtlas::clearCache ();
+	for (auto i = 0u; i <= CGlyphAtlas::kMaxCachedAtlases; ++i)
+		CGlyphAtlas::get (kNormalFont, CColor (static_cast<uint8_t> (i), 0, 0), 1.);
+	EXPECT (CGlyphAtlas::getNumCachedAtlases () <= CGlyphAtlas::kMaxCachedAtlases);
+	CGlyphAtlas::clearCache ();
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CGlyphAtlasTest, StringWidth)
+{
+	auto atlas = CGlyphAtlas::get (kNormalFont, kWhiteCColor, 1.);
+	auto drawContext = COffscreenContext::create ({10., 10.});
+	EXPECT (atlas && drawContext);
+	if (!atlas || !drawContext)
+		return;
+	drawContext->setFont (kNormalFont);
+	CCoord width = 0.;
+	for (auto c : {"1", "0", ".", "5", " ", "d", "B"})
+		width += drawContext->getStringWidth (c);
+	EXPECT_EQ (atlas->getStringWidth ("10.5 dB"), width);
+	EXPECT_EQ (atlas->getStringWidth (""), 0.);
+	CGlyphAtlas::clearCache ();
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CGlyphAtlasTest, ParamDisplayFastTextRendering)
+{
+	CGlyphAtlas::clearCache ();
+	auto drawContext = COffscreenContext::create ({100., 20.});
+	EXPECT (drawContext);
+	if (!drawContext)
+		return;
+	auto display = owned (new CParamDisplay (CRect (0, 0, 100, 20)));
+	auto draw = [&] () {
+		drawContext->beginDraw ();
+		display->draw (drawContext);
+		drawContext->endDraw ();
+	};
+
+	draw ();
+	EXPECT_EQ (CGlyphAtlas::getNumCachedAtlases (), 0u);
+
+	display->setFastTextRendering (true);
+	draw ();
+	EXPECT_EQ (CGlyphAtlas::getNumCachedAtlases (), 1u);
+	display->setStyle (display->getStyle () | CParamDisplay::kShadowText);
+	draw ();
+	EXPECT_EQ (CGlyphAtlas::getNumCachedAtlases (), 2u);
+
+	// strings with other characters and rotated text use the platform text rendering
+	CGlyphAtlas::clearCache ();
+	display->setValueToStringFunction2 ([] (float, std::string& result, CParamDisplay*) {
+		result = "100 \xC2\xB5s";
+		return true;
+	});
+	draw ();
+	EXPECT_EQ (CGlyphAtlas::getNumCachedAtlases (), 0u);
+	display->setValueToStringFunction2 (nullptr);
+	display->setTextRotation (90.);
+	draw ();
+	EXPECT_EQ (CGlyphAtlas::getNumCachedAtlases (), 0u);
+}
+
+} // VSTGUI
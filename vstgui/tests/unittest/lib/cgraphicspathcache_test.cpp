@@ -0,0 +1,122 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cgraphicspathcache.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../../../lib/controls/cknob.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+using Key = CGraphicsPathCache::KeyBuilder;
+
+//------------------------------------------------------------------------
+struct TestKnob : CKnob
+{
+	TestKnob ()
+	: CKnob (CRect (0, 0, 40, 40), nullptr, 0, nullptr, nullptr, CPoint (),
+			 kCoronaDrawing | kCoronaOutline | kSkipHandleDrawing)
+	{
+	}
+
+	using CKnob::pathCache;
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CGraphicsPathCacheTest, Keys)
+{
+	CRect r (0, 0, 10, 10);
+	EXPECT_EQ (Key ().add (r).add (0.5).get (), Key ().add (r).add (0.5).get ());
+	EXPECT_NE (Key ().add (r).add (0.5).get (), Key ().add (r).add (0.25).get ());
+	EXPECT_NE (Key ().add (r).get (), Key ().add (CRect (0, 0, 10, 11)).get ());
+	EXPECT_NE (Key ().add (1.).add (2.).get (), Key ().add (2.).add (1.).get ());
+	EXPECT_EQ (Key ().add (-0.).get (), Key ().add (0.).get ());
+	EXPECT_NE (Key ().add (int32_t (1)).get (), Key ().add (int32_t (2)).get ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CGraphicsPathCacheTest, Quantize)
+{
+	EXPECT_EQ (CGraphicsPathCache::quantize (0.26, 4), 0.25);
+	EXPECT_EQ (CGraphicsPathCache::quantize (0.9, 4), 1.);
+	EXPECT_EQ (CGraphicsPathCache::quantize (0., 4), 0.);
+	EXPECT_EQ (CGraphicsPathCache::quantize (0.3, 0), 0.3);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CGraphicsPathCacheTest, BuildsOnlyOncePerKey)
+{
+	auto drawContext = COffscreenContext::create ({10., 10.});
+	EXPECT (drawContext);
+	CGraphicsPathCache cache (2);
+	uint32_t numBuildCalls = 0;
+	auto build = [&] (CGraphicsPath& path) {
+		++numBuildCalls;
+		path.addRect (CRect (0, 0, 5, 5));
+	};
+	auto path1 = cache.get (drawContext, 1, build);
+	EXPECT (path1);
+	EXPECT_EQ (cache.get (drawContext, 1, build), path1);
+	EXPECT_EQ (numBuildCalls, 1u);
+	auto path2 = cache.get (drawContext, 2, build);
+	EXPECT_NE (path2, path1);
+	EXPECT_EQ (numBuildCalls, 2u);
+	EXPECT_EQ (cache.getNumEntries (), 2u);
+
+	// the least recently used path is removed first
+	cache.get (drawContext, 1, build);
+	cache.get (drawContext, 3, build);
+	EXPECT_EQ (cache.getNumEntries (), 2u);
+	EXPECT_EQ (numBuildCalls, 3u);
+	cache.get (drawContext, 1, build);
+	EXPECT_EQ (numBuildCalls, 3u);
+	cache.get (drawContext, 2, build);
+	EXPECT_EQ (numBuildCalls, 4u);
+	EXPECT_EQ (cache.getNumBuiltPaths (), 4u);
+
+	cache.clear ();
+	EXPECT_EQ (cache.getNumEntries (), 0u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CGraphicsPathCacheTest, KnobReusesPaths)
+{
+	auto drawContext = COffscreenContext::create ({40., 40.});
+	EXPECT (drawContext);
+	auto knob = owned (new TestKnob ());
+	auto draw = [&] () {
+		drawContext->beginDraw ();
+		knob->draw (drawContext);
+		drawContext->endDraw ();
+	};
+	knob->setValueNormalized (0.5f);
+	draw ();
+	// the outline and the value arc
+	EXPECT_EQ (knob->pathCache.getNumBuiltPaths (), 2u);
+	draw ();
+	EXPECT_EQ (knob->pathCache.getNumBuiltPaths (), 2u);
+
+	// a change smaller than a quarter pixel on the arc does not build a new path
+	knob->setValueNormalized (0.50001f);
+	draw ();
+	EXPECT_EQ (knob->pathCache.getNumBuiltPaths (), 2u);
+
+	// only the value arc is rebuilt
+	knob->setValueNormalized (0.8f);
+	draw ();
+	EXPECT_EQ (knob->pathCache.getNumBuiltPaths (), 3u);
+	knob->setValueNormalized (0.5f);
+	draw ();
+	EXPECT_EQ (knob->pathCache.getNumBuiltPaths (), 3u);
+
+	knob->setCoronaInset (2.);
+	draw ();
+	EXPECT_EQ (knob->pathCache.getNumBuiltPaths (), 5u);
+}
+
+} // VSTGUI
@@ -0,0 +1,79 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cinvalidrectlist.h"
+#include "../unittests.h"
+#include <chrono>
+#include <random>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+std::vector<CRect> makeMeterRects (size_t count)
+{
+	// meter and LED like rects on a 20 pixel grid, some of them overlapping or touching
+	std::vector<CRect> rects;
+	std::mt19937 rng (static_cast<uint32_t> (count));
+	std::uniform_int_distribution<int> xDist (0, 99);
+	std::uniform_int_distribution<int> yDist (0, 59);
+	std::uniform_int_distribution<int> sizeDist (8, 24);
+	for (auto i = 0u; i < count; ++i)
+	{
+		auto x = xDist (rng) * 20.;
+		auto y = yDist (rng) * 20.;
+		rects.emplace_back (x, y, x + sizeDist (rng), y + sizeDist (rng));
+	}
+	return rects;
+}
+
+//------------------------------------------------------------------------
+void benchmarkAdd (UnitTest::Context* context, size_t count)
+{
+	using namespace std::chrono;
+	constexpr auto iterations = 20u;
+
+	auto rects = makeMeterRects (count);
+	CInvalidRectList list;
+	auto start = steady_clock::now ();
+	for (auto i = 0u; i < iterations; ++i)
+	{
+		list.clear ();
+		for (const auto& r : rects)
+			list.add (r);
+	}
+	auto addDuration = duration_cast<microseconds> (steady_clock::now () - start).count ();
+	auto numRects = list.data ().size ();
+
+	start = steady_clock::now ();
+	joinNearbyInvalidRects (list, 24.);
+	auto joinDuration = duration_cast<microseconds> (steady_clock::now () - start).count ();
+
+	context->print ("%u rects: add %.1f us per frame (%u merged rects), join nearby %lld us",
+					static_cast<uint32_t> (count),
+					static_cast<double> (addDuration) / iterations,
+					static_cast<uint32_t> (numRects), static_cast<long long> (joinDuration));
+	EXPECT (numRects > 0 && numRects <= count);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+TEST_CASE (CInvalidRectListBenchmark, Add10)
+{
+	benchmarkAdd (context, 10);
+}
+
+TEST_CASE (CInvalidRectListBenchmark, Add100)
+{
+	benchmarkAdd (context, 100);
+}
+
+TEST_CASE (CInvalidRectListBenchmark, Add1000)
+{
+	benchmarkAdd (context, 1000);
+}
+
+} // VSTGUI
@@ -47,4 +47,110 @@ TEST_CASE (CInvalidRectListTest, AddMulti)
 	EXPECT_EQ (list.data ().size (), 2u);
 }
 
+TEST_CASE (CInvalidRectListTest, AddTouchingOne)
+{
+	CInvalidRectList list;
+	EXPECT_TRUE (list.add ({0, 0, 100, 100}));
+	EXPECT_TRUE (list.add ({100, 0, 200, 100}));
+	EXPECT_EQ (list.data ().size (), 1u);
+	EXPECT_EQ (list.data ()[0], CRect (0, 0, 200, 100));
+}
+
+TEST_CASE (CInvalidRectListTest, AddAcrossCells)
+{
+	CInvalidRectList::Policy policy;
+	policy.cellSize = 10.;
+	CInvalidRectList list (policy);
+	EXPECT_TRUE (list.add ({5, 5, 8, 8}));
+	EXPECT_TRUE (list.add ({35, 35, 38, 38}));
+	EXPECT_TRUE (list.add ({0, 0, 40, 40}));
+	EXPECT_EQ (list.data ().size (), 1u);
+	EXPECT_EQ (list.data ()[0], CRect (0, 0, 40, 40));
+}
+
+TEST_CASE (CInvalidRectListTest, AddChainMerge)
+{
+	CInvalidRectList::Policy policy;
+	policy.cellSize = 16.;
+	CInvalidRectList list (policy);
+	for (auto i = 0; i < 100; ++i)
+		EXPECT_TRUE (list.add ({i * 10., 0., i * 10. + 10., 10.}));
+	EXPECT_EQ (list.data ().size (), 1u);
+	EXPECT_EQ (list.data ()[0], CRect (0, 0, 1000, 10));
+}
+
+TEST_CASE (CInvalidRectListTest, AddHugeRect)
+{
+	CInvalidRectList list;
+	EXPECT_TRUE (list.add ({10, 10, 20, 20}));
+	EXPECT_TRUE (list.add ({5000, 5000, 5010, 5010}));
+	EXPECT_TRUE (list.add ({-100000, -100000, 100000, 100000}));
+	EXPECT_EQ (list.data ().size (), 1u);
+	EXPECT_FALSE (list.add ({30, 30, 40, 40}));
+}
+
+TEST_CASE (CInvalidRectListTest, PolicyJoinDistance)
+{
+	CInvalidRectList::Policy policy;
+	policy.joinDistance = 10.;
+	policy.joinAreaFactor = 1.5;
+	CInvalidRectList list (policy);
+	EXPECT_TRUE (list.add ({0, 0, 100, 100}));
+	EXPECT_TRUE (list.add ({105, 0, 200, 100}));
+	EXPECT_EQ (list.data ().size (), 1u);
+	EXPECT_TRUE (list.add ({300, 0, 400, 100}));
+	EXPECT_EQ (list.data ().size (), 2u);
+}
+
+TEST_CASE (CInvalidRectListTest, PolicyMaxRects)
+{
+	CInvalidRectList::Policy policy;
+	policy.maxRects = 2;
+	CInvalidRectList list (policy);
+	EXPECT_TRUE (list.add ({0, 0, 10, 10}));
+	EXPECT_TRUE (list.add ({20, 20, 30, 30}));
+	EXPECT_EQ (list.data ().size (), 2u);
+	EXPECT_TRUE (list.add ({40, 40, 50, 50}));
+	EXPECT_EQ (list.data ().size (), 1u);
+	EXPECT_EQ (list.data ()[0], CRect (0, 0, 50, 50));
+}
+
+TEST_CASE (CInvalidRectListTest, Erase)
+{
+	CInvalidRectList list;
+	EXPECT_TRUE (list.add ({0, 0, 10, 10}));
+	EXPECT_TRUE (list.add ({20, 20, 30, 30}));
+	EXPECT_TRUE (list.add ({40, 40, 50, 50}));
+	list.erase (list.begin ());
+	EXPECT_EQ (list.data ().size (), 2u);
+	EXPECT_TRUE (list.add ({0, 0, 10, 10}));
+	EXPECT_FALSE (list.add ({40, 40, 50, 50}));
+	EXPECT_EQ (list.data ().size (), 3u);
+}
+
+TEST_CASE (CInvalidRectListTest, ClearAndReuse)
+{
+	CInvalidRectList list;
+	EXPECT_TRUE (list.add ({0, 0, 100, 100}));
+	list.clear ();
+	EXPECT_TRUE (list.empty ());
+	EXPECT_TRUE (list.add ({10, 10, 20, 20}));
+	EXPECT_EQ (list.data ().size (), 1u);
+}
+
+TEST_CASE (CInvalidRectListTest, JoinNearby)
+{
+	CInvalidRectList list;
+	EXPECT_TRUE (list.add ({0, 0, 100, 10}));
+	EXPECT_TRUE (list.add ({0, 20, 100, 30}));
+	EXPECT_TRUE (list.add ({0, 40, 100, 50}));
+	EXPECT_TRUE (list.add ({200, 200, 210, 210}));
+	EXPECT_EQ (list.data ().size (), 4u);
+	joinNearbyInvalidRects (list, 5.);
+	EXPECT_EQ (list.data ().size (), 4u);
+	joinNearbyInvalidRects (list, 10.);
+	EXPECT_EQ (list.data ().size (), 2u);
+	EXPECT_TRUE (std::find (list.begin (), list.end (), CRect (0, 0, 100, 50)) != list.end ());
+}
+
 } // VSTGUI
@@ -0,0 +1,205 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../lib/cframe.h"
+#include "../../../../lib/controls/ccontrol.h"
+#include "../../../../lib/controls/ccontrolvaluemailbox.h"
+#include "../../../../lib/controls/icontrollistener.h"
+#include "../../unittests.h"
+#include <map>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+class MailboxControl : public CControl
+{
+public:
+	MailboxControl (int32_t tag) : CControl (CRect (0, 0, 10, 10), nullptr, tag) {}
+	void draw (CDrawContext* pContext) override {}
+
+	CLASS_METHODS (MailboxControl, CControl)
+};
+
+//------------------------------------------------------------------------
+struct ValueChangedListener : IControlListener
+{
+	void valueChanged (CControl* pControl) override { ++numValueChangedCalls; }
+	uint32_t numValueChangedCalls {0};
+};
+
+//------------------------------------------------------------------------
+std::map<int32_t, float> drainAll (CControlValueMailbox& mailbox)
+{
+	std::map<int32_t, float> result;
+	mailbox.drain ([&] (int32_t tag, float value) { result[tag] = value; });
+	return result;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CControlValueMailboxTest, CoalescesToLatestValue)
+{
+	CControlValueMailbox mailbox;
+	EXPECT_FALSE (mailbox.hasPendingValues ());
+	EXPECT (mailbox.post (1, 0.1f));
+	EXPECT (mailbox.post (2, 0.2f));
+	EXPECT (mailbox.post (1, 0.3f));
+	EXPECT (mailbox.hasPendingValues ());
+	uint32_t numCalls = 0;
+	std::map<int32_t, float> values;
+	EXPECT_EQ (mailbox.drain ([&] (int32_t tag, float value) {
+		++numCalls;
+		values[tag] = value;
+	}),
+			   2u);
+	EXPECT_EQ (numCalls, 2u);
+	EXPECT_EQ (values[1], 0.3f);
+	EXPECT_EQ (values[2], 0.2f);
+	EXPECT_FALSE (mailbox.hasPendingValues ());
+	EXPECT (drainAll (mailbox).empty ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CControlValueMailboxTest, Capacity)
+{
+	CControlValueMailbox mailbox (10);
+	EXPECT_EQ (mailbox.getCapacity (), 64u);
+	for (auto tag = 0; tag < 64; ++tag)
+		EXPECT (mailbox.post (tag * 64, 1.f));
+	EXPECT_FALSE (mailbox.post (4096, 1.f));
+	// known tags can still be posted
+	EXPECT (mailbox.post (128, 0.5f));
+	EXPECT_FALSE (mailbox.post (CControlValueMailbox::kInvalidTag, 1.f));
+	auto values = drainAll (mailbox);
+	EXPECT_EQ (values.size (), 64u);
+	EXPECT_EQ (values[128], 0.5f);
+	EXPECT_EQ (CControlValueMailbox (1000).getCapacity (), 1024u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CControlValueMailboxTest, MultipleProducers)
+{
+	constexpr auto numThreads = 4;
+	constexpr auto numTagsPerThread = 50;
+	constexpr auto numValues = 1000;
+	CControlValueMailbox mailbox;
+	std::map<int32_t, float> values;
+	std::atomic<uint32_t> numFailedPosts {0};
+	std::vector<std::thread> threads;
+	for (auto t = 0; t < numThreads; ++t)
+	{
+		threads.emplace_back ([&, t] () {
+			for (auto i = 1; i <= numValues; ++i)
+			{
+				for (auto tag = 0; tag < numTagsPerThread; ++tag)
+				{
+					if (!mailbox.post (t * numTagsPerThread + tag, static_cast<float> (i)))
+						++numFailedPosts;
+				}
+			}
+		});
+	}
+	// drain while the producers are running
+	for (auto i = 0; i < 100; ++i)
+	{
+		for (const auto& v : drainAll (mailbox))
+			values[v.first] = v.second;
+	}
+	for (auto& thread : threads)
+		thread.join ();
+	for (const auto& v : drainAll (mailbox))
+		values[v.first] = v.second;
+	EXPECT_EQ (numFailedPosts, 0u);
+	EXPECT_EQ (values.size (), static_cast<size_t> (numThreads * numTagsPerThread));
+	for (const auto& v : values)
+		EXPECT_EQ (v.second, static_cast<float> (numValues));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CControlValueMailboxTest, FrameSetsControlValues)
+{
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	auto control1 = new MailboxControl (1);
+	auto control2 = new MailboxControl (1);
+	auto control3 = new MailboxControl (2);
+	ValueChangedListener listener;
+	control1->registerControlListener (&listener);
+	frame->addView (control1);
+	frame->addView (control2);
+	frame->addView (control3);
+	frame->attached (frame);
+
+	auto mailbox = frame->getControlValueMailbox ();
+	EXPECT (mailbox);
+	EXPECT_EQ (frame->getControlValueMailbox (), mailbox);
+	mailbox->post (1, 0.25f);
+	mailbox->post (1, 0.5f);
+	mailbox->post (2, 0.75f);
+	frame->dispatchControlValueMailbox ();
+	EXPECT_EQ (control1->getValue (), 0.5f);
+	EXPECT_EQ (control2->getValue (), 0.5f);
+	EXPECT_EQ (control3->getValue (), 0.75f);
+	// the values come from the model, they are not reported as edits
+	EXPECT_EQ (listener.numValueChangedCalls, 0u);
+
+	// controls the user edits keep their value
+	control2->beginEdit ();
+	mailbox->post (1, 1.f);
+	frame->dispatchControlValueMailbox ();
+	EXPECT_EQ (control1->getValue (), 1.f);
+	EXPECT_EQ (control2->getValue (), 0.5f);
+	control2->endEdit ();
+
+	// tag changes and removed views
+	control3->setTag (1);
+	frame->removeView (control1, false);
+	mailbox->post (1, 0.f);
+	frame->idle ();
+	EXPECT_EQ (control2->getValue (), 0.f);
+	EXPECT_EQ (control3->getValue (), 0.f);
+
+	control1->unregisterControlListener (&listener);
+	control1->forget ();
+	frame->removeAll ();
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CControlValueMailboxTest, ControlChangesViewHierarchy)
+{
+	// adds a view to the frame when it gets a value, which invalidates the index of the frame
+	class AddViewControl : public MailboxControl
+	{
+	public:
+		using MailboxControl::MailboxControl;
+		void setValue (float val) override
+		{
+			MailboxControl::setValue (val);
+			if (auto frame = getFrame ())
+				frame->addView (new CView (CRect (0, 0, 10, 10)));
+		}
+	};
+
+	auto frame = owned (new CFrame (CRect (0, 0, 100, 100), nullptr));
+	std::vector<CControl*> controls;
+	for (auto i = 0; i < 3; ++i)
+	{
+		controls.emplace_back (new AddViewControl (1));
+		frame->addView (controls.back ());
+	}
+	frame->attached (frame);
+
+	frame->getControlValueMailbox ()->post (1, 0.5f);
+	frame->dispatchControlValueMailbox ();
+	for (auto control : controls)
+		EXPECT_EQ (control->getValue (), 0.5f);
+	EXPECT_EQ (frame->getNbViews (), 6u);
+	frame->removeAll ();
+}
+
+} // VSTGUI
@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "../../../../lib/controls/clistcontrol.h"
+#include "../../../../lib/coffscreencontext.h"
 #include "../../../../lib/cscrollview.h"
 #include "../../unittests.h"
 #include "../eventhelpers.h"
@@ -51,6 +52,48 @@ static KeyboardEvent makeKeyboardEvent (int32_t c, VirtualKey virt,
 	return event;
 }
 
+//------------------------------------------------------------------------
+struct VariableHeightConfigurator : IListControlConfigurator, NonAtomicReferenceCounted
+{
+	CListControlRowDesc getRowDesc (int32_t row) const override
+	{
+		return {static_cast<CCoord> (10 + (row % 3) * 10), CListControlRowDesc::Selectable};
+	}
+};
+
+//------------------------------------------------------------------------
+struct CountingBlockConfigurator : StaticListControlConfigurator, IListControlBlockConfigurator
+{
+	CountingBlockConfigurator (CCoord rowHeight) : StaticListControlConfigurator (rowHeight) {}
+
+	void getRowDescs (int32_t firstRow, int32_t numRows, CListControlRowDesc* descs) const override
+	{
+		++numFetches;
+		numFetchedRows += numRows;
+		for (auto i = 0; i < numRows; ++i)
+			descs[i] = getRowDesc (firstRow + i);
+	}
+	Optional<CCoord> getUniformRowHeight () const override
+	{
+		return makeOptional (getRowHeight ());
+	}
+
+	mutable int32_t numFetches {0};
+	mutable int32_t numFetchedRows {0};
+};
+
+//------------------------------------------------------------------------
+struct CountingDrawer : IListControlDrawer, NonAtomicReferenceCounted
+{
+	void drawBackground (CDrawContext* context, CRect size) override {}
+	void drawRow (CDrawContext* context, CRect size, Row row) override
+	{
+		rows.push_back (row.getIndex ());
+	}
+
+	std::vector<int32_t> rows;
+};
+
 TEST_CASE (CListControlTest, minMax)
 {
 	constexpr auto rowHeight = 20;
@@ -299,5 +342,94 @@ TEST_CASE (CListControlTest, PageDown)
 	parent->removeAll (false);
 }
 
+TEST_CASE (CListControlTest, VariableRowHeights)
+{
+	auto listControl = makeOwned<CListControl> (CRect (0, 0, 100, 100));
+	listControl->setMin (0.f);
+	listControl->setMax (8.f);
+	listControl->setConfigurator (makeOwned<VariableHeightConfigurator> ());
+	listControl->recalculateLayout ();
+	// row heights 10, 20, 30, 10, 20, 30, 10, 20, 30
+	EXPECT_EQ (listControl->getHeight (), 180.);
+
+	auto rr = listControl->getRowRect (4);
+	EXPECT (rr);
+	EXPECT (*rr == CRect (0, 70, 100, 90));
+	rr = listControl->getRowRect (8);
+	EXPECT (rr);
+	EXPECT (*rr == CRect (0, 150, 100, 180));
+	EXPECT_FALSE (listControl->getRowRect (9));
+
+	EXPECT_EQ (*listControl->getRowAtPoint ({0., 0.}), 0);
+	EXPECT_EQ (*listControl->getRowAtPoint ({0., 9.}), 0);
+	EXPECT_EQ (*listControl->getRowAtPoint ({0., 10.}), 1);
+	EXPECT_EQ (*listControl->getRowAtPoint ({0., 59.}), 2);
+	EXPECT_EQ (*listControl->getRowAtPoint ({0., 60.}), 3);
+	EXPECT_EQ (*listControl->getRowAtPoint ({0., 179.}), 8);
+	EXPECT_FALSE (listControl->getRowAtPoint ({0., 180.}));
+}
+
+TEST_CASE (CListControlTest, RowDescriptionsAreFetchedLazily)
+{
+	constexpr auto numRows = 10000;
+	auto listControl = makeOwned<CListControl> (CRect (0, 0, 100, 100));
+	auto config = makeOwned<CountingBlockConfigurator> (20.);
+	listControl->setMin (0.f);
+	listControl->setMax (static_cast<float> (numRows - 1));
+	listControl->setConfigurator (config);
+	listControl->recalculateLayout ();
+	EXPECT_EQ (listControl->getHeight (), numRows * 20.);
+	EXPECT_EQ (config->numFetches, 0);
+
+	auto rr = listControl->getRowRect (5000);
+	EXPECT (rr);
+	EXPECT (*rr == CRect (0, 100000, 100, 100020));
+	EXPECT_EQ (*listControl->getRowAtPoint ({0., 100019.}), 5000);
+	EXPECT_EQ (config->numFetches, 0);
+
+	dispatchMouseEvent<MouseDownEvent> (listControl, {0., 100010.}, MouseButton::Left);
+	dispatchMouseEvent<MouseUpEvent> (listControl, {0., 100010.}, MouseButton::Left);
+	EXPECT_EQ (listControl->getValue (), 5000.f);
+	EXPECT_EQ (config->numFetches, 1);
+	EXPECT (config->numFetchedRows < numRows / 10);
+}
+
+TEST_CASE (CListControlTest, NoRowsWithBlockConfigurator)
+{
+	struct VariableHeightBlockConfigurator : CountingBlockConfigurator
+	{
+		using CountingBlockConfigurator::CountingBlockConfigurator;
+		Optional<CCoord> getUniformRowHeight () const override { return {}; }
+	};
+
+	auto listControl = makeOwned<CListControl> (CRect (0, 0, 100, 100));
+	auto config = makeOwned<VariableHeightBlockConfigurator> (20.);
+	listControl->setMin (0.f);
+	listControl->setMax (-1.f);
+	listControl->setConfigurator (config);
+	listControl->recalculateLayout ();
+	EXPECT_EQ (listControl->getNumRows (), 0);
+	EXPECT_EQ (config->numFetches, 0);
+	EXPECT_FALSE (listControl->getRowRect (0));
+}
+
+TEST_CASE (CListControlTest, DrawOnlyVisibleRows)
+{
+	constexpr auto rowHeight = 20;
+	constexpr auto numRows = 1000;
+	auto listControl = createTestListControl (rowHeight, numRows - 1);
+	auto drawer = makeOwned<CountingDrawer> ();
+	listControl->setDrawer (drawer);
+	auto drawContext = COffscreenContext::create ({100., 200.});
+	EXPECT (drawContext);
+
+	listControl->drawRect (drawContext, CRect (0, 25, 100, 65));
+	EXPECT_EQ (drawer->rows, std::vector<int32_t> ({1, 2, 3}));
+
+	drawer->rows.clear ();
+	listControl->drawRect (drawContext, CRect (0, 145, 100, 195));
+	EXPECT_EQ (drawer->rows, std::vector<int32_t> ({7, 8, 9}));
+}
+
 //------------------------------------------------------------------------
 } // VSTGUI
@@ -0,0 +1,162 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cframe.h"
+#include "../../../lib/cscrollview.h"
+#include "../unittests.h"
+#include <algorithm>
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+CScrollView* makeScrollView (const CRect& size, int32_t style, std::vector<CView*>& rows)
+{
+	auto scrollView = new CScrollView (size, CRect (0, 0, size.getWidth (), 1000),
+									   style | CScrollView::kVerticalScrollbar);
+	for (auto i = 0; i < 100; ++i)
+	{
+		auto row = new CView (CRect (0, i * 10., size.getWidth (), i * 10. + 10.));
+		scrollView->addView (row);
+		rows.emplace_back (row);
+	}
+	return scrollView;
+}
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CScrollViewTest, TransformScrolling)
+{
+	auto frame = new CFrame (CRect (0, 0, 200, 100), nullptr);
+	std::vector<CView*> movedRows;
+	std::vector<CView*> transformedRows;
+	auto moved = makeScrollView (CRect (0, 0, 100, 100), 0, movedRows);
+	auto transformed =
+		makeScrollView (CRect (100, 0, 200, 100), CScrollView::kTransformScrolling, transformedRows);
+	frame->addView (moved);
+	frame->addView (transformed);
+	frame->attached (frame);
+
+	moved->makeRectVisible (CRect (0, 500, 100, 510));
+	transformed->makeRectVisible (CRect (0, 500, 100, 510));
+	EXPECT_EQ (moved->getScrollOffset (), transformed->getScrollOffset ());
+	EXPECT (moved->getScrollOffset ().y != 0.);
+
+	// the rows of the transformed scroll view keep their size
+	EXPECT_EQ (transformedRows[50]->getViewSize (), CRect (0, 500, 100, 510));
+	EXPECT (movedRows[50]->getViewSize () != CRect (0, 500, 100, 510));
+
+	auto options = GetViewOptions ().deep ();
+	for (auto y = 5.; y < 100.; y += 10.)
+	{
+		auto movedView = frame->getViewAt (CPoint (50, y), options);
+		auto transformedView = frame->getViewAt (CPoint (150, y), options);
+		EXPECT (movedView && transformedView);
+		if (!movedView || !transformedView)
+			continue;
+		auto index = std::find (movedRows.begin (), movedRows.end (), movedView) - movedRows.begin ();
+		EXPECT_EQ (transformedView, transformedRows[index]);
+
+		CPoint p1 (movedView->getViewSize ().getTopLeft ());
+		CPoint p2 (transformedView->getViewSize ().getTopLeft ());
+		movedView->localToFrame (p1);
+		transformedView->localToFrame (p2);
+		EXPECT_EQ (p1.x + 100., p2.x);
+		EXPECT_EQ (p1.y, p2.y);
+		CRect visible1 = movedView->getVisibleViewSize ();
+		CRect visible2 = transformedView->getVisibleViewSize ();
+		EXPECT_EQ (visible1.getHeight (), visible2.getHeight ());
+	}
+	frame->close ();
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CScrollViewTest, SwitchTransformScrolling)
+{
+	auto frame = new CFrame (CRect (0, 0, 100, 100), nullptr);
+	std::vector<CView*> rows;
+	auto scrollView = makeScrollView (CRect (0, 0, 100, 100), 0, rows);
+	frame->addView (scrollView);
+	frame->attached (frame);
+
+	scrollView->makeRectVisible (CRect (0, 500, 100, 510));
+	auto scrolledSize = rows[50]->getViewSize ();
+	EXPECT (scrolledSize != CRect (0, 500, 100, 510));
+
+	scrollView->setStyle (scrollView->getStyle () | CScrollView::kTransformScrolling);
+	EXPECT_EQ (rows[50]->getViewSize (), CRect (0, 500, 100, 510));
+	auto view = frame->getViewAt (CPoint (50, scrolledSize.top + 5.), GetViewOptions ().deep ());
+	EXPECT_EQ (view, rows[50]);
+
+	scrollView->setStyle (scrollView->getStyle () & ~CScrollView::kTransformScrolling);
+	EXPECT_EQ (rows[50]->getViewSize (), scrolledSize);
+	view = frame->getViewAt (CPoint (50, scrolledSize.top + 5.), GetViewOptions ().deep ());
+	EXPECT_EQ (view, rows[50]);
+	frame->close ();
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CScrollViewTest, SpatialIndexFollowsScrolling)
+{
+	auto frame = new CFrame (CRect (0, 0, 100, 100), nullptr);
+	std::vector<CView*> rows;
+	auto scrollView = makeScrollView (CRect (0, 0, 100, 100), 0, rows);
+	auto container = rows.front ()->getParentView ()->asViewContainer ();
+	container->setSpatialIndexEnabled (true);
+	frame->addView (scrollView);
+	frame->attached (frame);
+
+	auto options = GetViewOptions ().deep ();
+	EXPECT_EQ (frame->getViewAt (CPoint (50, 5), options), rows[0]);
+	scrollView->makeRectVisible (CRect (0, 500, 100, 510));
+	for (auto y = 5.; y < 100.; y += 10.)
+	{
+		auto view = frame->getViewAt (CPoint (50, y), options);
+		EXPECT (view);
+		if (!view)
+			continue;
+		CPoint p (view->getViewSize ().getTopLeft ());
+		view->localToFrame (p);
+		EXPECT (p.y <= y && p.y + 10. > y);
+	}
+	frame->close ();
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CScrollViewTest, ScrollingInsideBitmapCacheInvalidatesCache)
+{
+	struct InvalidRectCountContainer : CViewContainer
+	{
+		using CViewContainer::CViewContainer;
+		void invalidRect (const CRect& rect) override
+		{
+			if (rect.pointInside (CPoint (10, 50)))
+				contentInvalidated = true;
+			CViewContainer::invalidRect (rect);
+		}
+		bool contentInvalidated {false};
+	};
+
+	auto frame = new CFrame (CRect (0, 0, 100, 100), nullptr);
+	auto container = new InvalidRectCountContainer (CRect (0, 0, 100, 100));
+	container->setCacheAsBitmap (true);
+	std::vector<CView*> rows;
+	auto scrollView = makeScrollView (CRect (0, 0, 100, 100), 0, rows);
+	rows.front ()->getParentView ()->setTransparency (false);
+	container->addView (scrollView);
+	frame->addView (container);
+	frame->attached (frame);
+
+	container->contentInvalidated = false;
+	scrollView->makeRectVisible (CRect (0, 500, 100, 510));
+	EXPECT (scrollView->getScrollOffset ().y != 0.);
+	// the content must not be moved by a blit, which does not update the cached bitmap
+	EXPECT (container->contentInvalidated);
+	frame->close ();
+}
+
+} // VSTGUI
@@ -0,0 +1,156 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/cframe.h"
+#include "../../../lib/coffscreencontext.h"
+#include "../../../lib/cshadowviewcontainer.h"
+#include "../../../lib/platform/iplatformbitmap.h"
+#include "../unittests.h"
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+/** writes its shape value directly into the first pixel of the offscreen it is drawn into */
+struct ShapeView : CView
+{
+	uint8_t shape {255};
+	uint32_t numOffscreenDraws {0};
+
+	ShapeView (const CRect& size) : CView (size) {}
+
+	void draw (CDrawContext* context) override
+	{
+		if (auto offscreen = dynamic_cast<COffscreenContext*> (context))
+		{
+			++numOffscreenDraws;
+			if (auto pixelAccess = offscreen->getBitmap ()->getPlatformBitmap ()->lockPixels (true))
+			{
+				for (auto i = 0; i < 4; ++i)
+					pixelAccess->getAddress ()[i] = shape;
+			}
+		}
+		setDirty (false);
+	}
+};
+
+//------------------------------------------------------------------------
+struct InvalidCountShadowViewContainer : CShadowViewContainer
+{
+	uint32_t numInvalidCalls {0};
+
+	InvalidCountShadowViewContainer (const CRect& size) : CShadowViewContainer (size) {}
+
+	void invalid () override
+	{
+		++numInvalidCalls;
+		CShadowViewContainer::invalid ();
+	}
+};
+
+//------------------------------------------------------------------------
+struct ShadowFixture
+{
+	CFrame* frame {new CFrame (CRect (0, 0, 200, 200), nullptr)};
+	InvalidCountShadowViewContainer* container {
+		new InvalidCountShadowViewContainer (CRect (0, 0, 200, 200))};
+	ShapeView* child {new ShapeView (CRect (10, 10, 100, 100))};
+	SharedPointer<COffscreenContext> context {COffscreenContext::create ({200., 200.})};
+
+	ShadowFixture ()
+	{
+		container->addView (child);
+		frame->addView (container);
+		frame->attached (frame);
+	}
+	~ShadowFixture () noexcept { frame->close (); }
+
+	CBitmap* draw ()
+	{
+		context->beginDraw ();
+		container->drawRect (context, container->getViewSize ());
+		context->endDraw ();
+		return container->getBackground ();
+	}
+};
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CShadowViewContainerTest, ShapeChangeRegeneratesShadow)
+{
+	ShadowFixture fixture;
+	fixture.container->setShadowFollowsContent (true);
+	SharedPointer<CBitmap> shadow = fixture.draw ();
+	EXPECT (shadow);
+	auto numOffscreenDraws = fixture.child->numOffscreenDraws;
+
+	// a content change neither renders the sub views offscreen nor regenerates the shadow
+	fixture.child->shape = 128;
+	fixture.child->invalid ();
+	EXPECT_EQ (fixture.draw (), shadow.get ());
+	EXPECT_EQ (fixture.child->numOffscreenDraws, numOffscreenDraws);
+
+	// a layout change checks the shape
+	fixture.child->setViewSize (CRect (20, 20, 110, 110));
+	fixture.container->numInvalidCalls = 0;
+	EXPECT_NE (fixture.draw (), shadow.get ());
+	EXPECT_EQ (fixture.child->numOffscreenDraws, numOffscreenDraws + 1);
+	// and does not invalidate the container while it is drawn
+	EXPECT_EQ (fixture.container->numInvalidCalls, 0u);
+	shadow = fixture.container->getBackground ();
+
+	// a layout change without a shape change keeps the shadow
+	fixture.child->setViewSize (CRect (10, 10, 100, 100));
+	EXPECT_EQ (fixture.draw (), shadow.get ());
+	EXPECT_EQ (fixture.child->numOffscreenDraws, numOffscreenDraws + 2);
+
+	// explicit invalidation always regenerates the shadow
+	fixture.container->invalidateShadow ();
+	EXPECT_NE (fixture.draw (), shadow.get ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CShadowViewContainerTest, ContentInvalidationIgnoredByDefault)
+{
+	ShadowFixture fixture;
+	EXPECT_FALSE (fixture.container->getShadowFollowsContent ());
+	SharedPointer<CBitmap> shadow = fixture.draw ();
+
+	// adding a view only regenerates the shadow if the shape changes
+	fixture.container->addView (new CView (CRect (0, 0, 10, 10)));
+	EXPECT_EQ (fixture.draw (), shadow.get ());
+
+	fixture.child->shape = 128;
+	fixture.child->invalid ();
+	EXPECT_EQ (fixture.draw (), shadow.get ());
+
+	// an explicit shape check picks up the changed shape
+	fixture.container->invalidateShadowShape ();
+	EXPECT_NE (fixture.draw (), shadow.get ());
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CShadowViewContainerTest, Downsampling)
+{
+	ShadowFixture fixture;
+	auto shadow = fixture.draw ();
+	EXPECT (shadow);
+	EXPECT_EQ (shadow->getPlatformBitmap ()->getSize (), CPoint (200, 200));
+
+	fixture.container->setShadowDownsampling (4);
+	shadow = fixture.draw ();
+	EXPECT (shadow);
+	EXPECT_EQ (shadow->getPlatformBitmap ()->getSize (), CPoint (50, 50));
+	EXPECT_EQ (shadow->getWidth (), 200.);
+
+	fixture.container->setShadowDownsampling (0);
+	EXPECT_EQ (fixture.container->getShadowDownsampling (), 1u);
+	fixture.container->setShadowDownsampling (100);
+	EXPECT_EQ (fixture.container->getShadowDownsampling (), 8u);
+}
+
+} // VSTGUI
@@ -3,6 +3,7 @@
 // distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
 
 #include "../../../lib/cframe.h"
+#include "../../../lib/coffscreencontext.h"
 #include "../../../lib/iviewlistener.h"
 #include "../../../lib/ccolor.h"
 #include "../../../lib/dragging.h"
@@ -109,6 +110,27 @@ public:
 	
  };
 
+class DrawCountView : public CView
+{
+public:
+	DrawCountView (const CRect& r) : CView (r) {}
+
+	void draw (CDrawContext* context) override
+	{
+		++drawCount;
+		CView::draw (context);
+	}
+
+	bool checkUpdate (const CRect& updateRect) const override
+	{
+		++checkUpdateCount;
+		return CView::checkUpdate (updateRect);
+	}
+
+	uint32_t drawCount {0};
+	mutable uint32_t checkUpdateCount {0};
+};
+
 } // anonymous
 
 TEST_SUITE_SETUP (CViewContainerTest)
@@ -638,4 +660,154 @@ TEST_CASE (CViewContainerTest, GetContainerAt)
 	EXPECT (res == c1);
 }
 
+TEST_CASE (CViewContainerTest, CacheAsBitmap)
+{
+	auto& container = TEST_SUITE_GET_STORAGE (SharedPointer<CViewContainer>);
+	auto view = new DrawCountView (CRect (10, 10, 50, 50));
+	container->addView (view);
+	EXPECT_FALSE (container->getCacheAsBitmap ());
+	container->setCacheAsBitmap (true);
+	EXPECT_TRUE (container->getCacheAsBitmap ());
+
+	auto drawContext = COffscreenContext::create ({200., 200.});
+	EXPECT (drawContext);
+	drawContext->beginDraw ();
+	container->drawRect (drawContext, container->getViewSize ());
+	EXPECT_EQ (view->drawCount, 1u);
+	container->drawRect (drawContext, container->getViewSize ());
+	container->drawRect (drawContext, CRect (0, 0, 20, 20));
+	EXPECT_EQ (view->drawCount, 1u);
+	container->invalidRect (CRect (100, 100, 150, 150));
+	container->drawRect (drawContext, container->getViewSize ());
+	EXPECT_EQ (view->drawCount, 1u);
+	container->invalidRect (CRect (20, 20, 30, 30));
+	container->drawRect (drawContext, container->getViewSize ());
+	EXPECT_EQ (view->drawCount, 2u);
+	// a dirty container redraws its cache when it is drawn
+	container->setDirty ();
+	container->drawRect (drawContext, container->getViewSize ());
+	EXPECT_EQ (view->drawCount, 3u);
+	EXPECT_FALSE (container->CView::isDirty ());
+	container->drawRect (drawContext, container->getViewSize ());
+	EXPECT_EQ (view->drawCount, 3u);
+	container->setViewSize (CRect (0, 0, 100, 100));
+	container->drawRect (drawContext, container->getViewSize ());
+	EXPECT_EQ (view->drawCount, 4u);
+	container->setCacheAsBitmap (false);
+	container->drawRect (drawContext, container->getViewSize ());
+	container->drawRect (drawContext, container->getViewSize ());
+	EXPECT_EQ (view->drawCount, 6u);
+	drawContext->endDraw ();
+}
+
+TEST_CASE (CViewContainerTest, SpatialIndex)
+{
+	auto frame = new CFrame (CRect (0, 0, 200, 200), nullptr);
+	auto container = new CViewContainer (CRect (0, 0, 200, 200));
+	auto withoutIndex = new CViewContainer (CRect (0, 0, 200, 200));
+	container->setSpatialIndexEnabled (true);
+	EXPECT_TRUE (container->getSpatialIndexEnabled ());
+	for (auto y = 0; y < 10; ++y)
+	{
+		for (auto x = 0; x < 10; ++x)
+		{
+			CRect r (x * 20., y * 20., x * 20. + 18., y * 20. + 18.);
+			container->addView (new CView (r));
+			withoutIndex->addView (new CView (r));
+		}
+	}
+	// overlapping view on top
+	container->addView (new CView (CRect (30, 30, 150, 50)));
+	withoutIndex->addView (new CView (CRect (30, 30, 150, 50)));
+	frame->addView (container);
+	frame->addView (withoutIndex);
+	frame->attached (frame);
+
+	auto indexOf = [] (CViewContainer* c, CView* view) -> int32_t {
+		for (auto i = 0u; i < c->getNbViews (); ++i)
+		{
+			if (c->getView (i) == view)
+				return static_cast<int32_t> (i);
+		}
+		return -1;
+	};
+	auto compare = [&] () {
+		for (CCoord y = 0; y < 200; y += 7)
+		{
+			for (CCoord x = 0; x < 200; x += 7)
+			{
+				CPoint p (x, y);
+				EXPECT_EQ (indexOf (container, container->getViewAt (p)),
+						   indexOf (withoutIndex, withoutIndex->getViewAt (p)));
+				CViewContainer::ViewList views1, views2;
+				container->getViewsAt (p, views1);
+				withoutIndex->getViewsAt (p, views2);
+				EXPECT_EQ (views1.size (), views2.size ());
+			}
+		}
+	};
+	compare ();
+	EXPECT_EQ (indexOf (container, container->getViewAt (CPoint (35, 35))), 100);
+
+	// move a view
+	container->getView (0)->setViewSize (CRect (100, 150, 130, 190));
+	withoutIndex->getView (0)->setViewSize (CRect (100, 150, 130, 190));
+	compare ();
+	EXPECT (container->getViewAt (CPoint (119, 185)) == container->getView (0));
+	EXPECT (container->getViewAt (CPoint (5, 5)) == nullptr);
+
+	// change the mouseable area
+	container->getView (1)->setMouseableArea (CRect (0, 0, 60, 10));
+	withoutIndex->getView (1)->setMouseableArea (CRect (0, 0, 60, 10));
+	compare ();
+	EXPECT (container->getViewAt (CPoint (5, 5)) == container->getView (1));
+
+	// change the z order and remove a view
+	container->changeViewZOrder (container->getView (100), 0);
+	withoutIndex->changeViewZOrder (withoutIndex->getView (100), 0);
+	container->removeView (container->getView (50));
+	withoutIndex->removeView (withoutIndex->getView (50));
+	compare ();
+	EXPECT_EQ (indexOf (container, container->getViewAt (CPoint (35, 35))), 12);
+
+	EXPECT_TRUE (frame->isChild (container->getView (10), true));
+	EXPECT_FALSE (container->isChild (withoutIndex->getView (10), true));
+	frame->close ();
+}
+
+TEST_CASE (CViewContainerTest, SpatialIndexDrawCulling)
+{
+	auto frame = new CFrame (CRect (0, 0, 200, 200), nullptr);
+	auto container = new CViewContainer (CRect (0, 0, 200, 200));
+	container->setSpatialIndexEnabled (true);
+	std::vector<DrawCountView*> views;
+	for (auto i = 0; i < 20; ++i)
+	{
+		views.emplace_back (new DrawCountView (CRect (i * 10., 0, i * 10. + 10., 10)));
+		container->addView (views.back ());
+	}
+	frame->addView (container);
+	frame->attached (frame);
+
+	auto drawContext = COffscreenContext::create ({200., 200.});
+	EXPECT (drawContext);
+	drawContext->beginDraw ();
+	container->drawRect (drawContext, container->getViewSize ());
+	for (auto view : views)
+		EXPECT_EQ (view->drawCount, 1u);
+	for (auto view : views)
+		view->checkUpdateCount = 0;
+	container->drawRect (drawContext, CRect (42, 2, 48, 8));
+	for (auto i = 0u; i < views.size (); ++i)
+		EXPECT_EQ (views[i]->drawCount, i == 4 ? 2u : 1u);
+	// only the views near the update rect are checked
+	EXPECT_EQ (views[15]->checkUpdateCount, 0u);
+	views[15]->setViewSize (CRect (40, 0, 50, 10));
+	container->drawRect (drawContext, CRect (42, 2, 48, 8));
+	EXPECT_EQ (views[4]->drawCount, 3u);
+	EXPECT_EQ (views[15]->drawCount, 2u);
+	drawContext->endDraw ();
+	frame->close ();
+}
+
 } // namespaces
@@ -0,0 +1,180 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../../../lib/platform/linux/cairographicscontext.h"
+#include "../../../../../lib/platform/linux/cairobitmap.h"
+#include "../../../../../lib/platform/platformfactory.h"
+#include "../../../../../lib/cbitmap.h"
+#include "../../../../../lib/coffscreencontext.h"
+#include "../../../unittests.h"
+#include <vector>
+
+namespace VSTGUI {
+
+namespace {
+
+//------------------------------------------------------------------------
+/** a cairo context without the bitmap extension, so CDrawContext draws tile by tile */
+class PerTileContext : public CairoGraphicsDeviceContext
+{
+public:
+	using CairoGraphicsDeviceContext::CairoGraphicsDeviceContext;
+
+	const IPlatformGraphicsDeviceContextBitmapExt* asBitmapExt () const override { return nullptr; }
+};
+
+//------------------------------------------------------------------------
+SharedPointer<COffscreenContext> createContext (CPoint size, double scaleFactor, bool native)
+{
+	auto device = std::dynamic_pointer_cast<CairoGraphicsDevice> (
+		getPlatformFactory ().getGraphicsDeviceFactory ().getDeviceForScreen (
+			DefaultScreenIdentifier));
+	auto bitmap = getPlatformFactory ().createBitmap (size * scaleFactor);
+	auto cairoBitmap = bitmap.cast<Cairo::Bitmap> ();
+	if (!device || !cairoBitmap)
+		return nullptr;
+	bitmap->setScaleFactor (scaleFactor);
+	PlatformGraphicsDeviceContextPtr context;
+	if (native)
+		context = device->createBitmapContext (bitmap);
+	else
+		context = std::make_shared<PerTileContext> (*device, cairoBitmap->getSurface ());
+	return makeOwned<COffscreenContext> (context, CRect (CPoint (), size * scaleFactor), bitmap);
+}
+
+//------------------------------------------------------------------------
+/** every pixel has another opaque color, so that a misplaced tile changes the result */
+SharedPointer<CBitmap> createSourceBitmap (CPoint size, double scaleFactor)
+{
+	auto platformBitmap = getPlatformFactory ().createBitmap (size * scaleFactor);
+	if (!platformBitmap)
+		return nullptr;
+	platformBitmap->setScaleFactor (scaleFactor);
+	auto bitmap = makeOwned<CBitmap> (platformBitmap);
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		do
+		{
+			auto x = accessor->getX ();
+			auto y = accessor->getY ();
+			accessor->setColor (CColor (static_cast<uint8_t> (x * 17),
+										static_cast<uint8_t> (y * 29),
+										static_cast<uint8_t> ((x + y) * 11), 255));
+		} while (++(*accessor));
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+std::vector<CColor> getColors (CBitmap* bitmap)
+{
+	std::vector<CColor> result;
+	if (auto accessor = owned (CBitmapPixelAccess::create (bitmap)))
+	{
+		do
+		{
+			CColor color;
+			accessor->getColor (color);
+			result.emplace_back (color);
+		} while (++(*accessor));
+	}
+	return result;
+}
+
+//------------------------------------------------------------------------
+template <typename Proc>
+std::vector<CColor> render (CPoint size, double scaleFactor, bool native, Proc proc)
+{
+	auto context = createContext (size, scaleFactor, native);
+	EXPECT (context);
+	if (!context)
+		return {};
+	context->beginDraw ();
+	proc (*context);
+	context->endDraw ();
+	return getColors (context->getBitmap ());
+}
+
+//------------------------------------------------------------------------
+/** draws with the native implementation and tile by tile and expects the same pixels */
+template <typename Proc>
+void expectSameAsPerTile (CPoint size, double scaleFactor, Proc proc)
+{
+	auto native = render (size, scaleFactor, true, proc);
+	auto perTile = render (size, scaleFactor, false, proc);
+	EXPECT_EQ (native.size (), static_cast<size_t> (size.x * size.y * scaleFactor * scaleFactor));
+	EXPECT_EQ (native.size (), perTile.size ());
+	for (auto i = 0u; i < native.size () && i < perTile.size (); ++i)
+		EXPECT_EQ (native[i], perTile[i]);
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoGraphicsContextTest, NativeBitmapExtension)
+{
+	auto offscreen = createContext (CPoint (10, 10), 1., true);
+	EXPECT (offscreen);
+	EXPECT (offscreen->getPlatformDeviceContext ()->asBitmapExt ());
+	offscreen = createContext (CPoint (10, 10), 1., false);
+	EXPECT (offscreen);
+	EXPECT (offscreen->getPlatformDeviceContext ()->asBitmapExt () == nullptr);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoGraphicsContextTest, FillRectWithBitmapAnchoredAtDestination)
+{
+	auto bitmap = createSourceBitmap (CPoint (7, 5), 1.);
+	EXPECT (bitmap);
+	expectSameAsPerTile (CPoint (48, 36), 1., [&] (CDrawContext& drawContext) {
+		drawContext.fillRectWithBitmap (bitmap, CRect (0, 0, 7, 5), CRect (3, 5, 40, 31), 1.f);
+		drawContext.fillRectWithBitmap (bitmap, CRect (1, 1, 6, 4), CRect (41, 2, 47, 35), 1.f);
+	});
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoGraphicsContextTest, FillRectWithFractionalBitmapPart)
+{
+	auto bitmap = createSourceBitmap (CPoint (7, 5), 1.);
+	EXPECT (bitmap);
+	// not on pixel boundaries, the native implementation leaves it to the per tile drawing
+	expectSameAsPerTile (CPoint (40, 30), 1., [&] (CDrawContext& drawContext) {
+		drawContext.fillRectWithBitmap (bitmap, CRect (0.5, 1.5, 4.5, 4.5), CRect (2, 3, 37, 28), 1.f);
+	});
+	auto bitmap2x = createSourceBitmap (CPoint (7, 5), 2.);
+	EXPECT (bitmap2x);
+	// on pixel boundaries of the 2x bitmap
+	expectSameAsPerTile (CPoint (40, 30), 2., [&] (CDrawContext& drawContext) {
+		drawContext.fillRectWithBitmap (bitmap2x, CRect (0.5, 1.5, 4.5, 4.5), CRect (2, 3, 37, 28),
+									1.f);
+	});
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoGraphicsContextTest, FillRectWithBitmapScaleFactor2)
+{
+	auto bitmap = createSourceBitmap (CPoint (7, 5), 2.);
+	EXPECT (bitmap);
+	expectSameAsPerTile (CPoint (48, 36), 2., [&] (CDrawContext& drawContext) {
+		drawContext.fillRectWithBitmap (bitmap, CRect (0, 0, 7, 5), CRect (3, 5, 40, 31), 1.f);
+		drawContext.fillRectWithBitmap (bitmap, CRect (1, 1, 6, 4), CRect (41, 2, 47, 35), 1.f);
+	});
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (CairoGraphicsContextTest, DrawBitmapNinePartTiled)
+{
+	CNinePartTiledDescription desc (3., 4., 2., 3.);
+	for (auto scaleFactor : {1., 2.})
+	{
+		auto bitmap = createSourceBitmap (CPoint (12, 11), scaleFactor);
+		EXPECT (bitmap);
+		expectSameAsPerTile (CPoint (50, 40), scaleFactor, [&] (CDrawContext& drawContext) {
+			drawContext.drawBitmapNinePartTiled (bitmap, CRect (2, 3, 45, 37), desc, 1.f);
+		});
+	}
+}
+
+} // VSTGUI
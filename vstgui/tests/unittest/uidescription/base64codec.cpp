@@ -4,7 +4,9 @@
 
 #include "../../../uidescription/base64codec.h"
 #include "../unittests.h"
+#include <cstring>
 #include <string>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -72,4 +74,102 @@ TEST_CASE (Base64CodecTest, DecodeBinary)
 	EXPECT (ptr[5] == 0x0A);
 }
 
+namespace {
+
+using Backend = Base64Codec::Backend;
+
+std::vector<uint8_t> makeTestData (size_t size)
+{
+	std::vector<uint8_t> data (size);
+	uint32_t seed = 0x12345678;
+	for (auto& byte : data)
+	{
+		seed = seed * 1664525u + 1013904223u;
+		byte = static_cast<uint8_t> (seed >> 24);
+	}
+	return data;
+}
+
+bool equals (const Base64Codec::Result& a, const Base64Codec::Result& b)
+{
+	return a.dataSize == b.dataSize && std::memcmp (a.data.get (), b.data.get (), a.dataSize) == 0;
+}
+
+} // anonymous
+
+TEST_CASE (Base64CodecTest, EncodeSmallSizes)
+{
+	uint8_t data[] = {'A', 'B', 'C'};
+	auto result = Base64Codec::encode (data, 1);
+	EXPECT (result.dataSize == 4);
+	EXPECT (std::string (reinterpret_cast<const char*> (result.data.get ()), 4) == "QQ==");
+	result = Base64Codec::encode (data, 2);
+	EXPECT (result.dataSize == 4);
+	EXPECT (std::string (reinterpret_cast<const char*> (result.data.get ()), 4) == "QUI=");
+	result = Base64Codec::encode (data, 3);
+	EXPECT (result.dataSize == 4);
+	EXPECT (std::string (reinterpret_cast<const char*> (result.data.get ()), 4) == "QUJD");
+	result = Base64Codec::encode (data, 0);
+	EXPECT (result.dataSize == 0);
+}
+
+TEST_CASE (Base64CodecTest, AllBackendsAreEqual)
+{
+	for (auto size : {0u, 1u, 2u, 11u, 12u, 16u, 47u, 48u, 100u, 1000u, 4099u})
+	{
+		auto data = makeTestData (size);
+		auto encoded = Base64Codec::encode (data.data (), data.size (), Backend::kScalar);
+		auto decoded = Base64Codec::decode (encoded.data.get (), encoded.dataSize, Backend::kScalar);
+		EXPECT (decoded.dataSize == size);
+		EXPECT (std::memcmp (decoded.data.get (), data.data (), size) == 0);
+		for (auto backend : {Backend::kSSE, Backend::kAVX2, Backend::kNEON})
+		{
+			if (!Base64Codec::isAvailable (backend))
+				continue;
+			EXPECT (equals (Base64Codec::encode (data.data (), data.size (), backend), encoded));
+			EXPECT (equals (Base64Codec::decode (encoded.data.get (), encoded.dataSize, backend),
+							decoded));
+		}
+	}
+}
+
+TEST_CASE (Base64CodecTest, DecodeUnpaddedData)
+{
+	auto data = makeTestData (200);
+	auto encoded = Base64Codec::encode (data.data (), data.size ());
+	// strip the padding
+	auto size = encoded.dataSize;
+	while (encoded.data.get ()[size - 1] == '=')
+		--size;
+	EXPECT (size < encoded.dataSize);
+	for (auto backend : {Backend::kScalar, Backend::kSSE, Backend::kAVX2, Backend::kNEON})
+	{
+		if (!Base64Codec::isAvailable (backend))
+			continue;
+		auto decoded = Base64Codec::decode (encoded.data.get (), size, backend);
+		EXPECT (decoded.dataSize == data.size ());
+		EXPECT (std::memcmp (decoded.data.get (), data.data (), data.size ()) == 0);
+	}
+}
+
+TEST_CASE (Base64CodecTest, StreamingDecoder)
+{
+	auto data = makeTestData (1001);
+	auto encoded = Base64Codec::encode (data.data (), data.size ());
+	for (auto readSize : {1u, 2u, 5u, 64u, 2000u})
+	{
+		Base64Codec::Decoder decoder (encoded.data.get (), encoded.dataSize);
+		std::vector<uint8_t> decoded;
+		uint8_t buffer[2000];
+		while (auto numRead = decoder.read (buffer, readSize))
+		{
+			EXPECT (numRead <= readSize);
+			decoded.insert (decoded.end (), buffer, buffer + numRead);
+			EXPECT (decoder.getPosition () == decoded.size ());
+		}
+		EXPECT (decoder.atEnd ());
+		EXPECT (decoded == data);
+	}
+}
+
 }
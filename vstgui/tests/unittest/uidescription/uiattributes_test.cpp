@@ -208,6 +208,41 @@ TEST_CASE (UIAttributesTest, StringToRect)
 	EXPECT (UIAttributes::stringToRect ("0, 12.5, 5, 8", r) && r == CRect (0, 12.5, 5, 8))
 }
 
+TEST_CASE (UIAttributesTest, ParsedValues)
+{
+	using Type = UIAttributes::ParsedValue::Type;
+	UIAttributes a;
+	a.setAttribute ("rect", "0, 12.5, 5, 8");
+	a.setAttribute ("int", "abc");
+	EXPECT (a.parseAttribute ("rect", Type::kRect));
+	EXPECT (a.parseAttribute ("int", Type::kInteger) == false);
+	EXPECT (a.parseAttribute ("missing", Type::kInteger) == false);
+	EXPECT (a.getParsedValue ("int") == nullptr);
+	auto parsed = a.getParsedValue ("rect");
+	EXPECT (parsed && parsed->type == Type::kRect);
+	CRect r;
+	EXPECT (a.getRectAttribute ("rect", r) && r == CRect (0, 12.5, 5, 8));
+
+	UIAttributes copy (a);
+	EXPECT (copy.getParsedValue ("rect") != nullptr);
+	EXPECT (copy.getRectAttribute ("rect", r) && r == CRect (0, 12.5, 5, 8));
+
+	a.setAttribute ("rect", "1, 2, 3, 4");
+	EXPECT (a.getParsedValue ("rect") == nullptr);
+	EXPECT (a.getRectAttribute ("rect", r) && r == CRect (1, 2, 3, 4));
+
+	UIAttributes::ParsedValue value;
+	value.type = Type::kDouble;
+	value.values[0] = 0.25;
+	EXPECT (a.setParsedValue ("missing", value) == false);
+	a.setAttribute ("double", "0.25");
+	EXPECT (a.setParsedValue ("double", value));
+	double d = 0.;
+	EXPECT (a.getDoubleAttribute ("double", d) && d == 0.25);
+	a.removeAttribute ("double");
+	EXPECT (a.getParsedValue ("double") == nullptr);
+}
+
 TEST_CASE (UIAttributesTest, StringArrayToStringWithEmptyStringArray)
 {
 	const UIAttributes::StringArray strings;
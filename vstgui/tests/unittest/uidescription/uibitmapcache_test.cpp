@@ -0,0 +1,309 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../uidescription/detail/uibitmapcache.h"
+#include "../../../lib/cpoint.h"
+#include "../../../lib/cbitmap.h"
+#include "../../../lib/platform/platformfactory.h"
+#include "../../../uidescription/uicontentprovider.h"
+#include "../../../uidescription/uidescription.h"
+#include "../unittests.h"
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#if WINDOWS
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace VSTGUI {
+
+using namespace Detail;
+
+namespace {
+
+//------------------------------------------------------------------------
+struct TestDirectory
+{
+	TestDirectory ()
+	{
+#if WINDOWS
+		char tempPath[MAX_PATH];
+		GetTempPathA (MAX_PATH, tempPath);
+		path = tempPath;
+#else
+		auto tempPath = getenv ("TMPDIR");
+		path = tempPath ? tempPath : "/tmp";
+#endif
+		path += "/vstgui_bitmapcache_test_";
+		path += std::to_string (std::chrono::steady_clock::now ().time_since_epoch ().count ());
+	}
+
+	~TestDirectory () noexcept
+	{
+		// a cache without room removes all entries
+		BitmapDiskCache cleanup (path, 0);
+#if WINDOWS
+		RemoveDirectoryA (path.data ());
+#else
+		rmdir (path.data ());
+#endif
+	}
+
+	std::string path;
+};
+
+//------------------------------------------------------------------------
+PlatformBitmapPtr createTestBitmap (uint32_t width, uint32_t height, uint32_t seed)
+{
+	auto bitmap = getPlatformFactory ().createBitmap (CPoint (width, height));
+	if (auto access = bitmap->lockPixels (true))
+	{
+		auto address = access->getAddress ();
+		for (auto y = 0u; y < height; ++y, address += access->getBytesPerRow ())
+		{
+			auto pixel = reinterpret_cast<uint32_t*> (address);
+			for (auto x = 0u; x < width; ++x)
+				pixel[x] = 0xff000000 | (seed + y * width + x);
+		}
+	}
+	return bitmap;
+}
+
+//------------------------------------------------------------------------
+bool pixelsEqual (IPlatformBitmap& b1, IPlatformBitmap& b2)
+{
+	if (b1.getSize () != b2.getSize ())
+		return false;
+	auto a1 = b1.lockPixels (true);
+	auto a2 = b2.lockPixels (true);
+	if (!a1 || !a2)
+		return false;
+	auto rowSize = static_cast<size_t> (b1.getSize ().x) * 4;
+	for (auto y = 0u; y < static_cast<uint32_t> (b1.getSize ().y); ++y)
+	{
+		if (memcmp (a1->getAddress () + y * a1->getBytesPerRow (),
+					a2->getAddress () + y * a2->getBytesPerRow (), rowSize) != 0)
+			return false;
+	}
+	return true;
+}
+
+#if VSTGUI_ENABLE_XML_PARSER
+//------------------------------------------------------------------------
+constexpr auto filteredBitmapUIDesc = R"(
+<vstgui-ui-description version="1">
+	<bitmaps>
+		<bitmap name="b1#2.0x" path="b1#2.0x.png">
+			<filter name="Box Blur">
+				<property name="Radius" value="3"/>
+			</filter>
+			<data encoding="base64">
+				iVBORw0KGgoAAAANSUhEUgAAAAwAAAAMCAYAAABWdVznAAABe2lDQ1BJQ0MgUHJvZmlsZQAAKJF9kE0rRF
+				EYx38zXjNkwcLC4jaG1RCjvGyUmYSaxTRGedvcueZFmXG7c4VsLJTtFCU23hZ8AjYWylopRUrKVyA20vUc
+				Q+OlPHXO+Z3nPM+/5/zB7ddNc7a0HTJZ24oOBrWx8Qmt4gEX5XjQ8OpGzuyPRMJIfJ0/4+VaqiWuWpXW3/
+				d/wzOdyBngqhTuM0zLFh4SblqwTcVKr96SoYRXFKcKvKE4XuCjj5pYNCR8KqwZaX1a+E7Yb6StDLiVvi/+
+				rSb1jTOz88bnPOon1Yns6IicXlmN5IgySFC8GGaAEF100Ct7F60EaJMbdmLRVs2hOXPJmkmlba1fnEhow1
+				mjza8F2ju6Qfn6269ibm4Xep6hJF/MxTfhZA0abos53w7UrsLxualb+keqRJY7mYTHQ6gZh7pLqJrMJTsD
+				hR9VB6Hs3nGemqFiHd7yjvO65zhv+9IsHp1lCx59anFwA7FlCF/A1ja0iHbt1Dv7WWccXX/QZQAAAExJRE
+				FUKBVjZEAALSAzDMFFYa0C8q6BRJhQhBEcUSAThIkGDUCVIIwBcNmAoRAmMKoBFhL4aEagJLYYhkXaazTN
+				q1jQBGBcdIUwcQYAOGIGVqwWW9EAAAAASUVORK5CYII=
+			</data>
+		</bitmap>
+	</bitmaps>
+</vstgui-ui-description>
+)";
+#endif
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapCacheTest, Keys)
+{
+	std::string data1 = "encoded image data";
+	std::string data2 = "encoded image date";
+	auto key = BitmapDiskCache::makeKey (data1.data (), data1.size (), "filter;");
+	EXPECT_EQ (key.dataSize, data1.size ());
+	EXPECT_EQ (key.dataHash,
+			   BitmapDiskCache::makeKey (data1.data (), data1.size (), "").dataHash);
+	EXPECT_NE (key.dataHash,
+			   BitmapDiskCache::makeKey (data2.data (), data2.size (), "filter;").dataHash);
+	EXPECT_NE (key.filterHash,
+			   BitmapDiskCache::makeKey (data1.data (), data1.size (), "filter2;").filterHash);
+	EXPECT_NE (BitmapDiskCache::hash ("a", 1), BitmapDiskCache::hash ("b", 1));
+	EXPECT_NE (BitmapDiskCache::hash ("a", 1), BitmapDiskCache::hash ("a", 1, 1));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapCacheTest, StoreAndLoad)
+{
+	TestDirectory dir;
+	BitmapDiskCache cache (dir.path, 1024 * 1024);
+	std::string data = "encoded image data";
+	auto key = BitmapDiskCache::makeKey (data.data (), data.size (), "");
+	EXPECT_EQ (cache.load (key), nullptr);
+
+	auto bitmap = createTestBitmap (13, 7, 1);
+	bitmap->setScaleFactor (2.);
+	EXPECT (cache.store (key, *bitmap));
+	EXPECT_EQ (cache.getSize (), 64u + 13u * 7u * 4u);
+
+	auto loaded = cache.load (key);
+	EXPECT (loaded);
+	EXPECT_EQ (loaded->getScaleFactor (), 2.);
+	EXPECT (pixelsEqual (*loaded, *bitmap));
+
+	// a new cache finds the entries of the directory
+	BitmapDiskCache cache2 (dir.path, 1024 * 1024);
+	EXPECT_EQ (cache2.getSize (), cache.getSize ());
+	loaded = cache2.load (key);
+	EXPECT (loaded);
+	EXPECT (pixelsEqual (*loaded, *bitmap));
+
+	auto otherKey = BitmapDiskCache::makeKey (data.data (), data.size (), "filter;");
+	EXPECT_EQ (cache.load (otherKey), nullptr);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapCacheTest, InvalidEntriesAreIgnored)
+{
+	TestDirectory dir;
+	BitmapDiskCache cache (dir.path, 1024 * 1024);
+	std::string data = "encoded image data";
+	auto key = BitmapDiskCache::makeKey (data.data (), data.size (), "");
+	auto bitmap = createTestBitmap (8, 8, 2);
+	EXPECT (cache.store (key, *bitmap));
+	EXPECT (cache.load (key));
+
+	// truncated
+	auto file = fopen (cache.getPath (key).data (), "r+b");
+	EXPECT (file);
+	fseek (file, 0, SEEK_END);
+	fputc (0, file);
+	fclose (file);
+	EXPECT_EQ (cache.load (key), nullptr);
+
+	// damaged header
+	EXPECT (cache.store (key, *bitmap));
+	file = fopen (cache.getPath (key).data (), "r+b");
+	EXPECT (file);
+	fseek (file, 20, SEEK_SET);
+	fputc (0xff, file);
+	fclose (file);
+	EXPECT_EQ (cache.load (key), nullptr);
+
+	// the key of another entry
+	EXPECT (cache.store (key, *bitmap));
+	auto otherKey = BitmapDiskCache::makeKey (data.data (), data.size () - 1, "");
+	std::rename (cache.getPath (key).data (), cache.getPath (otherKey).data ());
+	EXPECT_EQ (cache.load (otherKey), nullptr);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapCacheTest, Eviction)
+{
+	TestDirectory dir;
+	constexpr uint64_t entrySize = 64 + 16 * 16 * 4;
+	BitmapDiskCache cache (dir.path, entrySize * 4);
+	std::vector<BitmapDiskCache::Key> keys;
+	for (auto i = 0u; i < 5; ++i)
+	{
+		auto data = std::to_string (i);
+		keys.emplace_back (BitmapDiskCache::makeKey (data.data (), data.size (), ""));
+		EXPECT (cache.store (keys.back (), *createTestBitmap (16, 16, i)));
+		EXPECT (cache.getSize () <= cache.getMaxSize ());
+	}
+	// the fifth entry exceeded the maximum size, only three entries are left
+	EXPECT_EQ (cache.getSize (), entrySize * 3);
+
+	// entries larger than the cache are not stored
+	auto data = std::string ("large");
+	auto key = BitmapDiskCache::makeKey (data.data (), data.size (), "");
+	EXPECT_FALSE (cache.store (key, *createTestBitmap (64, 64, 0)));
+	EXPECT_EQ (cache.load (key), nullptr);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapCacheTest, ReplacedEntryIsCountedOnce)
+{
+	TestDirectory dir;
+	constexpr uint64_t entrySize = 64 + 16 * 16 * 4;
+	BitmapDiskCache cache (dir.path, entrySize * 4);
+	std::string data = "encoded image data";
+	auto key = BitmapDiskCache::makeKey (data.data (), data.size (), "");
+	for (auto i = 0u; i < 8; ++i)
+	{
+		EXPECT (cache.store (key, *createTestBitmap (16, 16, i)));
+		EXPECT_EQ (cache.getSize (), entrySize);
+	}
+	EXPECT (cache.load (key));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapCacheTest, EvictionOrderOfEntriesWrittenInOneSecond)
+{
+	TestDirectory dir;
+	constexpr uint64_t entrySize = 64 + 16 * 16 * 4;
+	BitmapDiskCache cache (dir.path, entrySize * 4);
+	std::vector<BitmapDiskCache::Key> keys;
+	for (auto i = 0u; i < 5; ++i)
+	{
+		auto data = std::to_string (i);
+		keys.emplace_back (BitmapDiskCache::makeKey (data.data (), data.size (), ""));
+		EXPECT (cache.store (keys.back (), *createTestBitmap (16, 16, i)));
+	}
+	// the two oldest entries were removed, the newest ones are kept
+	EXPECT_EQ (cache.load (keys[0]), nullptr);
+	EXPECT_EQ (cache.load (keys[1]), nullptr);
+	EXPECT (cache.load (keys[2]));
+	EXPECT (cache.load (keys[3]));
+	EXPECT (cache.load (keys[4]));
+}
+
+#if VSTGUI_ENABLE_XML_PARSER
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapCacheTest, FilteredBitmapOfDescription)
+{
+	TestDirectory dir;
+	auto loadBitmap = [&] (bool useCache, bool& loadedFromCache) {
+		MemoryContentProvider provider (
+			filteredBitmapUIDesc, static_cast<uint32_t> (strlen (filteredBitmapUIDesc)));
+		auto desc = makeOwned<UIDescription> (&provider);
+		EXPECT (desc->parse ());
+		if (useCache)
+			desc->setBitmapCacheDirectory (dir.path.data ());
+		loadedFromCache = false;
+		desc->setBitmapDecodeTraceFunc ([&] (const UIDescription::BitmapDecodeTrace& trace) {
+			loadedFromCache = trace.loadedFromCache;
+		});
+		PlatformBitmapPtr result;
+		if (auto bitmap = desc->getBitmap ("b1#2.0x"))
+			result = bitmap->getPlatformBitmap ();
+		return result;
+	};
+	bool loadedFromCache;
+	auto uncached = loadBitmap (false, loadedFromCache);
+	EXPECT (uncached);
+	EXPECT_EQ (uncached->getScaleFactor (), 2.);
+
+	auto stored = loadBitmap (true, loadedFromCache);
+	EXPECT (stored);
+	EXPECT_FALSE (loadedFromCache);
+
+	auto loaded = loadBitmap (true, loadedFromCache);
+	EXPECT (loaded);
+	EXPECT (loadedFromCache);
+	EXPECT_EQ (stored->getScaleFactor (), uncached->getScaleFactor ());
+	EXPECT_EQ (loaded->getScaleFactor (), uncached->getScaleFactor ());
+	EXPECT (pixelsEqual (*stored, *uncached));
+	EXPECT (pixelsEqual (*loaded, *uncached));
+}
+#endif
+
+} // VSTGUI
@@ -0,0 +1,188 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../uidescription/detail/uibitmapdecoder.h"
+#include "../../../lib/cbitmap.h"
+#include "../../../uidescription/uicontentprovider.h"
+#include "../../../uidescription/uidescription.h"
+#include "../unittests.h"
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+namespace VSTGUI {
+
+using namespace Detail;
+
+namespace {
+
+#if VSTGUI_ENABLE_XML_PARSER
+//------------------------------------------------------------------------
+constexpr auto prefetchUIDesc = R"(
+<vstgui-ui-description version="1">
+	<bitmaps>
+		<bitmap name="b1" path="b1.png">
+			<data encoding="base64">
+				iVBORw0KGgoAAAANSUhEUgAAAAwAAAAMCAYAAABWdVznAAABe2lDQ1BJQ0MgUHJvZmlsZQAAKJF9kE0rRF
+				EYx38zXjNkwcLC4jaG1RCjvGyUmYSaxTRGedvcueZFmXG7c4VsLJTtFCU23hZ8AjYWylopRUrKVyA20vUc
+				Q+OlPHXO+Z3nPM+/5/zB7ddNc7a0HTJZ24oOBrWx8Qmt4gEX5XjQ8OpGzuyPRMJIfJ0/4+VaqiWuWpXW3/
+				d/wzOdyBngqhTuM0zLFh4SblqwTcVKr96SoYRXFKcKvKE4XuCjj5pYNCR8KqwZaX1a+E7Yb6StDLiVvi/+
+				rSb1jTOz88bnPOon1Yns6IicXlmN5IgySFC8GGaAEF100Ct7F60EaJMbdmLRVs2hOXPJmkmlba1fnEhow1
+				mjza8F2ju6Qfn6269ibm4Xep6hJF/MxTfhZA0abos53w7UrsLxualb+keqRJY7mYTHQ6gZh7pLqJrMJTsD
+				hR9VB6Hs3nGemqFiHd7yjvO65zhv+9IsHp1lCx59anFwA7FlCF/A1ja0iHbt1Dv7WWccXX/QZQAAAExJRE
+				FUKBVjZEAALSAzDMFFYa0C8q6BRJhQhBEcUSAThIkGDUCVIIwBcNmAoRAmMKoBFhL4aEagJLYYhkXaazTN
+				q1jQBGBcdIUwcQYAOGIGVqwWW9EAAAAASUVORK5CYII=
+			</data>
+		</bitmap>
+		<bitmap name="b2" path="b2.png"/>
+	</bitmaps>
+	<template class="CViewContainer" name="t1" size="100, 100" bitmap="b1"/>
+	<template class="CViewContainer" name="t2" size="100, 100" bitmap="b2"/>
+</vstgui-ui-description>
+)";
+
+//------------------------------------------------------------------------
+bool pixelsEqual (CBitmap* b1, CBitmap* b2)
+{
+	if (!b1 || !b2 || !b1->getPlatformBitmap () || !b2->getPlatformBitmap ())
+		return false;
+	auto pb1 = b1->getPlatformBitmap ();
+	auto pb2 = b2->getPlatformBitmap ();
+	if (pb1->getSize () != pb2->getSize () || pb1->getScaleFactor () != pb2->getScaleFactor ())
+		return false;
+	auto a1 = pb1->lockPixels (true);
+	auto a2 = pb2->lockPixels (true);
+	if (!a1 || !a2)
+		return false;
+	auto rowSize = static_cast<size_t> (pb1->getSize ().x) * 4;
+	for (auto y = 0u; y < static_cast<uint32_t> (pb1->getSize ().y); ++y)
+	{
+		if (memcmp (a1->getAddress () + y * a1->getBytesPerRow (),
+					a2->getAddress () + y * a2->getBytesPerRow (), rowSize) != 0)
+			return false;
+	}
+	return true;
+}
+#endif
+
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapDecoderTest, EveryJobRunsOnce)
+{
+	constexpr auto kNumJobs = 64u;
+	std::atomic<uint32_t> counter {0};
+	std::vector<BitmapDecodeJobPtr> jobs;
+	BitmapDecodeQueue queue (3);
+	for (auto i = 0u; i < kNumJobs; ++i)
+	{
+		jobs.emplace_back (queue.schedule ([&counter, i] () {
+			++counter;
+			DecodedBitmap result;
+			result.nameScaleFactor = i;
+			return result;
+		}));
+	}
+	for (auto i = 0u; i < kNumJobs; ++i)
+	{
+		EXPECT_EQ (jobs[i]->complete ().nameScaleFactor, static_cast<double> (i));
+		// completing twice must not run the task again
+		EXPECT_EQ (jobs[i]->complete ().nameScaleFactor, static_cast<double> (i));
+	}
+	EXPECT_EQ (counter.load (), kNumJobs);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapDecoderTest, PendingJobsOutliveQueue)
+{
+	uint32_t counter = 0;
+	BitmapDecodeJobPtr job;
+	{
+		BitmapDecodeQueue queue (1);
+		queue.cancelPending ();
+		job = queue.schedule ([&counter] () {
+			++counter;
+			DecodedBitmap result;
+			result.filtersApplied = true;
+			return result;
+		});
+	}
+	EXPECT_TRUE (job->complete ().filtersApplied);
+	EXPECT_EQ (counter, 1u);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapDecoderTest, CompleteRunsPendingJobOnCallingThread)
+{
+	BitmapDecodeJob job ([] () {
+		DecodedBitmap result;
+		result.bitmap = makeOwned<CBitmap> (CPoint (1, 1));
+		result.nameScaleFactor = 2.;
+		return result;
+	});
+	auto decoded = job.complete ();
+	EXPECT_EQ (decoded.nameScaleFactor, 2.);
+	EXPECT_TRUE (job.wasDecodedInBackground () == false);
+	EXPECT_TRUE (job.getWaitTime ().count () == 0);
+	// the bitmap is handed over, the job does not hold a reference anymore
+	EXPECT (decoded.bitmap);
+	EXPECT_EQ (decoded.bitmap->getNbReference (), 1);
+	EXPECT (job.complete ().bitmap == nullptr);
+	EXPECT_EQ (job.complete ().nameScaleFactor, 2.);
+}
+
+#if VSTGUI_ENABLE_XML_PARSER
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapDecoderTest, PrefetchedBitmapOfDescription)
+{
+	MemoryContentProvider provider (prefetchUIDesc,
+									static_cast<uint32_t> (strlen (prefetchUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse ());
+	std::vector<UIDescription::BitmapDecodeTrace> traces;
+	desc.setBitmapDecodeTraceFunc (
+		[&] (const UIDescription::BitmapDecodeTrace& trace) { traces.emplace_back (trace); });
+
+	// only the bitmap of the template with image data is scheduled, and only once
+	EXPECT_EQ (desc.prefetchBitmaps ("t1"), 1u);
+	EXPECT_EQ (desc.prefetchBitmaps ("t1"), 0u);
+	auto bitmap = desc.getBitmap ("b1");
+	EXPECT (bitmap);
+	EXPECT_EQ (traces.size (), 1u);
+	EXPECT (traces[0].prefetched);
+	EXPECT (desc.getBitmap ("b1") == bitmap);
+	EXPECT_EQ (traces.size (), 1u);
+	EXPECT_EQ (desc.prefetchBitmaps ("t1"), 0u);
+
+	MemoryContentProvider provider2 (prefetchUIDesc,
+									 static_cast<uint32_t> (strlen (prefetchUIDesc)));
+	UIDescription desc2 (&provider2);
+	EXPECT (desc2.parse ());
+	EXPECT (pixelsEqual (bitmap, desc2.getBitmap ("b1")));
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIBitmapDecoderTest, PrefetchedBitmapsAfterFreePlatformResources)
+{
+	MemoryContentProvider provider (prefetchUIDesc,
+									static_cast<uint32_t> (strlen (prefetchUIDesc)));
+	UIDescription desc (&provider);
+	EXPECT (desc.parse ());
+	// the jobs are dropped while the workers may still decode them
+	for (auto i = 0; i < 16; ++i)
+	{
+		EXPECT_EQ (desc.prefetchBitmaps ("t1"), 1u);
+		desc.freePlatformResources ();
+	}
+	EXPECT_EQ (desc.prefetchBitmaps ("t1"), 1u);
+	auto bitmap = shared (desc.getBitmap ("b1"));
+	EXPECT (bitmap);
+	desc.freePlatformResources ();
+	auto decoded = desc.getBitmap ("b1");
+	EXPECT (decoded != bitmap);
+	EXPECT (pixelsEqual (bitmap, decoded));
+}
+#endif
+
+} // VSTGUI
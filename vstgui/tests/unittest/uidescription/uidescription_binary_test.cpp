@@ -0,0 +1,242 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "../../../lib/ccolor.h"
+#include "../../../lib/cviewcontainer.h"
+#include "../../../uidescription/detail/uibinarypersistence.h"
+#include "../../../uidescription/uiattributes.h"
+#include "../../../uidescription/uicontentprovider.h"
+#include "uidescription_test_helper.h"
+
+namespace VSTGUI {
+using namespace UIDescriptionTesting;
+
+namespace {
+
+//------------------------------------------------------------------------
+static constexpr auto saveFlags =
+	UIDescription::kWriteImagesIntoUIDescFile | UIDescription::kDoNotVerifyImageData;
+
+constexpr auto binaryTestUIDesc = R"(
+{
+	"vstgui-ui-description": {
+		"version": "1",
+		"variables": {
+			"number": "10",
+			"string": "this is a string"
+		},
+		"bitmaps": {
+			"b1": {
+				"path": "b1.png"
+			},
+			"b1#2.0x": {
+				"path": "b1#2.0x.png",
+				"scale-factor": "2"
+			}
+		},
+		"fonts": {
+			"f1": {
+				"font-name": "Arial",
+				"size": "8"
+			}
+		},
+		"colors": {
+			"c1": "#000000ff",
+			"c2": "#ff000064"
+		},
+		"gradients": {
+			"g1": [
+				{
+					"rgba": "#000000ff",
+					"start": "0"
+				},
+				{
+					"rgba": "#ffffffff",
+					"start": "1"
+				}
+			]
+		},
+		"control-tags": {
+			"t1": "1234"
+		},
+		"custom": {
+			"c": {
+				"key": "value"
+			}
+		},
+		"templates": {
+			"view": {
+				"attributes": {
+					"background-color": "c2",
+					"class": "CViewContainer",
+					"origin": "0, 0",
+					"size": "400, 235"
+				},
+				"children": {
+					"CView": {
+						"attributes": {
+							"class": "CView",
+							"origin": "4, 10",
+							"size": "392, 40"
+						}
+					},
+					"CViewContainer": {
+						"attributes": {
+							"class": "CViewContainer",
+							"origin": "4, 60",
+							"size": "200, 100"
+						},
+						"children": {
+							"CView": {
+								"attributes": {
+									"class": "CView",
+									"origin": "10, 10",
+									"size": "20, 30"
+								}
+							}
+						}
+					}
+				}
+			}
+		}
+	}
+}
+)";
+
+//------------------------------------------------------------------------
+std::string saveAsJSON (SaveUIDescription& desc)
+{
+	CMemoryStream stream (1024, 1024, false);
+	EXPECT (desc.saveToStream (stream, saveFlags, nullptr));
+	return {reinterpret_cast<const char*> (stream.getBuffer ()),
+			static_cast<size_t> (stream.tell ())};
+}
+
+//------------------------------------------------------------------------
+void compareViews (CView* v1, CView* v2)
+{
+	EXPECT (v1 && v2);
+	EXPECT (v1->getViewSize () == v2->getViewSize ());
+	auto c1 = v1->asViewContainer ();
+	auto c2 = v2->asViewContainer ();
+	EXPECT ((c1 == nullptr) == (c2 == nullptr));
+	if (!c1)
+		return;
+	EXPECT (c1->getNbViews () == c2->getNbViews ());
+	EXPECT (c1->getBackgroundColor () == c2->getBackgroundColor ());
+	for (auto i = 0u; i < c1->getNbViews (); ++i)
+		compareViews (c1->getView (i), c2->getView (i));
+}
+
+//------------------------------------------------------------------------
+} // anonymous
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, RoundTrip)
+{
+	MemoryContentProvider provider (binaryTestUIDesc,
+									static_cast<uint32_t> (strlen (binaryTestUIDesc)));
+	SaveUIDescription desc (&provider);
+	EXPECT (desc.parse ());
+
+	CMemoryStream binary;
+	EXPECT (desc.saveToStream (binary, saveFlags | UIDescription::kWriteAsBinary, nullptr));
+	EXPECT (Detail::UIBinaryDescReader::isBinaryDesc (binary.getBuffer (),
+													   static_cast<size_t> (binary.tell ())));
+
+	MemoryContentProvider binaryProvider (binary.getBuffer (),
+										  static_cast<uint32_t> (binary.tell ()));
+	SaveUIDescription binaryDesc (&binaryProvider);
+	EXPECT (binaryDesc.parse ());
+	EXPECT (saveAsJSON (desc) == saveAsJSON (binaryDesc));
+
+	CColor color;
+	EXPECT (binaryDesc.getColor ("c2", color));
+	EXPECT (color == CColor (255, 0, 0, 100));
+	EXPECT (binaryDesc.getTagForName ("t1") == 1234);
+	double number;
+	EXPECT (binaryDesc.getVariable ("number", number));
+	EXPECT (number == 10.);
+	EXPECT (binaryDesc.hasBitmapName ("b1#2.0x"));
+	EXPECT (binaryDesc.getGradient ("g1") != nullptr);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, SameViewTree)
+{
+	MemoryContentProvider provider (binaryTestUIDesc,
+									static_cast<uint32_t> (strlen (binaryTestUIDesc)));
+	SaveUIDescription desc (&provider);
+	EXPECT (desc.parse ());
+	CMemoryStream binary;
+	EXPECT (desc.saveToStream (binary, saveFlags | UIDescription::kWriteAsBinary, nullptr));
+	MemoryContentProvider binaryProvider (binary.getBuffer (),
+										  static_cast<uint32_t> (binary.tell ()));
+	UIDescription binaryDesc (&binaryProvider);
+	EXPECT (binaryDesc.parse ());
+
+	Controller controller;
+	auto view = owned (desc.createView ("view", &controller));
+	auto binaryView = owned (binaryDesc.createView ("view", &controller));
+	compareViews (view, binaryView);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, TypedValues)
+{
+	MemoryContentProvider provider (binaryTestUIDesc,
+									static_cast<uint32_t> (strlen (binaryTestUIDesc)));
+	SaveUIDescription desc (&provider);
+	EXPECT (desc.parse ());
+	CMemoryStream binary;
+	EXPECT (desc.saveToStream (binary, saveFlags | UIDescription::kWriteAsBinary, nullptr));
+	auto root = Detail::UIBinaryDescReader::read (binary.getBuffer (),
+												  static_cast<size_t> (binary.tell ()));
+	EXPECT (root);
+
+	using Type = UIAttributes::ParsedValue::Type;
+	auto templates = root->getChildren ().findChildNode ("template");
+	EXPECT (templates);
+	auto attributes = templates->getAttributes ();
+	auto size = attributes->getParsedValue ("size");
+	EXPECT (size && size->type == Type::kPoint);
+	EXPECT (size->values[0] == 400. && size->values[1] == 235.);
+	EXPECT (attributes->getParsedValue ("class") == nullptr);
+	CPoint p;
+	EXPECT (attributes->getPointAttribute ("size", p) && p == CPoint (400, 235));
+
+	auto colors = root->getChildren ().findChildNode ("colors");
+	EXPECT (colors);
+	auto c2 = colors->getChildren ().findChildNodeWithAttributeValue ("name", "c2");
+	EXPECT (c2);
+	auto color = c2->getAttributes ()->getParsedValue ("rgba");
+	EXPECT (color && color->type == Type::kColor);
+	EXPECT (color->values[0] == 255. && color->values[3] == 100.);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, TruncatedData)
+{
+	MemoryContentProvider provider (binaryTestUIDesc,
+									static_cast<uint32_t> (strlen (binaryTestUIDesc)));
+	SaveUIDescription desc (&provider);
+	EXPECT (desc.parse ());
+	CMemoryStream binary;
+	EXPECT (desc.saveToStream (binary, saveFlags | UIDescription::kWriteAsBinary, nullptr));
+	auto size = static_cast<size_t> (binary.tell ());
+	for (auto truncatedSize : {size_t (4), size_t (20), size / 2, size - 1})
+	{
+		EXPECT (Detail::UIBinaryDescReader::read (binary.getBuffer (), truncatedSize) == nullptr);
+	}
+	EXPECT (Detail::UIBinaryDescReader::read (binary.getBuffer (), size) != nullptr);
+}
+
+//------------------------------------------------------------------------
+TEST_CASE (UIDescriptionBinaryTests, TextIsNotBinary)
+{
+	EXPECT (Detail::UIBinaryDescReader::isBinaryDesc (
+				binaryTestUIDesc, strlen (binaryTestUIDesc)) == false);
+}
+
+} // VSTGUI
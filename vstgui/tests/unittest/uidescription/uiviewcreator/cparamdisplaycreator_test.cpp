@@ -70,6 +70,13 @@ TEST_CASE (CParamDisplayCreatorTest, FontAntialias)
 	                              [&] (CParamDisplay* v) { return v->getAntialias () == false; });
 }
 
+TEST_CASE (CParamDisplayCreatorTest, FastTextRendering)
+{
+	DummyUIDescription uiDesc;
+	testAttribute<CParamDisplay> (kCParamDisplay, kAttrFastTextRendering, true, &uiDesc,
+	                              [&] (CParamDisplay* v) { return v->getFastTextRendering (); });
+}
+
 TEST_CASE (CParamDisplayCreatorTest, TextAlignment)
 {
 	DummyUIDescription uiDesc;
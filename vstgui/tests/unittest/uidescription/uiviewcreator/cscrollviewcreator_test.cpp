@@ -75,6 +75,13 @@ TEST_CASE (CScrollViewContainerCreatorTest, AutoHideScrollbars)
 	    [&] (CScrollView* v) { return v->getStyle () & CScrollView::kAutoHideScrollbars; });
 }
 
+TEST_CASE (CScrollViewContainerCreatorTest, TransformScrolling)
+{
+	testAttribute<CScrollView> (
+	    kCScrollView, kAttrTransformScrolling, true, nullptr,
+	    [&] (CScrollView* v) { return v->getStyle () & CScrollView::kTransformScrolling; });
+}
+
 TEST_CASE (CScrollViewContainerCreatorTest, ScrollbarWidth)
 {
 	testAttribute<CScrollView> (kCScrollView, kAttrScrollbarWidth, 5., nullptr,
@@ -38,6 +38,22 @@ TEST_CASE (CShadowViewContainerCreatorTest, ShadowOffset)
 	    [&] (CShadowViewContainer* v) { return v->getShadowOffset () == p; });
 }
 
+TEST_CASE (CShadowViewContainerCreatorTest, ShadowDownsampling)
+{
+	DummyUIDescription uidesc;
+	testAttribute<CShadowViewContainer> (
+	    kCShadowViewContainer, kAttrShadowDownsampling, 4, &uidesc,
+	    [] (CShadowViewContainer* v) { return v->getShadowDownsampling () == 4u; });
+}
+
+TEST_CASE (CShadowViewContainerCreatorTest, ShadowFollowsContent)
+{
+	DummyUIDescription uidesc;
+	testAttribute<CShadowViewContainer> (
+	    kCShadowViewContainer, kAttrShadowFollowsContent, true, &uidesc,
+	    [] (CShadowViewContainer* v) { return v->getShadowFollowsContent (); });
+}
+
 TEST_CASE (CShadowViewContainerCreatorTest, ShadowBlurSizeMinMax)
 {
 	DummyUIDescription uidesc;
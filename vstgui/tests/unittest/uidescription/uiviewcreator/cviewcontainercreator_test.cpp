@@ -47,4 +47,12 @@ TEST_CASE (CViewContainerCreatorTest, BackgroundColorDrawStyleValues)
 	                    {"stroked", "filled", "filled and stroked"});
 }
 
+TEST_CASE (CViewContainerCreatorTest, CacheAsBitmap)
+{
+	testAttribute<CViewContainer> (kCViewContainer, kAttrCacheAsBitmap, true, nullptr,
+	                               [] (CViewContainer* v) { return v->getCacheAsBitmap (); });
+	testAttribute<CViewContainer> (kCViewContainer, kAttrCacheAsBitmap, false, nullptr,
+	                               [] (CViewContainer* v) { return !v->getCacheAsBitmap (); });
+}
+
 } // VSTGUI
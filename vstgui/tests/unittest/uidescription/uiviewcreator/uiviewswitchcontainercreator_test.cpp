@@ -71,6 +71,27 @@ TEST_CASE (UIViewSwitchContainerCreatorTest, AnimationTime)
 	    [] (UIViewSwitchContainer* v) { return v->getAnimationTime () == 1234; });
 }
 
+TEST_CASE (UIViewSwitchContainerCreatorTest, ViewCacheSize)
+{
+	DummyUIDescription uidesc;
+	testAttribute<UIViewSwitchContainer> (
+	    kUIViewSwitchContainer, kAttrViewCacheSize, 4, &uidesc,
+	    [] (UIViewSwitchContainer* v) { return v->getViewCachePolicy ().maxViews == 4; });
+	testAttribute<UIViewSwitchContainer> (
+	    kUIViewSwitchContainer, kAttrViewCacheSize, -1, &uidesc, [] (UIViewSwitchContainer* v) {
+		    return v->getViewCachePolicy ().maxViews ==
+		           UIViewSwitchContainer::ViewCachePolicy::keepAll ().maxViews;
+	    });
+}
+
+TEST_CASE (UIViewSwitchContainerCreatorTest, PrewarmViews)
+{
+	DummyUIDescription uidesc;
+	testAttribute<UIViewSwitchContainer> (
+	    kUIViewSwitchContainer, kAttrPrewarmViews, true, &uidesc,
+	    [] (UIViewSwitchContainer* v) { return v->getPrewarmViews (); });
+}
+
 TEST_CASE (UIViewSwitchContainerCreatorTest, AnimationStyleValues)
 {
 	DummyUIDescription uidesc;
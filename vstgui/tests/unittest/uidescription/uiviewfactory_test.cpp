@@ -348,4 +348,76 @@ TEST_CASE (UIViewFactoryTest, ApplyCustomViewAttributes)
 	EXPECT (view->baseState == BaseView::State::kState3);
 }
 
+TEST_CASE (UIViewFactoryTest, CreateViewFromPlan)
+{
+	auto& factory = TEST_SUITE_GET_STORAGE (SharedPointer<UIViewFactory>);
+
+	auto a = makeOwned<UIAttributes> ();
+	a->setAttribute (UIViewCreator::kAttrClass, viewCreator.getViewName ());
+	a->setIntegerAttribute (viewAttr, 5);
+	a->setAttribute (baseViewAttr, "2");
+	auto plan = factory->createCreationPlan (a, nullptr);
+	EXPECT (plan->creators.size () == 2);
+	EXPECT (UIViewFactory::isCreationPlanValid (*plan, *a));
+	for (auto i = 0; i < 2; ++i)
+	{
+		auto v = owned (factory->createView (*plan, nullptr));
+		auto view = v.cast<View> ();
+		EXPECT (view != nullptr);
+		EXPECT (view->value == 5);
+		EXPECT (view->baseState == BaseView::State::kState2);
+		EXPECT (UTF8StringView (UIViewFactory::getViewName (view)) == viewCreator.getViewName ());
+	}
+}
+
+TEST_CASE (UIViewFactoryTest, CreationPlanKeepsParsedValues)
+{
+	auto& factory = TEST_SUITE_GET_STORAGE (SharedPointer<UIViewFactory>);
+
+	auto a = makeOwned<UIAttributes> ();
+	a->setAttribute (UIViewCreator::kAttrClass, viewCreator.getViewName ());
+	a->setAttribute (viewAttr, "5");
+	UIAttributes::ParsedValue value;
+	value.type = UIAttributes::ParsedValue::Type::kInteger;
+	value.values[0] = 5.;
+	EXPECT (a->setParsedValue (viewAttr, value));
+	auto plan = factory->createCreationPlan (a, nullptr);
+	auto parsed = plan->evaluatedAttributes.getParsedValue (viewAttr);
+	EXPECT (parsed != nullptr);
+	EXPECT (parsed->type == UIAttributes::ParsedValue::Type::kInteger);
+	EXPECT (parsed->values[0] == 5.);
+	auto v = owned (factory->createView (*plan, nullptr));
+	auto view = v.cast<View> ();
+	EXPECT (view && view->value == 5);
+}
+
+TEST_CASE (UIViewFactoryTest, CreationPlanInvalidation)
+{
+	auto& factory = TEST_SUITE_GET_STORAGE (SharedPointer<UIViewFactory>);
+
+	auto a = makeOwned<UIAttributes> ();
+	a->setAttribute (UIViewCreator::kAttrClass, viewCreator.getViewName ());
+	auto plan = factory->createCreationPlan (a, nullptr);
+	UIAttributes other;
+	EXPECT (UIViewFactory::isCreationPlanValid (*plan, other) == false);
+	a->setIntegerAttribute (viewAttr, 1);
+	EXPECT (UIViewFactory::isCreationPlanValid (*plan, *a) == false);
+	plan = factory->createCreationPlan (a, nullptr);
+	EXPECT (UIViewFactory::isCreationPlanValid (*plan, *a));
+	factory->unregisterViewCreator (viewCreator);
+	EXPECT (UIViewFactory::isCreationPlanValid (*plan, *a) == false);
+	factory->registerViewCreator (viewCreator);
+}
+
+TEST_CASE (UIViewFactoryTest, CreateUnknownViewFromPlan)
+{
+	auto& factory = TEST_SUITE_GET_STORAGE (SharedPointer<UIViewFactory>);
+
+	auto a = makeOwned<UIAttributes> ();
+	a->setAttribute (UIViewCreator::kAttrClass, "Unknown");
+	auto plan = factory->createCreationPlan (a, nullptr);
+	EXPECT (plan->creators.empty ());
+	EXPECT (factory->createView (*plan, nullptr) == nullptr);
+}
+
 } // VSTGUI
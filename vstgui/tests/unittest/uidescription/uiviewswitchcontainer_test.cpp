@@ -27,8 +27,11 @@ struct View3 : public CView
 
 struct TestUIDescription : public UIDescriptionAdapter
 {
+	mutable uint32_t numCreatedViews {0};
+
 	CView* createView (UTF8StringPtr name, IController* controller) const override
 	{
+		++numCreatedViews;
 		if (UTF8StringView (name) == "v1")
 			return new View1 ();
 		else if (UTF8StringView (name) == "v2")
@@ -115,4 +118,159 @@ TEST_CASE (UIDescriptionViewSwitchControllerTest, NoAnimation)
 	container->removed (rootView);
 }
 
+struct PrewarmTestViewSwitch : public UIViewSwitchContainer
+{
+	using UIViewSwitchContainer::UIViewSwitchContainer;
+	using UIViewSwitchContainer::prewarmNextView;
+};
+
+TEST_CASE (UIDescriptionViewSwitchControllerTest, NoViewCache)
+{
+	TestUIDescription uiDesc;
+	auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+	viewSwitch->setAnimationTime (0);
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+	controller->setTemplateNames ("v1,v2");
+	EXPECT (container->addView (viewSwitch));
+	container->attached (rootView);
+	viewSwitch->setCurrentViewIndex (0);
+	viewSwitch->setCurrentViewIndex (1);
+	viewSwitch->setCurrentViewIndex (0);
+	EXPECT_EQ (uiDesc.numCreatedViews, 3u);
+	EXPECT_EQ (viewSwitch->getNumCachedViews (), 0u);
+	container->removed (rootView);
+}
+
+TEST_CASE (UIDescriptionViewSwitchControllerTest, ViewCacheKeepLast)
+{
+	TestUIDescription uiDesc;
+	auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+	viewSwitch->setAnimationTime (0);
+	viewSwitch->setViewCachePolicy (UIViewSwitchContainer::ViewCachePolicy::keepLast (1));
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+	controller->setTemplateNames ("v1,v2,v3");
+	EXPECT (container->addView (viewSwitch));
+	container->attached (rootView);
+	viewSwitch->setCurrentViewIndex (0);
+	auto view1 = viewSwitch->getView (0);
+	viewSwitch->setCurrentViewIndex (1);
+	EXPECT_EQ (viewSwitch->getNumCachedViews (), 1u);
+	viewSwitch->setCurrentViewIndex (0);
+	EXPECT_EQ (viewSwitch->getView (0), view1);
+	EXPECT_EQ (uiDesc.numCreatedViews, 2u);
+	viewSwitch->setCurrentViewIndex (2);
+	// the view of index 1 was dropped for the view of index 0
+	viewSwitch->setCurrentViewIndex (1);
+	EXPECT_EQ (uiDesc.numCreatedViews, 4u);
+	EXPECT_EQ (viewSwitch->getNumCachedViews (), 1u);
+	container->removed (rootView);
+}
+
+TEST_CASE (UIDescriptionViewSwitchControllerTest, ViewCacheRestoresViewState)
+{
+	TestUIDescription uiDesc;
+	auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+	viewSwitch->setAnimationTime (0);
+	viewSwitch->setViewCachePolicy (UIViewSwitchContainer::ViewCachePolicy::keepAll ());
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+	controller->setTemplateNames ("v3,v1");
+	EXPECT (container->addView (viewSwitch));
+	container->attached (rootView);
+	viewSwitch->setCurrentViewIndex (0);
+	auto view = viewSwitch->getView (0);
+	// simulate a fade out animation
+	view->setAlphaValue (0.f);
+	view->setViewSize (CRect (50, 0, 150, 100));
+	viewSwitch->setCurrentViewIndex (1);
+	viewSwitch->setViewSize (CRect (0, 0, 200, 100));
+	viewSwitch->setCurrentViewIndex (0);
+	EXPECT_EQ (viewSwitch->getView (0), view);
+	EXPECT_EQ (view->getAlphaValue (), 1.f);
+	EXPECT_EQ (view->getViewSize (), CRect (0, 0, 200, 100));
+	container->removed (rootView);
+}
+
+TEST_CASE (UIDescriptionViewSwitchControllerTest, ViewCacheMemoryBounded)
+{
+	TestUIDescription uiDesc;
+	auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto viewSwitch = new UIViewSwitchContainer (CRect (0, 0, 100, 100));
+	viewSwitch->setAnimationTime (0);
+	auto view = owned (new CView (CRect ()));
+	auto viewMemory = UIViewSwitchContainer::estimateViewMemory (view);
+	EXPECT (viewMemory > 0u);
+	viewSwitch->setViewCachePolicy (
+		UIViewSwitchContainer::ViewCachePolicy::memoryBounded (viewMemory * 2));
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+	controller->setTemplateNames ("v1,v2,v3,v1");
+	EXPECT (container->addView (viewSwitch));
+	container->attached (rootView);
+	for (auto index = 0; index < 4; ++index)
+		viewSwitch->setCurrentViewIndex (index);
+	EXPECT_EQ (viewSwitch->getNumCachedViews (), 2u);
+	viewSwitch->setViewCachePolicy (UIViewSwitchContainer::ViewCachePolicy::keepLast (1));
+	EXPECT_EQ (viewSwitch->getNumCachedViews (), 1u);
+	controller->setTemplateNames ("v1");
+	EXPECT_EQ (viewSwitch->getNumCachedViews (), 0u);
+	container->removed (rootView);
+}
+
+TEST_CASE (UIDescriptionViewSwitchControllerTest, PrewarmViews)
+{
+	TestUIDescription uiDesc;
+	auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto viewSwitch = new PrewarmTestViewSwitch (CRect (0, 0, 100, 100));
+	viewSwitch->setAnimationTime (0);
+	viewSwitch->setViewCachePolicy (UIViewSwitchContainer::ViewCachePolicy::keepAll ());
+	viewSwitch->setPrewarmViews (true);
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+	controller->setTemplateNames ("v1,v2,v3");
+	EXPECT (container->addView (viewSwitch));
+	container->attached (rootView);
+	viewSwitch->setCurrentViewIndex (1);
+	for (auto i = 0; i < 5; ++i)
+		viewSwitch->prewarmNextView ();
+	EXPECT_EQ (viewSwitch->getNumCachedViews (), 2u);
+	EXPECT_EQ (uiDesc.numCreatedViews, 3u);
+	viewSwitch->setCurrentViewIndex (0);
+	EXPECT (dynamic_cast<View1*> (viewSwitch->getView (0)));
+	viewSwitch->setCurrentViewIndex (2);
+	EXPECT (dynamic_cast<View3*> (viewSwitch->getView (0)));
+	EXPECT_EQ (uiDesc.numCreatedViews, 3u);
+	container->removed (rootView);
+}
+
+TEST_CASE (UIDescriptionViewSwitchControllerTest, PrewarmSkipsFailedViews)
+{
+	TestUIDescription uiDesc;
+	auto rootView = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto container = owned (new CViewContainer (CRect (0, 0, 100, 100)));
+	auto viewSwitch = new PrewarmTestViewSwitch (CRect (0, 0, 100, 100));
+	viewSwitch->setAnimationTime (0);
+	viewSwitch->setViewCachePolicy (UIViewSwitchContainer::ViewCachePolicy::keepAll ());
+	viewSwitch->setPrewarmViews (true);
+	auto controller = new UIDescriptionViewSwitchController (viewSwitch, &uiDesc, nullptr);
+	controller->setTemplateNames ("v1,unknown,v3");
+	EXPECT (container->addView (viewSwitch));
+	container->attached (rootView);
+	viewSwitch->setCurrentViewIndex (0);
+	for (auto i = 0; i < 5; ++i)
+		viewSwitch->prewarmNextView ();
+	// the unknown template is tried once and the view after it is still created
+	EXPECT_EQ (uiDesc.numCreatedViews, 3u);
+	EXPECT_EQ (viewSwitch->getNumCachedViews (), 1u);
+	viewSwitch->setCurrentViewIndex (2);
+	EXPECT (dynamic_cast<View3*> (viewSwitch->getView (0)));
+	EXPECT_EQ (uiDesc.numCreatedViews, 3u);
+	container->removed (rootView);
+}
+
 } // VSTGUI
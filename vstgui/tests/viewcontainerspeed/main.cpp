@@ -0,0 +1,116 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "vstgui/lib/cframe.h"
+#include "vstgui/lib/finally.h"
+#include "vstgui/lib/vstguiinit.h"
+
+#include <chrono>
+#include <cstdio>
+#include <random>
+#include <string>
+#include <vector>
+
+//------------------------------------------------------------------------
+#if MAC
+#include <CoreFoundation/CoreFoundation.h>
+#elif WINDOWS
+struct IUnknown;
+#include <windows.h>
+#endif
+
+using namespace VSTGUI;
+
+//------------------------------------------------------------------------
+/** a step sequencer like page: a container per row with a control per column */
+static CViewContainer* makeMatrix (uint32_t rows, uint32_t columns, bool spatialIndex)
+{
+	auto page = new CViewContainer (CRect (0, 0, columns * 20., rows * 20.));
+	page->setSpatialIndexEnabled (spatialIndex);
+	for (auto y = 0u; y < rows; ++y)
+	{
+		auto row = new CViewContainer (CRect (0, y * 20., columns * 20., y * 20. + 20.));
+		row->setSpatialIndexEnabled (spatialIndex);
+		for (auto x = 0u; x < columns; ++x)
+			row->addView (new CView (CRect (x * 20. + 1., 1., x * 20. + 19., 19.)));
+		page->addView (row);
+	}
+	return page;
+}
+
+//------------------------------------------------------------------------
+static bool measureGetViewAt (uint32_t rows, uint32_t columns, uint32_t iterations)
+{
+	using namespace std::chrono;
+
+	auto frame = new CFrame (CRect (0, 0, columns * 20., rows * 20. * 2.), nullptr);
+	auto closeFrame = finally ([frame] () { frame->close (); });
+	auto linear = makeMatrix (rows, columns, false);
+	auto indexed = makeMatrix (rows, columns, true);
+	indexed->setViewSize (CRect (0, rows * 20., columns * 20., rows * 40.));
+	frame->addView (linear);
+	frame->addView (indexed);
+	frame->attached (frame);
+
+	std::mt19937 rng (rows * columns);
+	std::uniform_real_distribution<CCoord> xDist (0., columns * 20.);
+	std::uniform_real_distribution<CCoord> yDist (0., rows * 20.);
+	std::vector<CPoint> points;
+	for (auto i = 0u; i < iterations; ++i)
+		points.emplace_back (xDist (rng), yDist (rng));
+
+	auto options = GetViewOptions ().deep ().mouseEnabled ().includeViewContainer ();
+	auto measure = [&] (CViewContainer* container, CCoord offset, uint32_t& numHits) {
+		numHits = 0;
+		auto start = steady_clock::now ();
+		for (const auto& p : points)
+		{
+			auto view = container->getViewAt (CPoint (p.x, p.y + offset), options);
+			if (view && !view->asViewContainer ())
+				++numHits;
+		}
+		return static_cast<double> (
+				   duration_cast<nanoseconds> (steady_clock::now () - start).count ()) /
+			   iterations;
+	};
+	uint32_t linearHits = 0;
+	uint32_t indexedHits = 0;
+	auto linearTime = measure (linear, 0., linearHits);
+	auto indexedTime = measure (indexed, rows * 20., indexedHits);
+
+	printf ("%6u views  getViewAt linear %8.1f ns  indexed %8.1f ns\n", rows * columns,
+			linearTime, indexedTime);
+	if (linearHits != indexedHits || linearHits == 0)
+	{
+		printf ("The spatial index found other views\n");
+		return false;
+	}
+	return true;
+}
+
+//------------------------------------------------------------------------
+int main (int argc, char* argv[])
+{
+#if MAC
+	VSTGUI::init (CFBundleGetMainBundle ());
+#elif WINDOWS
+	VSTGUI::init (GetModuleHandle (nullptr));
+#else
+	VSTGUI::init (nullptr);
+#endif
+	auto cleanup = finally ([] () { VSTGUI::exit (); });
+
+	// usage: viewcontainerspeed [iterations]
+	uint32_t iterations = argc > 1 ? static_cast<uint32_t> (std::stoul (argv[1])) : 20000;
+	if (iterations == 0)
+		iterations = 1;
+
+	for (auto size : {std::make_pair (10u, 10u), std::make_pair (20u, 50u),
+					  std::make_pair (100u, 100u)})
+	{
+		if (!measureGetViewAt (size.first, size.second, iterations))
+			return -1;
+	}
+	return 0;
+}
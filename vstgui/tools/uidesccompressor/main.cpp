@@ -45,6 +45,7 @@ int main (int argv, char* argc[])
 	std::string inputPath;
 	std::string outputPath;
 	bool noCompression = false;
+	bool binary = false;
 	uint32_t compressionLevel = 1;
 	for (auto i = 0; i < argv; ++i)
 	{
@@ -71,13 +72,17 @@ int main (int argv, char* argc[])
 		{
 			noCompression = true;
 		}
+		else if (arg == "--binary")
+		{
+			binary = true;
+		}
 	}
 	if (inputPath.empty () || outputPath.empty ())
 	{
 		printAndTerminate ("No input or output path specified!");
 	}
-	printf ("Copy %s to %s%s\n", inputPath.data (), outputPath.data (),
-			noCompression ? " [uncompressed]" : "[compressed]");
+	printf ("Copy %s to %s%s%s\n", inputPath.data (), outputPath.data (),
+			noCompression ? " [uncompressed]" : "[compressed]", binary ? "[binary]" : "");
 
 	CompressedUIDescription uiDesc (CResourceDescription (inputPath.data ()));
 	if (!uiDesc.parse ())
@@ -85,6 +90,8 @@ int main (int argv, char* argc[])
 		printAndTerminate ("Parsing failed!");
 	}
 	int32_t flags = UIDescription::kWriteImagesIntoUIDescFile;
+	if (binary)
+		flags |= UIDescription::kWriteAsBinary;
 	if (noCompression)
 	{
 		if (inputPath == outputPath && uiDesc.getOriginalIsCompressed () == false)
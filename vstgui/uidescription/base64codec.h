@@ -5,13 +5,77 @@
 #pragma once
 
 #include "../lib/malloc.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define VSTGUI_BASE64_SSE 1
+#include <emmintrin.h>
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#endif
+#endif
+#if defined(__AVX2__)
+#define VSTGUI_BASE64_AVX2 1
+#include <immintrin.h>
+#endif
+#if defined(__ARM_NEON) && (defined(__aarch64__) || defined(_M_ARM64))
+#define VSTGUI_BASE64_NEON 1
+#include <arm_neon.h>
+#endif
 
 namespace VSTGUI {
 
 //-----------------------------------------------------------------------------
+/** Base64 encoder and decoder
+ *
+ *	The bulk of the data is processed with the vector instructions the compiler targets (SSE2,
+ *	SSSE3, AVX2 or NEON), blocks with characters outside of the base64 alphabet and the end of
+ *	the data are processed by the scalar code.
+ */
 class Base64Codec
 {
 public:
+	enum class Backend
+	{
+		kScalar,
+		kSSE,
+		kAVX2,
+		kNEON
+	};
+
+	/** the fastest backend available in this build */
+	static constexpr Backend bestBackend ()
+	{
+#if VSTGUI_BASE64_AVX2
+		return Backend::kAVX2;
+#elif VSTGUI_BASE64_NEON
+		return Backend::kNEON;
+#elif VSTGUI_BASE64_SSE
+		return Backend::kSSE;
+#else
+		return Backend::kScalar;
+#endif
+	}
+
+	static constexpr bool isAvailable (Backend backend)
+	{
+		switch (backend)
+		{
+			case Backend::kScalar: return true;
+#if VSTGUI_BASE64_SSE
+			case Backend::kSSE: return true;
+#endif
+#if VSTGUI_BASE64_AVX2
+			case Backend::kAVX2: return true;
+#endif
+#if VSTGUI_BASE64_NEON
+			case Backend::kNEON: return true;
+#endif
+			default: return false;
+		}
+	}
+
 	struct Result
 	{
 		Buffer<uint8_t> data;
@@ -19,63 +83,131 @@ public:
 	};
 
 	template<typename T>
-	static inline Result decode (const T& base64String)
+	static inline Result decode (const T& base64String, Backend backend = bestBackend ())
 	{
-		return decode (base64String.data (), base64String.size ());
+		return decode (base64String.data (), base64String.size (), backend);
 	}
 
 	template <typename T>
-	static inline Result decode (const T* inBuffer, size_t inBufferSize)
+	static inline Result decode (const T* inBuffer, size_t inBufferSize,
+								 Backend backend = bestBackend ())
 	{
 		static_assert (sizeof (T) == 1, "T must be one byte type");
 		Result r;
 		r.data.allocate ((inBufferSize * 3 / 4) + 3);
-		uint8_t input1[4];
-		uint8_t input2[4];
-		auto input1Ptr = reinterpret_cast<uint32_t*>(&input1[0]);
-		auto input2Ptr = reinterpret_cast<uint32_t*>(&input2[0]);
-		auto buffer32Ptr = reinterpret_cast<const uint32_t*> (inBuffer);
-		while (inBufferSize > 8)
-		{
-			*input1Ptr = *buffer32Ptr++;
-			*input2Ptr = *buffer32Ptr++;
-			r.dataSize += decodeblock<false> (input1, r.data.get () + r.dataSize);
-			r.dataSize += decodeblock<false> (input2, r.data.get () + r.dataSize);
-			inBufferSize -= 8;
-		}
-		while (inBufferSize > 4)
+		auto input = reinterpret_cast<const uint8_t*> (inBuffer);
+		auto tailSize = getTailSize (inBufferSize);
+		auto bodySize = inBufferSize - tailSize;
+		r.dataSize = static_cast<uint32_t> (decodeBody (input, bodySize, r.data.get (), backend));
+		r.dataSize += decodeTail (input + bodySize, tailSize, r.data.get () + r.dataSize);
+		return r;
+	}
+
+	//-----------------------------------------------------------------------------
+	/** Incremental decoder
+	 *
+	 *	Decodes directly into the buffers passed to read (), so that the decoded data can be
+	 *	streamed into a consumer without an intermediate buffer for the complete data.
+	 */
+	class Decoder
+	{
+	public:
+		template <typename T>
+		Decoder (const T* inBuffer, size_t inBufferSize, Backend backend = bestBackend ())
+		: input (reinterpret_cast<const uint8_t*> (inBuffer))
+		, tailSize (getTailSize (inBufferSize))
+		, bodySize (inBufferSize - tailSize)
+		, backend (backend)
 		{
-			*input1Ptr = *buffer32Ptr++;
-			r.dataSize += decodeblock<false> (input1, r.data.get () + r.dataSize);
-			inBufferSize -= 4;
+			static_assert (sizeof (T) == 1, "T must be one byte type");
 		}
-		if (inBufferSize > 0)
+
+		/** decode up to size bytes into buffer
+		 *
+		 *	@return the number of decoded bytes, zero at the end of the data
+		 */
+		size_t read (void* buffer, size_t size)
 		{
-			input1[0] = input1[1] = input1[2] = input1[3] = '=';
-			auto ptr = reinterpret_cast<const uint8_t*>(buffer32Ptr);
-			for (uint32_t j = 0; j < inBufferSize; j++)
+			auto output = static_cast<uint8_t*> (buffer);
+			size_t numRead = 0;
+			while (numRead < size)
 			{
-				input1[j] = *ptr++;
+				if (pendingPos < pendingSize)
+				{
+					auto n = std::min<size_t> (pendingSize - pendingPos, size - numRead);
+					std::memcpy (output + numRead, pending + pendingPos, n);
+					pendingPos += static_cast<uint32_t> (n);
+					numRead += n;
+				}
+				else if (bodySize > 0)
+				{
+					auto numGroups = std::min (bodySize / 4, (size - numRead) / 3);
+					if (numGroups == 0)
+					{
+						// not enough space left for a complete group
+						uint8_t group[4];
+						std::memcpy (group, input, 4);
+						decodeblock<false> (group, pending);
+						setPending (3);
+						input += 4;
+						bodySize -= 4;
+						continue;
+					}
+					numRead += decodeBody (input, numGroups * 4, output + numRead, backend);
+					input += numGroups * 4;
+					bodySize -= numGroups * 4;
+				}
+				else if (tailSize > 0)
+				{
+					setPending (decodeTail (input, tailSize, pending));
+					input += tailSize;
+					tailSize = 0;
+				}
+				else
+					break;
 			}
-			r.dataSize += decodeblock<true> (input1, r.data.get () + r.dataSize);
+			numDecoded += numRead;
+			return numRead;
+		}
+
+		/** the number of bytes decoded so far */
+		size_t getPosition () const { return numDecoded; }
+		bool atEnd () const { return bodySize == 0 && tailSize == 0 && pendingPos == pendingSize; }
+
+	private:
+		void setPending (uint32_t numBytes)
+		{
+			pendingSize = numBytes;
+			pendingPos = 0;
 		}
-		return r;
-	}
 
-	static inline Result encode (const void* binaryData, size_t binaryDataSize)
+		const uint8_t* input;
+		size_t tailSize;
+		size_t bodySize;
+		size_t numDecoded {0};
+		Backend backend;
+		uint8_t pending[3] {};
+		uint32_t pendingPos {0};
+		uint32_t pendingSize {0};
+	};
+
+	static inline Result encode (const void* binaryData, size_t binaryDataSize,
+								 Backend backend = bestBackend ())
 	{
 		Result r;
 		r.data.allocate ((binaryDataSize * 4) / 3 + 4);
 		auto ptr = reinterpret_cast<const uint8_t*> (binaryData);
+		auto output = r.data.get ();
+		size_t i = encodeBody (ptr, binaryDataSize, output, backend);
+		ptr += i;
+		output += (i / 3) * 4;
 		uint8_t input[3];
-		uint32_t i;
-		for (i = 0; i < (binaryDataSize - 3); i += 3)
+		for (; i + 3 <= binaryDataSize; i += 3, output += 4)
 		{
 			input[0] = *ptr++;
 			input[1] = *ptr++;
 			input[2] = *ptr++;
-			encodeblock (input, r.data.get () + r.dataSize, 3);
-			r.dataSize += 4;
+			encodeblock (input, output, 3);
 		}
 		if (i < binaryDataSize)
 		{
@@ -85,13 +217,336 @@ public:
 			{
 				input[j] = *ptr++;
 			}
-			encodeblock (input, r.data.get () + r.dataSize, j);
-			r.dataSize += 4;
+			encodeblock (input, output, j);
+			output += 4;
 		}
+		r.dataSize = static_cast<uint32_t> (output - r.data.get ());
 		return r;
 	}
 
 private:
+	/** the last group of the input is decoded separately, as it may be padded or incomplete */
+	static constexpr size_t getTailSize (size_t inBufferSize)
+	{
+		return inBufferSize == 0 ? 0 : ((inBufferSize - 1) % 4) + 1;
+	}
+
+	/** decode complete groups without padding, returns the number of decoded bytes */
+	static inline size_t decodeBody (const uint8_t* input, size_t inputSize, uint8_t* output,
+									 Backend backend)
+	{
+		auto start = output;
+		switch (backend)
+		{
+#if VSTGUI_BASE64_AVX2
+			case Backend::kAVX2:
+			{
+				while (inputSize >= 32 && decodeBlockAVX2 (input, output))
+				{
+					input += 32;
+					output += 24;
+					inputSize -= 32;
+				}
+				break;
+			}
+#endif
+#if VSTGUI_BASE64_NEON
+			case Backend::kNEON:
+			{
+				while (inputSize >= 64 && decodeBlockNEON (input, output))
+				{
+					input += 64;
+					output += 48;
+					inputSize -= 64;
+				}
+				break;
+			}
+#endif
+			default: break;
+		}
+#if VSTGUI_BASE64_SSE
+		if (backend != Backend::kScalar)
+		{
+			while (inputSize >= 16 && decodeBlockSSE (input, output))
+			{
+				input += 16;
+				output += 12;
+				inputSize -= 16;
+			}
+		}
+#endif
+		uint8_t group[4];
+		for (; inputSize >= 4; inputSize -= 4, input += 4, output += 3)
+		{
+			std::memcpy (group, input, 4);
+			decodeblock<false> (group, output);
+		}
+		return static_cast<size_t> (output - start);
+	}
+
+	static inline uint32_t decodeTail (const uint8_t* input, size_t inputSize, uint8_t output[3])
+	{
+		if (inputSize == 0)
+			return 0;
+		uint8_t group[4] = {'=', '=', '=', '='};
+		std::memcpy (group, input, std::min<size_t> (inputSize, 4));
+		return decodeblock<true> (group, output);
+	}
+
+	/** encode complete groups with the vector instructions, returns the number of encoded
+	 *	bytes */
+	static inline size_t encodeBody (const uint8_t* input, size_t inputSize, uint8_t* output,
+									 Backend backend)
+	{
+		size_t numEncoded = 0;
+		switch (backend)
+		{
+#if VSTGUI_BASE64_AVX2
+			case Backend::kAVX2:
+			{
+				// the block loads 28 bytes
+				for (; numEncoded + 28 <= inputSize; numEncoded += 24, output += 32)
+					encodeBlockAVX2 (input + numEncoded, output);
+				break;
+			}
+#endif
+#if VSTGUI_BASE64_NEON
+			case Backend::kNEON:
+			{
+				for (; numEncoded + 48 <= inputSize; numEncoded += 48, output += 64)
+					encodeBlockNEON (input + numEncoded, output);
+				break;
+			}
+#endif
+			default: break;
+		}
+#if VSTGUI_BASE64_SSE
+		if (backend != Backend::kScalar)
+		{
+			// the block loads 16 bytes
+			for (; numEncoded + 16 <= inputSize; numEncoded += 12, output += 16)
+				encodeBlockSSE (input + numEncoded, output);
+		}
+#endif
+		return numEncoded;
+	}
+
+#if VSTGUI_BASE64_SSE
+	/** decode 16 characters into 12 bytes, returns false if a character is not in the base64
+	 *	alphabet */
+	static inline bool decodeBlockSSE (const uint8_t* in, uint8_t* out)
+	{
+		auto input = _mm_loadu_si128 (reinterpret_cast<const __m128i*> (in));
+		auto inRange = [input] (char first, char last) {
+			return _mm_and_si128 (_mm_cmpgt_epi8 (input, _mm_set1_epi8 (first - 1)),
+								  _mm_cmplt_epi8 (input, _mm_set1_epi8 (last + 1)));
+		};
+		auto upper = inRange ('A', 'Z');
+		auto lower = inRange ('a', 'z');
+		auto digit = inRange ('0', '9');
+		auto plus = _mm_cmpeq_epi8 (input, _mm_set1_epi8 ('+'));
+		auto slash = _mm_cmpeq_epi8 (input, _mm_set1_epi8 ('/'));
+		auto valid = _mm_or_si128 (_mm_or_si128 (_mm_or_si128 (upper, lower), digit),
+								   _mm_or_si128 (plus, slash));
+		if (_mm_movemask_epi8 (valid) != 0xFFFF)
+			return false;
+		auto offset = _mm_or_si128 (
+			_mm_or_si128 (_mm_and_si128 (upper, _mm_set1_epi8 (-65)),
+						  _mm_and_si128 (lower, _mm_set1_epi8 (-71))),
+			_mm_or_si128 (_mm_and_si128 (digit, _mm_set1_epi8 (4)),
+						  _mm_or_si128 (_mm_and_si128 (plus, _mm_set1_epi8 (19)),
+										_mm_and_si128 (slash, _mm_set1_epi8 (16)))));
+		auto values = _mm_add_epi8 (input, offset);
+		// 2 x 6 bits -> 12 bits per 16 bit lane, 2 x 12 bits -> 24 bits per 32 bit lane
+		auto merged = _mm_or_si128 (
+			_mm_slli_epi16 (_mm_and_si128 (values, _mm_set1_epi16 (0x00FF)), 6),
+			_mm_srli_epi16 (values, 8));
+		merged = _mm_or_si128 (
+			_mm_slli_epi32 (_mm_and_si128 (merged, _mm_set1_epi32 (0xFFFF)), 12),
+			_mm_srli_epi32 (merged, 16));
+#if defined(__SSSE3__) || defined(__AVX__)
+		auto bytes = _mm_shuffle_epi8 (
+			merged, _mm_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+		_mm_storel_epi64 (reinterpret_cast<__m128i*> (out), bytes);
+		auto last = static_cast<uint32_t> (_mm_cvtsi128_si32 (_mm_srli_si128 (bytes, 8)));
+		std::memcpy (out + 8, &last, 4);
+#else
+		alignas (16) uint32_t lanes[4];
+		_mm_store_si128 (reinterpret_cast<__m128i*> (lanes), merged);
+		for (auto lane : lanes)
+		{
+			*out++ = static_cast<uint8_t> (lane >> 16);
+			*out++ = static_cast<uint8_t> (lane >> 8);
+			*out++ = static_cast<uint8_t> (lane);
+		}
+#endif
+		return true;
+	}
+
+	/** encode 12 bytes into 16 characters, reads 16 bytes */
+	static inline void encodeBlockSSE (const uint8_t* in, uint8_t* out)
+	{
+#if defined(__SSSE3__) || defined(__AVX__)
+		auto input = _mm_shuffle_epi8 (
+			_mm_loadu_si128 (reinterpret_cast<const __m128i*> (in)),
+			_mm_setr_epi8 (2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1));
+#else
+		auto group = [in] (int32_t i) {
+			return static_cast<int32_t> ((in[i * 3] << 16) | (in[i * 3 + 1] << 8) | in[i * 3 + 2]);
+		};
+		auto input = _mm_setr_epi32 (group (0), group (1), group (2), group (3));
+#endif
+		auto mask = _mm_set1_epi32 (0x3F);
+		auto indices = _mm_or_si128 (
+			_mm_or_si128 (_mm_and_si128 (_mm_srli_epi32 (input, 18), mask),
+						  _mm_slli_epi32 (_mm_and_si128 (_mm_srli_epi32 (input, 12), mask), 8)),
+			_mm_or_si128 (_mm_slli_epi32 (_mm_and_si128 (_mm_srli_epi32 (input, 6), mask), 16),
+						  _mm_slli_epi32 (_mm_and_si128 (input, mask), 24)));
+		auto select = [] (__m128i condition, __m128i a, __m128i b) {
+			return _mm_or_si128 (_mm_and_si128 (condition, a), _mm_andnot_si128 (condition, b));
+		};
+		auto offset = select (_mm_cmpeq_epi8 (indices, _mm_set1_epi8 (62)), _mm_set1_epi8 (-19),
+							  _mm_set1_epi8 (-16));
+		offset = select (_mm_cmplt_epi8 (indices, _mm_set1_epi8 (62)), _mm_set1_epi8 (-4), offset);
+		offset = select (_mm_cmplt_epi8 (indices, _mm_set1_epi8 (52)), _mm_set1_epi8 (71), offset);
+		offset = select (_mm_cmplt_epi8 (indices, _mm_set1_epi8 (26)), _mm_set1_epi8 (65), offset);
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (out), _mm_add_epi8 (indices, offset));
+	}
+#endif // VSTGUI_BASE64_SSE
+
+#if VSTGUI_BASE64_AVX2
+	/** decode 32 characters into 24 bytes, returns false if a character is not in the base64
+	 *	alphabet */
+	static inline bool decodeBlockAVX2 (const uint8_t* in, uint8_t* out)
+	{
+		auto input = _mm256_loadu_si256 (reinterpret_cast<const __m256i*> (in));
+		auto inRange = [input] (char first, char last) {
+			return _mm256_and_si256 (_mm256_cmpgt_epi8 (input, _mm256_set1_epi8 (first - 1)),
+									 _mm256_cmpgt_epi8 (_mm256_set1_epi8 (last + 1), input));
+		};
+		auto upper = inRange ('A', 'Z');
+		auto lower = inRange ('a', 'z');
+		auto digit = inRange ('0', '9');
+		auto plus = _mm256_cmpeq_epi8 (input, _mm256_set1_epi8 ('+'));
+		auto slash = _mm256_cmpeq_epi8 (input, _mm256_set1_epi8 ('/'));
+		auto valid = _mm256_or_si256 (_mm256_or_si256 (_mm256_or_si256 (upper, lower), digit),
+									  _mm256_or_si256 (plus, slash));
+		if (static_cast<uint32_t> (_mm256_movemask_epi8 (valid)) != 0xFFFFFFFFu)
+			return false;
+		auto offset = _mm256_or_si256 (
+			_mm256_or_si256 (_mm256_and_si256 (upper, _mm256_set1_epi8 (-65)),
+							 _mm256_and_si256 (lower, _mm256_set1_epi8 (-71))),
+			_mm256_or_si256 (_mm256_and_si256 (digit, _mm256_set1_epi8 (4)),
+							 _mm256_or_si256 (_mm256_and_si256 (plus, _mm256_set1_epi8 (19)),
+											  _mm256_and_si256 (slash, _mm256_set1_epi8 (16)))));
+		auto values = _mm256_add_epi8 (input, offset);
+		auto merged = _mm256_maddubs_epi16 (values, _mm256_set1_epi32 (0x01400140));
+		merged = _mm256_madd_epi16 (merged, _mm256_set1_epi32 (0x00011000));
+		auto bytes = _mm256_shuffle_epi8 (
+			merged, _mm256_setr_epi8 (2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1, 2, 1,
+									  0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+		bytes = _mm256_permutevar8x32_epi32 (bytes, _mm256_setr_epi32 (0, 1, 2, 4, 5, 6, 3, 7));
+		_mm_storeu_si128 (reinterpret_cast<__m128i*> (out), _mm256_castsi256_si128 (bytes));
+		_mm_storel_epi64 (reinterpret_cast<__m128i*> (out + 16),
+						  _mm256_extracti128_si256 (bytes, 1));
+		return true;
+	}
+
+	/** encode 24 bytes into 32 characters, reads 28 bytes */
+	static inline void encodeBlockAVX2 (const uint8_t* in, uint8_t* out)
+	{
+		auto input = _mm256_inserti128_si256 (
+			_mm256_castsi128_si256 (_mm_loadu_si128 (reinterpret_cast<const __m128i*> (in))),
+			_mm_loadu_si128 (reinterpret_cast<const __m128i*> (in + 12)), 1);
+		input = _mm256_shuffle_epi8 (
+			input, _mm256_setr_epi8 (2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1, 2, 1, 0,
+									 -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1));
+		auto mask = _mm256_set1_epi32 (0x3F);
+		auto indices = _mm256_or_si256 (
+			_mm256_or_si256 (
+				_mm256_and_si256 (_mm256_srli_epi32 (input, 18), mask),
+				_mm256_slli_epi32 (_mm256_and_si256 (_mm256_srli_epi32 (input, 12), mask), 8)),
+			_mm256_or_si256 (
+				_mm256_slli_epi32 (_mm256_and_si256 (_mm256_srli_epi32 (input, 6), mask), 16),
+				_mm256_slli_epi32 (_mm256_and_si256 (input, mask), 24)));
+		auto offset =
+			_mm256_blendv_epi8 (_mm256_set1_epi8 (-16), _mm256_set1_epi8 (-19),
+								_mm256_cmpeq_epi8 (indices, _mm256_set1_epi8 (62)));
+		offset = _mm256_blendv_epi8 (offset, _mm256_set1_epi8 (-4),
+									 _mm256_cmpgt_epi8 (_mm256_set1_epi8 (62), indices));
+		offset = _mm256_blendv_epi8 (offset, _mm256_set1_epi8 (71),
+									 _mm256_cmpgt_epi8 (_mm256_set1_epi8 (52), indices));
+		offset = _mm256_blendv_epi8 (offset, _mm256_set1_epi8 (65),
+									 _mm256_cmpgt_epi8 (_mm256_set1_epi8 (26), indices));
+		_mm256_storeu_si256 (reinterpret_cast<__m256i*> (out), _mm256_add_epi8 (indices, offset));
+	}
+#endif // VSTGUI_BASE64_AVX2
+
+#if VSTGUI_BASE64_NEON
+	/** decode 64 characters into 48 bytes, returns false if a character is not in the base64
+	 *	alphabet */
+	static inline bool decodeBlockNEON (const uint8_t* in, uint8_t* out)
+	{
+		auto input = vld4q_u8 (in);
+		auto invalid = vdupq_n_u8 (0);
+		auto translate = [&invalid] (uint8x16_t c) {
+			auto inRange = [c] (uint8_t first, uint8_t last) {
+				return vandq_u8 (vcgeq_u8 (c, vdupq_n_u8 (first)), vcleq_u8 (c, vdupq_n_u8 (last)));
+			};
+			auto upper = inRange ('A', 'Z');
+			auto lower = inRange ('a', 'z');
+			auto digit = inRange ('0', '9');
+			auto plus = vceqq_u8 (c, vdupq_n_u8 ('+'));
+			auto slash = vceqq_u8 (c, vdupq_n_u8 ('/'));
+			auto valid = vorrq_u8 (vorrq_u8 (vorrq_u8 (upper, lower), digit), vorrq_u8 (plus, slash));
+			invalid = vorrq_u8 (invalid, vmvnq_u8 (valid));
+			auto offset = vorrq_u8 (
+				vorrq_u8 (vandq_u8 (upper, vdupq_n_u8 (static_cast<uint8_t> (-65))),
+						  vandq_u8 (lower, vdupq_n_u8 (static_cast<uint8_t> (-71)))),
+				vorrq_u8 (vandq_u8 (digit, vdupq_n_u8 (4)),
+						  vorrq_u8 (vandq_u8 (plus, vdupq_n_u8 (19)),
+									vandq_u8 (slash, vdupq_n_u8 (16)))));
+			return vaddq_u8 (c, offset);
+		};
+		auto a = translate (input.val[0]);
+		auto b = translate (input.val[1]);
+		auto c = translate (input.val[2]);
+		auto d = translate (input.val[3]);
+		if (vmaxvq_u8 (invalid) != 0)
+			return false;
+		uint8x16x3_t output;
+		output.val[0] = vorrq_u8 (vshlq_n_u8 (a, 2), vshrq_n_u8 (b, 4));
+		output.val[1] = vorrq_u8 (vshlq_n_u8 (b, 4), vshrq_n_u8 (c, 2));
+		output.val[2] = vorrq_u8 (vshlq_n_u8 (c, 6), d);
+		vst3q_u8 (out, output);
+		return true;
+	}
+
+	/** encode 48 bytes into 64 characters */
+	static inline void encodeBlockNEON (const uint8_t* in, uint8_t* out)
+	{
+		static constexpr uint8_t alphabet[] =
+			"ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		uint8x16x4_t table;
+		table.val[0] = vld1q_u8 (alphabet);
+		table.val[1] = vld1q_u8 (alphabet + 16);
+		table.val[2] = vld1q_u8 (alphabet + 32);
+		table.val[3] = vld1q_u8 (alphabet + 48);
+		auto input = vld3q_u8 (in);
+		auto mask = vdupq_n_u8 (0x3F);
+		uint8x16x4_t output;
+		output.val[0] = vqtbl4q_u8 (table, vshrq_n_u8 (input.val[0], 2));
+		output.val[1] = vqtbl4q_u8 (
+			table, vandq_u8 (vorrq_u8 (vshlq_n_u8 (input.val[0], 4), vshrq_n_u8 (input.val[1], 4)),
+							 mask));
+		output.val[2] = vqtbl4q_u8 (
+			table, vandq_u8 (vorrq_u8 (vshlq_n_u8 (input.val[1], 2), vshrq_n_u8 (input.val[2], 6)),
+							 mask));
+		output.val[3] = vqtbl4q_u8 (table, vandq_u8 (input.val[2], mask));
+		vst4q_u8 (out, output);
+	}
+#endif // VSTGUI_BASE64_NEON
+
 	template<bool finalBlock = true>
 	static inline uint32_t decodeblock (uint8_t input[4], uint8_t output[3])
 	{
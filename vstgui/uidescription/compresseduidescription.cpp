@@ -202,7 +202,8 @@ bool CompressedUIDescription::save (UTF8StringPtr filename, int32_t flags,
 		                        CFileStream::kWriteMode | CFileStream::kTruncateMode,
 		                        kLittleEndianByteOrder))
 		{
-			result = saveToStream (xmlFileStream, flags, func);
+			// the backup is meant to be edited, so it is never written in the binary format
+			result = saveToStream (xmlFileStream, flags & ~kWriteAsBinary, func);
 		}
 	}
 	return result;
@@ -110,6 +110,7 @@ public:
 	void rewind () override { pos = 0; }
 
 	const int8_t* getBuffer () const { return buffer; }
+	uint32_t getSize () const { return size; }
 
 	bool operator<< (const std::string& str) override;
 	bool operator>> (std::string& string) override;
@@ -0,0 +1,540 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "uibinarypersistence.h"
+#include "../uiattributes.h"
+#include "../uicontentprovider.h"
+#include <array>
+#include <cstring>
+#include <map>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+namespace UIBinaryDesc {
+
+/*
+	Layout (all numbers are uint32_t little endian):
+
+	magic[8] version numStrings stringDataSize numNodes
+	numStrings * (offset length)
+	stringDataSize bytes of string data
+	numNodes * (kind name data numAttributes numChildren
+				numAttributes * (key value valueType [typed value]))
+
+	name, data, key and value are indices into the string table, the nodes are in pre-order.
+	When valueType is not String, the value string is followed by its parsed form, so that it
+	does not need to be parsed again when the views are created: Boolean and Integer as one
+	number, Double as one, Point as two and Rect as four doubles (each as two numbers, low part
+	first) and Color as one number with red in the lowest byte.
+*/
+
+static constexpr std::array<char, 8> kMagic = {'V', 'S', 'T', 'G', 'U', 'I', 'B', 'D'};
+static constexpr uint32_t kVersion = 2;
+/** version 1 stored all values as strings only */
+static constexpr uint32_t kMinVersion = 1;
+static constexpr uint32_t kNoString = 0xFFFFFFFF;
+static constexpr uint32_t kMaxNodeDepth = 512;
+
+//------------------------------------------------------------------------
+enum class NodeKind : uint32_t
+{
+	Node,
+	Comment,
+	Bitmap,
+	Font,
+	Color,
+	ControlTag,
+	Variable,
+	Gradient,
+};
+
+//------------------------------------------------------------------------
+enum class ValueType : uint32_t
+{
+	String,
+	Boolean,
+	Integer,
+	Double,
+	Point,
+	Rect,
+	Color,
+};
+
+using ParsedValue = UIAttributes::ParsedValue;
+
+//------------------------------------------------------------------------
+static ValueType toValueType (ParsedValue::Type type)
+{
+	switch (type)
+	{
+		case ParsedValue::Type::kBoolean: return ValueType::Boolean;
+		case ParsedValue::Type::kInteger: return ValueType::Integer;
+		case ParsedValue::Type::kDouble: return ValueType::Double;
+		case ParsedValue::Type::kPoint: return ValueType::Point;
+		case ParsedValue::Type::kRect: return ValueType::Rect;
+		case ParsedValue::Type::kColor: return ValueType::Color;
+	}
+	return ValueType::String;
+}
+
+//------------------------------------------------------------------------
+/** the first type, which the value can be parsed as */
+static ValueType parseValueType (UIAttributes& attributes, const std::string& name)
+{
+	static constexpr std::array<ParsedValue::Type, 6> kTypes = {
+		ParsedValue::Type::kColor,	 ParsedValue::Type::kRect,	  ParsedValue::Type::kPoint,
+		ParsedValue::Type::kInteger, ParsedValue::Type::kDouble, ParsedValue::Type::kBoolean};
+	for (auto type : kTypes)
+	{
+		if (attributes.parseAttribute (name, type))
+			return toValueType (type);
+	}
+	return ValueType::String;
+}
+
+//------------------------------------------------------------------------
+static NodeKind getNodeKind (UINode* node)
+{
+	if (dynamic_cast<UICommentNode*> (node))
+		return NodeKind::Comment;
+	if (dynamic_cast<UIBitmapNode*> (node))
+		return NodeKind::Bitmap;
+	if (dynamic_cast<UIFontNode*> (node))
+		return NodeKind::Font;
+	if (dynamic_cast<UIColorNode*> (node))
+		return NodeKind::Color;
+	if (dynamic_cast<UIControlTagNode*> (node))
+		return NodeKind::ControlTag;
+	if (dynamic_cast<UIVariableNode*> (node))
+		return NodeKind::Variable;
+	if (dynamic_cast<UIGradientNode*> (node))
+		return NodeKind::Gradient;
+	return NodeKind::Node;
+}
+
+//------------------------------------------------------------------------
+struct Writer
+{
+	uint32_t intern (std::string_view str)
+	{
+		auto it = stringIndices.find (str);
+		if (it != stringIndices.end ())
+			return it->second;
+		auto index = static_cast<uint32_t> (strings.size ());
+		stringIndices.emplace (str, index);
+		strings.emplace_back (str);
+		return index;
+	}
+
+	static void put (std::vector<uint8_t>& buffer, uint32_t value)
+	{
+		for (auto i = 0u; i < 4u; ++i)
+			buffer.emplace_back (static_cast<uint8_t> (value >> (i * 8u)));
+	}
+
+	static void putDouble (std::vector<uint8_t>& buffer, double value)
+	{
+		uint64_t bits;
+		std::memcpy (&bits, &value, sizeof (bits));
+		put (buffer, static_cast<uint32_t> (bits));
+		put (buffer, static_cast<uint32_t> (bits >> 32));
+	}
+
+	void writeValue (ValueType type, const ParsedValue& value)
+	{
+		put (nodeData, static_cast<uint32_t> (type));
+		switch (type)
+		{
+			case ValueType::String:
+				break;
+			case ValueType::Boolean:
+			case ValueType::Integer:
+				put (nodeData, static_cast<uint32_t> (static_cast<int32_t> (value.values[0])));
+				break;
+			case ValueType::Double:
+				putDouble (nodeData, value.values[0]);
+				break;
+			case ValueType::Point:
+				putDouble (nodeData, value.values[0]);
+				putDouble (nodeData, value.values[1]);
+				break;
+			case ValueType::Rect:
+				for (auto v : value.values)
+					putDouble (nodeData, v);
+				break;
+			case ValueType::Color:
+			{
+				uint32_t rgba = 0;
+				for (auto i = 0u; i < 4u; ++i)
+					rgba |= static_cast<uint32_t> (value.values[i]) << (i * 8u);
+				put (nodeData, rgba);
+				break;
+			}
+		}
+	}
+
+	void writeNode (UINode* node)
+	{
+		++numNodes;
+		auto kind = getNodeKind (node);
+		put (nodeData, static_cast<uint32_t> (kind));
+		put (nodeData, intern (node->getName ()));
+		put (nodeData, node->getData ().empty () ? kNoString : intern (node->getData ()));
+		// sorted, so that compiling the same description always results in the same file
+		std::map<std::string_view, std::string_view> attributes (node->getAttributes ()->begin (),
+																 node->getAttributes ()->end ());
+		auto numAttributes = static_cast<uint32_t> (attributes.size ());
+		uint32_t numChildren = 0;
+		for (auto& child : node->getChildren ())
+		{
+			if (!child->noExport ())
+				++numChildren;
+		}
+		put (nodeData, numAttributes);
+		put (nodeData, numChildren);
+		// parsed on a copy, so that the description is not modified
+		UIAttributes typedAttributes (*node->getAttributes ());
+		for (const auto& attr : attributes)
+		{
+			put (nodeData, intern (attr.first));
+			put (nodeData, intern (attr.second));
+			std::string name (attr.first);
+			auto type = parseValueType (typedAttributes, name);
+			auto parsed = typedAttributes.getParsedValue (name);
+			writeValue (type, parsed ? *parsed : ParsedValue ());
+		}
+		for (auto& child : node->getChildren ())
+		{
+			if (!child->noExport ())
+				writeNode (child);
+		}
+	}
+
+	bool write (OutputStream& stream, UINode* rootNode)
+	{
+		writeNode (rootNode);
+
+		std::vector<uint8_t> header;
+		header.insert (header.end (), kMagic.begin (), kMagic.end ());
+		put (header, kVersion);
+		put (header, static_cast<uint32_t> (strings.size ()));
+		size_t stringDataSize = 0;
+		for (auto str : strings)
+			stringDataSize += str.size ();
+		if (stringDataSize > kNoString)
+			return false;
+		put (header, static_cast<uint32_t> (stringDataSize));
+		put (header, numNodes);
+		uint32_t offset = 0;
+		for (auto str : strings)
+		{
+			put (header, offset);
+			put (header, static_cast<uint32_t> (str.size ()));
+			offset += static_cast<uint32_t> (str.size ());
+		}
+		auto writeRaw = [&] (const void* data, size_t size) {
+			return size == 0 ||
+				   stream.writeRaw (data, static_cast<uint32_t> (size)) == static_cast<uint32_t> (size);
+		};
+		if (!writeRaw (header.data (), header.size ()))
+			return false;
+		for (auto str : strings)
+		{
+			if (!writeRaw (str.data (), str.size ()))
+				return false;
+		}
+		return writeRaw (nodeData.data (), nodeData.size ());
+	}
+
+	std::unordered_map<std::string_view, uint32_t> stringIndices;
+	std::vector<std::string_view> strings;
+	std::vector<uint8_t> nodeData;
+	uint32_t numNodes {0};
+};
+
+//------------------------------------------------------------------------
+struct Reader
+{
+	Reader (const uint8_t* data, size_t size) : data (data), size (size) {}
+
+	bool get (uint32_t& value)
+	{
+		if (size - pos < 4)
+			return false;
+		value = static_cast<uint32_t> (data[pos]) | (static_cast<uint32_t> (data[pos + 1]) << 8) |
+				(static_cast<uint32_t> (data[pos + 2]) << 16) |
+				(static_cast<uint32_t> (data[pos + 3]) << 24);
+		pos += 4;
+		return true;
+	}
+
+	bool getDouble (double& value)
+	{
+		uint32_t low, high;
+		if (!get (low) || !get (high))
+			return false;
+		auto bits = static_cast<uint64_t> (low) | (static_cast<uint64_t> (high) << 32);
+		std::memcpy (&value, &bits, sizeof (value));
+		return true;
+	}
+
+	bool getValue (ValueType& type, ParsedValue& value)
+	{
+		uint32_t typeValue;
+		if (!get (typeValue))
+			return false;
+		type = static_cast<ValueType> (typeValue);
+		switch (type)
+		{
+			case ValueType::String:
+				return true;
+			case ValueType::Boolean:
+			case ValueType::Integer:
+			{
+				uint32_t v;
+				if (!get (v))
+					return false;
+				value.type = type == ValueType::Boolean ? ParsedValue::Type::kBoolean
+														: ParsedValue::Type::kInteger;
+				value.values[0] = static_cast<int32_t> (v);
+				return true;
+			}
+			case ValueType::Double:
+				value.type = ParsedValue::Type::kDouble;
+				return getDouble (value.values[0]);
+			case ValueType::Point:
+				value.type = ParsedValue::Type::kPoint;
+				return getDouble (value.values[0]) && getDouble (value.values[1]);
+			case ValueType::Rect:
+				value.type = ParsedValue::Type::kRect;
+				return getDouble (value.values[0]) && getDouble (value.values[1]) &&
+					   getDouble (value.values[2]) && getDouble (value.values[3]);
+			case ValueType::Color:
+			{
+				uint32_t rgba;
+				if (!get (rgba))
+					return false;
+				value.type = ParsedValue::Type::kColor;
+				for (auto i = 0u; i < 4u; ++i)
+					value.values[i] = static_cast<uint8_t> (rgba >> (i * 8u));
+				return true;
+			}
+		}
+		return false;
+	}
+
+	bool getString (std::string_view& str)
+	{
+		uint32_t index;
+		if (!get (index) || index >= strings.size ())
+			return false;
+		str = strings[index];
+		return true;
+	}
+
+	bool readHeader ()
+	{
+		if (size < kMagic.size () || std::memcmp (data, kMagic.data (), kMagic.size ()) != 0)
+			return false;
+		pos = kMagic.size ();
+		uint32_t numStrings, stringDataSize;
+		if (!get (version) || version < kMinVersion || version > kVersion || !get (numStrings) ||
+			!get (stringDataSize) || !get (numNodes))
+			return false;
+		if (numStrings > (size - pos) / 8)
+			return false;
+		auto stringData = pos + static_cast<size_t> (numStrings) * 8;
+		if (stringDataSize > size - stringData)
+			return false;
+		strings.reserve (numStrings);
+		for (auto i = 0u; i < numStrings; ++i)
+		{
+			uint32_t offset, length;
+			get (offset);
+			get (length);
+			if (offset > stringDataSize || length > stringDataSize - offset)
+				return false;
+			strings.emplace_back (reinterpret_cast<const char*> (data + stringData + offset), length);
+		}
+		pos = stringData + stringDataSize;
+		return true;
+	}
+
+	UINode* readNode (uint32_t depth)
+	{
+		if (depth > kMaxNodeDepth || numNodes == 0)
+			return nullptr;
+		--numNodes;
+		uint32_t kindValue, dataIndex, numAttributes, numChildren;
+		std::string_view name;
+		if (!get (kindValue) || !getString (name) || !get (dataIndex) || !get (numAttributes) ||
+			!get (numChildren))
+			return nullptr;
+		if (dataIndex != kNoString && dataIndex >= strings.size ())
+			return nullptr;
+		auto hasValueTypes = version >= 2;
+		if (numAttributes > (size - pos) / (hasValueTypes ? 12 : 8))
+			return nullptr;
+		auto attributes = makeOwned<UIAttributes> (numAttributes);
+		for (auto i = 0u; i < numAttributes; ++i)
+		{
+			std::string_view key, value;
+			ValueType type = ValueType::String;
+			ParsedValue parsed;
+			if (!getString (key) || !getString (value) ||
+				(hasValueTypes && !getValue (type, parsed)))
+				return nullptr;
+			std::string name (key);
+			attributes->setAttribute (name, std::string (value));
+			if (type != ValueType::String)
+				attributes->setParsedValue (name, parsed);
+		}
+		std::string nodeName (name);
+		UINode* node = nullptr;
+		switch (static_cast<NodeKind> (kindValue))
+		{
+			case NodeKind::Node:
+			{
+				// the same main nodes as in the text formats need the fast name lookup
+				auto needsFastChildNameAttributeLookup =
+					depth == 1 && (nodeName == MainNodeNames::kBitmap ||
+								   nodeName == MainNodeNames::kColor ||
+								   nodeName == MainNodeNames::kControlTag);
+				node = new UINode (nodeName, attributes, needsFastChildNameAttributeLookup);
+				break;
+			}
+			case NodeKind::Comment:
+				node = new UICommentNode ({});
+				break;
+			case NodeKind::Bitmap:
+				node = new UIBitmapNode (nodeName, attributes);
+				break;
+			case NodeKind::Font:
+				node = new UIFontNode (nodeName, attributes);
+				break;
+			case NodeKind::Color:
+				node = new UIColorNode (nodeName, attributes);
+				break;
+			case NodeKind::ControlTag:
+				node = new UIControlTagNode (nodeName, attributes);
+				break;
+			case NodeKind::Variable:
+				node = new UIVariableNode (nodeName, attributes);
+				break;
+			case NodeKind::Gradient:
+				node = new UIGradientNode (nodeName, attributes);
+				break;
+			default:
+				return nullptr;
+		}
+		if (dataIndex != kNoString)
+			node->getData ().assign (strings[dataIndex].data (), strings[dataIndex].size ());
+		for (auto i = 0u; i < numChildren; ++i)
+		{
+			auto child = readNode (depth + 1);
+			if (!child)
+			{
+				node->forget ();
+				return nullptr;
+			}
+			node->getChildren ().add (child);
+		}
+		return node;
+	}
+
+	const uint8_t* data;
+	size_t size;
+	size_t pos {0};
+	uint32_t version {0};
+	uint32_t numNodes {0};
+	std::vector<std::string_view> strings;
+};
+
+//------------------------------------------------------------------------
+} // UIBinaryDesc
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescReader {
+
+//------------------------------------------------------------------------
+bool isBinaryDesc (const void* data, size_t dataSize)
+{
+	return dataSize >= UIBinaryDesc::kMagic.size () &&
+		   std::memcmp (data, UIBinaryDesc::kMagic.data (), UIBinaryDesc::kMagic.size ()) == 0;
+}
+
+//------------------------------------------------------------------------
+SharedPointer<UINode> read (const void* data, size_t dataSize)
+{
+	UIBinaryDesc::Reader reader (static_cast<const uint8_t*> (data), dataSize);
+	if (!reader.readHeader ())
+		return nullptr;
+	if (auto rootNode = reader.readNode (0))
+		return owned (rootNode);
+	return nullptr;
+}
+
+//------------------------------------------------------------------------
+SharedPointer<UINode> read (IContentProvider& contentProvider)
+{
+	// a memory content provider is read in place, this way a memory mapped file is not copied
+	if (auto memoryProvider = dynamic_cast<MemoryContentProvider*> (&contentProvider))
+	{
+		auto pos = static_cast<uint32_t> (memoryProvider->tell ());
+		auto buffer = memoryProvider->getBuffer () + pos;
+		auto bufferSize = memoryProvider->getSize () - pos;
+		if (!isBinaryDesc (buffer, bufferSize))
+			return nullptr;
+		return read (buffer, bufferSize);
+	}
+
+	std::vector<uint8_t> buffer (UIBinaryDesc::kMagic.size ());
+	auto numRead = contentProvider.readRawData (reinterpret_cast<int8_t*> (buffer.data ()),
+												static_cast<uint32_t> (buffer.size ()));
+	if (numRead != buffer.size () || !isBinaryDesc (buffer.data (), buffer.size ()))
+	{
+		contentProvider.rewind ();
+		return nullptr;
+	}
+	constexpr uint32_t kChunkSize = 64 * 1024;
+	while (true)
+	{
+		auto offset = buffer.size ();
+		buffer.resize (offset + kChunkSize);
+		numRead =
+			contentProvider.readRawData (reinterpret_cast<int8_t*> (buffer.data () + offset), kChunkSize);
+		if (numRead == kStreamIOError)
+			numRead = 0;
+		buffer.resize (offset + numRead);
+		if (numRead < kChunkSize)
+			break;
+	}
+	return read (buffer.data (), buffer.size ());
+}
+
+//------------------------------------------------------------------------
+} // UIBinaryDescReader
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescWriter {
+
+//------------------------------------------------------------------------
+bool write (OutputStream& stream, UINode* rootNode)
+{
+	UIBinaryDesc::Writer writer;
+	return writer.write (stream, rootNode);
+}
+
+//------------------------------------------------------------------------
+} // UIBinaryDescWriter
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -0,0 +1,49 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../cstream.h"
+#include "../icontentprovider.h"
+#include "uinode.h"
+
+//------------------------------------------------------------------------
+namespace VSTGUI {
+namespace Detail {
+
+//------------------------------------------------------------------------
+/** Binary UIDescription format
+ *
+ *	All names and values are interned in one string table and the nodes are stored in pre-order
+ *	with fixed size little endian records referencing the table. Reading it does not need any
+ *	tokenizing or unescaping.
+ *
+ *	Only a MemoryContentProvider is read in place, e.g. one that points to a file the caller has
+ *	mapped into memory. VSTGUI does not map files itself: when UIDescription loads a resource or a
+ *	file path, the content is read into a buffer first. In either case the names and values are
+ *	copied out of the string table into the UINode attributes, so the data does not need to stay
+ *	valid after reading.
+ */
+namespace UIBinaryDescReader {
+
+//------------------------------------------------------------------------
+bool isBinaryDesc (const void* data, size_t dataSize);
+SharedPointer<UINode> read (const void* data, size_t dataSize);
+SharedPointer<UINode> read (IContentProvider& contentProvider);
+
+//------------------------------------------------------------------------
+} // UIBinaryDescReader
+
+//------------------------------------------------------------------------
+namespace UIBinaryDescWriter {
+
+//------------------------------------------------------------------------
+bool write (OutputStream& stream, UINode* rootNode);
+
+//------------------------------------------------------------------------
+} // UIBinaryDescWriter
+
+//------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
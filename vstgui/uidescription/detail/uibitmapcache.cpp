@@ -0,0 +1,469 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "uibitmapcache.h"
+#include "../../lib/cpoint.h"
+#include "../../lib/platform/platformfactory.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#if WINDOWS
+#include <windows.h>
+#else
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+#if LINUX
+#include "../../lib/platform/linux/linuxfactory.h"
+#endif
+
+namespace VSTGUI {
+namespace Detail {
+namespace BitmapDiskCacheFile {
+
+static constexpr uint32_t kMagic = 'V' | ('G' << 8) | ('B' << 16) | ('C' << 24);
+static constexpr uint32_t kVersion = 1;
+static constexpr uint32_t kMaxDimension = 32768;
+static constexpr const char* kExtension = ".vgbc";
+
+//-----------------------------------------------------------------------------
+/** the header of an entry, followed by the rows of the bitmap. Its size keeps the pixels aligned
+ *	when the file is mapped into memory. */
+struct Header
+{
+	uint32_t magic;
+	uint32_t version;
+	uint64_t dataHash;
+	uint64_t filterHash;
+	uint64_t dataSize;
+	uint32_t width;
+	uint32_t height;
+	uint32_t bytesPerRow;
+	uint32_t pixelFormat;
+	double scaleFactor;
+	uint64_t headerHash;
+
+	uint64_t calcHash () const { return BitmapDiskCache::hash (this, offsetof (Header, headerHash)); }
+	uint64_t getFileSize () const { return sizeof (Header) + uint64_t (bytesPerRow) * height; }
+
+	bool isValid (const BitmapDiskCache::Key& key, uint64_t fileSize) const
+	{
+		return magic == kMagic && version == kVersion && dataHash == key.dataHash &&
+			   filterHash == key.filterHash && dataSize == key.dataSize && width > 0 &&
+			   height > 0 && width <= kMaxDimension && height <= kMaxDimension &&
+			   bytesPerRow == width * 4 && scaleFactor > 0. && headerHash == calcHash () &&
+			   getFileSize () == fileSize;
+	}
+};
+static_assert (sizeof (Header) == 64, "unexpected header size");
+
+//-----------------------------------------------------------------------------
+struct EntryInfo
+{
+	std::string path;
+	uint64_t size;
+	/** the modification time in the finest resolution of the platform */
+	uint64_t time;
+};
+
+//-----------------------------------------------------------------------------
+static bool hasExtension (const char* name)
+{
+	auto nameLength = strlen (name);
+	auto extLength = strlen (kExtension);
+	return nameLength > extLength && strcmp (name + nameLength - extLength, kExtension) == 0;
+}
+
+#if WINDOWS
+//-----------------------------------------------------------------------------
+static void createDirectory (const std::string& path)
+{
+	for (auto pos = path.find_first_of ("/\\", 3); pos != std::string::npos;
+		 pos = path.find_first_of ("/\\", pos + 1))
+		CreateDirectoryA (path.substr (0, pos).data (), nullptr);
+	CreateDirectoryA (path.data (), nullptr);
+}
+
+//-----------------------------------------------------------------------------
+static std::vector<EntryInfo> listEntries (const std::string& directory)
+{
+	std::vector<EntryInfo> entries;
+	WIN32_FIND_DATAA data;
+	auto handle = FindFirstFileA ((directory + "/*").data (), &data);
+	if (handle == INVALID_HANDLE_VALUE)
+		return entries;
+	do
+	{
+		if ((data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) || !hasExtension (data.cFileName))
+			continue;
+		auto size = (uint64_t (data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+		auto time = (uint64_t (data.ftLastWriteTime.dwHighDateTime) << 32) |
+					data.ftLastWriteTime.dwLowDateTime;
+		entries.push_back ({directory + "/" + data.cFileName, size, time});
+	} while (FindNextFileA (handle, &data));
+	FindClose (handle);
+	return entries;
+}
+
+//-----------------------------------------------------------------------------
+static bool replaceFile (const std::string& from, const std::string& to)
+{
+	return MoveFileExA (from.data (), to.data (), MOVEFILE_REPLACE_EXISTING) != 0;
+}
+
+//-----------------------------------------------------------------------------
+static uint64_t getFileSize (const std::string& path)
+{
+	WIN32_FILE_ATTRIBUTE_DATA data;
+	if (!GetFileAttributesExA (path.data (), GetFileExInfoStandard, &data))
+		return 0;
+	return (uint64_t (data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+}
+
+//-----------------------------------------------------------------------------
+/** sets the modification time to the precise system time, the file system may only use the
+ *	coarse one, which does not order entries written in quick succession */
+static void touchFile (const std::string& path)
+{
+	auto handle = CreateFileA (path.data (), FILE_WRITE_ATTRIBUTES,
+							   FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+							   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (handle == INVALID_HANDLE_VALUE)
+		return;
+	FILETIME now;
+	GetSystemTimePreciseAsFileTime (&now);
+	SetFileTime (handle, nullptr, &now, &now);
+	CloseHandle (handle);
+}
+
+//-----------------------------------------------------------------------------
+static uint32_t getProcessID () { return static_cast<uint32_t> (GetCurrentProcessId ()); }
+
+#else
+//-----------------------------------------------------------------------------
+static void createDirectory (const std::string& path)
+{
+	for (auto pos = path.find ('/', 1); pos != std::string::npos; pos = path.find ('/', pos + 1))
+		mkdir (path.substr (0, pos).data (), 0755);
+	mkdir (path.data (), 0755);
+}
+
+//-----------------------------------------------------------------------------
+static uint64_t getModificationTime (const struct stat& info)
+{
+#if MAC
+	const auto& time = info.st_mtimespec;
+#else
+	const auto& time = info.st_mtim;
+#endif
+	return static_cast<uint64_t> (time.tv_sec) * 1000000000ull +
+		   static_cast<uint64_t> (time.tv_nsec);
+}
+
+//-----------------------------------------------------------------------------
+static std::vector<EntryInfo> listEntries (const std::string& directory)
+{
+	std::vector<EntryInfo> entries;
+	auto dir = opendir (directory.data ());
+	if (!dir)
+		return entries;
+	while (auto entry = readdir (dir))
+	{
+		if (!hasExtension (entry->d_name))
+			continue;
+		auto path = directory + "/" + entry->d_name;
+		struct stat info;
+		if (stat (path.data (), &info) != 0 || !S_ISREG (info.st_mode))
+			continue;
+		entries.push_back (
+			{std::move (path), static_cast<uint64_t> (info.st_size), getModificationTime (info)});
+	}
+	closedir (dir);
+	return entries;
+}
+
+//-----------------------------------------------------------------------------
+static bool replaceFile (const std::string& from, const std::string& to)
+{
+	return rename (from.data (), to.data ()) == 0;
+}
+
+//-----------------------------------------------------------------------------
+static uint64_t getFileSize (const std::string& path)
+{
+	struct stat info;
+	if (stat (path.data (), &info) != 0 || !S_ISREG (info.st_mode))
+		return 0;
+	return static_cast<uint64_t> (info.st_size);
+}
+
+//-----------------------------------------------------------------------------
+/** sets the modification time to the precise system time, the file system may only use the
+ *	coarse one, which does not order entries written in quick succession */
+static void touchFile (const std::string& path)
+{
+	struct timespec times[2];
+	if (clock_gettime (CLOCK_REALTIME, &times[0]) != 0)
+		return;
+	times[1] = times[0];
+	utimensat (AT_FDCWD, path.data (), times, 0);
+}
+
+//-----------------------------------------------------------------------------
+static uint32_t getProcessID () { return static_cast<uint32_t> (getpid ()); }
+
+#endif // WINDOWS
+
+//-----------------------------------------------------------------------------
+/** creates a platform bitmap and fills it row by row via readRow (address) */
+template <typename ReadRowProc>
+static PlatformBitmapPtr createBitmap (const Header& header, ReadRowProc&& readRow)
+{
+	auto bitmap = getPlatformFactory ().createBitmap (CPoint (header.width, header.height));
+	if (!bitmap)
+		return nullptr;
+	auto access = bitmap->lockPixels (true);
+	if (!access || access->getPixelFormat () != header.pixelFormat ||
+		access->getBytesPerRow () < header.bytesPerRow)
+		return nullptr;
+	auto address = access->getAddress ();
+	for (auto y = 0u; y < header.height; ++y, address += access->getBytesPerRow ())
+	{
+		if (!readRow (address))
+			return nullptr;
+	}
+	return bitmap;
+}
+
+//-----------------------------------------------------------------------------
+} // BitmapDiskCacheFile
+
+//-----------------------------------------------------------------------------
+BitmapDiskCache::BitmapDiskCache (const std::string& inDirectory, uint64_t maxSize)
+: directory (inDirectory), maxSize (maxSize)
+{
+	while (directory.size () > 1 && (directory.back () == '/' || directory.back () == '\\'))
+		directory.pop_back ();
+	BitmapDiskCacheFile::createDirectory (directory);
+	for (const auto& entry : BitmapDiskCacheFile::listEntries (directory))
+		size += entry.size;
+	if (size > maxSize)
+		evict ();
+}
+
+//-----------------------------------------------------------------------------
+auto BitmapDiskCache::makeKey (const void* data, size_t dataSize,
+							   const std::string& filterDescription) -> Key
+{
+	Key key;
+	key.dataHash = hash (data, dataSize);
+	key.filterHash = hash (filterDescription.data (), filterDescription.size ());
+	key.dataSize = dataSize;
+	return key;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t BitmapDiskCache::hash (const void* data, size_t size, uint64_t seed)
+{
+	constexpr uint64_t prime = 0x100000001b3ull;
+	auto result = 0xcbf29ce484222325ull ^ seed;
+	auto ptr = static_cast<const uint8_t*> (data);
+	// eight bytes per step, the encoded images of a skin can be quite large
+	for (; size >= sizeof (uint64_t); size -= sizeof (uint64_t), ptr += sizeof (uint64_t))
+	{
+		uint64_t word;
+		memcpy (&word, ptr, sizeof (word));
+		result = (result ^ word) * prime;
+		result ^= result >> 29;
+	}
+	for (; size > 0; --size, ++ptr)
+		result = (result ^ *ptr) * prime;
+	result ^= result >> 33;
+	result *= 0xff51afd7ed558ccdull;
+	result ^= result >> 33;
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+std::string BitmapDiskCache::getPath (const Key& key) const
+{
+	char name[40];
+	snprintf (name, sizeof (name), "%016llx%016llx",
+			  static_cast<unsigned long long> (key.dataHash),
+			  static_cast<unsigned long long> (key.filterHash));
+	return directory + "/" + name + BitmapDiskCacheFile::kExtension;
+}
+
+//-----------------------------------------------------------------------------
+uint64_t BitmapDiskCache::getSize () const
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	return size;
+}
+
+//-----------------------------------------------------------------------------
+PlatformBitmapPtr BitmapDiskCache::load (const Key& key)
+{
+	using namespace BitmapDiskCacheFile;
+	auto path = getPath (key);
+	Header header;
+#if WINDOWS
+	auto file = fopen (path.data (), "rb");
+	if (!file)
+		return nullptr;
+	PlatformBitmapPtr bitmap;
+	if (fread (&header, sizeof (header), 1, file) == 1 && _fseeki64 (file, 0, SEEK_END) == 0 &&
+		header.isValid (key, static_cast<uint64_t> (_ftelli64 (file))) &&
+		_fseeki64 (file, sizeof (header), SEEK_SET) == 0)
+	{
+		bitmap = createBitmap (header, [&] (uint8_t* address) {
+			return fread (address, header.bytesPerRow, 1, file) == 1;
+		});
+	}
+	fclose (file);
+#else
+	auto fd = open (path.data (), O_RDONLY);
+	if (fd == -1)
+		return nullptr;
+	struct stat info;
+	void* mapping = MAP_FAILED;
+	if (fstat (fd, &info) == 0 && static_cast<uint64_t> (info.st_size) >= sizeof (Header))
+	{
+		// private and writable, so that changing the pixels of the bitmap does not change the file
+		mapping = mmap (nullptr, static_cast<size_t> (info.st_size), PROT_READ | PROT_WRITE,
+						MAP_PRIVATE, fd, 0);
+	}
+	close (fd);
+	if (mapping == MAP_FAILED)
+		return nullptr;
+	auto mappingSize = static_cast<size_t> (info.st_size);
+	memcpy (&header, mapping, sizeof (header));
+	if (!header.isValid (key, mappingSize))
+	{
+		munmap (mapping, mappingSize);
+		return nullptr;
+	}
+	auto pixels = static_cast<uint8_t*> (mapping) + sizeof (Header);
+#if LINUX
+	if (auto linuxFactory = getPlatformFactory ().asLinuxFactory ())
+	{
+		auto bitmap = linuxFactory->createBitmapFromPixels (
+			pixels, CPoint (header.width, header.height), header.bytesPerRow,
+			static_cast<IPlatformBitmapPixelAccess::PixelFormat> (header.pixelFormat),
+			[mapping, mappingSize] () { munmap (mapping, mappingSize); });
+		if (bitmap)
+		{
+			bitmap->setScaleFactor (header.scaleFactor);
+			touchFile (path);
+		}
+		return bitmap;
+	}
+#endif
+	auto bitmap = createBitmap (header, [&] (uint8_t* address) {
+		memcpy (address, pixels, header.bytesPerRow);
+		pixels += header.bytesPerRow;
+		return true;
+	});
+	munmap (mapping, mappingSize);
+#endif // WINDOWS
+	if (bitmap)
+	{
+		bitmap->setScaleFactor (header.scaleFactor);
+		touchFile (path);
+	}
+	return bitmap;
+}
+
+//-----------------------------------------------------------------------------
+bool BitmapDiskCache::store (const Key& key, IPlatformBitmap& bitmap)
+{
+	using namespace BitmapDiskCacheFile;
+	Header header {};
+	header.magic = kMagic;
+	header.version = kVersion;
+	header.dataHash = key.dataHash;
+	header.filterHash = key.filterHash;
+	header.dataSize = key.dataSize;
+	header.width = static_cast<uint32_t> (bitmap.getSize ().x);
+	header.height = static_cast<uint32_t> (bitmap.getSize ().y);
+	header.bytesPerRow = header.width * 4;
+	if (header.width == 0 || header.height == 0 || header.width > kMaxDimension ||
+		header.height > kMaxDimension || header.getFileSize () > maxSize)
+		return false;
+	auto access = bitmap.lockPixels (true);
+	if (!access || access->getBytesPerRow () < header.bytesPerRow)
+		return false;
+	header.pixelFormat = static_cast<uint32_t> (access->getPixelFormat ());
+	header.scaleFactor = bitmap.getScaleFactor ();
+	header.headerHash = header.calcHash ();
+
+	// the entry only appears under its name when it was completely written
+	auto path = getPath (key);
+	std::string tempPath;
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		tempPath = path + ".tmp" + std::to_string (getProcessID ()) + "-" +
+				   std::to_string (++tempFileCounter);
+	}
+	auto file = fopen (tempPath.data (), "wb");
+	if (!file)
+		return false;
+	auto success = fwrite (&header, sizeof (header), 1, file) == 1;
+	auto address = access->getAddress ();
+	for (auto y = 0u; success && y < header.height; ++y, address += access->getBytesPerRow ())
+		success = fwrite (address, header.bytesPerRow, 1, file) == 1;
+	access = nullptr;
+	success = fclose (file) == 0 && success;
+	// an entry replaced by this one must not be counted twice
+	auto replacedSize = getFileSize (path);
+	if (!success || !replaceFile (tempPath, path))
+	{
+		std::remove (tempPath.data ());
+		return false;
+	}
+	touchFile (path);
+	bool needsEviction;
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		size = (size > replacedSize ? size - replacedSize : 0) + header.getFileSize ();
+		needsEviction = size > maxSize;
+	}
+	if (needsEviction)
+		evict ();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void BitmapDiskCache::evict ()
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	auto entries = BitmapDiskCacheFile::listEntries (directory);
+	std::sort (entries.begin (), entries.end (),
+			   [] (const auto& e1, const auto& e2) { return e1.time < e2.time; });
+	uint64_t totalSize = 0;
+	for (const auto& entry : entries)
+		totalSize += entry.size;
+	// leave some room, so that the next entries can be added without scanning the directory again
+	auto targetSize = maxSize - maxSize / 4;
+	for (const auto& entry : entries)
+	{
+		if (totalSize <= targetSize)
+			break;
+		if (std::remove (entry.path.data ()) == 0)
+			totalSize -= entry.size;
+	}
+	size = totalSize;
+}
+
+//-----------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -0,0 +1,77 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../lib/platform/iplatformbitmap.h"
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace VSTGUI {
+namespace Detail {
+
+//-----------------------------------------------------------------------------
+/** A directory of decoded bitmaps
+ *
+ *	Every entry holds the premultiplied 32 bit pixels and the scale factor of a bitmap after its
+ *	filters were applied.
+ *	The entries are keyed by a hash of the encoded image data and a hash of the filter description,
+ *	so a changed image or filter chain results in a new entry. When the size of all entries exceeds
+ *	the maximum size the least recently used entries are removed.
+ *
+ *	Entries are written to a temporary file and renamed afterwards, so several instances can share
+ *	a directory. Loading only validates the header and the file size, not the pixels.
+ *
+ *	On Linux the entries are mapped into memory and used by the bitmap without copying them, on
+ *	the other platforms the pixels are read into a new bitmap.
+ *
+ *	All methods are thread safe.
+ */
+class BitmapDiskCache
+{
+public:
+	struct Key
+	{
+		uint64_t dataHash {0};
+		uint64_t filterHash {0};
+		uint64_t dataSize {0};
+	};
+
+	/** @param directory the directory of the entries, it is created if it does not exist
+	 *	@param maxSize maximum size of all entries in bytes
+	 */
+	BitmapDiskCache (const std::string& directory, uint64_t maxSize);
+
+	static Key makeKey (const void* data, size_t dataSize, const std::string& filterDescription);
+	static uint64_t hash (const void* data, size_t size, uint64_t seed = 0);
+
+	/** @return the bitmap of the entry or nullptr if there is no valid entry for the key */
+	PlatformBitmapPtr load (const Key& key);
+	/** add or replace the entry for the key */
+	bool store (const Key& key, IPlatformBitmap& bitmap);
+	/** remove the least recently used entries until all entries take at most three quarters of
+	 *	the maximum size */
+	void evict ();
+
+	std::string getPath (const Key& key) const;
+	const std::string& getDirectory () const { return directory; }
+	uint64_t getMaxSize () const { return maxSize; }
+	/** the size of all entries in bytes, including entries written by others when this cache
+	 *	scanned the directory the last time */
+	uint64_t getSize () const;
+
+private:
+	std::string directory;
+	uint64_t maxSize;
+	mutable std::mutex mutex;
+	uint64_t size {0};
+	uint32_t tempFileCounter {0};
+};
+
+using BitmapDiskCachePtr = std::shared_ptr<BitmapDiskCache>;
+
+//-----------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -0,0 +1,161 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#include "uibitmapdecoder.h"
+#include <algorithm>
+#include <system_error>
+
+namespace VSTGUI {
+namespace Detail {
+
+//-----------------------------------------------------------------------------
+BitmapDecodeJob::BitmapDecodeJob (Task&& task) : task (std::move (task)) {}
+
+//-----------------------------------------------------------------------------
+bool BitmapDecodeJob::tryRun ()
+{
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		if (state != State::Pending)
+			return false;
+		state = State::Running;
+	}
+	run ();
+	return true;
+}
+
+//-----------------------------------------------------------------------------
+void BitmapDecodeJob::run ()
+{
+	auto start = std::chrono::steady_clock::now ();
+	auto decoded = task ();
+	// the task may hold objects which are not thread safe reference counted, so release it on the
+	// thread which executed it while nobody else can access it
+	task = nullptr;
+	auto duration = std::chrono::steady_clock::now () - start;
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		result = std::move (decoded);
+		decodeTime = std::chrono::duration_cast<Duration> (duration);
+		state = State::Done;
+	}
+	finished.notify_all ();
+}
+
+//-----------------------------------------------------------------------------
+DecodedBitmap BitmapDecodeJob::takeResult ()
+{
+	auto bitmap = std::move (result.bitmap);
+	auto decoded = result;
+	decoded.bitmap = std::move (bitmap);
+	return decoded;
+}
+
+//-----------------------------------------------------------------------------
+DecodedBitmap BitmapDecodeJob::complete ()
+{
+	if (tryRun ())
+	{
+		decodedInBackground = false;
+		return takeResult ();
+	}
+	auto start = std::chrono::steady_clock::now ();
+	std::unique_lock<std::mutex> lock (mutex);
+	if (state != State::Done)
+	{
+		finished.wait (lock, [this] () { return state == State::Done; });
+		waitTime =
+			std::chrono::duration_cast<Duration> (std::chrono::steady_clock::now () - start);
+	}
+	return takeResult ();
+}
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+BitmapDecodeQueue::BitmapDecodeQueue (uint32_t threads) : numThreads (threads)
+{
+	if (numThreads == 0)
+	{
+		// keep one core for the ui thread, which is decoding the bitmaps it needs itself
+		auto hwThreads = std::thread::hardware_concurrency ();
+		numThreads = std::clamp (hwThreads > 1 ? hwThreads - 1 : 1u, 1u, 4u);
+	}
+}
+
+//-----------------------------------------------------------------------------
+BitmapDecodeQueue::~BitmapDecodeQueue () noexcept
+{
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		jobs.clear ();
+		quit = true;
+	}
+	wakeUp.notify_all ();
+	for (auto& worker : workers)
+		worker.join ();
+}
+
+//-----------------------------------------------------------------------------
+BitmapDecodeJobPtr BitmapDecodeQueue::schedule (BitmapDecodeJob::Task&& task)
+{
+	auto job = std::make_shared<BitmapDecodeJob> (std::move (task));
+	{
+		std::lock_guard<std::mutex> guard (mutex);
+		if (workers.empty ())
+			startWorkers ();
+		// without workers the job is executed when it is completed
+		if (workers.empty ())
+			return job;
+		jobs.emplace_back (job);
+	}
+	wakeUp.notify_one ();
+	return job;
+}
+
+//-----------------------------------------------------------------------------
+void BitmapDecodeQueue::cancelPending ()
+{
+	std::lock_guard<std::mutex> guard (mutex);
+	jobs.clear ();
+}
+
+//-----------------------------------------------------------------------------
+void BitmapDecodeQueue::startWorkers ()
+{
+	workers.reserve (numThreads);
+	for (auto i = 0u; i < numThreads; ++i)
+	{
+		try
+		{
+			workers.emplace_back ([this] () { workerLoop (); });
+		}
+		catch (const std::system_error&)
+		{
+			break;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+void BitmapDecodeQueue::workerLoop ()
+{
+	while (true)
+	{
+		BitmapDecodeJobPtr job;
+		{
+			std::unique_lock<std::mutex> lock (mutex);
+			wakeUp.wait (lock, [this] () { return quit || !jobs.empty (); });
+			if (quit)
+				return;
+			job = std::move (jobs.front ());
+			jobs.pop_front ();
+		}
+		job->tryRun ();
+	}
+}
+
+//-----------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -0,0 +1,117 @@
+// This file is part of VSTGUI. It is subject to the license terms
+// in the LICENSE file found in the top-level directory of this
+// distribution and at http://github.com/steinbergmedia/vstgui/LICENSE
+
+#pragma once
+
+#include "../../lib/cbitmap.h"
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace VSTGUI {
+namespace Detail {
+
+//-----------------------------------------------------------------------------
+struct DecodedBitmap
+{
+	SharedPointer<CBitmap> bitmap;
+	/** the scale factor encoded in the file name of the bitmap, zero if there is none */
+	double nameScaleFactor {0.};
+	/** true if the bitmap filters of the bitmap node were already applied */
+	bool filtersApplied {false};
+	/** true if the bitmap was loaded from the bitmap cache */
+	bool loadedFromCache {false};
+};
+
+//-----------------------------------------------------------------------------
+/** A bitmap decode job
+ *
+ *	The task of the job is executed exactly once, either on a worker thread of the
+ *	BitmapDecodeQueue or on the thread calling complete () if no worker has started it yet.
+ */
+class BitmapDecodeJob
+{
+public:
+	using Duration = std::chrono::nanoseconds;
+	using Task = std::function<DecodedBitmap ()>;
+
+	explicit BitmapDecodeJob (Task&& task);
+
+	/** execute the task if nobody else has started it yet */
+	bool tryRun ();
+	/** block until the task has finished and return its result
+	 *
+	 *	The bitmap is moved out of the job, as its reference count is not thread safe: a worker
+	 *	thread may hold the last reference to the job and must never release a bitmap the caller
+	 *	already uses. Later calls return the result without the bitmap.
+	 */
+	DecodedBitmap complete ();
+
+	/** time the task took, only valid after complete () returned */
+	Duration getDecodeTime () const { return decodeTime; }
+	/** time complete () had to wait for a worker thread to finish the task */
+	Duration getWaitTime () const { return waitTime; }
+	/** false if the task was executed by complete () */
+	bool wasDecodedInBackground () const { return decodedInBackground; }
+
+private:
+	enum class State
+	{
+		Pending,
+		Running,
+		Done
+	};
+
+	void run ();
+	DecodedBitmap takeResult ();
+
+	std::mutex mutex;
+	std::condition_variable finished;
+	State state {State::Pending};
+	Task task;
+	DecodedBitmap result;
+	Duration decodeTime {};
+	Duration waitTime {};
+	bool decodedInBackground {true};
+};
+
+using BitmapDecodeJobPtr = std::shared_ptr<BitmapDecodeJob>;
+
+//-----------------------------------------------------------------------------
+/** A small pool of worker threads decoding bitmaps in the background
+ *
+ *	The worker threads are started with the first scheduled job. Jobs still pending when the
+ *	queue is destroyed are not lost, they will be executed by whoever completes them.
+ */
+class BitmapDecodeQueue
+{
+public:
+	/** @param numThreads number of worker threads, zero to choose depending on the hardware */
+	explicit BitmapDecodeQueue (uint32_t numThreads = 0);
+	~BitmapDecodeQueue () noexcept;
+
+	BitmapDecodeJobPtr schedule (BitmapDecodeJob::Task&& task);
+	/** remove all jobs not yet picked up by a worker thread from the queue */
+	void cancelPending ();
+
+private:
+	void startWorkers ();
+	void workerLoop ();
+
+	std::mutex mutex;
+	std::condition_variable wakeUp;
+	std::deque<BitmapDecodeJobPtr> jobs;
+	std::vector<std::thread> workers;
+	uint32_t numThreads;
+	bool quit {false};
+};
+
+//-----------------------------------------------------------------------------
+} // Detail
+} // VSTGUI
@@ -5,6 +5,8 @@
 #include "../../lib/cbitmap.h"
 #include "../../lib/cfont.h"
 #include "../../lib/cgradient.h"
+#include "../../lib/platform/common/fileresourceinputstream.h"
+#include "../../lib/platform/iplatformresourceinputstream.h"
 #include "../../lib/platform/platformfactory.h"
 #include "../base64codec.h"
 #include "../cstream.h"
@@ -229,11 +231,18 @@ UIBitmapNode::~UIBitmapNode () noexcept
 }
 
 //-----------------------------------------------------------------------------
-void UIBitmapNode::freePlatformResources ()
+void UIBitmapNode::releaseBitmap ()
 {
 	if (bitmap)
 		bitmap->forget ();
 	bitmap = nullptr;
+	decodeJob = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void UIBitmapNode::freePlatformResources ()
+{
+	releaseBitmap ();
 }
 
 //-----------------------------------------------------------------------------
@@ -333,9 +342,18 @@ void UIBitmapNode::removeXMLData ()
 }
 
 //-----------------------------------------------------------------------------
-CBitmap* UIBitmapNode::createBitmap (const std::string& str, const BitmapVariant& variant) const
+CBitmap* UIBitmapNode::createBitmap (const std::string& str, const BitmapVariant& variant,
+									 const PlatformBitmapPtr& platformBitmap)
 {
-
+	if (platformBitmap)
+	{
+		CResourceDescription desc (str.data ());
+		if (auto partDesc = std::get_if<CNinePartTiledDescription> (&variant))
+			return new CNinePartTiledBitmap (desc, platformBitmap, *partDesc);
+		else if (auto multiFrameDesc = std::get_if<CMultiFrameBitmapDescription> (&variant))
+			return new CMultiFrameBitmap (desc, platformBitmap, *multiFrameDesc);
+		return new CBitmap (desc, platformBitmap);
+	}
 	if (auto partDesc = std::get_if<CNinePartTiledDescription> (&variant))
 		return new CNinePartTiledBitmap (CResourceDescription (str.data ()), *partDesc);
 	else if (auto multiFrameDesc = std::get_if<CMultiFrameBitmapDescription> (&variant))
@@ -350,6 +368,40 @@ UINode* UIBitmapNode::dataNode () const
 	return (node && !node->getData ().empty ()) ? node : nullptr;
 }
 
+//------------------------------------------------------------------------
+/** feeds the decoded base64 data to the bitmap decoder while decoding */
+class Base64DecodeStream : public IPlatformResourceInputStream
+{
+public:
+	Base64DecodeStream (const std::string& base64Data)
+	: decoder (base64Data.data (), base64Data.size ())
+	{
+	}
+
+	uint32_t readRaw (void* buffer, uint32_t size) override
+	{
+		return static_cast<uint32_t> (decoder.read (buffer, size));
+	}
+	int64_t seek (int64_t pos, SeekMode mode) override { return kStreamSeekError; }
+	int64_t tell () override { return static_cast<int64_t> (decoder.getPosition ()); }
+
+private:
+	Base64Codec::Decoder decoder;
+};
+
+//------------------------------------------------------------------------
+PlatformBitmapPtr UIBitmapNode::createBitmapFromData (const std::string& base64Data,
+													  double scaleFactor)
+{
+	Base64DecodeStream stream (base64Data);
+	if (auto platformBitmap = getPlatformFactory ().createBitmapFromStream (stream))
+	{
+		platformBitmap->setScaleFactor (scaleFactor);
+		return platformBitmap;
+	}
+	return nullptr;
+}
+
 //------------------------------------------------------------------------
 PlatformBitmapPtr UIBitmapNode::createBitmapFromDataNode () const
 {
@@ -358,75 +410,168 @@ PlatformBitmapPtr UIBitmapNode::createBitmapFromDataNode () const
 		auto codecStr = node->getAttributes ()->getAttributeValue ("encoding");
 		if (codecStr && *codecStr == "base64")
 		{
-			auto result = Base64Codec::decode (node->getData ());
-			if (auto platformBitmap = getPlatformFactory ().createBitmapFromMemory (
-			        result.data.get (), result.dataSize))
-			{
-				double scaleFactor = 1.;
-				if (attributes->getDoubleAttribute ("scale-factor", scaleFactor))
-					platformBitmap->setScaleFactor (scaleFactor);
-				return platformBitmap;
-			}
+			double scaleFactor = 1.;
+			attributes->getDoubleAttribute ("scale-factor", scaleFactor);
+			return createBitmapFromData (node->getData (), scaleFactor);
 		}
 	}
 	return nullptr;
 }
 
 //-----------------------------------------------------------------------------
-CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
+auto UIBitmapNode::createDecodeRequest (const std::string& pathHint) const -> DecodeRequest
 {
-	if (bitmap == nullptr)
+	DecodeRequest request;
+	const std::string* path = attributes->getAttributeValue ("path");
+	if (path == nullptr)
+		return request;
+	request.hasPath = true;
+	request.path = *path;
+	int32_t tmpValue {};
+	CRect offsets;
+	if (attributes->getRectAttribute ("nineparttiled-offsets", offsets))
+	{
+		request.variant =
+			CNinePartTiledDescription (offsets.left, offsets.top, offsets.right, offsets.bottom);
+	}
+	else if (attributes->getIntegerAttribute ("multiframe-num-frames", tmpValue))
 	{
-		const std::string* path = attributes->getAttributeValue ("path");
-		if (path)
+		CMultiFrameBitmapDescription multiFrameDesc {};
+		multiFrameDesc.numFrames = static_cast<uint16_t> (tmpValue);
+		if (attributes->getIntegerAttribute ("mulitframe-frames-per-row", tmpValue))
+			multiFrameDesc.framesPerRow = static_cast<uint16_t> (tmpValue);
+		attributes->getPointAttribute ("multiframe-size", multiFrameDesc.frameSize);
+		request.variant = multiFrameDesc;
+	}
+	if (pathIsAbsolute (pathHint))
+	{
+		std::string absPath = pathHint;
+		if (removeLastPathComponent (absPath))
+			request.absolutePath = absPath + "/" + *path;
+	}
+	if (auto node = dataNode ())
+	{
+		auto codecStr = node->getAttributes ()->getAttributeValue ("encoding");
+		if (codecStr && *codecStr == "base64")
 		{
-			BitmapVariant bitmapVariant;
-			int32_t tmpValue {};
-			CRect offsets;
-			if (attributes->getRectAttribute ("nineparttiled-offsets", offsets))
-			{
-				bitmapVariant = CNinePartTiledDescription (offsets.left, offsets.top, offsets.right,
-														   offsets.bottom);
-			}
-			else if (attributes->getIntegerAttribute ("multiframe-num-frames", tmpValue))
-			{
-				CMultiFrameBitmapDescription multiFrameDesc {};
-				multiFrameDesc.numFrames = static_cast<uint16_t> (tmpValue);
-				if (attributes->getIntegerAttribute ("mulitframe-frames-per-row", tmpValue))
-					multiFrameDesc.framesPerRow = static_cast<uint16_t> (tmpValue);
-				attributes->getPointAttribute ("multiframe-size", multiFrameDesc.frameSize);
-				bitmapVariant = multiFrameDesc;
-			}
-			bitmap = createBitmap (*path, bitmapVariant);
-			if (bitmap->getPlatformBitmap () == nullptr && pathIsAbsolute (pathHint))
-			{
-				std::string absPath = pathHint;
-				if (removeLastPathComponent (absPath))
-				{
-					absPath += "/" + *path;
-					if (auto platformBitmap =
-					        getPlatformFactory ().createBitmapFromPath (absPath.c_str ()))
-					{
-						bitmap->setPlatformBitmap (platformBitmap);
-					}
-				}
-			}
+			request.base64Data = node->getData ();
+			attributes->getDoubleAttribute ("scale-factor", request.dataScaleFactor);
 		}
-		if (bitmap && bitmap->getPlatformBitmap () == nullptr)
+	}
+	return request;
+}
+
+//-----------------------------------------------------------------------------
+DecodedBitmap UIBitmapNode::decodeBitmap (const DecodeRequest& request)
+{
+	DecodedBitmap result;
+	if (!request.hasPath)
+		return result;
+	result.bitmap = owned (createBitmap (request.path, request.variant));
+	if (result.bitmap->getPlatformBitmap () == nullptr && !request.absolutePath.empty ())
+	{
+		if (auto platformBitmap =
+				getPlatformFactory ().createBitmapFromPath (request.absolutePath.c_str ()))
 		{
-			if (auto platformBitmap = createBitmapFromDataNode ())
-				bitmap->setPlatformBitmap (platformBitmap);
+			result.bitmap->setPlatformBitmap (platformBitmap);
 		}
-		if (bitmap && path && bitmap->getPlatformBitmap () &&
-		    bitmap->getPlatformBitmap ()->getScaleFactor () == 1.)
+	}
+	if (result.bitmap->getPlatformBitmap () == nullptr && !request.base64Data.empty ())
+	{
+		if (auto platformBitmap = createBitmapFromData (request.base64Data, request.dataScaleFactor))
+			result.bitmap->setPlatformBitmap (platformBitmap);
+	}
+	applyNameScaleFactor (request, result);
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+DecodedBitmap UIBitmapNode::decodeBitmap (const DecodeRequest& request,
+										  const PlatformBitmapPtr& platformBitmap)
+{
+	DecodedBitmap result;
+	if (!request.hasPath)
+		return result;
+	result.bitmap = owned (createBitmap (request.path, request.variant, platformBitmap));
+	applyNameScaleFactor (request, result);
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+void UIBitmapNode::applyNameScaleFactor (const DecodeRequest& request, DecodedBitmap& decoded)
+{
+	auto platformBitmap = decoded.bitmap->getPlatformBitmap ();
+	if (platformBitmap && platformBitmap->getScaleFactor () == 1.)
+	{
+		double scaleFactor = 1.;
+		if (Detail::decodeScaleFactorFromName (request.path, scaleFactor))
 		{
-			double scaleFactor = 1.;
-			if (Detail::decodeScaleFactorFromName (*path, scaleFactor))
+			platformBitmap->setScaleFactor (scaleFactor);
+			decoded.nameScaleFactor = scaleFactor;
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+auto UIBitmapNode::readEncodedData (const DecodeRequest& request) -> EncodedData
+{
+	EncodedData result;
+	if (!request.hasPath)
+		return result;
+	auto readAll = [&] (IPlatformResourceInputStream& stream) {
+		constexpr uint32_t chunkSize = 64 * 1024;
+		while (true)
+		{
+			auto pos = result.data.size ();
+			result.data.resize (pos + chunkSize);
+			auto numBytes = stream.readRaw (result.data.data () + pos, chunkSize);
+			if (numBytes == kStreamIOError)
 			{
-				bitmap->getPlatformBitmap ()->setScaleFactor (scaleFactor);
-				attributes->setDoubleAttribute ("scale-factor", scaleFactor);
+				result.data.clear ();
+				return;
 			}
+			result.data.resize (pos + numBytes);
+			if (numBytes == 0)
+				return;
 		}
+	};
+	CResourceDescription desc (request.path.data ());
+	if (auto stream = getPlatformFactory ().createResourceInputStream (desc))
+		readAll (*stream);
+	if (result.data.empty () && !request.absolutePath.empty ())
+	{
+		if (auto stream = FileResourceInputStream::create (request.absolutePath))
+			readAll (*stream);
+	}
+	if (result.data.empty () && !request.base64Data.empty ())
+	{
+		Base64DecodeStream stream (request.base64Data);
+		readAll (stream);
+		result.scaleFactor = request.dataScaleFactor;
+	}
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+void UIBitmapNode::setDecodedBitmap (const DecodedBitmap& decoded)
+{
+	if (bitmap || !decoded.bitmap)
+		return;
+	bitmap = decoded.bitmap;
+	bitmap->remember ();
+	if (decoded.nameScaleFactor != 0.)
+		attributes->setDoubleAttribute ("scale-factor", decoded.nameScaleFactor);
+	if (decoded.filtersApplied)
+		filterProcessed = true;
+}
+
+//-----------------------------------------------------------------------------
+CBitmap* UIBitmapNode::getBitmap (const std::string& pathHint)
+{
+	if (bitmap == nullptr)
+	{
+		decodeJob = nullptr;
+		setDecodedBitmap (decodeBitmap (createDecodeRequest (pathHint)));
 	}
 	return bitmap;
 }
@@ -436,9 +581,7 @@ void UIBitmapNode::setBitmap (UTF8StringPtr bitmapName)
 {
 	std::string name (bitmapName);
 	attributes->setAttribute ("path", name);
-	if (bitmap)
-		bitmap->forget ();
-	bitmap = nullptr;
+	releaseBitmap ();
 	double scaleFactor = 1.;
 	if (Detail::decodeScaleFactorFromName (name, scaleFactor))
 		attributes->setDoubleAttribute ("scale-factor", scaleFactor);
@@ -460,6 +603,7 @@ void UIBitmapNode::setMultiFrameDesc (const CMultiFrameBitmapDescription* desc)
 			bitmap = nullptr;
 		}
 	}
+	decodeJob = nullptr;
 	if (desc)
 	{
 		attributes->setPointAttribute ("multiframe-size", desc->frameSize);
@@ -491,6 +635,7 @@ void UIBitmapNode::setNinePartTiledOffset (const CRect* offsets)
 			bitmap = nullptr;
 		}
 	}
+	decodeJob = nullptr;
 	if (offsets)
 		attributes->setRectAttribute ("nineparttiled-offsets", *offsets);
 	else
@@ -500,9 +645,7 @@ void UIBitmapNode::setNinePartTiledOffset (const CRect* offsets)
 //-----------------------------------------------------------------------------
 void UIBitmapNode::invalidBitmap ()
 {
-	if (bitmap)
-		bitmap->forget ();
-	bitmap = nullptr;
+	releaseBitmap ();
 	filterProcessed = false;
 }
 
@@ -659,9 +802,20 @@ UIColorNode::UIColorNode (const std::string& name, const SharedPointer<UIAttribu
 		color.blue = (uint8_t)strtol (blue->c_str (), nullptr, 10);
 	if (alpha)
 		color.alpha = (uint8_t)strtol (alpha->c_str (), nullptr, 10);
-	if (rgb)
+	// the binary format stores the parsed colors
+	auto getParsedColor = [&] (const std::string& name) {
+		auto parsed = attributes->getParsedValue (name);
+		if (!parsed || parsed->type != UIAttributes::ParsedValue::Type::kColor)
+			return false;
+		color = CColor (static_cast<uint8_t> (parsed->values[0]),
+						static_cast<uint8_t> (parsed->values[1]),
+						static_cast<uint8_t> (parsed->values[2]),
+						static_cast<uint8_t> (parsed->values[3]));
+		return true;
+	};
+	if (rgb && !getParsedColor ("rgb"))
 		parseColor (*rgb, color);
-	if (rgba)
+	if (rgba && !getParsedColor ("rgba"))
 		parseColor (*rgba, color);
 }
 
@@ -7,9 +7,11 @@
 #include "../../lib/vstguifwd.h"
 #include "../uidescriptionfwd.h"
 #include "../../lib/ccolor.h"
+#include "uibitmapdecoder.h"
 #include "uidesclist.h"
 
 #include <variant>
+#include <vector>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -123,6 +125,20 @@ protected:
 class UIBitmapNode : public UINode
 {
 public:
+	using BitmapVariant =
+		std::variant<uint32_t, CNinePartTiledDescription, CMultiFrameBitmapDescription>;
+
+	/** everything needed to decode the bitmap without accessing the node */
+	struct DecodeRequest
+	{
+		std::string path;
+		std::string absolutePath;
+		std::string base64Data;
+		BitmapVariant variant;
+		double dataScaleFactor {1.};
+		bool hasPath {false};
+	};
+
 	UIBitmapNode (const std::string& name, const SharedPointer<UIAttributes>& attributes);
 	CBitmap* getBitmap (const std::string& pathHint);
 	void setBitmap (UTF8StringPtr bitmapName);
@@ -134,6 +150,33 @@ public:
 	bool getScaledBitmapsAdded () const { return scaledBitmapsAdded; }
 	void setScaledBitmapsAdded () { scaledBitmapsAdded = true; }
 
+	bool hasBitmap () const { return bitmap != nullptr; }
+	DecodeRequest createDecodeRequest (const std::string& pathHint) const;
+	/** decodes the bitmap of the request. Does not access any node, so it can be called from
+	 *	any thread as long as the platform factory supports it. */
+	static DecodedBitmap decodeBitmap (const DecodeRequest& request);
+	/** creates the bitmap of the request for an already decoded platform bitmap */
+	static DecodedBitmap decodeBitmap (const DecodeRequest& request,
+									   const PlatformBitmapPtr& platformBitmap);
+
+	struct EncodedData
+	{
+		std::vector<uint8_t> data;
+		/** the scale factor of the bitmap before the one encoded in its name is applied */
+		double scaleFactor {1.};
+	};
+	/** reads the encoded image data of the request from the same sources decodeBitmap () uses,
+	 *	the data is empty if none could be read */
+	static EncodedData readEncodedData (const DecodeRequest& request);
+	/** takes over a decoded bitmap if the node does not have a bitmap yet */
+	void setDecodedBitmap (const DecodedBitmap& decoded);
+
+	/** the job decoding the bitmap in the background. It is dropped whenever the bitmap is
+	 *	invalidated, as its result would be outdated. */
+	void setDecodeJob (const BitmapDecodeJobPtr& job) { decodeJob = job; }
+	const BitmapDecodeJobPtr& getDecodeJob () const { return decodeJob; }
+	BitmapDecodeJobPtr takeDecodeJob () { return std::move (decodeJob); }
+
 	void createXMLData (const std::string& pathHint);
 	void removeXMLData ();
 	bool hasXMLData () const;
@@ -142,13 +185,17 @@ public:
 
 protected:
 	~UIBitmapNode () noexcept override;
-	using BitmapVariant =
-		std::variant<uint32_t, CNinePartTiledDescription, CMultiFrameBitmapDescription>;
-	CBitmap* createBitmap (const std::string& str, const BitmapVariant& variant) const;
+	static CBitmap* createBitmap (const std::string& str, const BitmapVariant& variant,
+								  const PlatformBitmapPtr& platformBitmap = nullptr);
+	static PlatformBitmapPtr createBitmapFromData (const std::string& base64Data,
+												   double scaleFactor);
 	PlatformBitmapPtr createBitmapFromDataNode () const;
+	static void applyNameScaleFactor (const DecodeRequest& request, DecodedBitmap& decoded);
 	static bool imagesEqual (IPlatformBitmap* b1, IPlatformBitmap* b2);
 	UINode* dataNode () const;
+	void releaseBitmap ();
 	CBitmap* bitmap;
+	BitmapDecodeJobPtr decodeJob;
 	bool filterProcessed;
 	bool scaledBitmapsAdded;
 };
@@ -90,6 +90,7 @@ static const std::string kAttrOpacity = "opacity";
 //-----------------------------------------------------------------------------
 static const std::string kAttrBackgroundColor = "background-color";
 static const std::string kAttrBackgroundColorDrawStyle = "background-color-draw-style";
+static const std::string kAttrCacheAsBitmap = "cache-as-bitmap";
 
 //-----------------------------------------------------------------------------
 // CLayeredViewContainerCreator attributes
@@ -118,6 +119,7 @@ static const std::string kAttrBordered = "bordered";
 static const std::string kAttrOverlayScrollbars = "overlay-scrollbars";
 static const std::string kAttrFollowFocusView = "follow-focus-view";
 static const std::string kAttrAutoHideScrollbars = "auto-hide-scrollbars";
+static const std::string kAttrTransformScrolling = "transform-scrolling";
 static const std::string kAttrScrollbarBackgroundColor = "scrollbar-background-color";
 static const std::string kAttrScrollbarFrameColor = "scrollbar-frame-color";
 static const std::string kAttrScrollbarScrollerColor = "scrollbar-scroller-color";
@@ -159,6 +161,7 @@ static const std::string kAttrTextInset = "text-inset";
 static const std::string kAttrValuePrecision = "value-precision";
 static const std::string kAttrTextRotation = "text-rotation";
 static const std::string kAttrTextShadowOffset = "text-shadow-offset";
+static const std::string kAttrFastTextRendering = "fast-text-rendering";
 
 //-----------------------------------------------------------------------------
 // COptionMenuCreator attributes
@@ -285,6 +288,8 @@ static const std::string kAttrTemplateNames = "template-names";
 static const std::string kAttrTemplateSwitchControl = "template-switch-control";
 static const std::string kAttrAnimationStyle = "animation-style";
 static const std::string kAttrAnimationTimingFunction = "animation-timing-function";
+static const std::string kAttrViewCacheSize = "view-cache-size";
+static const std::string kAttrPrewarmViews = "prewarm-views";
 
 //-----------------------------------------------------------------------------
 // CSplitViewCreator attributes
@@ -298,6 +303,8 @@ static const std::string kAttrResizeMethod = "resize-method";
 static const std::string kAttrShadowIntensity = "shadow-intensity";
 static const std::string kAttrShadowBlurSize = "shadow-blur-size";
 static const std::string kAttrShadowOffset = "shadow-offset";
+static const std::string kAttrShadowDownsampling = "shadow-downsampling";
+static const std::string kAttrShadowFollowsContent = "shadow-follows-content";
 
 //-----------------------------------------------------------------------------
 // CGradientViewCreator attributes
@@ -4,6 +4,7 @@
 
 #include "uiattributes.h"
 #include "cstream.h"
+#include "detail/parsecolor.h"
 #include "../lib/cpoint.h"
 #include "../lib/crect.h"
 #include "../lib/cstring.h"
@@ -250,6 +251,161 @@ UIAttributes::UIAttributes (size_t reserve)
 	UIAttributesMap::reserve (reserve);
 }
 
+//-----------------------------------------------------------------------------
+UIAttributes::UIAttributes (const UIAttributes& other)
+: NonAtomicReferenceCounted (other), UIAttributesMap (other)
+{
+	copyParsedValues (other);
+}
+
+//-----------------------------------------------------------------------------
+UIAttributes& UIAttributes::operator= (const UIAttributes& other)
+{
+	if (this == &other)
+		return *this;
+	UIAttributesMap::operator= (other);
+	parsedValues.clear ();
+	copyParsedValues (other);
+	++changeCount;
+	return *this;
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::copyParsedValues (const UIAttributes& other)
+{
+	if (other.parsedValues.empty ())
+		return;
+	for (auto& attr : static_cast<UIAttributesMap&> (*this))
+	{
+		auto it = other.find (attr.first);
+		if (it == other.end ())
+			continue;
+		auto parsedIt = other.parsedValues.find (&it->second);
+		if (parsedIt != other.parsedValues.end ())
+			parsedValues.emplace (&attr.second, parsedIt->second);
+	}
+}
+
+//-----------------------------------------------------------------------------
+const UIAttributes::ParsedValue* UIAttributes::findParsedValue (const std::string* value,
+																ParsedValue::Type type) const
+{
+	if (parsedValues.empty ())
+		return nullptr;
+	auto it = parsedValues.find (value);
+	if (it == parsedValues.end ())
+		return nullptr;
+	// every integer string is also a valid double string
+	if (it->second.type == type ||
+		(type == ParsedValue::Type::kDouble && it->second.type == ParsedValue::Type::kInteger))
+		return &it->second;
+	return nullptr;
+}
+
+//-----------------------------------------------------------------------------
+void UIAttributes::eraseParsedValue (const std::string* value)
+{
+	if (!parsedValues.empty ())
+		parsedValues.erase (value);
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::parseAttribute (const std::string& name, ParsedValue::Type type)
+{
+	auto str = getAttributeValue (name);
+	if (!str)
+		return false;
+	if (findParsedValue (str, type))
+		return true;
+	ParsedValue parsed;
+	parsed.type = type;
+	auto result = false;
+	switch (type)
+	{
+		case ParsedValue::Type::kBoolean:
+		{
+			bool b;
+			if ((result = stringToBool (*str, b)))
+				parsed.values[0] = b ? 1. : 0.;
+			break;
+		}
+		case ParsedValue::Type::kInteger:
+		{
+			int32_t i;
+			if ((result = stringToInteger (*str, i)))
+				parsed.values[0] = i;
+			break;
+		}
+		case ParsedValue::Type::kDouble:
+		{
+			result = stringToDouble (*str, parsed.values[0]);
+			break;
+		}
+		case ParsedValue::Type::kPoint:
+		{
+			CPoint p;
+			if ((result = stringToPoint (*str, p)))
+			{
+				parsed.values[0] = p.x;
+				parsed.values[1] = p.y;
+			}
+			break;
+		}
+		case ParsedValue::Type::kRect:
+		{
+			CRect r;
+			if ((result = stringToRect (*str, r)))
+			{
+				parsed.values[0] = r.left;
+				parsed.values[1] = r.top;
+				parsed.values[2] = r.right;
+				parsed.values[3] = r.bottom;
+			}
+			break;
+		}
+		case ParsedValue::Type::kColor:
+		{
+			CColor c;
+			if ((result = Detail::parseColor (*str, c)))
+			{
+				parsed.values[0] = c.red;
+				parsed.values[1] = c.green;
+				parsed.values[2] = c.blue;
+				parsed.values[3] = c.alpha;
+			}
+			break;
+		}
+	}
+	if (result)
+		parsedValues[str] = parsed;
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+bool UIAttributes::setParsedValue (const std::string& name, const ParsedValue& value)
+{
+	if (auto str = getAttributeValue (name))
+	{
+		parsedValues[str] = value;
+		return true;
+	}
+	return false;
+}
+
+//-----------------------------------------------------------------------------
+auto UIAttributes::getParsedValue (const std::string& name) const -> const ParsedValue*
+{
+	if (parsedValues.empty ())
+		return nullptr;
+	if (auto str = getAttributeValue (name))
+	{
+		auto it = parsedValues.find (str);
+		if (it != parsedValues.end ())
+			return &it->second;
+	}
+	return nullptr;
+}
+
 //-----------------------------------------------------------------------------
 bool UIAttributes::hasAttribute (const std::string& name) const
 {
@@ -270,9 +426,13 @@ const std::string* UIAttributes::getAttributeValue (const std::string& name) con
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, const std::string& value)
 {
+	++changeCount;
 	iterator iter = find (name);
 	if (iter != end ())
+	{
+		eraseParsedValue (&iter->second);
 		iter->second = value;
+	}
 	else
 		emplace (name, value);
 }
@@ -280,9 +440,13 @@ void UIAttributes::setAttribute (const std::string& name, const std::string& val
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (const std::string& name, std::string&& value)
 {
+	++changeCount;
 	iterator iter = find (name);
 	if (iter != end ())
+	{
+		eraseParsedValue (&iter->second);
 		iter->second = std::move (value);
+	}
 	else
 		emplace (name, std::move (value));
 }
@@ -290,9 +454,13 @@ void UIAttributes::setAttribute (const std::string& name, std::string&& value)
 //-----------------------------------------------------------------------------
 void UIAttributes::setAttribute (std::string&& name, std::string&& value)
 {
+	++changeCount;
 	iterator iter = find (name);
 	if (iter != end ())
+	{
+		eraseParsedValue (&iter->second);
 		iter->second = std::move (value);
+	}
 	else
 		emplace (std::move (name), std::move (value));
 }
@@ -300,9 +468,13 @@ void UIAttributes::setAttribute (std::string&& name, std::string&& value)
 //-----------------------------------------------------------------------------
 void UIAttributes::removeAttribute (const std::string& name)
 {
+	++changeCount;
 	iterator iter = find (name);
 	if (iter != end ())
+	{
+		eraseParsedValue (&iter->second);
 		erase (iter);
+	}
 }
 
 //-----------------------------------------------------------------------------
@@ -315,7 +487,14 @@ void UIAttributes::setDoubleAttribute (const std::string& name, double value)
 bool UIAttributes::getDoubleAttribute (const std::string& name, double& value) const
 {
 	if (auto str = getAttributeValue (name))
+	{
+		if (auto parsed = findParsedValue (str, ParsedValue::Type::kDouble))
+		{
+			value = parsed->values[0];
+			return true;
+		}
 		return stringToDouble (*str, value);
+	}
 	return false;
 }
 
@@ -329,7 +508,14 @@ void UIAttributes::setBooleanAttribute (const std::string& name, bool value)
 bool UIAttributes::getBooleanAttribute (const std::string& name, bool& value) const
 {
 	if (auto str = getAttributeValue (name))
+	{
+		if (auto parsed = findParsedValue (str, ParsedValue::Type::kBoolean))
+		{
+			value = parsed->values[0] != 0.;
+			return true;
+		}
 		return stringToBool (*str, value);
+	}
 	return false;
 }
 
@@ -343,7 +529,14 @@ void UIAttributes::setIntegerAttribute (const std::string& name, int32_t value)
 bool UIAttributes::getIntegerAttribute (const std::string& name, int32_t& value) const
 {
 	if (auto str = getAttributeValue (name))
+	{
+		if (auto parsed = findParsedValue (str, ParsedValue::Type::kInteger))
+		{
+			value = static_cast<int32_t> (parsed->values[0]);
+			return true;
+		}
 		return stringToInteger(*str, value);
+	}
 	return false;
 }
 
@@ -357,7 +550,14 @@ void UIAttributes::setPointAttribute (const std::string& name, const CPoint& p)
 bool UIAttributes::getPointAttribute (const std::string& name, CPoint& p) const
 {
 	if (auto str = getAttributeValue (name))
+	{
+		if (auto parsed = findParsedValue (str, ParsedValue::Type::kPoint))
+		{
+			p = CPoint (parsed->values[0], parsed->values[1]);
+			return true;
+		}
 		return stringToPoint (*str, p);
+	}
 	return false;
 }
 
@@ -371,7 +571,15 @@ void UIAttributes::setRectAttribute (const std::string& name, const CRect& r)
 bool UIAttributes::getRectAttribute (const std::string& name, CRect& r) const
 {
 	if (auto str = getAttributeValue (name))
+	{
+		if (auto parsed = findParsedValue (str, ParsedValue::Type::kRect))
+		{
+			r = CRect (parsed->values[0], parsed->values[1], parsed->values[2],
+					   parsed->values[3]);
+			return true;
+		}
 		return stringToRect (*str, r);
+	}
 	return false;
 }
 
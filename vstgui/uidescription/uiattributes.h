@@ -24,8 +24,11 @@ public:
 	
 	explicit UIAttributes (UTF8StringPtr* attributes = nullptr);
 	explicit UIAttributes (size_t reserve);
+	UIAttributes (const UIAttributes& other);
 	~UIAttributes () noexcept override = default;
 
+	UIAttributes& operator= (const UIAttributes& other);
+
 	using UIAttributesMap::empty;
 
 	using UIAttributesMap::begin;
@@ -58,7 +61,44 @@ public:
 	void setStringArrayAttribute (const std::string& name, const StringArray& values);
 	bool getStringArrayAttribute (const std::string& name, StringArray& values) const;
 	
-	void removeAll () { clear (); }
+	void removeAll ()
+	{
+		clear ();
+		parsedValues.clear ();
+		++changeCount;
+	}
+
+	/** typed form of an attribute value, which the typed getters use instead of parsing the
+	 *	string of the attribute again
+	 */
+	struct ParsedValue
+	{
+		enum class Type : uint8_t
+		{
+			kBoolean,
+			kInteger,
+			kDouble,
+			kPoint,
+			kRect,
+			kColor
+		};
+		Type type {Type::kDouble};
+		/** bool and integer values are stored in the first element, a point in the first two,
+		 *	a rect as left, top, right, bottom and a color as red, green, blue, alpha */
+		double values[4] {};
+	};
+
+	/** parse the value of the attribute as type and keep the result until the attribute is
+	 *	changed. Returns false if the attribute does not exist or could not be parsed as type.
+	 */
+	bool parseAttribute (const std::string& name, ParsedValue::Type type);
+	/** set the typed form of the current value of the attribute. The caller guarantees that it
+	 *	matches the string value. */
+	bool setParsedValue (const std::string& name, const ParsedValue& value);
+	const ParsedValue* getParsedValue (const std::string& name) const;
+
+	/** incremented on every modification, used to validate data derived from the attributes */
+	uint32_t getChangeCount () const { return changeCount; }
 
 	bool store (OutputStream& stream) const;
 	bool restore (InputStream& stream);
@@ -75,7 +115,16 @@ public:
 	static bool stringToRect (const std::string& str, CRect& r);
 	static std::string stringArrayToString (const StringArray& values);
 	static bool stringToStringArray (const std::string& str, StringArray& values);
-	
+
+private:
+	const ParsedValue* findParsedValue (const std::string* value, ParsedValue::Type type) const;
+	void eraseParsedValue (const std::string* value);
+	void copyParsedValues (const UIAttributes& other);
+
+	uint32_t changeCount {0};
+	/** keyed by the address of the value string in the map, which is stable until the
+	 *	attribute is removed */
+	std::unordered_map<const std::string*, ParsedValue> parsedValues;
 };
 
 } // VSTGUI
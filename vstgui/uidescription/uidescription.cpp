@@ -25,9 +25,13 @@
 #include "../lib/platform/std_unorderedmap.h"
 #include "../lib/platform/iplatformbitmap.h"
 #include "../lib/platform/iplatformfont.h"
+#include "../lib/platform/platformfactory.h"
 #include "detail/locale.h"
 #include "detail/parsecolor.h"
 #include "detail/scalefactorutils.h"
+#include "detail/uibinarypersistence.h"
+#include "detail/uibitmapcache.h"
+#include "detail/uibitmapdecoder.h"
 #include "detail/uidesclist.h"
 #include "detail/uijsonpersistence.h"
 #include "detail/uinode.h"
@@ -38,6 +42,8 @@
 #include <algorithm>
 #include <cassert>
 #include <deque>
+#include <typeinfo>
+#include <unordered_set>
 
 namespace VSTGUI {
 
@@ -99,6 +105,16 @@ struct UIDescription::Impl : ListenerProvider<Impl, UIDescriptionListener>
 	
 	Optional<UINode*> variableBaseNode;
 
+	// only the plain view factory creates its views via creation plans, as a subclass may
+	// override createView
+	UIViewFactory* planningViewFactory {nullptr};
+	std::unordered_map<const UIAttributes*, UIViewFactory::CreationPlanPtr> creationPlans;
+
+	BitmapDecodeTraceFunc bitmapDecodeTraceFunc;
+	Detail::BitmapDiskCachePtr bitmapCache;
+	// declared after the nodes, so that the worker threads are stopped before the nodes are gone
+	std::unique_ptr<Detail::BitmapDecodeQueue> bitmapDecodeQueue;
+
 	UINode* getVariableBaseNode ()
 	{
 		if (!variableBaseNode)
@@ -108,6 +124,38 @@ struct UIDescription::Impl : ListenerProvider<Impl, UIDescriptionListener>
 		}
 		return *variableBaseNode;
 	}
+
+	void setViewFactory (IViewFactory* factory)
+	{
+		viewFactory = factory ? factory : getGenericViewFactory ();
+		planningViewFactory = typeid (*viewFactory) == typeid (UIViewFactory)
+								  ? static_cast<UIViewFactory*> (viewFactory)
+								  : nullptr;
+		creationPlans.clear ();
+	}
+
+	/** drop the plans of view nodes which were removed, their attributes are only referenced
+	 *	by the plan */
+	void pruneCreationPlans ()
+	{
+		for (auto it = creationPlans.begin (); it != creationPlans.end ();)
+		{
+			if (!it->second || it->second->attributes->getNbReference () == 1)
+				it = creationPlans.erase (it);
+			else
+				++it;
+		}
+	}
+
+	CView* createView (const SharedPointer<UIAttributes>& attributes, const IUIDescription* desc)
+	{
+		if (!planningViewFactory)
+			return viewFactory->createView (*attributes, desc);
+		auto& plan = creationPlans[attributes.get ()];
+		if (!plan || !UIViewFactory::isCreationPlanValid (*plan, *attributes))
+			plan = planningViewFactory->createCreationPlan (attributes, desc);
+		return planningViewFactory->createView (*plan, desc);
+	}
 };
 
 //-----------------------------------------------------------------------------
@@ -115,21 +163,17 @@ UIDescription::UIDescription (const CResourceDescription& uidescFile, IViewFacto
 {
 	impl = std::unique_ptr<Impl> (new Impl);
 	impl->uidescFile = uidescFile;
-	impl->viewFactory = _viewFactory;
+	impl->setViewFactory (_viewFactory);
 	if (uidescFile.type == CResourceDescription::kStringType && uidescFile.u.name != nullptr)
 		setFilePath (uidescFile.u.name);
-	if (impl->viewFactory == nullptr)
-		impl->viewFactory = getGenericViewFactory ();
 }
 
 //-----------------------------------------------------------------------------
 UIDescription::UIDescription (IContentProvider* contentProvider, IViewFactory* _viewFactory)
 {
 	impl = std::unique_ptr<Impl> (new Impl);
-	impl->viewFactory = _viewFactory;
+	impl->setViewFactory (_viewFactory);
 	impl->contentProvider = contentProvider;
-	if (impl->viewFactory == nullptr)
-		impl->viewFactory = getGenericViewFactory ();
 }
 
 //-----------------------------------------------------------------------------
@@ -249,6 +293,8 @@ bool UIDescription::parse ()
 		return true;
 		
 	static auto parseUIDesc = [] (IContentProvider* contentProvider) -> SharedPointer<UINode> {
+		if (auto nodes = Detail::UIBinaryDescReader::read (*contentProvider))
+			return nodes;
 		if (auto nodes = Detail::UIJsonDescReader::read (*contentProvider))
 			return nodes;
 #if VSTGUI_ENABLE_XML_PARSER
@@ -356,6 +402,9 @@ static void FreeNodePlatformResources (Detail::UINode* node)
 //-----------------------------------------------------------------------------
 void UIDescription::freePlatformResources ()
 {
+	if (impl->bitmapDecodeQueue)
+		impl->bitmapDecodeQueue->cancelPending ();
+	impl->creationPlans.clear ();
 	if (impl->nodes)
 		FreeNodePlatformResources (impl->nodes);
 }
@@ -420,7 +469,10 @@ bool UIDescription::save (UTF8StringPtr filename, int32_t flags, AttributeSaveFi
 	std::string oldName = moveOldFile (filename);
 	bool result = false;
 	CFileStream stream;
-	if (stream.open (filename, CFileStream::kWriteMode|CFileStream::kTruncateMode))
+	auto openMode = CFileStream::kWriteMode | CFileStream::kTruncateMode;
+	if (flags & kWriteAsBinary)
+		openMode |= CFileStream::kBinaryMode;
+	if (stream.open (filename, openMode))
 	{
 		result = saveToStream (stream, flags, func);
 	}
@@ -472,6 +524,8 @@ bool UIDescription::saveToStream (OutputStream& stream, int32_t flags, Attribute
 	impl->nodes->getAttributes ()->setAttribute ("version", "1");
 	
 	BufferedOutputStream bufferedStream (stream);
+	if (flags & kWriteAsBinary)
+		return Detail::UIBinaryDescWriter::write (bufferedStream, impl->nodes);
 	if (flags & kWriteAsXML)
 	{
 #if VSTGUI_ENABLE_XML_PARSER
@@ -674,7 +728,7 @@ CView* UIDescription::createViewFromNode (UINode* node) const
 	}
 	if (result == nullptr && impl->viewFactory)
 	{
-		result = impl->viewFactory->createView (*node->getAttributes (), this);
+		result = impl->createView (node->getAttributes (), this);
 		if (result == nullptr)
 		{
 			result = new CViewContainer (CRect (0, 0, 0, 0));
@@ -906,12 +960,328 @@ IControlListener* UIDescription::getControlListener (UTF8StringPtr name) const
 	return nullptr;
 }
 
+//-----------------------------------------------------------------------------
+using BitmapFilterList = std::list<SharedPointer<BitmapFilter::IFilter>>;
+
+//-----------------------------------------------------------------------------
+/** creates the filters of the bitmap node, if description is not nullptr it is filled with a
+ *	description of the filters and their properties, used as the key of the bitmap cache */
+static BitmapFilterList createBitmapFilters (const Detail::UIBitmapNode* bitmapNode,
+											 const UIDescription* desc,
+											 std::string* description = nullptr)
+{
+	BitmapFilterList filters;
+	for (auto& childNode : bitmapNode->getChildren ())
+	{
+		const std::string* filterName = nullptr;
+		if (childNode->getName () == "filter" && (filterName = childNode->getAttributes ()->getAttributeValue ("name")))
+		{
+			auto filter = owned (BitmapFilter::Factory::getInstance().createFilter (filterName->c_str ()));
+			if (filter == nullptr)
+				continue;
+			filters.emplace_back (filter);
+			if (description)
+				*description += *filterName + ";";
+			for (auto& propertyNode : childNode->getChildren ())
+			{
+				if (propertyNode->getName () != "property")
+					continue;
+				const std::string* propName = propertyNode->getAttributes ()->getAttributeValue ("name");
+				if (propName == nullptr)
+					continue;
+				if (description)
+				{
+					*description += *propName + "=";
+					if (auto value = propertyNode->getAttributes ()->getAttributeValue ("value"))
+						*description += *value;
+					*description += ";";
+				}
+				switch (filter->getProperty (propName->c_str ()).getType ())
+				{
+					case BitmapFilter::Property::kInteger:
+					{
+						int32_t intValue;
+						if (propertyNode->getAttributes ()->getIntegerAttribute ("value", intValue))
+							filter->setProperty (propName->c_str (), intValue);
+						break;
+					}
+					case BitmapFilter::Property::kFloat:
+					{
+						double floatValue;
+						if (propertyNode->getAttributes ()->getDoubleAttribute ("value", floatValue))
+							filter->setProperty (propName->c_str (), floatValue);
+						break;
+					}
+					case BitmapFilter::Property::kPoint:
+					{
+						CPoint pointValue;
+						if (propertyNode->getAttributes ()->getPointAttribute ("value", pointValue))
+							filter->setProperty (propName->c_str (), pointValue);
+						break;
+					}
+					case BitmapFilter::Property::kRect:
+					{
+						CRect rectValue;
+						if (propertyNode->getAttributes ()->getRectAttribute ("value", rectValue))
+							filter->setProperty (propName->c_str (), rectValue);
+						break;
+					}
+					case BitmapFilter::Property::kColor:
+					{
+						const std::string* colorString = propertyNode->getAttributes()->getAttributeValue ("value");
+						if (colorString)
+						{
+							CColor color;
+							if (desc->getColor (colorString->c_str (), color))
+							{
+								filter->setProperty(propName->c_str (), color);
+								// the color name may refer to a different color next time
+								if (description)
+									*description += std::to_string (color.red) + "," +
+													std::to_string (color.green) + "," +
+													std::to_string (color.blue) + "," +
+													std::to_string (color.alpha) + ";";
+							}
+						}
+						break;
+					}
+					case BitmapFilter::Property::kTransformMatrix:
+					{
+						// TODO
+						break;
+					}
+					case BitmapFilter::Property::kObject: // objects can not be stored/restored
+					case BitmapFilter::Property::kUnknown:
+						break;
+				}
+			}
+		}
+	}
+	return filters;
+}
+
+//-----------------------------------------------------------------------------
+static void applyBitmapFilters (const BitmapFilterList& filters, CBitmap* bitmap)
+{
+	for (auto& filter : filters)
+	{
+		filter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
+		if (filter->run ())
+		{
+			auto obj = filter->getProperty (BitmapFilter::Standard::Property::kOutputBitmap).getObject ();
+			if (auto* outputBitmap = dynamic_cast<CBitmap*>(obj))
+			{
+				bitmap->setPlatformBitmap (outputBitmap->getPlatformBitmap ());
+			}
+		}
+	}
+}
+
+//-----------------------------------------------------------------------------
+/** decodes the bitmap of the request and applies the filters. With a cache the decoded and
+ *	filtered bitmap is taken from the cache if possible or added to it otherwise. */
+static Detail::DecodedBitmap decodeAndFilterBitmap (
+	const Detail::UIBitmapNode::DecodeRequest& request, const BitmapFilterList& filters,
+	const std::string& filterDescription, const Detail::BitmapDiskCachePtr& cache)
+{
+	using Detail::UIBitmapNode;
+	if (cache)
+	{
+		auto encoded = UIBitmapNode::readEncodedData (request);
+		if (!encoded.data.empty ())
+		{
+			auto key = Detail::BitmapDiskCache::makeKey (encoded.data.data (),
+														 encoded.data.size (), filterDescription);
+			if (auto platformBitmap = cache->load (key))
+			{
+				// the scale factor from the name must be found as if the bitmap was decoded, but
+				// the filters may have changed it
+				auto filteredScaleFactor = platformBitmap->getScaleFactor ();
+				platformBitmap->setScaleFactor (encoded.scaleFactor);
+				auto result = UIBitmapNode::decodeBitmap (request, platformBitmap);
+				platformBitmap->setScaleFactor (filteredScaleFactor);
+				result.filtersApplied = true;
+				result.loadedFromCache = true;
+				return result;
+			}
+			if (auto platformBitmap = getPlatformFactory ().createBitmapFromMemory (
+					encoded.data.data (), static_cast<uint32_t> (encoded.data.size ())))
+			{
+				platformBitmap->setScaleFactor (encoded.scaleFactor);
+				auto result = UIBitmapNode::decodeBitmap (request, platformBitmap);
+				applyBitmapFilters (filters, result.bitmap);
+				result.filtersApplied = true;
+				if (auto filteredBitmap = result.bitmap->getPlatformBitmap ())
+					cache->store (key, *filteredBitmap);
+				return result;
+			}
+		}
+	}
+	auto result = UIBitmapNode::decodeBitmap (request);
+	// without a platform bitmap the bitmap creators are asked on the main thread, and the filters
+	// are applied afterwards
+	if (result.bitmap && result.bitmap->getPlatformBitmap ())
+	{
+		applyBitmapFilters (filters, result.bitmap);
+		result.filtersApplied = true;
+	}
+	return result;
+}
+
+//-----------------------------------------------------------------------------
+void UIDescription::setBitmapDecodeTraceFunc (BitmapDecodeTraceFunc&& func)
+{
+	impl->bitmapDecodeTraceFunc = std::move (func);
+}
+
+//-----------------------------------------------------------------------------
+void UIDescription::setBitmapCacheDirectory (UTF8StringPtr directory, uint64_t maxSize)
+{
+	if (directory)
+		impl->bitmapCache = std::make_shared<Detail::BitmapDiskCache> (directory, maxSize);
+	else
+		impl->bitmapCache = nullptr;
+}
+
+//-----------------------------------------------------------------------------
+uint32_t UIDescription::prefetchBitmaps (UTF8StringPtr templateName)
+{
+	if (!impl->nodes)
+		return 0;
+	UINode* bitmapsNode = getBaseNode (Detail::MainNodeNames::kBitmap);
+	if (!bitmapsNode)
+		return 0;
+
+	// the bitmaps by their name without scale factor, so that the scaled variants are found too
+	std::unordered_map<std::string, std::vector<Detail::UIBitmapNode*>> bitmaps;
+	for (auto& it : bitmapsNode->getChildren ())
+	{
+		auto* bitmapNode = dynamic_cast<Detail::UIBitmapNode*> (it);
+		if (bitmapNode == nullptr)
+			continue;
+		if (auto bitmapName = bitmapNode->getAttributes ()->getAttributeValue ("name"))
+			bitmaps[Detail::removeScaleFactorFromName (*bitmapName)].emplace_back (bitmapNode);
+	}
+	std::unordered_map<std::string, UINode*> templates;
+	for (auto& it : impl->nodes->getChildren ())
+	{
+		if (it->getName () != Detail::MainNodeNames::kTemplate)
+			continue;
+		if (auto nodeName = it->getAttributes ()->getAttributeValue ("name"))
+			templates.emplace (*nodeName, it);
+	}
+
+	std::vector<UINode*> stack;
+	std::unordered_set<std::string> visitedTemplates;
+	auto addTemplate = [&] (const std::string& name) {
+		auto it = templates.find (name);
+		if (it != templates.end () && visitedTemplates.emplace (name).second)
+			stack.emplace_back (it->second);
+	};
+	if (templateName)
+		addTemplate (templateName);
+	else
+	{
+		for (auto& it : templates)
+			addTemplate (it.first);
+	}
+
+	// every attribute value (or list item) naming a bitmap or another template is followed
+	std::vector<Detail::UIBitmapNode*> bitmapNodes;
+	std::unordered_set<Detail::UIBitmapNode*> foundBitmapNodes;
+	auto addValue = [&] (const std::string& value) {
+		addTemplate (value);
+		auto it = bitmaps.find (Detail::removeScaleFactorFromName (value));
+		if (it == bitmaps.end ())
+			return;
+		for (auto bitmapNode : it->second)
+		{
+			if (foundBitmapNodes.emplace (bitmapNode).second)
+				bitmapNodes.emplace_back (bitmapNode);
+		}
+	};
+	while (!stack.empty ())
+	{
+		auto node = stack.back ();
+		stack.pop_back ();
+		for (const auto& attr : *node->getAttributes ())
+		{
+			if (attr.second.find (',') == std::string::npos)
+			{
+				addValue (attr.second);
+				continue;
+			}
+			std::stringstream stream (attr.second);
+			std::string item;
+			while (std::getline (stream, item, ','))
+			{
+				item.erase (0, item.find_first_not_of (' '));
+				item.erase (item.find_last_not_of (' ') + 1);
+				addValue (item);
+			}
+		}
+		for (auto& child : node->getChildren ())
+			stack.emplace_back (child);
+	}
+
+	uint32_t numScheduled = 0;
+	for (auto bitmapNode : bitmapNodes)
+	{
+		if (bitmapNode->hasBitmap () || bitmapNode->getDecodeJob ())
+			continue;
+		// the request and the filters are created here, the worker thread must not touch any node
+		auto request = bitmapNode->createDecodeRequest (impl->filePath);
+		if (!request.hasPath)
+			continue;
+		BitmapFilterList filters;
+		std::string filterDescription;
+		if (!bitmapNode->getFilterProcessed ())
+			filters = createBitmapFilters (bitmapNode, this, &filterDescription);
+		if (!impl->bitmapDecodeQueue)
+			impl->bitmapDecodeQueue = std::make_unique<Detail::BitmapDecodeQueue> ();
+		// the filters are moved into the task, as their reference count is not thread safe
+		bitmapNode->setDecodeJob (impl->bitmapDecodeQueue->schedule (
+			[request = std::move (request), filters = std::move (filters),
+			 filterDescription = std::move (filterDescription), cache = impl->bitmapCache] () {
+				return decodeAndFilterBitmap (request, filters, filterDescription, cache);
+			}));
+		++numScheduled;
+	}
+	return numScheduled;
+}
+
 //-----------------------------------------------------------------------------
 CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 {
 	auto* bitmapNode = dynamic_cast<Detail::UIBitmapNode*> (findChildNodeByNameAttribute (getBaseNode (Detail::MainNodeNames::kBitmap), name));
 	if (bitmapNode)
 	{
+		auto traceDecode = impl->bitmapDecodeTraceFunc && !bitmapNode->hasBitmap ();
+		BitmapDecodeTrace trace;
+		trace.name = name;
+		auto decodeStart = std::chrono::steady_clock::now ();
+		if (auto job = bitmapNode->takeDecodeJob ())
+		{
+			auto decoded = job->complete ();
+			bitmapNode->setDecodedBitmap (decoded);
+			trace.decodeTime = job->getDecodeTime ();
+			trace.waitTime = job->getWaitTime ();
+			trace.prefetched = true;
+			trace.decodedInBackground = job->wasDecodedInBackground ();
+			trace.loadedFromCache = decoded.loadedFromCache;
+			decodeStart = std::chrono::steady_clock::now ();
+		}
+		else if (impl->bitmapCache && !bitmapNode->hasBitmap ())
+		{
+			std::string filterDescription;
+			BitmapFilterList filters;
+			if (!bitmapNode->getFilterProcessed ())
+				filters = createBitmapFilters (bitmapNode, this, &filterDescription);
+			auto decoded = decodeAndFilterBitmap (bitmapNode->createDecodeRequest (impl->filePath),
+												  filters, filterDescription, impl->bitmapCache);
+			bitmapNode->setDecodedBitmap (decoded);
+			trace.loadedFromCache = decoded.loadedFromCache;
+		}
 		CBitmap* bitmap = bitmapNode->getBitmap (impl->filePath);
 		if (impl->bitmapCreator && bitmap && bitmap->getPlatformBitmap () == nullptr)
 		{
@@ -940,90 +1310,15 @@ CBitmap* UIDescription::getBitmap (UTF8StringPtr name) const
 		}
 		if (bitmap && bitmapNode->getFilterProcessed () == false)
 		{
-			std::list<SharedPointer<BitmapFilter::IFilter> > filters;
-			for (auto& childNode : bitmapNode->getChildren ())
-			{
-				const std::string* filterName = nullptr;
-				if (childNode->getName () == "filter" && (filterName = childNode->getAttributes ()->getAttributeValue ("name")))
-				{
-					auto filter = owned (BitmapFilter::Factory::getInstance().createFilter (filterName->c_str ()));
-					if (filter == nullptr)
-						continue;
-					filters.emplace_back (filter);
-					for (auto& propertyNode : childNode->getChildren ())
-					{
-						if (propertyNode->getName () != "property")
-							continue;
-						const std::string* propName = propertyNode->getAttributes ()->getAttributeValue ("name");
-						if (propName == nullptr)
-							continue;
-						switch (filter->getProperty (propName->c_str ()).getType ())
-						{
-							case BitmapFilter::Property::kInteger:
-							{
-								int32_t intValue;
-								if (propertyNode->getAttributes ()->getIntegerAttribute ("value", intValue))
-									filter->setProperty (propName->c_str (), intValue);
-								break;
-							}
-							case BitmapFilter::Property::kFloat:
-							{
-								double floatValue;
-								if (propertyNode->getAttributes ()->getDoubleAttribute ("value", floatValue))
-									filter->setProperty (propName->c_str (), floatValue);
-								break;
-							}
-							case BitmapFilter::Property::kPoint:
-							{
-								CPoint pointValue;
-								if (propertyNode->getAttributes ()->getPointAttribute ("value", pointValue))
-									filter->setProperty (propName->c_str (), pointValue);
-								break;
-							}
-							case BitmapFilter::Property::kRect:
-							{
-								CRect rectValue;
-								if (propertyNode->getAttributes ()->getRectAttribute ("value", rectValue))
-									filter->setProperty (propName->c_str (), rectValue);
-								break;
-							}
-							case BitmapFilter::Property::kColor:
-							{
-								const std::string* colorString = propertyNode->getAttributes()->getAttributeValue ("value");
-								if (colorString)
-								{
-									CColor color;
-									if (getColor (colorString->c_str (), color))
-										filter->setProperty(propName->c_str (), color);
-								}
-								break;
-							}
-							case BitmapFilter::Property::kTransformMatrix:
-							{
-								// TODO
-								break;
-							}
-							case BitmapFilter::Property::kObject: // objects can not be stored/restored
-							case BitmapFilter::Property::kUnknown:
-								break;
-						}
-					}
-				}
-			}
-			for (auto& filter : filters)
-			{
-				filter->setProperty (BitmapFilter::Standard::Property::kInputBitmap, bitmap);
-				if (filter->run ())
-				{
-					auto obj = filter->getProperty (BitmapFilter::Standard::Property::kOutputBitmap).getObject ();
-					if (auto* outputBitmap = dynamic_cast<CBitmap*>(obj))
-					{
-						bitmap->setPlatformBitmap (outputBitmap->getPlatformBitmap ());
-					}
-				}
-			}
+			applyBitmapFilters (createBitmapFilters (bitmapNode, this), bitmap);
 			bitmapNode->setFilterProcessed ();
 		}
+		if (traceDecode && bitmap)
+		{
+			trace.decodeTime += std::chrono::duration_cast<std::chrono::nanoseconds> (
+				std::chrono::steady_clock::now () - decodeStart);
+			impl->bitmapDecodeTraceFunc (trace);
+		}
 		if (bitmap && bitmapNode->getScaledBitmapsAdded () == false)
 		{
 			double scaleFactor;
@@ -1720,6 +2015,7 @@ void UIDescription::updateViewDescription (UTF8StringPtr name, CView* view)
 		}
 		node->getChildren ().removeAll ();
 		updateAttributesForView (node, view);
+		impl->pruneCreationPlans ();
 	}
 #endif
 }
@@ -1752,6 +2048,7 @@ bool UIDescription::removeTemplate (UTF8StringPtr name)
 	if (templateNode)
 	{
 		impl->nodes->getChildren ().remove (templateNode);
+		impl->pruneCreationPlans ();
 		impl->forEachListener ([this] (UIDescriptionListener* l) {
 			l->onUIDescTemplateChanged (this);
 		});
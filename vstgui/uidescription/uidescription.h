@@ -6,6 +6,8 @@
 
 #include "iuidescription.h"
 #include "uidescriptionfwd.h"
+#include <chrono>
+#include <functional>
 #include <list>
 #include <string>
 #include <memory>
@@ -28,6 +30,7 @@ protected:
 		WriteImagesIntoUIDescFileBit,
 		DoNotVerifyImageDataBit,
 		WriteAsXmlBit,
+		WriteAsBinaryBit,
 		LastSaveFlagBit,
 	};
 public:
@@ -43,6 +46,8 @@ public:
 		kWriteImagesIntoUIDescFile	= 1 << WriteImagesIntoUIDescFileBit,
 		kDoNotVerifyImageData	= 1 << DoNotVerifyImageDataBit,
 		kWriteAsXML = 1 << WriteAsXmlBit,
+		/** write the binary format, see Detail::UIBinaryDescReader */
+		kWriteAsBinary = 1 << WriteAsBinaryBit,
 		
 		kWriteImagesIntoXMLFile [[deprecated("use kWriteImagesIntoUIDescFile")]] = kWriteImagesIntoUIDescFile,
 		kDoNotVerifyImageXMLData [[deprecated("use kDoNotVerifyImageData")]] = kDoNotVerifyImageData,
@@ -145,6 +150,49 @@ public:
 	void setBitmapCreator (IBitmapCreator* bitmapCreator);
 	void setBitmapCreator2 (IBitmapCreator2* bitmapCreator);
 
+	/** Decode the bitmaps used by a template on background threads
+	 *
+	 *	All bitmaps referenced by the attributes of the template, the templates it refers to and
+	 *	the scaled variants of these bitmaps are decoded and filtered on a small worker pool.
+	 *	getBitmap () only blocks for bitmaps which are not finished yet.
+	 *	Only use this if the platform factory supports creating bitmaps on other threads.
+	 *
+	 *	@param templateName name of the template, or nullptr for all templates
+	 *	@return number of bitmaps scheduled for decoding
+	 */
+	uint32_t prefetchBitmaps (UTF8StringPtr templateName = nullptr);
+
+	struct BitmapDecodeTrace
+	{
+		UTF8StringPtr name {nullptr};
+		/** time needed to decode the bitmap including its filters */
+		std::chrono::nanoseconds decodeTime {};
+		/** time the calling thread was blocked waiting for a worker thread */
+		std::chrono::nanoseconds waitTime {};
+		/** the bitmap was scheduled via prefetchBitmaps () */
+		bool prefetched {false};
+		/** the bitmap was decoded on a worker thread */
+		bool decodedInBackground {false};
+		/** the bitmap was loaded from the bitmap cache directory */
+		bool loadedFromCache {false};
+	};
+	using BitmapDecodeTraceFunc = std::function<void (const BitmapDecodeTrace&)>;
+	/** set a function called whenever getBitmap () delivers a newly decoded bitmap */
+	void setBitmapDecodeTraceFunc (BitmapDecodeTraceFunc&& func);
+
+	/** Keep the decoded and filtered bitmaps in a cache directory
+	 *
+	 *	Bitmaps found in the directory are loaded from there instead of decoding their image data
+	 *	and running their filters again. The entries are keyed by the image data and the filters,
+	 *	so changed bitmaps are decoded again. Several descriptions can share a directory.
+	 *
+	 *	@param directory the cache directory, it is created if needed. nullptr disables the cache
+	 *	@param maxSize maximum size of the directory in bytes, the least recently used entries are
+	 *	removed when it is exceeded
+	 */
+	void setBitmapCacheDirectory (UTF8StringPtr directory,
+								  uint64_t maxSize = 1024ull * 1024ull * 1024ull);
+
 	using FocusDrawing = FocusDrawingSettings;
 	FocusDrawing getFocusDrawingSettings () const;
 	void setFocusDrawingSettings (const FocusDrawing& fd);
@@ -100,6 +100,22 @@ public:
 		return end ();
 	}
 
+	std::vector<const IViewCreator*> resolveCreatorChain (IdStringPtr name)
+	{
+		std::vector<const IViewCreator*> creators;
+		auto iter = find (name);
+		while (iter != end ())
+		{
+			creators.emplace_back ((*iter).second);
+			if ((*iter).second->getBaseViewName () == nullptr)
+				break;
+			iter = find ((*iter).second->getBaseViewName ());
+		}
+		return creators;
+	}
+
+	uint32_t getChangeCount () const { return changeCount; }
+
 	void add (IdStringPtr name, const IViewCreator* viewCreator)
 	{
 #if DEBUG
@@ -109,7 +125,7 @@ public:
 		}
 #endif
 		insert (std::make_pair (viewCreator->getViewName (), viewCreator));
-		
+		++changeCount;
 	}
 
 	void remove (const IViewCreator* viewCreator)
@@ -118,7 +134,11 @@ public:
 		if (it == end ())
 			return;
 		erase (it);
+		++changeCount;
 	}
+
+private:
+	uint32_t changeCount {0};
 };
 
 //-----------------------------------------------------------------------------
@@ -225,7 +245,10 @@ IdStringPtr UIViewFactory::getViewName (CView* view)
 }
 
 //-----------------------------------------------------------------------------
-void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
+template<typename GetAttributeTypeFunc, typename RememberFunc>
+static void evaluateAttributes (const UIAttributes& attributes, UIAttributes& evaluatedAttributes,
+								const IUIDescription* description,
+								GetAttributeTypeFunc&& getAttributeType, RememberFunc&& remember)
 {
 	std::string evaluatedValue;
 	for (const auto& attr : attributes)
@@ -234,21 +257,21 @@ void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttribut
 		if (description && description->getVariable (value.c_str (), evaluatedValue))
 		{
 		#if VSTGUI_LIVE_EDITING
-			rememberAttribute (view, attr.first.c_str (), value.c_str ());
+			remember (attr.first, value);
 		#endif
 			evaluatedAttributes.setAttribute (attr.first, evaluatedValue);
 		}
 		else
 		{
 		#if VSTGUI_LIVE_EDITING
-			auto type = getAttributeType (view, attr.first);
+			auto type = getAttributeType (attr.first);
 			switch (type)
 			{
 				case IViewCreator::kColorType:
 				case IViewCreator::kTagType:
 				case IViewCreator::kFontType:
 				case IViewCreator::kGradientType:
-					rememberAttribute (view, attr.first.c_str (), value.c_str ());
+					remember (attr.first, value);
 					break;
 				default:
 					break;
@@ -259,6 +282,124 @@ void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttribut
 	}
 }
 
+//-----------------------------------------------------------------------------
+void UIViewFactory::evaluateAttributesAndRemember (CView* view, const UIAttributes& attributes, UIAttributes& evaluatedAttributes, const IUIDescription* description) const
+{
+	evaluateAttributes (
+		attributes, evaluatedAttributes, description,
+		[&] (const std::string& name) {
+#if VSTGUI_LIVE_EDITING
+			return getAttributeType (view, name);
+#else
+			return IViewCreator::kUnknownType;
+#endif
+		},
+		[&] (const std::string& name, const std::string& value) {
+#if VSTGUI_LIVE_EDITING
+			rememberAttribute (view, name.c_str (), value);
+#endif
+		});
+}
+
+//-----------------------------------------------------------------------------
+auto UIViewFactory::createCreationPlan (const SharedPointer<UIAttributes>& attributes, const IUIDescription* description) const -> CreationPlanPtr
+{
+	auto& registry = getCreatorRegistry ();
+	auto plan = std::make_shared<CreationPlan> ();
+	plan->attributes = attributes;
+	plan->attributesChangeCount = attributes->getChangeCount ();
+	plan->registryChangeCount = registry.getChangeCount ();
+	const std::string* className = attributes->getAttributeValue (UIViewCreator::kAttrClass);
+	plan->creators = registry.resolveCreatorChain (className ? className->c_str () : "CViewContainer");
+	if (plan->creators.empty ())
+	{
+	#if DEBUG
+		DebugPrint ("UIViewFactory::createCreationPlan(..): Could not find view of class: %s\n", className ? className->c_str () : "CViewContainer");
+	#endif
+		return plan;
+	}
+	auto getAttributeType = [&] (const std::string& name) {
+		for (auto creator : plan->creators)
+		{
+			auto type = creator->getAttributeType (name);
+			if (type != IViewCreator::kUnknownType)
+				return type;
+		}
+		return IViewCreator::kUnknownType;
+	};
+	evaluateAttributes (*attributes, plan->evaluatedAttributes, description, getAttributeType,
+						[&] (const std::string& name, const std::string& value) {
+#if VSTGUI_LIVE_EDITING
+							plan->rememberedAttributes.emplace_back (name, value);
+#endif
+						});
+	// parse the typed values once, so that the creators don't parse them for every view
+	using ParsedType = UIAttributes::ParsedValue::Type;
+	for (const auto& attr : plan->evaluatedAttributes)
+	{
+		if (auto parsed = attributes->getParsedValue (attr.first))
+		{
+			auto value = attributes->getAttributeValue (attr.first);
+			if (value && *value == attr.second)
+			{
+				plan->evaluatedAttributes.setParsedValue (attr.first, *parsed);
+				continue;
+			}
+		}
+		switch (getAttributeType (attr.first))
+		{
+			case IViewCreator::kBooleanType:
+				plan->evaluatedAttributes.parseAttribute (attr.first, ParsedType::kBoolean);
+				break;
+			case IViewCreator::kIntegerType:
+				plan->evaluatedAttributes.parseAttribute (attr.first, ParsedType::kInteger);
+				break;
+			case IViewCreator::kFloatType:
+				plan->evaluatedAttributes.parseAttribute (attr.first, ParsedType::kDouble);
+				break;
+			case IViewCreator::kPointType:
+				plan->evaluatedAttributes.parseAttribute (attr.first, ParsedType::kPoint);
+				break;
+			case IViewCreator::kRectType:
+				plan->evaluatedAttributes.parseAttribute (attr.first, ParsedType::kRect);
+				break;
+			default:
+				break;
+		}
+	}
+	return plan;
+}
+
+//-----------------------------------------------------------------------------
+CView* UIViewFactory::createView (const CreationPlan& plan, const IUIDescription* description) const
+{
+	if (plan.creators.empty ())
+		return nullptr;
+	CView* view = plan.creators.front ()->create (*plan.attributes, description);
+	if (view)
+	{
+		view->setAttribute (kViewNameAttribute, plan.creators.front ()->getViewName ());
+	#if VSTGUI_LIVE_EDITING
+		for (const auto& attr : plan.rememberedAttributes)
+			rememberAttribute (view, attr.first.c_str (), attr.second);
+	#endif
+		for (auto creator : plan.creators)
+		{
+			if (!creator->apply (view, plan.evaluatedAttributes, description))
+				break;
+		}
+	}
+	return view;
+}
+
+//-----------------------------------------------------------------------------
+bool UIViewFactory::isCreationPlanValid (const CreationPlan& plan, const UIAttributes& attributes)
+{
+	return plan.attributes.get () == &attributes &&
+		   plan.attributesChangeCount == attributes.getChangeCount () &&
+		   plan.registryChangeCount == getCreatorRegistry ().getChangeCount ();
+}
+
 #if VSTGUI_LIVE_EDITING
 //-----------------------------------------------------------------------------
 bool UIViewFactory::getAttributeNamesForView (CView* view, StringList& attributeNames) const
@@ -8,6 +8,9 @@
 #include "iuidescription.h"
 #include "iviewfactory.h"
 #include "iviewcreator.h"
+#include "uiattributes.h"
+#include <memory>
+#include <vector>
 
 namespace VSTGUI {
 
@@ -28,6 +31,30 @@ public:
 	
 	static IdStringPtr getViewName (CView* view);
 
+	/** Pre-resolved data to create views for one set of attributes
+	 *
+	 *	The view creator chain is looked up and the variables in the attributes are evaluated
+	 *	once, after that the plan can be used to create any number of views. A plan stays valid
+	 *	as long as its attributes are not modified and no view creator is (un)registered.
+	 */
+	struct CreationPlan
+	{
+		SharedPointer<UIAttributes> attributes;
+		uint32_t attributesChangeCount {0};
+		uint32_t registryChangeCount {0};
+		/** the view creator of the class and all its base classes */
+		std::vector<const IViewCreator*> creators;
+		UIAttributes evaluatedAttributes;
+#if VSTGUI_LIVE_EDITING
+		std::vector<std::pair<std::string, std::string>> rememberedAttributes;
+#endif
+	};
+	using CreationPlanPtr = std::shared_ptr<const CreationPlan>;
+
+	CreationPlanPtr createCreationPlan (const SharedPointer<UIAttributes>& attributes, const IUIDescription* description) const;
+	CView* createView (const CreationPlan& plan, const IUIDescription* description) const;
+	static bool isCreationPlanValid (const CreationPlan& plan, const UIAttributes& attributes);
+
 	static void registerViewCreator (const IViewCreator& viewCreator);
 	static void unregisterViewCreator (const IViewCreator& viewCreator);
 
@@ -12,6 +12,10 @@
 
 namespace VSTGUI {
 
+//-----------------------------------------------------------------------------
+static constexpr uint32_t kPrewarmInterval = 50;
+static constexpr uint64_t kEstimatedMemoryPerView = 1024;
+
 //-----------------------------------------------------------------------------
 UIViewSwitchContainer::UIViewSwitchContainer (const CRect& size)
 : CViewContainer (size)
@@ -21,6 +25,8 @@ UIViewSwitchContainer::UIViewSwitchContainer (const CRect& size)
 //-----------------------------------------------------------------------------
 UIViewSwitchContainer::~UIViewSwitchContainer () noexcept
 {
+	if (prewarmTimer)
+		prewarmTimer->stop ();
 	setController (nullptr);
 }
 
@@ -34,6 +40,7 @@ void UIViewSwitchContainer::setController (IViewSwitchController* _controller)
 			obj->forget ();
 	}
 	controller = _controller;
+	clearViewCache ();
 }
 
 //-----------------------------------------------------------------------------
@@ -43,16 +50,13 @@ void UIViewSwitchContainer::setCurrentViewIndex (int32_t viewIndex)
 
 	if (controller && viewIndex != currentViewIndex)
 	{
-		CView* view = controller->createViewForIndex (viewIndex);
+		CachedView entry;
+		CView* view = createViewForIndex (viewIndex, entry);
 		if (view)
 		{
-			if (view->getAutosizeFlags () & kAutosizeAll)
-			{
-				CRect vs (getViewSize ());
-				vs.offset (-vs.left, -vs.top);
-				view->setViewSize (vs);
-				view->setMouseableArea (vs);
-			}
+			if (currentView.view)
+				addToViewCache (std::move (currentView));
+			currentView = std::move (entry);
 			if (isAttached () && animationTime)
 			{
 				removeAnimation ("UIViewSwitchContainer::setCurrentViewIndex");
@@ -144,6 +148,198 @@ void UIViewSwitchContainer::setCurrentViewIndex (int32_t viewIndex)
 	}
 }
 
+//-----------------------------------------------------------------------------
+/** returns the view with a reference the caller takes over, either from the cache or newly created
+ */
+CView* UIViewSwitchContainer::createViewForIndex (int32_t index, CachedView& entry)
+{
+	auto it = std::find_if (viewCache.begin (), viewCache.end (),
+							[index] (const CachedView& e) { return e.index == index; });
+	if (it != viewCache.end ())
+	{
+		// the view may still be faded out by the last exchange animation
+		if (it->view->isAttached ())
+			removeAnimation ("UIViewSwitchContainer::setCurrentViewIndex");
+		entry = std::move (*it);
+		viewCache.erase (it);
+		viewCacheMemory -= entry.memory;
+		if (!entry.view->isAttached ())
+		{
+			CView* view = entry.view;
+			view->remember ();
+			if (view->getAutosizeFlags () & kAutosizeAll)
+			{
+				entry.viewSize = getViewSize ();
+				entry.viewSize.originize ();
+			}
+			view->setViewSize (entry.viewSize);
+			view->setMouseableArea (entry.viewSize);
+			view->setAlphaValue (entry.alphaValue);
+			return view;
+		}
+		entry = {};
+	}
+	CView* view = controller ? controller->createViewForIndex (index) : nullptr;
+	if (view)
+	{
+		if (view->getAutosizeFlags () & kAutosizeAll)
+		{
+			CRect vs (getViewSize ());
+			vs.offset (-vs.left, -vs.top);
+			view->setViewSize (vs);
+			view->setMouseableArea (vs);
+		}
+		entry.index = index;
+		entry.view = view;
+		entry.viewSize = view->getViewSize ();
+		entry.alphaValue = view->getAlphaValue ();
+	}
+	return view;
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::addToViewCache (CachedView&& entry, bool mostRecentlyUsed)
+{
+	if (cachePolicy.maxViews == 0)
+		return;
+	if (cachePolicy.maxMemory)
+		entry.memory = estimateViewMemory (entry.view);
+	viewCacheMemory += entry.memory;
+	if (mostRecentlyUsed)
+		viewCache.emplace_front (std::move (entry));
+	else
+		viewCache.emplace_back (std::move (entry));
+	trimViewCache ();
+}
+
+//-----------------------------------------------------------------------------
+bool UIViewSwitchContainer::isViewCacheFull () const
+{
+	if (viewCache.size () >= cachePolicy.maxViews)
+		return true;
+	return cachePolicy.maxMemory && viewCacheMemory >= cachePolicy.maxMemory;
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::trimViewCache ()
+{
+	while (!viewCache.empty () &&
+		   (viewCache.size () > cachePolicy.maxViews ||
+			(cachePolicy.maxMemory && viewCacheMemory > cachePolicy.maxMemory)))
+	{
+		viewCacheMemory -= viewCache.back ().memory;
+		viewCache.pop_back ();
+	}
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::setViewCachePolicy (const ViewCachePolicy& policy)
+{
+	bool memoryBoundChanged = (policy.maxMemory != 0) != (cachePolicy.maxMemory != 0);
+	cachePolicy = policy;
+	if (memoryBoundChanged)
+	{
+		viewCacheMemory = 0;
+		for (auto& entry : viewCache)
+		{
+			entry.memory = cachePolicy.maxMemory ? estimateViewMemory (entry.view) : 0;
+			viewCacheMemory += entry.memory;
+		}
+	}
+	trimViewCache ();
+	if (prewarmViews && isAttached ())
+		startPrewarming ();
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::clearViewCache ()
+{
+	viewCache.clear ();
+	viewCacheMemory = 0;
+	failedPrewarmIndices.clear ();
+}
+
+//-----------------------------------------------------------------------------
+uint64_t UIViewSwitchContainer::estimateViewMemory (CView* view)
+{
+	if (!view)
+		return 0;
+	uint64_t memory = kEstimatedMemoryPerView;
+	if (auto container = view->asViewContainer ())
+	{
+		if (container->getCacheAsBitmap ())
+		{
+			// the bitmap cache uses 4 bytes per pixel
+			memory += static_cast<uint64_t> (container->getWidth ()) *
+					  static_cast<uint64_t> (container->getHeight ()) * 4;
+		}
+		container->forEachChild (
+			[&memory] (CView* child) { memory += estimateViewMemory (child); });
+	}
+	return memory;
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::setPrewarmViews (bool state)
+{
+	prewarmViews = state;
+	if (prewarmViews && isAttached ())
+		startPrewarming ();
+	else if (!prewarmViews && prewarmTimer)
+	{
+		prewarmTimer->stop ();
+		prewarmTimer = nullptr;
+	}
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::startPrewarming ()
+{
+	if (prewarmTimer || !controller || controller->getNumViews () <= 0 || isViewCacheFull ())
+		return;
+	// one view per timer call, so that a single call does not block the UI for long
+	prewarmTimer = makeOwned<CVSTGUITimer> ([this] (CVSTGUITimer*) { prewarmNextView (); },
+											kPrewarmInterval);
+}
+
+//-----------------------------------------------------------------------------
+void UIViewSwitchContainer::prewarmNextView ()
+{
+	auto isCreatedOrFailed = [this] (int32_t index) {
+		return currentView.index == index ||
+			   std::find (failedPrewarmIndices.begin (), failedPrewarmIndices.end (), index) !=
+				   failedPrewarmIndices.end () ||
+			   std::find_if (viewCache.begin (), viewCache.end (), [index] (const CachedView& e) {
+				   return e.index == index;
+			   }) != viewCache.end ();
+	};
+	int32_t numViews = controller ? controller->getNumViews () : 0;
+	int32_t index = 0;
+	while (index < numViews && isCreatedOrFailed (index))
+		++index;
+	if (index < numViews && !isViewCacheFull ())
+	{
+		CachedView entry;
+		if (auto view = createViewForIndex (index, entry))
+		{
+			view->forget ();
+			// prewarmed views were not used yet
+			addToViewCache (std::move (entry), false);
+		}
+		else
+		{
+			failedPrewarmIndices.push_back (index);
+		}
+		if (!isViewCacheFull ())
+			return;
+	}
+	if (prewarmTimer)
+	{
+		prewarmTimer->stop ();
+		prewarmTimer = nullptr;
+	}
+}
+
 //-----------------------------------------------------------------------------
 void UIViewSwitchContainer::setAnimationTime (uint32_t ms)
 {
@@ -167,8 +363,11 @@ bool UIViewSwitchContainer::attached (CView* parent)
 {
 	bool result = CViewContainer::attached (parent);
 	CViewContainer::removeAll ();
+	currentView = {};
 	if (result && controller)
 		controller->switchContainerAttached ();
+	if (result && prewarmViews)
+		startPrewarming ();
 	return result;
 }
 
@@ -178,10 +377,16 @@ bool UIViewSwitchContainer::removed (CView* parent)
 	if (isAttached ())
 	{
 		removeAnimation ("UIViewSwitchContainer::setCurrentViewIndex");
+		if (prewarmTimer)
+		{
+			prewarmTimer->stop ();
+			prewarmTimer = nullptr;
+		}
 		bool result = CViewContainer::removed (parent);
 		if (result && controller)
 			controller->switchContainerRemoved ();
 		CViewContainer::removeAll ();
+		currentView = {};
 		return result;
 	}
 	return false;
@@ -284,6 +489,8 @@ void UIDescriptionViewSwitchController::valueChanged (CControl* pControl)
 //-----------------------------------------------------------------------------
 void UIDescriptionViewSwitchController::setTemplateNames (UTF8StringPtr _templateNames)
 {
+	// the cached views belong to the old template names
+	viewSwitch->clearViewCache ();
 	templateNames.clear ();
 	if (_templateNames)
 	{
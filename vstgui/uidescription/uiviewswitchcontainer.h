@@ -6,8 +6,11 @@
 
 #include "../lib/cviewcontainer.h"
 #include "../lib/controls/icontrollistener.h"
+#include "../lib/cvstguitimer.h"
 #include "../lib/vstguifwd.h"
 #include "uidescriptionfwd.h"
+#include <limits>
+#include <list>
 #include <vector>
 #include <string>
 
@@ -50,16 +53,78 @@ public:
 	void setTimingFunction (TimingFunction t);
 	TimingFunction getTimingFunction () const { return timingFunction; }
 
+	/** defines which of the views not shown are kept to be reused when switching back to them */
+	struct ViewCachePolicy
+	{
+		/** maximum number of cached views, the current view is not counted */
+		uint32_t maxViews {0};
+		/** maximum estimated memory of the cached views in bytes, 0 for no limit */
+		uint64_t maxMemory {0};
+
+		static ViewCachePolicy none () { return {}; }
+		static ViewCachePolicy keepLast (uint32_t numViews) { return {numViews, 0}; }
+		static ViewCachePolicy keepAll () { return {std::numeric_limits<uint32_t>::max (), 0}; }
+		static ViewCachePolicy memoryBounded (uint64_t maxBytes)
+		{
+			return {std::numeric_limits<uint32_t>::max (), maxBytes};
+		}
+	};
+
+	/** the default policy does not cache any views */
+	void setViewCachePolicy (const ViewCachePolicy& policy);
+	const ViewCachePolicy& getViewCachePolicy () const { return cachePolicy; }
+	/** release all cached views and retry the indices that failed to prewarm */
+	void clearViewCache ();
+	uint32_t getNumCachedViews () const { return static_cast<uint32_t> (viewCache.size ()); }
+	/** estimated memory of a view tree as used by a memory bounded cache policy. It counts a fixed
+	 *	amount per view and the bitmap cache of view containers. Bitmaps used by the views are
+	 *	shared with their owner (e.g. the UIDescription) and are not counted, so the real memory
+	 *	of a view tree can be higher.
+	 */
+	static uint64_t estimateViewMemory (CView* view);
+
+	/** create the views of the other indices after the container was attached, as far as the
+	 *	cache policy allows to keep them. One view is created every 50 ms on a timer, this does not
+	 *	wait for the UI to be idle, so creating a large view can still delay a frame. Indices the
+	 *	controller does not create a view for are not tried again. */
+	void setPrewarmViews (bool state);
+	bool getPrewarmViews () const { return prewarmViews; }
+
 	bool attached (CView* parent) override;
 	bool removed (CView* parent) override;
 //-----------------------------------------------------------------------------
 	CLASS_METHODS (UIViewSwitchContainer, CViewContainer)
 protected:
+	struct CachedView
+	{
+		int32_t index {-1};
+		SharedPointer<CView> view;
+		/** view size and alpha value before the view was animated */
+		CRect viewSize;
+		float alphaValue {1.f};
+		uint64_t memory {0};
+	};
+
+	CView* createViewForIndex (int32_t index, CachedView& entry);
+	void addToViewCache (CachedView&& entry, bool mostRecentlyUsed = true);
+	bool isViewCacheFull () const;
+	void trimViewCache ();
+	void startPrewarming ();
+	void prewarmNextView ();
+
 	IViewSwitchController* controller {nullptr};
 	int32_t currentViewIndex {-1};
 	uint32_t animationTime {120};
 	AnimationStyle animationStyle {kFadeInOut};
 	TimingFunction timingFunction {kLinear};
+	ViewCachePolicy cachePolicy;
+	/** most recently used first */
+	std::list<CachedView> viewCache;
+	CachedView currentView;
+	uint64_t viewCacheMemory {0};
+	SharedPointer<CVSTGUITimer> prewarmTimer;
+	std::vector<int32_t> failedPrewarmIndices;
+	bool prewarmViews {false};
 };
 
 //-----------------------------------------------------------------------------
@@ -76,6 +141,8 @@ public:
 	virtual CView* createViewForIndex (int32_t index) = 0;
 	virtual void switchContainerAttached () = 0;
 	virtual void switchContainerRemoved () = 0;
+	/** number of view indices, needed for prewarming the views. -1 if unknown */
+	virtual int32_t getNumViews () const { return -1; }
 protected:
 	UIViewSwitchContainer* viewSwitch;
 };
@@ -89,6 +156,7 @@ public:
 	CView* createViewForIndex (int32_t index) override;
 	void switchContainerAttached () override;
 	void switchContainerRemoved () override;
+	int32_t getNumViews () const override { return static_cast<int32_t> (templateNames.size ()); }
 
 	void setTemplateNames (UTF8StringPtr templateNames); // comma separated
 	void getTemplateNames (std::string& str); // comma separated
@@ -83,6 +83,8 @@ bool ParamDisplayCreator::apply (CView* view, const UIAttributes& attributes,
 	bool b;
 	if (attributes.getBooleanAttribute (kAttrFontAntialias, b))
 		display->setAntialias (b);
+	if (attributes.getBooleanAttribute (kAttrFastTextRendering, b))
+		display->setFastTextRendering (b);
 
 	const auto* textAlignmentAttr = attributes.getAttributeValue (kAttrTextAlignment);
 	if (textAlignmentAttr)
@@ -151,6 +153,7 @@ bool ParamDisplayCreator::getAttributeNames (StringList& attributeNames) const
 	attributeNames.emplace_back (kAttrStyleShadowText);
 	attributeNames.emplace_back (kAttrStyleRoundRect);
 	attributeNames.emplace_back (kAttrTextRotation);
+	attributeNames.emplace_back (kAttrFastTextRendering);
 	return true;
 }
 
@@ -199,6 +202,8 @@ auto ParamDisplayCreator::getAttributeType (const string& attributeName) const -
 		return kFloatType;
 	else if (attributeName == kAttrBackgroundOffset)
 		return kPointType;
+	else if (attributeName == kAttrFastTextRendering)
+		return kBooleanType;
 	return kUnknownType;
 }
 
@@ -325,6 +330,11 @@ bool ParamDisplayCreator::getAttributeValue (CView* view, const string& attribut
 		stringValue = UIAttributes::pointToString (pd->getBackOffset ());
 		return true;
 	}
+	else if (attributeName == kAttrFastTextRendering)
+	{
+		stringValue = pd->getFastTextRendering () ? strTrue : strFalse;
+		return true;
+	}
 	return false;
 }
 
@@ -81,6 +81,8 @@ bool ScrollViewCreator::apply (CView* view, const UIAttributes& attributes,
 	                CScrollView::kFollowFocusView, style);
 	applyStyleMask (attributes.getAttributeValue (kAttrAutoHideScrollbars),
 	                CScrollView::kAutoHideScrollbars, style);
+	applyStyleMask (attributes.getAttributeValue (kAttrTransformScrolling),
+	                CScrollView::kTransformScrolling, style);
 	scrollView->setStyle (style);
 	CColor color;
 	CScrollbar* vscrollbar = scrollView->getVerticalScrollbar ();
@@ -129,6 +131,7 @@ bool ScrollViewCreator::getAttributeNames (StringList& attributeNames) const
 	attributeNames.emplace_back (kAttrScrollbarWidth);
 	attributeNames.emplace_back (kAttrBordered);
 	attributeNames.emplace_back (kAttrFollowFocusView);
+	attributeNames.emplace_back (kAttrTransformScrolling);
 	return true;
 }
 
@@ -159,6 +162,8 @@ auto ScrollViewCreator::getAttributeType (const string& attributeName) const ->
 		return kBooleanType;
 	if (attributeName == kAttrFollowFocusView)
 		return kBooleanType;
+	if (attributeName == kAttrTransformScrolling)
+		return kBooleanType;
 	return kUnknownType;
 }
 
@@ -235,6 +240,11 @@ bool ScrollViewCreator::getAttributeValue (CView* view, const string& attributeN
 		stringValue = sc->getStyle () & CScrollView::kFollowFocusView ? strTrue : strFalse;
 		return true;
 	}
+	if (attributeName == kAttrTransformScrolling)
+	{
+		stringValue = sc->getStyle () & CScrollView::kTransformScrolling ? strTrue : strFalse;
+		return true;
+	}
 	return false;
 }
 
@@ -9,6 +9,7 @@
 #include "../uiattributes.h"
 #include "../uiviewcreator.h"
 #include "../uiviewfactory.h"
+#include <algorithm>
 
 //------------------------------------------------------------------------
 namespace VSTGUI {
@@ -60,6 +61,12 @@ bool ShadowViewContainerCreator::apply (CView* view, const UIAttributes& attribu
 	CPoint p;
 	if (attributes.getPointAttribute (kAttrShadowOffset, p))
 		shadowView->setShadowOffset (p);
+	int32_t downsampling;
+	if (attributes.getIntegerAttribute (kAttrShadowDownsampling, downsampling))
+		shadowView->setShadowDownsampling (static_cast<uint32_t> (std::max (1, downsampling)));
+	bool followsContent;
+	if (attributes.getBooleanAttribute (kAttrShadowFollowsContent, followsContent))
+		shadowView->setShadowFollowsContent (followsContent);
 	return true;
 }
 
@@ -69,6 +76,8 @@ bool ShadowViewContainerCreator::getAttributeNames (StringList& attributeNames)
 	attributeNames.emplace_back (kAttrShadowIntensity);
 	attributeNames.emplace_back (kAttrShadowOffset);
 	attributeNames.emplace_back (kAttrShadowBlurSize);
+	attributeNames.emplace_back (kAttrShadowDownsampling);
+	attributeNames.emplace_back (kAttrShadowFollowsContent);
 	return true;
 }
 
@@ -81,6 +90,10 @@ auto ShadowViewContainerCreator::getAttributeType (const string& attributeName)
 		return kPointType;
 	if (attributeName == kAttrShadowBlurSize)
 		return kFloatType;
+	if (attributeName == kAttrShadowDownsampling)
+		return kIntegerType;
+	if (attributeName == kAttrShadowFollowsContent)
+		return kBooleanType;
 	return kUnknownType;
 }
 
@@ -107,6 +120,17 @@ bool ShadowViewContainerCreator::getAttributeValue (CView* view, const string& a
 		stringValue = UIAttributes::pointToString (shadowView->getShadowOffset ());
 		return true;
 	}
+	else if (attributeName == kAttrShadowDownsampling)
+	{
+		stringValue = UIAttributes::integerToString (
+		    static_cast<int32_t> (shadowView->getShadowDownsampling ()));
+		return true;
+	}
+	else if (attributeName == kAttrShadowFollowsContent)
+	{
+		stringValue = shadowView->getShadowFollowsContent () ? strTrue : strFalse;
+		return true;
+	}
 	return false;
 }
 
@@ -126,6 +150,12 @@ bool ShadowViewContainerCreator::getAttributeValueRange (const string& attribute
 		maxValue = 1;
 		return true;
 	}
+	else if (attributeName == kAttrShadowDownsampling)
+	{
+		minValue = 1;
+		maxValue = 8;
+		return true;
+	}
 	return false;
 }
 
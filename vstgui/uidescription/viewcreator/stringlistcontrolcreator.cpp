@@ -46,7 +46,7 @@ CView* StringListControlCreator::create (const UIAttributes& attributes,
 	auto control = new CListControl (CRect (0, 0, 100, 200));
 	auto drawer = makeOwned<StringListControlDrawer> ();
 	control->setDrawer (drawer);
-	auto configurator = makeOwned<StaticListControlConfigurator> (12.);
+	auto configurator = makeOwned<UniformListControlConfigurator> (12.);
 	control->setConfigurator (configurator);
 	return control;
 }
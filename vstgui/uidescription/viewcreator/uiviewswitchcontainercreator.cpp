@@ -123,6 +123,19 @@ bool UIViewSwitchContainerCreator::apply (CView* view, const UIAttributes& attri
 	{
 		viewSwitch->setAnimationTime (static_cast<uint32_t> (animationTime));
 	}
+	int32_t viewCacheSize;
+	if (attributes.getIntegerAttribute (kAttrViewCacheSize, viewCacheSize))
+	{
+		// a negative size keeps all views
+		viewSwitch->setViewCachePolicy (
+		    viewCacheSize < 0 ?
+		        UIViewSwitchContainer::ViewCachePolicy::keepAll () :
+		        UIViewSwitchContainer::ViewCachePolicy::keepLast (
+		            static_cast<uint32_t> (viewCacheSize)));
+	}
+	bool prewarmViews;
+	if (attributes.getBooleanAttribute (kAttrPrewarmViews, prewarmViews))
+		viewSwitch->setPrewarmViews (prewarmViews);
 	return true;
 }
 
@@ -134,6 +147,8 @@ bool UIViewSwitchContainerCreator::getAttributeNames (StringList& attributeNames
 	attributeNames.emplace_back (kAttrAnimationStyle);
 	attributeNames.emplace_back (kAttrAnimationTimingFunction);
 	attributeNames.emplace_back (kAttrAnimationTime);
+	attributeNames.emplace_back (kAttrViewCacheSize);
+	attributeNames.emplace_back (kAttrPrewarmViews);
 	return true;
 }
 
@@ -150,6 +165,10 @@ auto UIViewSwitchContainerCreator::getAttributeType (const string& attributeName
 		return kListType;
 	if (attributeName == kAttrAnimationTime)
 		return kIntegerType;
+	if (attributeName == kAttrViewCacheSize)
+		return kIntegerType;
+	if (attributeName == kAttrPrewarmViews)
+		return kBooleanType;
 	return kUnknownType;
 }
 
@@ -193,6 +212,20 @@ bool UIViewSwitchContainerCreator::getAttributeValue (CView* view, const string&
 		    UIAttributes::integerToString (static_cast<int32_t> (viewSwitch->getAnimationTime ()));
 		return true;
 	}
+	else if (attributeName == kAttrViewCacheSize)
+	{
+		auto maxViews = viewSwitch->getViewCachePolicy ().maxViews;
+		stringValue = UIAttributes::integerToString (
+		    maxViews == UIViewSwitchContainer::ViewCachePolicy::keepAll ().maxViews ?
+		        -1 :
+		        static_cast<int32_t> (maxViews));
+		return true;
+	}
+	else if (attributeName == kAttrPrewarmViews)
+	{
+		stringValue = viewSwitch->getPrewarmViews () ? strTrue : strFalse;
+		return true;
+	}
 	else if (attributeName == kAttrAnimationStyle)
 	{
 		stringValue = animationStyleStrings ()[viewSwitch->getAnimationStyle ()];
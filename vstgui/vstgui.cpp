@@ -4,6 +4,7 @@
 
 #include "lib/cbitmap.cpp"
 #include "lib/cbitmapfilter.cpp"
+#include "lib/cbitmaptilerenderer.cpp"
 #include "lib/cclipboard.cpp"
 #include "lib/ccolor.cpp"
 #include "lib/cdatabrowser.cpp"
@@ -14,9 +15,11 @@
 #include "lib/cfileselector.cpp"
 #include "lib/cfont.cpp"
 #include "lib/cframe.cpp"
+#include "lib/cglyphatlas.cpp"
 #include "lib/cgradient.cpp"
 #include "lib/cgradientview.cpp"
 #include "lib/cgraphicspath.cpp"
+#include "lib/cgraphicspathcache.cpp"
 #include "lib/clayeredviewcontainer.cpp"
 #include "lib/clinestyle.cpp"
 #include "lib/coffscreencontext.cpp"
@@ -43,6 +46,7 @@
 #include "lib/controls/cbuttons.cpp"
 #include "lib/controls/ccolorchooser.cpp"
 #include "lib/controls/ccontrol.cpp"
+#include "lib/controls/ccontrolvaluemailbox.cpp"
 #include "lib/controls/cfontchooser.cpp"
 #include "lib/controls/cknob.cpp"
 #include "lib/controls/clistcontrol.cpp"
@@ -8,6 +8,7 @@
 #include "lib/vstguibase.h"
 #include "lib/cbitmap.h"
 #include "lib/cbitmapfilter.h"
+#include "lib/cbitmaptilerenderer.h"
 #include "lib/cbuttonstate.h"
 #include "lib/ccolor.h"
 #include "lib/cdatabrowser.h"
@@ -17,9 +18,11 @@
 #include "lib/cfileselector.h"
 #include "lib/cfont.h"
 #include "lib/cframe.h"
+#include "lib/cglyphatlas.h"
 #include "lib/cgradient.h"
 #include "lib/cgradientview.h"
 #include "lib/cgraphicspath.h"
+#include "lib/cgraphicspathcache.h"
 #include "lib/clayeredviewcontainer.h"
 #include "lib/clinestyle.h"
 #include "lib/coffscreencontext.h"
@@ -44,6 +47,7 @@
 #include "lib/controls/cbuttons.h"
 #include "lib/controls/ccolorchooser.h"
 #include "lib/controls/ccontrol.h"
+#include "lib/controls/ccontrolvaluemailbox.h"
 #include "lib/controls/cfontchooser.h"
 #include "lib/controls/cknob.h"
 #include "lib/controls/cmoviebitmap.h"
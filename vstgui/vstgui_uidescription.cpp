@@ -72,6 +72,9 @@
 #include "uidescription/viewcreator/vumetercreator.cpp"
 #include "uidescription/viewcreator/xypadcreator.cpp"
 
+#include "uidescription/detail/uibinarypersistence.cpp"
+#include "uidescription/detail/uibitmapcache.cpp"
+#include "uidescription/detail/uibitmapdecoder.cpp"
 #include "uidescription/detail/uidesclist.cpp"
 #include "uidescription/detail/uijsonpersistence.cpp"
 #include "uidescription/detail/uinode.cpp"